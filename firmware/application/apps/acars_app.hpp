@@ -100,14 +100,11 @@ private:
 	uint32_t target_frequency() const;
 	void set_target_frequency(const uint32_t new_value);
 	
-	MessageHandlerRegistration message_handler_packet {
-		Message::ID::ACARSPacket,
-		[this](Message* const p) {
-			const auto message = static_cast<const ACARSPacketMessage*>(p);
-			const acars::Packet packet { message->packet };
-			this->on_packet(packet);
-		}
-	};
+	void on_packet_message(const ACARSPacketMessage* const message) {
+		const acars::Packet packet { message->packet };
+		on_packet(packet);
+	}
+	MessageHandler<ACARSPacketMessage, ACARSAppView, &ACARSAppView::on_packet_message> message_handler_packet { this };
 
 };
 
@@ -196,15 +196,16 @@ void RecentEntriesTable<AISRecentEntries>::draw(
 	Painter& painter,
 	const Style& style
 ) {
-	std::string line = ais::format::mmsi(entry.mmsi) + " ";
+	FixedString<32> line;
+	line.dec_uint(entry.mmsi, 9).append(' ');
 	if( !entry.name.empty() ) {
-		line += entry.name;
+		line.append(entry.name);
 	} else {
-		line += entry.call_sign;
+		line.append(entry.call_sign);
 	}
 
 	line.resize(target_rect.width() / 8, ' ');
-	painter.draw_string(target_rect.location(), style, line);
+	painter.draw_string(target_rect.location(), style, line.c_str());
 }
 
 AISRecentEntryDetailView::AISRecentEntryDetailView(NavigationView& nav) {
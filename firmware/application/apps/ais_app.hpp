@@ -217,16 +217,13 @@ private:
 		{ 21 * 8, 5, 6 * 8, 4 },
 	};
 
-	MessageHandlerRegistration message_handler_packet {
-		Message::ID::AISPacket,
-		[this](Message* const p) {
-			const auto message = static_cast<const AISPacketMessage*>(p);
-			const ais::Packet packet { message->packet };
-			if( packet.is_valid() ) {
-				this->on_packet(packet);
-			}
+	void on_packet_message(const AISPacketMessage* const message) {
+		const ais::Packet packet { message->packet };
+		if( packet.is_valid() ) {
+			on_packet(packet);
 		}
-	};
+	}
+	MessageHandler<AISPacketMessage, AISAppView, &AISAppView::on_packet_message> message_handler_packet { this };
 
 	uint32_t target_frequency_ = initial_target_frequency;
 
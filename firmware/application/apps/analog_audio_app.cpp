@@ -49,12 +49,19 @@ AMOptionsView::AMOptionsView(
 	add_children({
 		&label_config,
 		&options_config,
+		&label_processing,
+		&options_processing,
 	});
 
 	options_config.set_selected_index(receiver_model.am_configuration());
 	options_config.on_change = [this](size_t n, OptionsField::value_t) {
 		receiver_model.set_am_configuration(n);
 	};
+
+	options_processing.set_by_value((receiver_model.audio_agc() ? 1 : 0) | (receiver_model.noise_blanker() ? 2 : 0));
+	options_processing.on_change = [this](size_t, OptionsField::value_t v) {
+		receiver_model.set_audio_processing(v & 1, v & 2);
+	};
 }
 
 /* NBFMOptionsView *******************************************************/
@@ -69,7 +76,9 @@ NBFMOptionsView::NBFMOptionsView(
 		&label_config,
 		&options_config,
 		&text_squelch,
-		&field_squelch
+		&field_squelch,
+		&text_tone_squelch,
+		&options_tone_squelch
 	});
 
 	options_config.set_selected_index(receiver_model.nbfm_configuration());
@@ -81,6 +90,20 @@ NBFMOptionsView::NBFMOptionsView(
 	field_squelch.on_change = [this](int32_t v) {
 		receiver_model.set_squelch_level(v);
 	};
+
+	OptionsField::options_t tone_options {
+		{ "off", NBFMConfigureMessage::tone_squelch_off },
+		{ "any", NBFMConfigureMessage::tone_squelch_any },
+	};
+	for (size_t c = 1; c <= 50; c++) {
+		const auto f = tone_keys[c].second;
+		tone_options.emplace_back(to_string_dec_uint(f, 3), std::lround(f * 100));
+	}
+	options_tone_squelch.set_options(tone_options);
+	options_tone_squelch.set_by_value(receiver_model.tone_squelch());
+	options_tone_squelch.on_change = [this](size_t, OptionsField::value_t v) {
+		receiver_model.set_tone_squelch(v);
+	};
 }
 
 /* AnalogAudioView *******************************************************/
@@ -345,31 +368,27 @@ void AnalogAudioView::update_modulation(const ReceiverModel::Mode modulation) {
 	if (exit_on_squelch) nav_.pop();
 }*/
 
-void AnalogAudioView::handle_coded_squelch(const bool enabled, const uint32_t value) {
-	if (enabled == true)
-	{
-		float diff, min_diff = value;
-		size_t min_idx { 0 };
-		size_t c;
-	
-		// Find nearest match
-		for (c = 0; c < tone_keys.size(); c++) {
-			diff = abs(((float)value / 100.0) - tone_keys[c].second);
-			if (diff < min_diff) {
-				min_idx = c;
-				min_diff = diff;
-			}
-		}
-	
-		// Arbitrary confidence threshold
-		if (min_diff < 40)
-			text_ctcss.set("CTCSS " + tone_keys[min_idx].first);
-		else
-			text_ctcss.set("???");
-	}
-	else if (enabled == false)
-	{
-		text_ctcss.set("RSSI " + to_string_dec_uint(value, 4 ));
+void AnalogAudioView::handle_coded_squelch(const CodedSquelchMessage& message) {
+	const auto confidence = " " + to_string_dec_uint(message.confidence, 3) + "%";
+
+	switch (message.type) {
+	case CodedSquelchMessage::Type::CTCSS:
+		text_ctcss.set(to_string_dec_uint(message.value / 100, 3) + "." + to_string_dec_uint((message.value / 10) % 10) + confidence);
+		break;
+
+	case CodedSquelchMessage::Type::DCS:
+		// DCS codes are named in octal
+		text_ctcss.set("D" + to_string_dec_uint((message.value >> 6) & 7) + to_string_dec_uint((message.value >> 3) & 7) +
+			to_string_dec_uint(message.value & 7) + (message.inverted ? "I" : "N") + confidence);
+		break;
+
+	case CodedSquelchMessage::Type::RSSI:
+		text_ctcss.set("RSSI " + to_string_dec_uint(message.value, 4 ));
+		break;
+
+	default:
+		text_ctcss.set("");
+		break;
 	}
 }
 
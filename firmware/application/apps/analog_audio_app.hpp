@@ -60,6 +60,22 @@ private:
 			{ "LSB ", 0 },
 		}
 	};
+
+	Text label_processing {
+		{ 9 * 8, 0 * 16, 4 * 8, 1 * 16 },
+		"Proc",
+	};
+
+	OptionsField options_processing {
+		{ 14 * 8, 0 * 16 },
+		6,
+		{
+			{ "off   ", 0 },
+			{ "AGC   ", 1 },
+			{ "NB    ", 2 },
+			{ "AGC+NB", 3 },
+		}
+	};
 };
 
 class NBFMOptionsView : public View {
@@ -82,16 +98,27 @@ private:
 	};
 	
 	Text text_squelch {
-		{ 9 * 8, 0 * 16, 8 * 8, 1 * 16 },
-		"SQ   /99"
+		{ 8 * 8, 0 * 16, 2 * 8, 1 * 16 },
+		"SQ"
 	};
 	NumberField field_squelch {
-		{ 12 * 8, 0 * 16 },
+		{ 11 * 8, 0 * 16 },
 		2,
 		{ 0, 99 },
 		1,
 		' ',
 	};
+
+	// CTCSS tone squelch, tones shown as whole Hz (unique for the standard set)
+	Text text_tone_squelch {
+		{ 14 * 8, 0 * 16, 1 * 8, 1 * 16 },
+		"T"
+	};
+	OptionsField options_tone_squelch {
+		{ 15 * 8, 0 * 16 },
+		3,
+		{ }
+	};
 };
 
 class AnalogAudioView : public View {
@@ -190,7 +217,7 @@ private:
 	void update_modulation(const ReceiverModel::Mode modulation);
 	
 	//void squelched();
-	void handle_coded_squelch(const bool enabled, const uint32_t value);
+	void handle_coded_squelch(const CodedSquelchMessage& message);
 	
 	/*MessageHandlerRegistration message_handler_squelch_signal {
 		Message::ID::RequestSignal,
@@ -200,13 +227,10 @@ private:
 		}
 	};*/
 	
-	MessageHandlerRegistration message_handler_coded_squelch {
-		Message::ID::CodedSquelch,
-		[this](const Message* const p) {
-			const auto message = *reinterpret_cast<const CodedSquelchMessage*>(p);
-			this->handle_coded_squelch(message.enabled, message.value);
-		}
-	};
+	void on_coded_squelch_message(const CodedSquelchMessage* const message) {
+		handle_coded_squelch(*message);
+	}
+	MessageHandler<CodedSquelchMessage, AnalogAudioView, &AnalogAudioView::on_coded_squelch_message> message_handler_coded_squelch { this };
 };
 
 } /* namespace ui */
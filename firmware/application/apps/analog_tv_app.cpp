@@ -230,8 +230,8 @@ void AnalogTvView::update_modulation(const ReceiverModel::Mode modulation) {
 	baseband::run_image(image_tag);
 
 	receiver_model.set_modulation(modulation);
-        receiver_model.set_sampling_rate(2000000);
-        receiver_model.set_baseband_bandwidth(2000000);
+	receiver_model.set_sampling_rate(4000000);
+	receiver_model.set_baseband_bandwidth(3500000);
 	receiver_model.enable();
 }
 
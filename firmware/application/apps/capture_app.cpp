@@ -42,6 +42,8 @@ CaptureAppView::CaptureAppView(NavigationView& nav) {
 		&field_lna,
 		&field_vga,
 		&option_bandwidth,
+		&option_trigger,
+		&option_hang,
 		&record_view,
 		&waterfall,
 	});
@@ -83,6 +85,15 @@ CaptureAppView::CaptureAppView(NavigationView& nav) {
 	};
 	
 	option_bandwidth.set_selected_index(7);		// 500k
+
+	option_trigger.on_change = [this](size_t, OptionsField::value_t) {
+		this->update_trigger();
+	};
+	option_hang.on_change = [this](size_t, OptionsField::value_t) {
+		this->update_trigger();
+	};
+	option_hang.set_selected_index(1);			// 0.5s
+	option_trigger.set_selected_index(0);		// Continuous
 	
 	receiver_model.set_modulation(ReceiverModel::Mode::Capture);
 	receiver_model.set_baseband_bandwidth(baseband_bandwidth);
@@ -128,4 +139,13 @@ void CaptureAppView::on_tuning_frequency_changed(rf::Frequency f) {
 	receiver_model.set_tuning_frequency(f);
 }
 
+void CaptureAppView::update_trigger() {
+	const auto threshold_db = static_cast<int32_t>(option_trigger.selected_index_value());
+	record_view.set_trigger({
+		threshold_db != 0,
+		threshold_db,
+		static_cast<uint32_t>(option_hang.selected_index_value())
+	});
+}
+
 } /* namespace ui */
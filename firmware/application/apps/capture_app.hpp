@@ -51,9 +51,12 @@ private:
 	static constexpr uint32_t baseband_bandwidth = 2500000;
 
 	void on_tuning_frequency_changed(rf::Frequency f);
+	void update_trigger();
 
 	Labels labels {
 		{ { 0 * 8, 1 * 16 }, "Rate:", Color::light_grey() },
+		{ { 11 * 8, 1 * 16 }, "Trig:", Color::light_grey() },
+		{ { 21 * 8, 1 * 16 }, "Hang:", Color::light_grey() },
 	};
 	
 	RSSI rssi {
@@ -99,6 +102,35 @@ private:
 		}
 	};
 	
+	// Channel power in dBFS, only bursts above it are recorded
+	OptionsField option_trigger {
+		{ 16 * 8, 1 * 16 },
+		4,
+		{
+			{ "Off", 0 },
+			{ "-90", -90 },
+			{ "-80", -80 },
+			{ "-70", -70 },
+			{ "-60", -60 },
+			{ "-50", -50 },
+			{ "-40", -40 },
+			{ "-30", -30 },
+			{ "-20", -20 }
+		}
+	};
+
+	OptionsField option_hang {
+		{ 26 * 8, 1 * 16 },
+		4,
+		{
+			{ "0.1s", 100 },
+			{ "0.5s", 500 },
+			{ "1s", 1000 },
+			{ "2s", 2000 },
+			{ "5s", 5000 }
+		}
+	};
+
 	RecordView record_view {
 		{ 0 * 8, 2 * 16, 30 * 8, 1 * 16 },
 		u"BBD_????", RecordView::FileType::RawS16, 16384, 3
@@ -82,16 +82,19 @@ void RecentEntriesTable<ERTRecentEntries>::draw(
 	Painter& painter,
 	const Style& style
 ) {
-	std::string line = ert::format::id(entry.id) + " " + ert::format::commodity_type(entry.commodity_type) + " " + ert::format::consumption(entry.last_consumption);
+	FixedString<32> line;
+	line.dec_uint(entry.id, 10).append(' ')
+		.dec_uint(entry.commodity_type, 2).append(' ')
+		.dec_uint(entry.last_consumption, 10);
 
 	if( entry.received_count > 999 ) {
-		line += " +++";
+		line.append(" +++");
 	} else {
-		line += " " + to_string_dec_uint(entry.received_count, 3);
+		line.append(' ').dec_uint(entry.received_count, 3);
 	}
 
 	line.resize(target_rect.width() / 8, ' ');
-	painter.draw_string(target_rect.location(), style, line);
+	painter.draw_string(target_rect.location(), style, line.c_str());
 }
 
 ERTAppView::ERTAppView(NavigationView&) {
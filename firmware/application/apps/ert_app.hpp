@@ -61,6 +61,10 @@ struct ERTKey {
 	}
 };
 
+inline uint32_t hash_key(const ERTKey& key) {
+	return hash_key((static_cast<uint64_t>(key.commodity_type) << 32) | key.id);
+}
+
 struct ERTRecentEntry {
 	using Key = ERTKey;
 
@@ -155,14 +159,11 @@ private:
 		{ 21 * 8, 0, 6 * 8, 4 },
 	};
 
-	MessageHandlerRegistration message_handler_packet {
-		Message::ID::ERTPacket,
-		[this](Message* const p) {
-			const auto message = static_cast<const ERTPacketMessage*>(p);
-			const ert::Packet packet { message->type, message->packet };
-			this->on_packet(packet);
-		}
-	};
+	void on_packet_message(const ERTPacketMessage* const message) {
+		const ert::Packet packet { message->type, message->packet };
+		on_packet(packet);
+	}
+	MessageHandler<ERTPacketMessage, ERTAppView, &ERTAppView::on_packet_message> message_handler_packet { this };
 
 	void on_packet(const ert::Packet& packet);
 	void on_show_list();
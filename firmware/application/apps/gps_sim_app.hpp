@@ -125,31 +125,22 @@ private:
 
 	spectrum::WaterfallWidget waterfall { };
 
-	MessageHandlerRegistration message_handler_replay_thread_error {
-		Message::ID::ReplayThreadDone,
-		[this](const Message* const p) {
-			const auto message = *reinterpret_cast<const ReplayThreadDoneMessage*>(p);
-			this->handle_replay_thread_done(message.return_code);
-		}
-	};
+	void on_replay_thread_error_message(const ReplayThreadDoneMessage* const message) {
+		handle_replay_thread_done(message->return_code);
+	}
+	MessageHandler<ReplayThreadDoneMessage, GpsSimAppView, &GpsSimAppView::on_replay_thread_error_message> message_handler_replay_thread_error { this };
 	
-	MessageHandlerRegistration message_handler_fifo_signal {
-		Message::ID::RequestSignal,
-		[this](const Message* const p) {
-			const auto message = static_cast<const RequestSignalMessage*>(p);
-			if (message->signal == RequestSignalMessage::Signal::FillRequest) {
-				this->set_ready();
-			}
+	void on_fifo_signal_message(const RequestSignalMessage* const message) {
+		if (message->signal == RequestSignalMessage::Signal::FillRequest) {
+			set_ready();
 		}
-	};
+	}
+	MessageHandler<RequestSignalMessage, GpsSimAppView, &GpsSimAppView::on_fifo_signal_message> message_handler_fifo_signal { this };
 	
-	MessageHandlerRegistration message_handler_tx_progress {
-		Message::ID::TXProgress,
-		[this](const Message* const p) {
-			const auto message = *reinterpret_cast<const TXProgressMessage*>(p);
-			this->on_tx_progress(message.progress);
-		}
-	};
+	void on_tx_progress_message(const TXProgressMessage* const message) {
+		on_tx_progress(message->progress);
+	}
+	MessageHandler<TXProgressMessage, GpsSimAppView, &GpsSimAppView::on_tx_progress_message> message_handler_tx_progress { this };
 };
 
 } /* namespace ui */
@@ -138,13 +138,7 @@ private:
 	uint32_t target_frequency() const;
 	void set_target_frequency(const uint32_t new_value);
 	
-	MessageHandlerRegistration message_handler_packet {
-		Message::ID::POCSAGPacket,
-		[this](Message* const p) {
-			const auto message = static_cast<const POCSAGPacketMessage*>(p);
-			this->on_packet(message);
-		}
-	};
+	MessageHandler<POCSAGPacketMessage, POCSAGAppView, &POCSAGAppView::on_packet> message_handler_packet { this };
 };
 
 } /* namespace ui */
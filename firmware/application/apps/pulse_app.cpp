@@ -0,0 +1,259 @@
+/*
+ * Copyright (C) 2026 agent
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "pulse_app.hpp"
+
+#include "baseband_api.hpp"
+#include "io_file.hpp"
+#include "string_format.hpp"
+
+#include "portapack.hpp"
+using namespace portapack;
+
+namespace ui {
+
+PulseAppView::PulseAppView(
+	NavigationView& nav
+) : nav_ { nav }
+{
+	baseband::run_image(portapack::spi_flash::image_tag_pulse);
+
+	add_children({
+		&labels,
+		&rssi,
+		&channel,
+		&field_frequency,
+		&field_frequency_step,
+		&field_rf_amp,
+		&field_lna,
+		&field_vga,
+		&options_decimation,
+		&field_threshold,
+		&field_min_width,
+		&button_log,
+		&text_log_filename,
+		&text_log_dropped,
+		&text_pulse_count,
+		&text_noise_floor,
+		&text_start,
+		&text_width,
+		&text_peak,
+		&text_offset,
+		&console,
+	});
+
+	field_frequency.set_value(receiver_model.tuning_frequency());
+	field_frequency.set_step(receiver_model.frequency_step());
+	field_frequency.on_change = [this](rf::Frequency f) {
+		this->on_tuning_frequency_changed(f);
+	};
+	field_frequency.on_edit = [this, &nav]() {
+		auto new_view = nav.push<FrequencyKeypadView>(receiver_model.tuning_frequency());
+		new_view->on_changed = [this](rf::Frequency f) {
+			this->on_tuning_frequency_changed(f);
+			this->field_frequency.set_value(f);
+		};
+	};
+
+	field_frequency_step.set_by_value(receiver_model.frequency_step());
+	field_frequency_step.on_change = [this](size_t, OptionsField::value_t v) {
+		receiver_model.set_frequency_step(v);
+		this->field_frequency.set_step(v);
+	};
+
+	options_decimation.set_by_value(4);
+	options_decimation.on_change = [this](size_t, OptionsField::value_t) {
+		this->on_config_changed();
+	};
+	field_threshold.set_value(10);
+	field_threshold.on_change = [this](int32_t) {
+		this->on_config_changed();
+	};
+	field_min_width.set_value(2);
+	field_min_width.on_change = [this](int32_t) {
+		this->on_config_changed();
+	};
+
+	button_log.on_select = [this](Button&) {
+		this->toggle_log();
+	};
+
+	receiver_model.set_modulation(ReceiverModel::Mode::Capture);
+	receiver_model.set_sampling_rate(sampling_rate);
+	receiver_model.set_baseband_bandwidth(baseband_bandwidth);
+	receiver_model.enable();
+
+	on_config_changed();
+}
+
+PulseAppView::~PulseAppView() {
+	// Stop the stream while the baseband can still acknowledge it.
+	capture_thread.reset();
+
+	// Leave the shared receiver model in a state other apps expect.
+	receiver_model.set_sampling_rate(3072000);
+	receiver_model.set_baseband_bandwidth(1750000);
+	receiver_model.set_modulation(ReceiverModel::Mode::WidebandFMAudio);
+
+	receiver_model.disable();
+	baseband::shutdown();
+}
+
+void PulseAppView::focus() {
+	field_frequency.focus();
+}
+
+void PulseAppView::on_tuning_frequency_changed(rf::Frequency f) {
+	receiver_model.set_tuning_frequency(f);
+}
+
+void PulseAppView::on_config_changed() {
+	// Pulse times in a log are relative to the configuration they were taken with.
+	stop_log();
+
+	baseband::set_pulse_config(
+		options_decimation.selected_index_value(),
+		field_threshold.value(),
+		field_min_width.value(),
+		max_width
+	);
+
+	pulse_count = 0;
+	console.clear();
+}
+
+std::string PulseAppView::format_duration(const uint32_t samples) const {
+	if( envelope_rate == 0 ) {
+		return "-";
+	}
+	const uint64_t us = uint64_t(samples) * 1000000U / envelope_rate;
+	if( us >= 10000 ) {
+		return to_string_dec_uint(us / 1000) + "ms";
+	} else {
+		return to_string_dec_uint(us) + "us";
+	}
+}
+
+void PulseAppView::on_statistics(const PulseStatisticsMessage& message) {
+	envelope_rate = message.envelope_rate;
+
+	text_noise_floor.set(to_string_dec_int(message.noise_floor_db) + "dBFS");
+	text_pulse_count.set(to_string_dec_uint(message.pulse_count));
+
+	if( message.pulse_count != pulse_count ) {
+		pulse_count = message.pulse_count;
+
+		const auto& pulse = message.last_pulse;
+		const auto start = format_duration(pulse.start);
+		const auto width = format_duration(pulse.width);
+		const auto peak = to_string_dec_int(pulse.peak_db);
+		const auto offset = to_string_dec_int(pulse.frequency_offset);
+		const bool truncated = pulse.flags & PulseDescriptor::flag_truncated;
+
+		text_start.set(start);
+		text_width.set(width + (truncated ? "+" : ""));
+		text_peak.set(peak + "dBFS " + to_string_dec_int(pulse.peak_db - pulse.noise_floor_db) + "dB SNR");
+		text_offset.set(offset + "Hz");
+
+		console.writeln(width + " " + peak + "dB " + offset + "Hz");
+	}
+
+	if( capture_thread ) {
+		const auto dropped_percent = std::min(99U, capture_thread->state().dropped_percent());
+		text_log_dropped.set(to_string_dec_uint(dropped_percent, 2, ' ') + "\%");
+	}
+}
+
+void PulseAppView::toggle_log() {
+	if( capture_thread ) {
+		stop_log();
+	} else {
+		start_log();
+	}
+}
+
+void PulseAppView::start_log() {
+	auto base_path = next_filename_stem_matching_pattern(u"PLS_????");
+	if( base_path.empty() ) {
+		return;
+	}
+
+	const auto metadata_file_error = write_metadata_file(base_path.replace_extension(u".TXT"));
+	if( metadata_file_error.is_valid() ) {
+		nav_.display_modal("Error", metadata_file_error.value().what());
+		return;
+	}
+
+	auto writer = std::make_unique<RawFileWriter>();
+	const auto create_error = writer->create(base_path.replace_extension(u".PLS"));
+	if( create_error.is_valid() ) {
+		nav_.display_modal("Error", create_error.value().what());
+		return;
+	}
+
+	text_log_filename.set(base_path.replace_extension().string());
+	button_log.set_text("Stop");
+	capture_thread = std::make_unique<CaptureThread>(
+		std::move(writer),
+		log_write_size, log_buffer_count,
+		[]() {
+			CaptureThreadDoneMessage message { };
+			EventDispatcher::send_message(message);
+		},
+		[](File::Error error) {
+			CaptureThreadDoneMessage message { error.code() };
+			EventDispatcher::send_message(message);
+		}
+	);
+}
+
+void PulseAppView::stop_log() {
+	if( capture_thread ) {
+		capture_thread.reset();
+		button_log.set_text("Log");
+		text_log_dropped.set("");
+	}
+}
+
+Optional<File::Error> PulseAppView::write_metadata_file(const std::filesystem::path& filename) {
+	File file;
+	const auto create_error = file.create(filename);
+	if( create_error.is_valid() ) {
+		return create_error;
+	}
+
+	const std::string lines[] {
+		"center_frequency=" + to_string_dec_uint(receiver_model.tuning_frequency()),
+		"envelope_rate=" + to_string_dec_uint(sampling_rate / 8 / options_decimation.selected_index_value()),
+		"threshold_db=" + to_string_dec_int(field_threshold.value()),
+		"min_width=" + to_string_dec_int(field_min_width.value()),
+		"record=start:u32,width:u32,frequency_offset_hz:i32,peak_dbfs:i8,noise_floor_dbfs:i8,flags:u16",
+	};
+	for(const auto& line : lines) {
+		const auto error = file.write_line(line);
+		if( error.is_valid() ) {
+			return error;
+		}
+	}
+	return { };
+}
+
+} /* namespace ui */
@@ -0,0 +1,209 @@
+/*
+ * Copyright (C) 2026 agent
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __PULSE_APP_HPP__
+#define __PULSE_APP_HPP__
+
+#include "ui_widget.hpp"
+#include "ui_navigation.hpp"
+#include "ui_receiver.hpp"
+
+#include "capture_thread.hpp"
+#include "event_m0.hpp"
+#include "message.hpp"
+
+#include <memory>
+
+namespace ui {
+
+/* Power-envelope pulse analysis: the baseband reports start, width, peak and
+ * frequency offset of every pulse, and optionally streams the descriptors to
+ * SD (PLS_????.PLS, 16-byte PulseDescriptor records, see the .TXT alongside).
+ */
+class PulseAppView : public View {
+public:
+	PulseAppView(NavigationView& nav);
+	~PulseAppView();
+
+	void focus() override;
+
+	std::string title() const override { return "Pulses"; };
+
+private:
+	static constexpr uint32_t sampling_rate = 2457600;
+	static constexpr uint32_t baseband_bandwidth = 1750000;
+	static constexpr uint32_t max_width = 65535;
+	/* 16 descriptors per SD write. Pulses still in a partial buffer when
+	 * logging stops are not written. */
+	static constexpr size_t log_write_size = 256;
+	static constexpr size_t log_buffer_count = 4;
+
+	NavigationView& nav_;
+
+	uint32_t envelope_rate { 0 };
+	uint32_t pulse_count { 0 };
+	std::unique_ptr<CaptureThread> capture_thread { };
+
+	void on_tuning_frequency_changed(rf::Frequency f);
+	void on_config_changed();
+	void on_statistics(const PulseStatisticsMessage& message);
+
+	void toggle_log();
+	void start_log();
+	void stop_log();
+	Optional<File::Error> write_metadata_file(const std::filesystem::path& filename);
+
+	std::string format_duration(const uint32_t samples) const;
+
+	Labels labels {
+		{ { 0 * 8, 1 * 16 }, "Avg:   Thr:  dB  Min:", Color::light_grey() },
+		{ { 0 * 8, 5 * 16 }, "Pulses:", Color::light_grey() },
+		{ { 0 * 8, 6 * 16 }, "Floor:", Color::light_grey() },
+		{ { 0 * 8, 7 * 16 }, "Start:", Color::light_grey() },
+		{ { 0 * 8, 8 * 16 }, "Width:", Color::light_grey() },
+		{ { 0 * 8, 9 * 16 }, "Peak:", Color::light_grey() },
+		{ { 0 * 8, 10 * 16 }, "Offset:", Color::light_grey() },
+	};
+
+	RSSI rssi {
+		{ 24 * 8, 0, 6 * 8, 4 },
+	};
+
+	Channel channel {
+		{ 24 * 8, 5, 6 * 8, 4 },
+	};
+
+	FrequencyField field_frequency {
+		{ 0 * 8, 0 * 16 },
+	};
+
+	FrequencyStepView field_frequency_step {
+		{ 10 * 8, 0 * 16 },
+	};
+
+	RFAmpField field_rf_amp {
+		{ 16 * 8, 0 * 16 }
+	};
+
+	LNAGainField field_lna {
+		{ 18 * 8, 0 * 16 }
+	};
+
+	VGAGainField field_vga {
+		{ 21 * 8, 0 * 16 }
+	};
+
+	OptionsField options_decimation {
+		{ 4 * 8, 1 * 16 },
+		2,
+		{
+			{ " 1", 1 },
+			{ " 2", 2 },
+			{ " 4", 4 },
+			{ " 8", 8 },
+			{ "16", 16 },
+			{ "32", 32 },
+			{ "64", 64 },
+		}
+	};
+
+	NumberField field_threshold {
+		{ 11 * 8, 1 * 16 },
+		2,
+		{ 3, 40 },
+		1,
+		' '
+	};
+
+	NumberField field_min_width {
+		{ 21 * 8, 1 * 16 },
+		3,
+		{ 1, 999 },
+		1,
+		' '
+	};
+
+	Button button_log {
+		{ 0 * 8, 2 * 16 + 8, 8 * 8, 24 },
+		"Log"
+	};
+
+	Text text_log_filename {
+		{ 9 * 8, 2 * 16 + 12, 12 * 8, 16 },
+		""
+	};
+
+	Text text_log_dropped {
+		{ 22 * 8, 2 * 16 + 12, 4 * 8, 16 },
+		""
+	};
+
+	Text text_pulse_count {
+		{ 8 * 8, 5 * 16, 12 * 8, 16 },
+		"-"
+	};
+
+	Text text_noise_floor {
+		{ 8 * 8, 6 * 16, 12 * 8, 16 },
+		"-"
+	};
+
+	Text text_start {
+		{ 8 * 8, 7 * 16, 16 * 8, 16 },
+		"-"
+	};
+
+	Text text_width {
+		{ 8 * 8, 8 * 16, 16 * 8, 16 },
+		"-"
+	};
+
+	Text text_peak {
+		{ 8 * 8, 9 * 16, 16 * 8, 16 },
+		"-"
+	};
+
+	Text text_offset {
+		{ 8 * 8, 10 * 16, 16 * 8, 16 },
+		"-"
+	};
+
+	Console console {
+		{ 0 * 8, 12 * 16, 30 * 8, 7 * 16 }
+	};
+
+	void on_statistics_message(const PulseStatisticsMessage* const message) {
+		on_statistics(*message);
+	}
+	MessageHandler<PulseStatisticsMessage, PulseAppView, &PulseAppView::on_statistics_message> message_handler_statistics { this };
+
+	void on_capture_thread_done_message(const CaptureThreadDoneMessage* const message) {
+		stop_log();
+		if( message->error ) {
+			nav_.display_modal("Error", File::Error { message->error }.what());
+		}
+	}
+	MessageHandler<CaptureThreadDoneMessage, PulseAppView, &PulseAppView::on_capture_thread_done_message> message_handler_capture_thread_done { this };
+};
+
+} /* namespace ui */
+
+#endif/*__PULSE_APP_HPP__*/
@@ -78,18 +78,68 @@ void ReplayAppView::on_file_changed(std::filesystem::path new_file_path) {
 	
 	text_sample_rate.set(unit_auto_scale(sample_rate, 3, 0) + "Hz");
 	
-	auto file_size = data_file.size();
+	file_size = data_file.size();
 	auto duration = (file_size * 1000) / (2 * 2 * sample_rate);
 	
 	progressbar.set_max(file_size);
 	text_filename.set(file_path.filename().string().substr(0, 12));
 	text_duration.set(to_string_time_ms(duration));
 	
+	// C16: one sample is an I/Q pair of int16
+	peaks.open("/" + file_path.string(), { 0, file_size / 4, peak_index::Format::CS16 });
+	refresh_overview();
+	
+	index.open(capture_index::index_path("/" + file_path.string()));
+	check_skip_quiet.hidden(!index.is_open());
+	update_start_time();
+	
 	button_play.focus();
 }
 
+void ReplayAppView::refresh_overview() {
+	const uint32_t samples_per_pixel = (peaks.source().sample_count + overview_width - 1) / overview_width;
+	
+	if (!samples_per_pixel || !peaks.read(0, samples_per_pixel, peak_buffer, overview_width))
+		memset(peak_buffer, 0, sizeof(peak_buffer));
+	
+	for (size_t i = 0; i < overview_width; i++) {
+		overview_buffer[i * 2] = peak_buffer[i].min << 8;
+		overview_buffer[i * 2 + 1] = peak_buffer[i].max << 8;
+	}
+	
+	overview.set_dirty();
+}
+
+void ReplayAppView::update_start_time() {
+	if (!index.is_open()) {
+		text_start_time.set("");
+		return;
+	}
+	
+	// Wall clock time of the block playback would start from
+	const auto sample = ((file_size * field_start.value()) / 100) / capture_index::bytes_per_sample;
+	const auto n = index.find(sample);
+	const auto entry = n.is_valid() ? index.entry(n.value()) : Optional<capture_index::Entry> { };
+	if (!entry.is_valid()) {
+		text_start_time.set("");
+		return;
+	}
+	
+	const auto& header = index.header();
+	const uint32_t seconds = (header.start_hour * 3600 + header.start_minute * 60 + header.start_second +
+		entry.value().time_ms / 1000) % 86400;
+	text_start_time.set("at " +
+		to_string_dec_uint(seconds / 3600, 2, '0') + ":" +
+		to_string_dec_uint((seconds / 60) % 60, 2, '0') + ":" +
+		to_string_dec_uint(seconds % 60, 2, '0'));
+}
+
 void ReplayAppView::on_tx_progress(const uint32_t progress) {
-	progressbar.set_value(progress);
+	const auto position = playback_offset + progress;
+	
+	progressbar.set_value(position);
+	if (file_size)
+		overview.set_cursor(1, (position * overview_width) / file_size);
 }
 
 void ReplayAppView::focus() {
@@ -117,12 +167,25 @@ void ReplayAppView::start() {
 
 	std::unique_ptr<stream::Reader> reader;
 	
-	auto p = std::make_unique<FileReader>();
-	auto open_error = p->open(file_path);
-	if( open_error.is_valid() ) {
-		file_error();
+	// Start where the overview cursor is, on a sector boundary
+	playback_offset = ((file_size * field_start.value()) / 100) & ~511ULL;
+	
+	if( index.is_open() && check_skip_quiet.value() ) {
+		// Progress then counts replayed bytes, skipped blocks don't show
+		auto p = std::make_unique<capture_index::ActiveReader>();
+		if( p->open(file_path, playback_offset).is_valid() ) {
+			file_error();
+		} else {
+			reader = std::move(p);
+		}
 	} else {
-		reader = std::move(p);
+		auto p = std::make_unique<FileReader>();
+		auto open_error = p->open(file_path);
+		if( open_error.is_valid() || p->seek(playback_offset).is_error() ) {
+			file_error();
+		} else {
+			reader = std::move(p);
+		}
 	}
 
 	if( reader ) {
@@ -194,9 +257,20 @@ ReplayAppView::ReplayAppView(
 		&field_rf_amp,
 		&check_loop,
 		&button_play,
+		&field_start,
+		&check_skip_quiet,
+		&text_start_time,
+		&overview,
 		&waterfall,
 	});
 	
+	field_start.on_change = [this](int32_t v) {
+		overview.set_cursor(0, (v * overview_width) / 100);
+		update_start_time();
+	};
+	
+	check_skip_quiet.hidden(true);
+	
 	field_frequency.set_value(target_frequency());
 	field_frequency.set_step(receiver_model.frequency_step());
 	field_frequency.on_change = [this](rf::Frequency f) {
@@ -28,6 +28,8 @@
 #include "ui_receiver.hpp"
 #include "replay_thread.hpp"
 #include "ui_spectrum.hpp"
+#include "peak_index.hpp"
+#include "capture_index.hpp"
 
 #include <string>
 #include <memory>
@@ -48,7 +50,8 @@ public:
 private:
 	NavigationView& nav_;
 	
-	static constexpr ui::Dim header_height = 3 * 16;
+	static constexpr ui::Dim header_height = 5 * 16;
+	static constexpr size_t overview_width = 20 * 8;
 	
 	uint32_t sample_rate = 0;
 	static constexpr uint32_t baseband_bandwidth = 2500000;
@@ -58,6 +61,8 @@ private:
 	void on_file_changed(std::filesystem::path new_file_path);
 	void on_target_frequency_changed(rf::Frequency f);
 	void on_tx_progress(const uint32_t progress);
+	void refresh_overview();
+	void update_start_time();
 	
 	void set_target_frequency(const rf::Frequency new_value);
 	rf::Frequency target_frequency() const;
@@ -71,11 +76,18 @@ private:
 	void file_error();
 
 	std::filesystem::path file_path { };
+	uint64_t file_size { 0 };
+	uint64_t playback_offset { 0 };
+	peak_index::Reader peaks { };
+	capture_index::Reader index { };
+	peak_index::Peak peak_buffer[overview_width] { };
+	int16_t overview_buffer[overview_width * 2] { };
 	std::unique_ptr<ReplayThread> replay_thread { };
 	bool ready_signal { false };
 
 	Labels labels {
-		{ { 10 * 8, 2 * 16 }, "LNA:   A:", Color::light_grey() }
+		{ { 10 * 8, 2 * 16 }, "LNA:   A:", Color::light_grey() },
+		{ { 0 * 8, 3 * 16 }, "Start:  %", Color::light_grey() }
 	};
 	
 	Button button_open {
@@ -122,33 +134,58 @@ private:
 		Color::black()
 	};
 
-	spectrum::WaterfallWidget waterfall { };
+	NumberField field_start {
+		{ 6 * 8, 3 * 16 },
+		2,
+		{ 0, 99 },
+		1,
+		' '
+	};
+	// Only shown for captures that have an index
+	Checkbox check_skip_quiet {
+		{ 0 * 8, 4 * 16 },
+		10,
+		"Skip quiet",
+		true
+	};
+	Text text_start_time {
+		{ 17 * 8, 4 * 16, 13 * 8, 16 },
+		""
+	};
 
-	MessageHandlerRegistration message_handler_replay_thread_error {
-		Message::ID::ReplayThreadDone,
-		[this](const Message* const p) {
-			const auto message = *reinterpret_cast<const ReplayThreadDoneMessage*>(p);
-			this->handle_replay_thread_done(message.return_code);
-		}
+	Waveform overview {
+		{ 10 * 8, 3 * 16, overview_width, 16 },
+		overview_buffer,
+		overview_width * 2,
+		0,
+		false,
+		Color::white()
 	};
+
+	spectrum::WaterfallWidget waterfall { };
+
+	void on_replay_thread_error_message(const ReplayThreadDoneMessage* const message) {
+		handle_replay_thread_done(message->return_code);
+	}
+	MessageHandler<ReplayThreadDoneMessage, ReplayAppView, &ReplayAppView::on_replay_thread_error_message> message_handler_replay_thread_error { this };
 	
-	MessageHandlerRegistration message_handler_fifo_signal {
-		Message::ID::RequestSignal,
-		[this](const Message* const p) {
-			const auto message = static_cast<const RequestSignalMessage*>(p);
-			if (message->signal == RequestSignalMessage::Signal::FillRequest) {
-				this->set_ready();
-			}
-		}
-	};
+	void on_peak_index_done_message(const PeakIndexDoneMessage* const message) {
+		peaks.index_done(message->success);
+		refresh_overview();
+	}
+	MessageHandler<PeakIndexDoneMessage, ReplayAppView, &ReplayAppView::on_peak_index_done_message> message_handler_peak_index_done { this };
 	
-	MessageHandlerRegistration message_handler_tx_progress {
-		Message::ID::TXProgress,
-		[this](const Message* const p) {
-			const auto message = *reinterpret_cast<const TXProgressMessage*>(p);
-			this->on_tx_progress(message.progress);
+	void on_fifo_signal_message(const RequestSignalMessage* const message) {
+		if (message->signal == RequestSignalMessage::Signal::FillRequest) {
+			set_ready();
 		}
-	};
+	}
+	MessageHandler<RequestSignalMessage, ReplayAppView, &ReplayAppView::on_fifo_signal_message> message_handler_fifo_signal { this };
+	
+	void on_tx_progress_message(const TXProgressMessage* const message) {
+		on_tx_progress(message->progress);
+	}
+	MessageHandler<TXProgressMessage, ReplayAppView, &ReplayAppView::on_tx_progress_message> message_handler_tx_progress { this };
 };
 
 } /* namespace ui */
@@ -20,7 +20,8 @@
  * Boston, MA 02110-1301, USA.
  */
 
-// To prepare samples: for f in ./*.wav; do sox "$f" -r 48000 -c 1 -b8 --norm "conv/$f"; done
+// To prepare samples: for f in ./*.wav; do sox "$f" -c 1 -b16 --norm "conv/$f"; done
+// Mono 8-bit or 16-bit, any rate up to 192kHz
 
 #include "soundboard_app.hpp"
 #include "string_format.hpp"
@@ -48,7 +49,7 @@ void SoundBoardView::stop() {
 
 void SoundBoardView::handle_replay_thread_done(const uint32_t return_code) {
 	stop();
-	progressbar.set_value(0);
+	overview.set_cursor(1, 0);
 	
 	if (return_code == ReplayThread::END_OF_FILE) {
 		if (check_random.value()) {
@@ -80,6 +81,7 @@ void SoundBoardView::start_tx(const uint32_t id) {
 	auto reader = std::make_unique<WAVFileReader>();
 	uint32_t tone_key_index = options_tone_key.selected_index();
 	uint32_t sample_rate;
+	uint8_t bits_per_sample;
 	
 	stop();
 
@@ -89,12 +91,14 @@ void SoundBoardView::start_tx(const uint32_t id) {
 	}
 	
 	playing_id = id;
-	
-	progressbar.set_max(reader->sample_count());
+	playing_samples = reader->sample_count();
+	playback_offset = (playing_samples * field_start.value()) / 100;
+	reader->data_seek(playback_offset);
 	
 	//button_play.set_bitmap(&bitmap_stop);
 	
 	sample_rate = reader->sample_rate();
+	bits_per_sample = reader->bits_per_sample();
 	
 	replay_thread = std::make_unique<ReplayThread>(
 		std::move(reader),
@@ -110,7 +114,8 @@ void SoundBoardView::start_tx(const uint32_t id) {
 		1536000 / 20,		// Update vu-meter at 20Hz
 		transmitter_model.channel_bandwidth(),
 		0,	// Gain is unused
-		TONES_F2D(tone_key_frequency(tone_key_index), 1536000)
+		TONES_F2D(tone_key_frequency(tone_key_index), 1536000),
+		bits_per_sample
 	);
 	baseband::set_sample_rate(sample_rate);
 	
@@ -121,16 +126,40 @@ void SoundBoardView::start_tx(const uint32_t id) {
 	tx_view.set_transmitting(true);
 }
 
-/*void SoundBoardView::show_infos() {
-	if (!reader->open(file_list[menu_view.highlighted_index()]))
+void SoundBoardView::on_highlight_entry() {
+	WAVFileReader reader;
+	const auto path = u"/WAV/" + file_list[menu_view.highlighted_index()].native();
+	
+	peaks.close();
+	
+	if (!reader.open(path))
 		return;
 	
-	text_duration.set(to_string_time_ms(reader->ms_duration()));
-	text_title.set(reader->title().substr(0, 15));
-}*/
+	text_duration.set(to_string_time_ms(reader.ms_duration()));
+	text_title.set(reader.title().substr(0, 15));
+	
+	const auto format = (reader.bits_per_sample() == 16) ? peak_index::Format::S16 : peak_index::Format::U8;
+	peaks.open(path, { reader.data_offset(), reader.sample_count(), format });
+	refresh_overview();
+}
+
+void SoundBoardView::refresh_overview() {
+	const uint32_t samples_per_pixel = (peaks.source().sample_count + 239) / 240;
+	
+	if (!samples_per_pixel || !peaks.read(0, samples_per_pixel, peak_buffer, 240))
+		memset(peak_buffer, 0, sizeof(peak_buffer));
+	
+	for (size_t i = 0; i < 240; i++) {
+		overview_buffer[i * 2] = peak_buffer[i].min << 8;
+		overview_buffer[i * 2 + 1] = peak_buffer[i].max << 8;
+	}
+	
+	overview.set_dirty();
+}
 
 void SoundBoardView::on_tx_progress(const uint32_t progress) {
-	progressbar.set_value(progress);
+	if (playing_samples)
+		overview.set_cursor(1, ((playback_offset + progress) * 240ULL) / playing_samples);
 }
 
 void SoundBoardView::on_select_entry() {
@@ -155,7 +184,7 @@ void SoundBoardView::refresh_list() {
 				if (entry_extension == ".WAV") {
 					
 					if (reader->open(u"/WAV/" + entry.path().native())) {
-						if ((reader->channels() == 1) && (reader->bits_per_sample() == 8)) {
+						if ((reader->channels() == 1) && ((reader->bits_per_sample() == 8) || (reader->bits_per_sample() == 16))) {
 							//sounds[c].ms_duration = reader->ms_duration();
 							//sounds[c].path = u"WAV/" + entry.path().native();
 							file_list.push_back(entry.path());
@@ -192,6 +221,9 @@ void SoundBoardView::refresh_list() {
 			});
 		}
 		
+		menu_view.on_highlight = [this]() {
+			on_highlight_entry();
+		};
 		menu_view.set_highlighted(0);	// Refresh
 	}
 }
@@ -209,7 +241,8 @@ SoundBoardView::SoundBoardView(
 		&options_tone_key,
 		&text_title,
 		&text_duration,
-		&progressbar,
+		&field_start,
+		&overview,
 		&check_loop,
 		&check_random,
 		&tx_view
@@ -217,13 +250,15 @@ SoundBoardView::SoundBoardView(
 	
 	refresh_list();
 	
-	text_title.set(to_string_dec_uint(file_list.size()));
-	
 	tone_keys_populate(options_tone_key);
 	options_tone_key.set_selected_index(0);
 	
 	check_loop.set_value(false);
 	check_random.set_value(false);
+	
+	field_start.on_change = [this](int32_t v) {
+		overview.set_cursor(0, (v * 240) / 100);
+	};
 
 	tx_view.on_edit_frequency = [this, &nav]() {
 		auto new_view = nav.push<FrequencyKeypadView>(receiver_model.tuning_frequency());
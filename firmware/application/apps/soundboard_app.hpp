@@ -29,6 +29,7 @@
 #include "baseband_api.hpp"
 #include "lfsr_random.hpp"
 #include "io_wave.hpp"
+#include "peak_index.hpp"
 #include "tone_key.hpp"
 
 namespace ui {
@@ -58,6 +59,8 @@ private:
 	tx_modes tx_mode = NORMAL;
 	
 	uint32_t playing_id { };
+	uint32_t playing_samples { };
+	uint32_t playback_offset { };
 	
 	std::vector<std::filesystem::path> file_list { };
 
@@ -67,6 +70,10 @@ private:
 	bool ready_signal { false };
 	lfsr_word_t lfsr_v = 1;
 	
+	peak_index::Reader peaks { };
+	peak_index::Peak peak_buffer[240] { };
+	int16_t overview_buffer[480] { };
+	
 	//void show_infos();
 	void start_tx(const uint32_t id);
 	//void on_ctcss_changed(uint32_t v);
@@ -78,10 +85,13 @@ private:
 	void on_tx_progress(const uint32_t progress);
 	void refresh_list();
 	void on_select_entry();
+	void on_highlight_entry();
+	void refresh_overview();
 	
 	Labels labels {
 		{ { 0, 20 * 8 + 4 }, "Title:", Color::light_grey() },
-		{ { 0, 23 * 8 }, "Key:", Color::light_grey() }
+		{ { 0, 23 * 8 }, "Key:", Color::light_grey() },
+		{ { 19 * 8, 25 * 8 + 8 }, "Start:  %", Color::light_grey() }
 	};
 	
 	MenuView menu_view {
@@ -119,8 +129,22 @@ private:
 		"Random"
 	};
 	
-	ProgressBar progressbar {
-		{ 0 * 8, 30 * 8 - 4, 30 * 8, 16 }
+	NumberField field_start {
+		{ 25 * 8, 25 * 8 + 8 },
+		2,
+		{ 0, 99 },
+		1,
+		' '
+	};
+	
+	// Peaks of the highlighted sound, start and playback position as cursors
+	Waveform overview {
+		{ 0 * 8, 30 * 8 - 4, 30 * 8, 16 },
+		overview_buffer,
+		480,
+		0,
+		false,
+		Color::white()
 	};
 	
 	TransmitterView tx_view {
@@ -129,31 +153,28 @@ private:
 		12
 	};
 	
-	MessageHandlerRegistration message_handler_replay_thread_error {
-		Message::ID::ReplayThreadDone,
-		[this](const Message* const p) {
-			const auto message = *reinterpret_cast<const ReplayThreadDoneMessage*>(p);
-			this->handle_replay_thread_done(message.return_code);
-		}
-	};
+	void on_replay_thread_error_message(const ReplayThreadDoneMessage* const message) {
+		handle_replay_thread_done(message->return_code);
+	}
+	MessageHandler<ReplayThreadDoneMessage, SoundBoardView, &SoundBoardView::on_replay_thread_error_message> message_handler_replay_thread_error { this };
 	
-	MessageHandlerRegistration message_handler_fifo_signal {
-		Message::ID::RequestSignal,
-		[this](const Message* const p) {
-			const auto message = static_cast<const RequestSignalMessage*>(p);
-			if (message->signal == RequestSignalMessage::Signal::FillRequest) {
-				this->set_ready();
-			}
-		}
-	};
+	void on_peak_index_done_message(const PeakIndexDoneMessage* const message) {
+		peaks.index_done(message->success);
+		refresh_overview();
+	}
+	MessageHandler<PeakIndexDoneMessage, SoundBoardView, &SoundBoardView::on_peak_index_done_message> message_handler_peak_index_done { this };
 	
-	MessageHandlerRegistration message_handler_tx_progress {
-		Message::ID::TXProgress,
-		[this](const Message* const p) {
-			const auto message = *reinterpret_cast<const TXProgressMessage*>(p);
-			this->on_tx_progress(message.progress);
+	void on_fifo_signal_message(const RequestSignalMessage* const message) {
+		if (message->signal == RequestSignalMessage::Signal::FillRequest) {
+			set_ready();
 		}
-	};
+	}
+	MessageHandler<RequestSignalMessage, SoundBoardView, &SoundBoardView::on_fifo_signal_message> message_handler_fifo_signal { this };
+	
+	void on_tx_progress_message(const TXProgressMessage* const message) {
+		on_tx_progress(message->progress);
+	}
+	MessageHandler<TXProgressMessage, SoundBoardView, &SoundBoardView::on_tx_progress_message> message_handler_tx_progress { this };
 };
 
 } /* namespace ui */
@@ -102,34 +102,35 @@ void RecentEntriesTable<TPMSRecentEntries>::draw(
 	Painter& painter,
 	const Style& style
 ) {
-	std::string line = tpms::format::type(entry.type) + " " + tpms::format::id(entry.id);
+	FixedString<32> line;
+	line.dec_uint(toUType(entry.type), 2).append(' ').hex(entry.id.value(), 8);
 
 	if( entry.last_pressure.is_valid() ) {
-		line += " " + tpms::format::pressure(entry.last_pressure.value());
+		line.append(' ').dec_int(entry.last_pressure.value().kilopascal(), 3);
 	} else {
-		line += " " "   ";
+		line.append(" " "   ");
 	}
 
 	if( entry.last_temperature.is_valid() ) {
-		line += " " + tpms::format::temperature(entry.last_temperature.value());
+		line.append(' ').dec_int(entry.last_temperature.value().celsius(), 3);
 	} else {
-		line += " " "   ";
+		line.append(" " "   ");
 	}
 
 	if( entry.received_count > 999 ) {
-		line += " +++";
+		line.append(" +++");
 	} else {
-		line += " " + to_string_dec_uint(entry.received_count, 3);
+		line.append(' ').dec_uint(entry.received_count, 3);
 	}
 
 	if( entry.last_flags.is_valid() ) {
-		line += " " + tpms::format::flags(entry.last_flags.value());
+		line.append(' ').hex(entry.last_flags.value(), 2);
 	} else {
-		line += " " "  ";
+		line.append(" " "  ");
 	}
 
 	line.resize(target_rect.width() / 8, ' ');
-	painter.draw_string(target_rect.location(), style, line);
+	painter.draw_string(target_rect.location(), style, line.c_str());
 }
 
 TPMSAppView::TPMSAppView(NavigationView&) {
@@ -142,6 +143,7 @@ TPMSAppView::TPMSAppView(NavigationView&) {
 		&field_rf_amp,
 		&field_lna,
 		&field_vga,
+		&text_hits,
 		&recent_entries_view,
 	});
 
@@ -160,6 +162,8 @@ TPMSAppView::TPMSAppView(NavigationView&) {
 	};
 	options_band.set_by_value(target_frequency());
 
+	update_hits();
+
 	logger = std::make_unique<TPMSLogger>();
 	if( logger ) {
 		logger->append(u"tpms.txt");
@@ -189,10 +193,26 @@ void TPMSAppView::on_packet(const tpms::Packet& packet) {
 	const auto reading_opt = packet.reading();
 	if( reading_opt.is_valid() ) {
 		const auto reading = reading_opt.value();
+		hits[reading.type()]++;
 		auto& entry = ::on_packet(recent, TPMSRecentEntry::Key { reading.type(), reading.id() });
 		entry.update(reading);
 		recent_entries_view.set_dirty();
 	}
+
+	update_hits();
+}
+
+void TPMSAppView::update_hits() {
+	using Type = tpms::Reading::Type;
+
+	text_hits.set(
+		"FLM " + to_string_dec_uint(hits[Type::FLM_64]) +
+		"/" + to_string_dec_uint(hits[Type::FLM_72]) +
+		"/" + to_string_dec_uint(hits[Type::FLM_80]) +
+		" Sch " + to_string_dec_uint(hits[Type::Schrader]) +
+		" GMC " + to_string_dec_uint(hits[Type::GMC_96]) +
+		" of " + to_string_dec_uint(candidates)
+	);
 }
 
 void TPMSAppView::on_show_list() {
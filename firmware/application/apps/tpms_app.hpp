@@ -44,6 +44,14 @@ constexpr bool operator==(const tpms::TransponderID& lhs, const tpms::Transponde
 
 } /* namespace std */
 
+namespace tpms {
+
+inline uint32_t hash_key(const std::pair<Reading::Type, TransponderID>& key) {
+	return ::hash_key((static_cast<uint64_t>(key.first) << 32) | key.second.value());
+}
+
+} /* namespace tpms */
+
 struct TPMSRecentEntry {
 	using Key = std::pair<tpms::Reading::Type, tpms::TransponderID>;
 
@@ -110,16 +118,14 @@ private:
 	static constexpr uint32_t sampling_rate = 2457600;
 	static constexpr uint32_t baseband_bandwidth = 1750000;
 
-	MessageHandlerRegistration message_handler_packet {
-		Message::ID::TPMSPacket,
-		[this](Message* const p) {
-			const auto message = static_cast<const TPMSPacketMessage*>(p);
-			const tpms::Packet packet { message->packet, message->signal_type };
-			this->on_packet(packet);
-		}
-	};
+	void on_packet_message(const TPMSPacketMessage* const message) {
+		const tpms::Packet packet { message->packet, message->signal_type, message->coding };
+		candidates = message->candidates;
+		on_packet(packet);
+	}
+	MessageHandler<TPMSPacketMessage, TPMSAppView, &TPMSAppView::on_packet_message> message_handler_packet { this };
 
-	static constexpr ui::Dim header_height = 1 * 16;
+	static constexpr ui::Dim header_height = 2 * 16;
 
 	RSSI rssi {
 		{ 21 * 8, 0, 6 * 8, 4 },
@@ -150,6 +156,15 @@ private:
 		{ 18 * 8, 0 * 16 }
 	};
 
+	// Validated packets per reading type, out of all candidates the M4 built
+	Text text_hits {
+		{ 0 * 8, 1 * 16, 30 * 8, 16 },
+		""
+	};
+
+	std::array<uint32_t, tpms::Reading::Type::GMC_96 + 1> hits { };
+	uint32_t candidates { 0 };
+
 	TPMSRecentEntries recent { };
 	std::unique_ptr<TPMSLogger> logger { };
 
@@ -167,6 +182,7 @@ private:
 
 	void on_packet(const tpms::Packet& packet);
 	void on_show_list();
+	void update_hits();
 
 	void on_band_changed(const uint32_t new_band_frequency);
 
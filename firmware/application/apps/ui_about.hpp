@@ -110,12 +110,10 @@ private:
 		"OK"
 	};
 	
-	MessageHandlerRegistration message_handler_update {
-		Message::ID::DisplayFrameSync,
-		[this](const Message* const) {
-			this->update();
-		}
-	};
+	void on_update_message(const DisplayFrameSyncMessage* const) {
+		update();
+	}
+	MessageHandler<DisplayFrameSyncMessage, AboutView, &AboutView::on_update_message> message_handler_update { this };
 	
 };
 
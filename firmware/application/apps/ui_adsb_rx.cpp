@@ -55,24 +55,27 @@ void RecentEntriesTable<AircraftRecentEntries>::draw(
 		target_color = Color::dark_grey();
 	}
 	
-	std::string entry_string = "\x1B";
-	entry_string += aged_color;
-	entry_string += to_string_hex(entry.ICAO_address, 6) + " " +
-		entry.callsign + "  " +
-		(entry.hits <= 999 ? to_string_dec_uint(entry.hits, 4) : "999+") + " " + 
-		entry.time_string;
+	FixedString<40> entry_string;
+	entry_string.append('\x1B').append(aged_color)
+		.hex(entry.ICAO_address, 6).append(' ')
+		.append(entry.callsign).append("  ");
+	if (entry.hits <= 999)
+		entry_string.dec_uint(entry.hits, 4);
+	else
+		entry_string.append("999+");
+	entry_string.append(' ').append(entry.time_string);
 	
 	painter.draw_string(
 		target_rect.location(),
 		style,
-		entry_string
+		entry_string.c_str()
 	);
 	
 	if (entry.pos.valid)
 		painter.draw_bitmap(target_rect.location() + Point(15 * 8, 0), bitmap_target, target_color, style.background);
 }
 
-void ADSBLogger::log_str(std::string& logline) {
+void ADSBLogger::log_str(const char* const logline) {
 	rtc::RTC datetime;
 	rtcGetTime(&RTCD1, &datetime);
 	log_file.write_entry(datetime,logline);
@@ -128,7 +131,6 @@ ADSBRxDetailsView::ADSBRxDetailsView(
 		&button_see_map
 	});
 	
-	std::unique_ptr<ADSBLogger> logger { };
 	update(entry_copy);
 
 	// The following won't (shouldn't !) change for a given airborne aircraft
@@ -195,7 +197,7 @@ void ADSBRxView::on_frame(const ADSBFrameMessage * message) {
 	std::string str_timestamp;
 	std::string callsign;
 	std::string str_info;
-	std::string logentry;
+	FixedString<128> logentry;
 
 	auto frame = message->frame;
 	uint32_t ICAO_address = frame.get_ICAO_address();
@@ -209,8 +211,9 @@ void ADSBRxView::on_frame(const ADSBFrameMessage * message) {
 		entry.set_time_string(str_timestamp);
 
 		entry.inc_hit();
-		logentry += to_string_hex_array(frame.get_raw_data(), 14) + " ";
-		logentry += "ICAO:" + to_string_hex(ICAO_address, 6) + " ";
+		for (size_t i = 0; i < 14; i++)
+			logentry.hex(frame.get_raw_data()[i], 2);
+		logentry.append(" ICAO:").hex(ICAO_address, 6).append(' ');
 		
 		if (frame.get_DF() == DF_ADSB) {
 			uint8_t msg_type = frame.get_msg_type();
@@ -219,7 +222,7 @@ void ADSBRxView::on_frame(const ADSBFrameMessage * message) {
 			if ((msg_type >= 1) && (msg_type <= 4)) {
 				callsign = decode_frame_id(frame);
 				entry.set_callsign(callsign);
-				logentry+=callsign+" ";
+				logentry.append(callsign).append(' ');
 			} else if (((msg_type >= 9) && (msg_type <= 18)) || ((msg_type >= 20) && (msg_type <= 22))) {
 				entry.set_frame_pos(frame, raw_data[6] & 4);
 				
@@ -231,7 +234,7 @@ void ADSBRxView::on_frame(const ADSBFrameMessage * message) {
 						"." + to_string_dec_int((int)(entry.pos.longitude * 1000) % 100);
 					
 					entry.set_info_string(str_info);
-					logentry+=str_info+ " ";
+					logentry.append(str_info).append(' ');
 
 					if (send_updates)
 						details_view->update(entry);
@@ -240,13 +243,11 @@ void ADSBRxView::on_frame(const ADSBFrameMessage * message) {
 		}
 		recent_entries_view.set_dirty(); 
 		
-		logger = std::make_unique<ADSBLogger>();
-        if (logger) {
-                logger->append(u"adsb.txt");
-                // will log each frame in format:
-                // 20171103100227 8DADBEEFDEADBEEFDEADBEEFDEADBEEF ICAO:nnnnnn callsign Alt:nnnnnn Latnnn.nn Lonnnn.nn
-				logger->log_str(logentry);
-        }
+		if (logger) {
+			// will log each frame in format:
+			// 20171103100227 8DADBEEFDEADBEEFDEADBEEFDEADBEEF ICAO:nnnnnn callsign Alt:nnnnnn Latnnn.nn Lonnnn.nn
+			logger->log_str(logentry.c_str());
+		}
 	}
 }
 
@@ -291,6 +292,10 @@ ADSBRxView::ADSBRxView(NavigationView& nav) {
 		on_tick_second();
 	};
 	
+	logger = std::make_unique<ADSBLogger>();
+	if (logger)
+		logger->append(u"adsb.txt");
+	
 	baseband::set_adsb();
 	
 	receiver_model.set_tuning_frequency(1090000000);
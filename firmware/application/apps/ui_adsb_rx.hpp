@@ -111,7 +111,7 @@ public:
 	Optional<File::Error> append(const std::filesystem::path& filename) {
 		return log_file.append(filename);
 	}
-	void log_str(std::string& logline);
+	void log_str(const char* const logline);
 
 private:
 	LogFile log_file { };
@@ -242,13 +242,7 @@ private:
 		{ 20 * 8, 4, 10 * 8, 8 },
 	};
 	
-	MessageHandlerRegistration message_handler_frame {
-		Message::ID::ADSBFrame,
-		[this](Message* const p) {
-			const auto message = static_cast<const ADSBFrameMessage*>(p);
-			this->on_frame(message);
-		}
-	};
+	MessageHandler<ADSBFrameMessage, ADSBRxView, &ADSBRxView::on_frame> message_handler_frame { this };
 };
 
 } /* namespace ui */
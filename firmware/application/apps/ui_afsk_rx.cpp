@@ -61,6 +61,7 @@ AFSKRxView::AFSKRxView(NavigationView& nav) {
 		&field_vga,
 		&field_frequency,
 		&text_debug,
+		&options_mode,
 		&button_modem_setup,
 		&record_view,
 		&console
@@ -104,8 +105,11 @@ AFSKRxView::AFSKRxView(NavigationView& nav) {
 	if (logger)
 		logger->append("AFSK_LOG.TXT");
 	
-	// Auto-configure modem for LCR RX (will be removed later)
-	baseband::set_afsk(persistent_memory::modem_baudrate(), 8, 0, false);
+	options_mode.set_selected_index(0);
+	options_mode.on_change = [this](size_t, OptionsField::value_t) {
+		configure_modem();
+	};
+	configure_modem();
 	
 	audio::set_rate(audio::Rate::Hz_24000);
 	audio::output::start();
@@ -116,6 +120,27 @@ AFSKRxView::AFSKRxView(NavigationView& nav) {
 	receiver_model.enable();
 }
 
+void AFSKRxView::configure_modem() {
+	if (options_mode.selected_index_value() == 1) {
+		// APRS: Bell 202 at 1200 bauds, whatever the modem setup says
+		baseband::set_afsk(1200, 8, true);
+	} else {
+		// Auto-configure modem for LCR RX (will be removed later)
+		baseband::set_afsk(persistent_memory::modem_baudrate(), 8, false);
+	}
+}
+
+void AFSKRxView::on_frame(const ax25::Packet& packet) {
+	const auto str_frame = packet.to_string();
+	
+	std::string str_console = "\x1B";
+	str_console += (char)((console_color++ & 3) + 9);
+	console.writeln(str_console + str_frame);
+	
+	if (logger)
+		logger->log_raw_data(str_frame);
+}
+
 void AFSKRxView::on_data(uint32_t value, bool is_data) {
 	std::string str_console = "\x1B";
 	std::string str_byte = "";
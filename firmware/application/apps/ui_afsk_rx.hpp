@@ -31,6 +31,8 @@
 #include "log_file.hpp"
 #include "utility.hpp"
 
+#include "ax25_packet.hpp"
+
 class AFSKLogger {
 public:
 	Optional<File::Error> append(const std::string& filename) {
@@ -56,6 +58,8 @@ public:
 	
 private:
 	void on_data(uint32_t value, bool is_data);
+	void on_frame(const ax25::Packet& packet);
+	void configure_modem();
 	
 	uint8_t console_color { 0 };
 	uint32_t prev_value { 0 };
@@ -87,6 +91,15 @@ private:
 	};
 	
 	
+	OptionsField options_mode {
+		{ 0 * 8, 2 * 16 },
+		5,
+		{
+			{ "LCR  ", 0 },
+			{ "AX.25", 1 }
+		}
+	};
+	
 	Button button_modem_setup {
 		{ 12 * 8, 1 * 16, 96, 24 },
 		"Modem setup"
@@ -107,13 +120,16 @@ private:
 	
 	std::unique_ptr<AFSKLogger> logger { };
 	
-	MessageHandlerRegistration message_handler_packet {
-		Message::ID::AFSKData,
-		[this](Message* const p) {
-			const auto message = static_cast<const AFSKDataMessage*>(p);
-			this->on_data(message->value, message->is_data);
-		}
-	};
+	void on_packet_message(const AFSKDataMessage* const message) {
+		on_data(message->value, message->is_data);
+	}
+	MessageHandler<AFSKDataMessage, AFSKRxView, &AFSKRxView::on_packet_message> message_handler_packet { this };
+	
+	void on_frame_message(const AX25FrameMessage* const message) {
+		const ax25::Packet packet { message->packet };
+		on_frame(packet);
+	}
+	MessageHandler<AX25FrameMessage, AFSKRxView, &AFSKRxView::on_frame_message> message_handler_frame { this };
 };
 
 } /* namespace ui */
@@ -105,13 +105,10 @@ private:
 		10
 	};
 	
-	MessageHandlerRegistration message_handler_tx_progress {
-		Message::ID::TXProgress,
-		[this](const Message* const p) {
-			const auto message = *reinterpret_cast<const TXProgressMessage*>(p);
-			this->on_tx_progress(message.progress, message.done);
-		}
-	};
+	void on_tx_progress_message(const TXProgressMessage* const message) {
+		on_tx_progress(message->progress, message->done);
+	}
+	MessageHandler<TXProgressMessage, APRSTXView, &APRSTXView::on_tx_progress_message> message_handler_tx_progress { this };
 };
 
 } /* namespace ui */
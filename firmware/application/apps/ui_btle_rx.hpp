@@ -93,13 +93,10 @@ private:
 	void update_freq(rf::Frequency f);
 	//void on_data_afsk(const AFSKDataMessage& message);
 	
-	MessageHandlerRegistration message_handler_packet {
-		Message::ID::AFSKData,
-		[this](Message* const p) {
-			const auto message = static_cast<const AFSKDataMessage*>(p);
-			this->on_data(message->value, message->is_data);
-		}
-	};
+	void on_packet_message(const AFSKDataMessage* const message) {
+		on_data(message->value, message->is_data);
+	}
+	MessageHandler<AFSKDataMessage, BTLERxView, &BTLERxView::on_packet_message> message_handler_packet { this };
 };
 
 } /* namespace ui */
@@ -22,9 +22,12 @@
 #include "ui_debug.hpp"
 
 #include "ch.h"
+#include "chibios_cpp.hpp"
 
 #include "radio.hpp"
+#include "baseband_api.hpp"
 #include "string_format.hpp"
+#include "log_thread.hpp"
 
 #include "audio.hpp"
 
@@ -42,12 +45,22 @@ namespace ui {
 DebugMemoryView::DebugMemoryView(NavigationView& nav) {
 	add_children({
 		&text_title,
+		&text_label_log_dropped,
+		&text_label_log_dropped_value,
 		&text_label_m0_core_free,
 		&text_label_m0_core_free_value,
 		&text_label_m0_heap_fragmented_free,
 		&text_label_m0_heap_fragmented_free_value,
 		&text_label_m0_heap_fragments,
 		&text_label_m0_heap_fragments_value,
+		&text_label_app_queue_depth,
+		&text_label_app_queue_depth_value,
+		&text_label_app_queue_pushed,
+		&text_label_app_queue_pushed_value,
+		&text_label_app_queue_dropped,
+		&text_label_app_queue_dropped_value,
+		&text_label_m0_heap_allocations,
+		&text_label_m0_heap_allocations_value,
 		&button_done
 	});
 
@@ -59,6 +72,22 @@ DebugMemoryView::DebugMemoryView(NavigationView& nav) {
 	text_label_m0_heap_fragmented_free_value.set(to_string_dec_uint(m0_fragmented_free_space, 5));
 	text_label_m0_heap_fragments_value.set(to_string_dec_uint(m0_fragments, 5));
 
+	const auto app_queue_stats = shared_memory.application_queue.statistics();
+	text_label_app_queue_depth_value.set(
+		to_string_dec_uint(shared_memory.application_queue.depth(), 4) + "/" +
+		to_string_dec_uint(app_queue_stats.depth_max, 4)
+	);
+	text_label_app_queue_pushed_value.set(to_string_dec_uint(app_queue_stats.pushed, 9));
+	text_label_app_queue_dropped_value.set(to_string_dec_uint(app_queue_stats.dropped, 9));
+	text_label_m0_heap_allocations_value.set(to_string_dec_uint(chibios::heap_allocations(), 9));
+
+	// Logs of the receiver apps closed since boot
+	const auto log_stats = LogThread::totals();
+	text_label_log_dropped_value.set(
+		to_string_dec_uint(log_stats.lines_dropped, 4) + "/" +
+		to_string_dec_uint(log_stats.lines_queued + log_stats.lines_dropped, 4)
+	);
+
 	button_done.on_select = [&nav](Button&){ nav.pop(); };
 }
 
@@ -153,6 +182,98 @@ void TemperatureView::focus() {
 	button_done.focus();
 }
 
+/* MemoryTelemetryWidget *************************************************/
+
+static void format_heap(
+	StringWriter& line, const char* const label,
+	const size_t used, const size_t high_water, const size_t size
+) {
+	line.append(label).dec_uint(used, 5).append('/').dec_uint(high_water, 5).append('/').dec_uint(size, 5);
+}
+
+static void format_stack(
+	StringWriter& line, const char* const name,
+	const size_t unused, const size_t size
+) {
+	line.append(' ').append(name).resize(12);
+	if( size ) {
+		line.dec_uint(unused, 5).append('/').dec_uint(size, 5);
+	} else {
+		line.append("    ?/    ?");
+	}
+}
+
+void MemoryTelemetryWidget::paint(Painter& painter) {
+	const auto rect = screen_rect();
+	const auto& s = style();
+	painter.fill_rectangle(rect, s.background);
+
+	Point p = rect.location();
+	FixedString<32> line;
+	const auto emit = [&]() {
+		if( (p.y() + 16) <= rect.bottom() ) {
+			painter.draw_string(p, s, line.c_str());
+		}
+		p += { 0, 16 };
+		line.clear();
+	};
+
+	size_t m0_free = 0;
+	const auto m0_fragments = chHeapStatus(NULL, &m0_free);
+	format_heap(line, "M0 heap ", chibios::heap_used(), chibios::heap_high_water(), chibios::heap_size());
+	emit();
+	line.append(" largest ").dec_uint(chibios::heap_largest_free(), 5).append(" frags ").dec_uint(m0_fragments);
+	emit();
+
+	line.append("M0 stack    unused/size");
+	emit();
+	for(auto tp = chRegFirstThread(); tp; tp = chRegNextThread(tp)) {
+		const auto size = chibios::thread_stack_size(tp);
+		format_stack(line, tp->p_name ? tp->p_name : "?", chibios::thread_stack_unused(tp, size), size);
+		emit();
+	}
+
+	const auto m4 = baseband::memory_statistics();
+	if( !m4.valid ) {
+		line.append("M4 no baseband image run yet");
+		emit();
+		return;
+	}
+
+	format_heap(line, "M4 heap ", m4.heap_used, m4.heap_high_water, m4.heap_size);
+	emit();
+	line.append(" largest ").dec_uint(m4.heap_largest_free, 5).append(" frags ").dec_uint(m4.heap_fragments);
+	emit();
+
+	line.append("M4 stack    unused/size");
+	emit();
+	static constexpr std::array<const char*, MemoryStatistics::StackCount> m4_stack_names { {
+		"main", "irq", "baseband", "rssi"
+	} };
+	for(size_t i=0; i<m4.stacks.size(); i++) {
+		format_stack(line, m4_stack_names[i], m4.stacks[i].unused, m4.stacks[i].size);
+		emit();
+	}
+}
+
+/* DebugStacksView *******************************************************/
+
+DebugStacksView::DebugStacksView(NavigationView& nav) {
+	add_children({
+		&text_title,
+		&memory_telemetry_widget,
+		&button_refresh,
+		&button_done,
+	});
+
+	button_refresh.on_select = [this](Button&){ memory_telemetry_widget.set_dirty(); };
+	button_done.on_select = [&nav](Button&){ nav.pop(); };
+}
+
+void DebugStacksView::focus() {
+	button_refresh.focus();
+}
+
 /* RegistersWidget *******************************************************/
 
 RegistersWidget::RegistersWidget(
@@ -346,6 +467,7 @@ DebugPeripheralsMenuView::DebugPeripheralsMenuView(NavigationView& nav) {
 DebugMenuView::DebugMenuView(NavigationView& nav) {
 	add_items({
 		{ "Memory", 		ui::Color::white(),	nullptr,	[&nav](){ nav.push<DebugMemoryView>(); } },
+		{ "Stacks & Heap",	ui::Color::white(),	nullptr,	[&nav](){ nav.push<DebugStacksView>(); } },
 		{ "Radio State",	ui::Color::white(),	nullptr,	[&nav](){ nav.push<NotImplementedView>(); } },
 		//{ "SD Card",		ui::Color::white(),	nullptr,	[&nav](){ nav.push<SDCardDebugView>(); } },
 		{ "Peripherals",	ui::Color::white(),	nullptr,	[&nav](){ nav.push<DebugPeripheralsMenuView>(); } },
@@ -45,10 +45,19 @@ public:
 
 private:
 	Text text_title {
-		{ 96, 96, 48, 16 },
+		{ 96, 80, 48, 16 },
 		"Memory",
 	};
 
+	Text text_label_log_dropped {
+		{ 0, 112, 152, 16 },
+		"Log Dropped/Lines",
+	};
+
+	Text text_label_log_dropped_value {
+		{ 160, 112, 80, 16 },
+	};
+
 	Text text_label_m0_core_free {
 		{ 0, 128, 144, 16 },
 		"M0 Core Free Bytes",
@@ -76,8 +85,44 @@ private:
 		{ 200, 160, 40, 16 },
 	};
 
+	Text text_label_app_queue_depth {
+		{ 0, 176, 152, 16 },
+		"App Queue Depth/Max",
+	};
+
+	Text text_label_app_queue_depth_value {
+		{ 160, 176, 80, 16 },
+	};
+
+	Text text_label_app_queue_pushed {
+		{ 0, 192, 152, 16 },
+		"App Queue Pushed",
+	};
+
+	Text text_label_app_queue_pushed_value {
+		{ 160, 192, 80, 16 },
+	};
+
+	Text text_label_app_queue_dropped {
+		{ 0, 208, 152, 16 },
+		"App Queue Dropped",
+	};
+
+	Text text_label_app_queue_dropped_value {
+		{ 160, 208, 80, 16 },
+	};
+
+	Text text_label_m0_heap_allocations {
+		{ 0, 224, 152, 16 },
+		"M0 Heap Allocations",
+	};
+
+	Text text_label_m0_heap_allocations_value {
+		{ 160, 224, 80, 16 },
+	};
+
 	Button button_done {
-		{ 72, 192, 96, 24 },
+		{ 72, 240, 96, 24 },
 		"Done"
 	};
 };
@@ -129,6 +174,48 @@ private:
 	};
 };
 
+/* Heap high-water/fragmentation and per-thread stack headroom for both
+ * cores. M4 figures come from the running baseband image or, when none is
+ * running, from the last one as it was shut down.
+ */
+class MemoryTelemetryWidget : public Widget {
+public:
+	explicit MemoryTelemetryWidget(
+		Rect parent_rect
+	) : Widget { parent_rect }
+	{
+	}
+
+	void paint(Painter& painter) override;
+};
+
+class DebugStacksView : public View {
+public:
+	explicit DebugStacksView(NavigationView& nav);
+
+	void focus() override;
+
+private:
+	Text text_title {
+		{ 64, 16, 112, 16 },
+		"Stacks & Heap",
+	};
+
+	MemoryTelemetryWidget memory_telemetry_widget {
+		{ 0, 40, 240, 208 },
+	};
+
+	Button button_refresh {
+		{ 16, 264, 96, 24 },
+		"Refresh"
+	};
+
+	Button button_done {
+		{ 128, 264, 96, 24 },
+		"Done"
+	};
+};
+
 struct RegistersWidgetConfig {
 	size_t registers_count;
 	size_t register_bits;
@@ -236,12 +323,10 @@ public:
 private:
 	uint8_t key_event_mask;
 
-	MessageHandlerRegistration message_handler_frame_sync {
-		Message::ID::DisplayFrameSync,
-		[this](const Message* const) {
-			this->on_frame_sync();
-		}
-	};
+	void on_frame_sync_message(const DisplayFrameSyncMessage* const) {
+		on_frame_sync();
+	}
+	MessageHandler<DisplayFrameSyncMessage, ControlsSwitchesWidget, &ControlsSwitchesWidget::on_frame_sync_message> message_handler_frame_sync { this };
 
 	void on_frame_sync();
 };
@@ -203,7 +203,7 @@ void EncodersView::focus() {
 }
 
 EncodersView::~EncodersView() {
-	transmitter_model.disable();
+	stop_tx();
 	baseband::shutdown();
 }
 
@@ -237,8 +237,8 @@ void EncodersView::on_tx_progress(const uint32_t progress, const bool done) {
 	//char str[16];
 	
 	if (!done) {
-		// Repeating...
-		repeat_index = progress + 1;
+		// Repeating... progress is in symbols, reported once per frame
+		repeat_index = std::min<uint32_t>(progress / frame_period + 1, repeat_min);
 		
 		/*if (tx_mode == SCAN) {
 			scan_progress++;
@@ -270,18 +270,28 @@ void EncodersView::on_tx_progress(const uint32_t progress, const bool done) {
 				start_tx(true);
 			}
 		} else {*/
-			transmitter_model.disable();
-			tx_mode = IDLE;
+			stop_tx();
 			text_status.set("Done");
 			progressbar.set_value(0);
-			tx_view.set_transmitting(false);
 		//}
 	}
 }
 
+void EncodersView::stop_tx() {
+	// Done or aborted, the baseband doesn't need the rest of the stream
+	replay_thread.reset();
+	ready_signal = false;
+	
+	transmitter_model.disable();
+	tx_mode = IDLE;
+	tx_view.set_transmitting(false);
+}
+
 void EncodersView::start_tx(const bool scan) {
 	(void)scan;
-	size_t bitstream_length = 0;
+	
+	replay_thread.reset();
+	ready_signal = false;
 	
 	repeat_min = view_config.repeat_min();
 	
@@ -305,18 +315,35 @@ void EncodersView::start_tx(const bool scan) {
 	
 	view_config.generate_frame();
 	
-	bitstream_length = make_bitstream(view_config.frame_fragments);
+	// Frames are streamed, repeats and pauses included: no length limit
+	auto reader = std::make_unique<BitstreamReader>(
+		view_config.frame_fragments,
+		repeat_min,
+		view_config.pause_symbols()
+	);
+	frame_period = std::max<uint32_t>(reader->period(), 1);
+	
+	const auto samples_per_symbol = view_config.samples_per_bit();
+	
+	// Raised-cosine edges over 1/16 of a symbol keep the keying splatter down
+	baseband::set_bitstream_tx(
+		BitstreamTXConfigMessage::Modulation::OOK,
+		samples_per_symbol,
+		samples_per_symbol / 16,
+		reader->symbol_count(),
+		frame_period
+	);
 
 	transmitter_model.set_sampling_rate(OOK_SAMPLERATE);
 	transmitter_model.set_rf_amp(true);
 	transmitter_model.set_baseband_bandwidth(1750000);
 	transmitter_model.enable();
 	
-	baseband::set_ook_data(
-		bitstream_length,
-		view_config.samples_per_bit(),
-		repeat_min,
-		view_config.pause_symbols()
+	replay_thread = std::make_unique<ReplayThread>(
+		std::move(reader),
+		read_size, buffer_count,
+		&ready_signal,
+		nullptr
 	);
 }
 
@@ -324,7 +351,7 @@ EncodersView::EncodersView(
 	NavigationView& nav
 ) : nav_ { nav }
 {
-	baseband::run_image(portapack::spi_flash::image_tag_ook);
+	baseband::run_image(portapack::spi_flash::image_tag_bitstream_tx);
 
 	add_children({
 		&tab_view,
@@ -348,7 +375,8 @@ EncodersView::EncodersView(
 	};
 	
 	tx_view.on_stop = [this]() {
-		tx_view.set_transmitting(false);
+		stop_tx();
+		update_progress();
 	};
 }
 
@@ -26,6 +26,8 @@
 #include "transmitter_model.hpp"
 #include "encoders.hpp"
 #include "de_bruijn.hpp"
+#include "replay_thread.hpp"
+#include "io_bitstream.hpp"
 
 using namespace encoders;
 
@@ -172,9 +174,17 @@ private:
 	tx_modes tx_mode = IDLE;
 	uint8_t repeat_index { 0 };
 	uint8_t repeat_min { 0 };
+	uint32_t frame_period { 1 };
+	
+	// 4096 symbols per buffer
+	const size_t read_size { 512 };
+	const size_t buffer_count { 3 };
+	std::unique_ptr<ReplayThread> replay_thread { };
+	bool ready_signal { false };
 	
 	void update_progress();
 	void start_tx(const bool scan);
+	void stop_tx();
 	void on_tx_progress(const uint32_t progress, const bool done);
 	
 	/*const Style style_address {
@@ -213,13 +223,17 @@ private:
 		9
 	};
 	
-	MessageHandlerRegistration message_handler_tx_progress {
-		Message::ID::TXProgress,
-		[this](const Message* const p) {
-			const auto message = *reinterpret_cast<const TXProgressMessage*>(p);
-			this->on_tx_progress(message.progress, message.done);
+	void on_fifo_signal_message(const RequestSignalMessage* const message) {
+		if (message->signal == RequestSignalMessage::Signal::FillRequest) {
+			ready_signal = true;
 		}
-	};
+	}
+	MessageHandler<RequestSignalMessage, EncodersView, &EncodersView::on_fifo_signal_message> message_handler_fifo_signal { this };
+	
+	void on_tx_progress_message(const TXProgressMessage* const message) {
+		on_tx_progress(message->progress, message->done);
+	}
+	MessageHandler<TXProgressMessage, EncodersView, &EncodersView::on_tx_progress_message> message_handler_tx_progress { this };
 };
 
 } /* namespace ui */
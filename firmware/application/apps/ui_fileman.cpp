@@ -32,42 +32,21 @@ namespace ui {
 void FileManBaseView::load_directory_contents(const std::filesystem::path& dir_path) {
 	current_path = dir_path;
 	
-	text_current.set(dir_path.string().substr(0, 30 - 8));
+	text_current.set(dir_path.string().substr(0, 18));
 	
 	entry_list.clear();
 	
-	auto filtering = (bool)extension_filter.size();
-	
-	// List directories and files, put directories up top
 	if (dir_path.string().length())
-		entry_list.push_back({ u"..", 0, true });
+		entry_list.push_back({ u"..", 0, { 0, 0 }, true });
 	
-	for (const auto& entry : std::filesystem::directory_iterator(dir_path, u"*")) {
-		if (std::filesystem::is_regular_file(entry.status())) {
-			if (entry.path().string().length()) {
-				bool matched = true;
-				if (filtering) {
-					auto entry_extension = entry.path().extension().string();
-				
-					for (auto &c: entry_extension)
-						c = toupper(c);
-					
-					if (entry_extension != extension_filter)
-						matched = false;
-				}
-				
-				if (matched)
-					entry_list.push_back({ entry.path(), (uint32_t)entry.size(), false });
-			}
-		} else if (std::filesystem::is_directory(entry.status())) {
-			entry_list.insert(entry_list.begin(), { entry.path(), 0, true });
-		}
-	}
+	// Sorted from the directory's index, the rest is read as the menu scrolls
+	directory.open(dir_path, sort, extension_filter);
+	directory.read_page(entry_list, page_size);
 }
 
 std::filesystem::path FileManBaseView::get_selected_path() {
 	auto selected_path_str = current_path.string();
-	auto entry_path = entry_list[menu_view.highlighted_index()].entry_path.string();
+	auto entry_path = entry_list[menu_view.highlighted_index()].path.string();
 	
 	if (entry_path == "..") {
 		selected_path_str = get_parent_dir().string();
@@ -100,8 +79,21 @@ FileManBaseView::FileManBaseView(
 	add_children({
 		&labels,
 		&text_current,
+		&options_sort,
 		&button_exit
 	});
+	
+	options_sort.on_change = [this](size_t, OptionsField::value_t v) {
+		sort = (DirectoryIndex::Sort)v;
+		load_directory_contents(current_path);
+		refresh_list();
+	};
+	
+	menu_view.on_highlight = [this]() {
+		load_more();
+		if (on_highlight_entry)
+			on_highlight_entry();
+	};
 
 	menu_view.on_left = [&nav, this]() {
 		load_directory_contents(get_parent_dir());
@@ -122,15 +114,34 @@ void FileManBaseView::focus() {
 	}
 }
 
+void FileManBaseView::load_more() {
+	if (directory.at_end() || (menu_view.highlighted_index() + page_size / 2 < entry_list.size()))
+		return;
+	
+	const auto first = entry_list.size();
+	if (directory.read_page(entry_list, page_size))
+		add_menu_items(first);
+	
+	// The directory changed since its index was written, list it again
+	if (directory.is_stale()) {
+		load_directory_contents(current_path);
+		refresh_list();
+	}
+}
+
 void FileManBaseView::refresh_list() {
 	if (on_refresh_widgets)
 		on_refresh_widgets(false);
 
 	menu_view.clear();
-	
-	for (size_t n = 0; n < entry_list.size(); n++) {
+	add_menu_items(0);
+	menu_view.set_highlighted(0);	// Refresh
+}
+
+void FileManBaseView::add_menu_items(const size_t first) {
+	for (size_t n = first; n < entry_list.size(); n++) {
 		auto entry = &entry_list[n];
-		auto entry_name = entry->entry_path.filename().string().substr(0, 20);
+		auto entry_name = entry->path.filename().string().substr(0, 20);
 		
 		if (entry->is_directory) {
 			
@@ -158,7 +169,7 @@ void FileManBaseView::refresh_list() {
 			
 			std::string size_str = to_string_dec_uint(file_size) + suffix[suffix_index];
 			
-			auto entry_extension = entry->entry_path.extension().string();
+			auto entry_extension = entry->path.extension().string();
 			for (auto &c: entry_extension)
 				c = toupper(c);
 			
@@ -181,8 +192,6 @@ void FileManBaseView::refresh_list() {
 			
 		}
 	}
-	
-	menu_view.set_highlighted(0);	// Refresh
 }
 
 /*void FileSaveView::on_save_name() {
@@ -237,7 +246,7 @@ FileLoadView::FileLoadView(
 		} else {
 			nav_.pop();
 			if (on_changed)
-				on_changed(current_path.string() + '/' + entry_list[menu_view.highlighted_index()].entry_path.string());
+				on_changed(current_path.string() + '/' + entry_list[menu_view.highlighted_index()].path.string());
 		}
 	};
 }
@@ -284,8 +293,12 @@ FileManagerView::FileManagerView(
 		&button_delete
 	});
 	
-	menu_view.on_highlight = [this]() {
-		text_date.set(to_string_FAT_timestamp(file_created_date(get_selected_path())));
+	on_highlight_entry = [this]() {
+		if (menu_view.highlighted_index() >= entry_list.size())
+			return;
+		
+		const auto& entry = entry_list[menu_view.highlighted_index()];
+		text_date.set(entry.timestamp.FAT_date ? to_string_FAT_timestamp(entry.timestamp) : "");
 	};
 	
 	refresh_list();
@@ -309,13 +322,13 @@ FileManagerView::FileManagerView(
 	};
 	
 	button_rename.on_select = [this, &nav](Button&) {
-		name_buffer = entry_list[menu_view.highlighted_index()].entry_path.filename().string().substr(0, max_filename_length);
+		name_buffer = entry_list[menu_view.highlighted_index()].path.filename().string().substr(0, max_filename_length);
 		on_rename(nav);
 	};
 	
 	button_delete.on_select = [this, &nav](Button&) {
 		// Use display_modal ?
-		nav.push<ModalMessageView>("Delete", "Delete " + entry_list[menu_view.highlighted_index()].entry_path.filename().string() + "\nAre you sure ?", YESNO,
+		nav.push<ModalMessageView>("Delete", "Delete " + entry_list[menu_view.highlighted_index()].path.filename().string() + "\nAre you sure ?", YESNO,
 			[this](bool choice) {
 				if (choice)
 					on_delete();
@@ -25,17 +25,12 @@
 #include "ui_painter.hpp"
 #include "ui_menu.hpp"
 #include "file.hpp"
+#include "directory_index.hpp"
 #include "ui_navigation.hpp"
 #include "ui_textentry.hpp"
 
 namespace ui {
 
-struct fileman_entry {
-	std::filesystem::path entry_path { };
-	uint32_t size { };
-	bool is_directory { };
-};
-
 class FileManBaseView : public View {
 public:
 	FileManBaseView(
@@ -54,6 +49,8 @@ protected:
 	NavigationView& nav_;
 	
 	static constexpr size_t max_filename_length = 30 - 2;
+	// Entries read ahead of the highlighted one
+	static constexpr size_t page_size = 16;
 	
 	const std::string suffix[5] = { "B", "kB", "MB", "GB", "??" };
 	
@@ -74,22 +71,36 @@ protected:
 	
 	bool empty_root { false };
 	std::function<void(void)> on_select_entry { nullptr };
+	std::function<void(void)> on_highlight_entry { nullptr };
 	std::function<void(bool)> on_refresh_widgets { nullptr };
-	std::vector<fileman_entry> entry_list { };
+	DirectoryIndex directory { };
+	DirectoryIndex::Sort sort { DirectoryIndex::Sort::Name };
+	std::vector<DirectoryIndex::Entry> entry_list { };
 	std::filesystem::path current_path { u"" };
 	std::string extension_filter { "" };
 	
 	void change_category(int32_t category_id);
 	std::filesystem::path get_parent_dir();
 	void refresh_list();
+	void add_menu_items(const size_t first);
+	void load_more();
 	
 	Labels labels {
 		{ { 0, 0 }, "Current:", Color::light_grey() }
 	};
 	Text text_current {
-		{ 8 * 8, 0 * 8, 22 * 8, 16 },
+		{ 8 * 8, 0 * 8, 18 * 8, 16 },
 		"",
 	};
+	OptionsField options_sort {
+		{ 26 * 8, 0 * 8 },
+		4,
+		{
+			{ "Name", (int32_t)DirectoryIndex::Sort::Name },
+			{ "Date", (int32_t)DirectoryIndex::Sort::Date },
+			{ "Size", (int32_t)DirectoryIndex::Sort::Size },
+		}
+	};
 	
 	MenuView menu_view {
 		{ 0, 2 * 8, 240, 26 * 8 },
@@ -265,13 +265,10 @@ private:
 		"START"
 	};
 	
-	MessageHandlerRegistration message_handler_retune {
-		Message::ID::Retune,
-		[this](Message* const p) {
-			const auto message = static_cast<const RetuneMessage*>(p);
-			this->on_retune(message->freq, message->range);
-		}
-	};
+	void on_retune_message(const RetuneMessage* const message) {
+		on_retune(message->freq, message->range);
+	}
+	MessageHandler<RetuneMessage, JammerView, &JammerView::on_retune_message> message_handler_retune { this };
 };
 
 } /* namespace ui */
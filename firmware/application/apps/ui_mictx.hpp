@@ -164,29 +164,21 @@ private:
 		"PTT: RIGHT BUTTON"
 	};
 	
-	MessageHandlerRegistration message_handler_lcd_sync {
-		Message::ID::DisplayFrameSync,
-		[this](const Message* const) {
-			this->update_vumeter();
-			this->do_timing();
-		}
-	};
-	
-	MessageHandlerRegistration message_handler_audio_level {
-		Message::ID::AudioLevelReport,
-		[this](const Message* const p) {
-			const auto message = static_cast<const AudioLevelReportMessage*>(p);
-			this->audio_level = message->value;
-		}
-	};
-	
-	MessageHandlerRegistration message_handler_tx_progress {
-		Message::ID::TXProgress,
-		[this](const Message* const p) {
-			const auto message = *reinterpret_cast<const TXProgressMessage*>(p);
-			this->on_tx_progress(message.done);
-		}
-	};
+	void on_lcd_sync_message(const DisplayFrameSyncMessage* const) {
+		update_vumeter();
+		do_timing();
+	}
+	MessageHandler<DisplayFrameSyncMessage, MicTXView, &MicTXView::on_lcd_sync_message> message_handler_lcd_sync { this };
+	
+	void on_audio_level_message(const AudioLevelReportMessage* const message) {
+		audio_level = message->value;
+	}
+	MessageHandler<AudioLevelReportMessage, MicTXView, &MicTXView::on_audio_level_message> message_handler_audio_level { this };
+	
+	void on_tx_progress_message(const TXProgressMessage* const message) {
+		on_tx_progress(message->done);
+	}
+	MessageHandler<TXProgressMessage, MicTXView, &MicTXView::on_tx_progress_message> message_handler_tx_progress { this };
 };
 
 } /* namespace ui */
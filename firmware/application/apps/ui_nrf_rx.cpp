@@ -22,20 +22,28 @@
  */
 
 #include "ui_nrf_rx.hpp"
-#include "ui_modemsetup.hpp"
 
-#include "modems.hpp"
-#include "audio.hpp"
-#include "rtc_time.hpp"
 #include "baseband_api.hpp"
 #include "string_format.hpp"
-#include "portapack_persistent_memory.hpp"
 
 using namespace portapack;
-using namespace modems;
 
 namespace ui {
 
+static std::string format_rate(const nrf24::DataRate data_rate) {
+	switch(data_rate) {
+	case nrf24::DataRate::Rate250k:	return "250k";
+	case nrf24::DataRate::Rate1M:	return "1M";
+	case nrf24::DataRate::Rate2M:	return "2M";
+	default:						return "Auto";
+	}
+}
+
+static void set_address(SymField& field, const uint64_t address) {
+	for(uint32_t c = 0; c < 10; c++)
+		field.set_sym(c, (address >> ((9 - c) * 4)) & 0xF);
+}
+
 void NRFRxView::focus() {
 	field_frequency.focus();
 }
@@ -54,28 +62,17 @@ NRFRxView::NRFRxView(NavigationView& nav) {
 		&field_lna,
 		&field_vga,
 		&field_frequency,
-		&text_debug,
-		&button_modem_setup,
-		&record_view,
+		&labels,
+		&options_rate,
+		&options_crc,
+		&options_width,
+		&sym_address_0,
+		&sym_address_1,
+		&text_stats,
 		&console
 	});
 	
-	// DEBUG
-	record_view.on_error = [&nav](std::string message) {
-		nav.display_modal("Error", message);
-	};
-	record_view.set_sampling_rate(24000);
-	
-	// Auto-configure modem for LCR RX (will be removed later)
 	update_freq(2480000000);
-	auto def_bell202 = &modem_defs[0];
-	persistent_memory::set_modem_baudrate(def_bell202->baudrate);
-	serial_format_t serial_format;
-	serial_format.data_bits = 7;
-	serial_format.parity = EVEN;
-	serial_format.stop_bits = 1;
-	serial_format.bit_order = LSB_FIRST;
-	persistent_memory::set_serial_format(serial_format);
 	
 	field_frequency.set_value(receiver_model.tuning_frequency());
 	field_frequency.set_step(100);
@@ -89,17 +86,31 @@ NRFRxView::NRFRxView(NavigationView& nav) {
 			field_frequency.set_value(f);
 		};
 	};
-
-	button_modem_setup.on_select = [&nav](Button&) {
-		nav.push<ModemSetupView>();
-	};
 	
+	// nRF24L01 reset values for pipes 0 and 1
+	set_address(sym_address_0, 0xE7E7E7E7E7);
+	set_address(sym_address_1, 0xC2C2C2C2C2);
+	options_width.set_selected_index(2);	// 5 bytes
+	options_rate.set_selected_index(0);		// Auto
+	options_crc.set_selected_index(0);		// Auto
 	
-	// Auto-configure modem for LCR RX (will be removed later)
-	baseband::set_nrf(persistent_memory::modem_baudrate(), 8, 0, false);
+	options_rate.on_change = [this](size_t, int32_t) {
+		configure();
+	};
+	options_crc.on_change = [this](size_t, int32_t) {
+		configure();
+	};
+	options_width.on_change = [this](size_t, int32_t) {
+		configure();
+	};
+	sym_address_0.on_change = [this]() {
+		configure();
+	};
+	sym_address_1.on_change = [this]() {
+		configure();
+	};
 	
-	audio::set_rate(audio::Rate::Hz_24000);
-	audio::output::start();
+	configure();
 	
 	receiver_model.set_sampling_rate(4000000);
 	receiver_model.set_baseband_bandwidth(4000000);
@@ -107,57 +118,54 @@ NRFRxView::NRFRxView(NavigationView& nav) {
 	receiver_model.enable();
 }
 
-void NRFRxView::on_data(uint32_t value, bool is_data) {
-	//std::string str_console = "\x1B";
-	std::string str_console = "";
-	if (is_data) {
-		// Colorize differently after message splits
-		//str_console += (char)((console_color & 3) + 9);
-		
-		//value &= 0xFF;											// ABCDEFGH
-		//value = ((value & 0xF0) >> 4) | ((value & 0x0F) << 4);	// EFGHABCD
-		//value = ((value & 0xCC) >> 2) | ((value & 0x33) << 2);	// GHEFCDAB
-		//value = ((value & 0xAA) >> 1) | ((value & 0x55) << 1);	// HGFEDCBA
-		//value &= 0x7F;											// Ignore parity, which is the MSB now
-		
-		//if ((value >= 32) && (value < 127)) {
-		//	str_console += (char)value;							// Printable
-		//} 
-		
-		//str_console += (char)'A';
-		//str_console += (char)value;
-		//str_console += "[" + to_string_hex(value, 2) + "]";	
-		str_console += " " + to_string_hex(value, 2) ;	
-		console.write(str_console);
-		
-		
-		
-		/*if ((value != 0x7F) && (prev_value == 0x7F)) {
-			// Message split
-			console.writeln("");
-			console_color++;
-			
-			
-		}*/
-		//prev_value = value;
-	} else {
-		// Baudrate estimation
-		//text_debug.set("~" + to_string_dec_uint(value)); 
-		if (value == 'A')
-		{console.write("addr:");}
-		else if (value == 'B')
-		{console.write(" data:");}
-		else if (value == 'C')
-		{
-			console.writeln("");
-			console.writeln("");
-		}
-		//console.writeln("");
+void NRFRxView::configure() {
+	const uint32_t width = options_width.selected_index_value();
+	std::array<nrf24::Address, nrf24::addresses_max> addresses { };
+	
+	// Fields always hold 5 bytes, shorter addresses use the leading ones
+	addresses[0] = { sym_address_0.value_hex_u64() >> ((5 - width) * 8), width };
+	addresses[1] = { sym_address_1.value_hex_u64() >> ((5 - width) * 8), width };
+	
+	baseband::set_nrf(
+		static_cast<nrf24::DataRate>(options_rate.selected_index_value()),
+		2,
+		addresses,
+		options_crc.selected_index_value()
+	);
+}
+
+void NRFRxView::on_packet(const nrf24::Packet& packet) {
+	std::string str_console = format_rate(packet.data_rate) + " " +
+		to_string_hex(packet.address.value, packet.address.width * 2) +
+		" P" + to_string_dec_uint(packet.pid) +
+		" L" + to_string_dec_uint(packet.length) + ":";
+	
+	for(size_t i = 0; i < packet.length; i++)
+		str_console += " " + to_string_hex(packet.payload[i], 2);
+	
+	console.writeln(str_console);
+}
+
+void NRFRxView::on_statistics(const NRFRxStatisticsMessage& message) {
+	uint32_t packets = 0;
+	uint32_t crc_errors = 0;
+	
+	for(const auto& rate : message.rates) {
+		packets += rate.packets;
+		crc_errors += rate.crc_errors;
 	}
+	
+	const uint32_t total = packets + crc_errors;
+	const uint32_t error_percent = total ? (crc_errors * 100) / total : 0;
+	
+	text_stats.set(
+		format_rate(message.data_rate) + " " +
+		to_string_dec_uint(packets) + " pkt/s CRC err " +
+		to_string_dec_uint(error_percent) + "%"
+	);
 }
 
 NRFRxView::~NRFRxView() {
-	audio::output::stop();
 	receiver_model.disable();
 	baseband::shutdown();
 }
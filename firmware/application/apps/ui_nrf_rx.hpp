@@ -27,7 +27,8 @@
 #include "ui.hpp"
 #include "ui_navigation.hpp"
 #include "ui_receiver.hpp"
-#include "ui_record_view.hpp"	// DEBUG
+
+#include "nrf24_packet.hpp"
 
 #include "utility.hpp"
 
@@ -43,11 +44,10 @@ public:
 	std::string title() const override { return "NRF RX"; };
 	
 private:
-	void on_data(uint32_t value, bool is_data);
-	
-	uint8_t console_color { 0 };
-	uint32_t prev_value { 0 };
-	std::string str_log { "" };
+	void on_packet(const nrf24::Packet& packet);
+	void on_statistics(const NRFRxStatisticsMessage& message);
+	void configure();
+	void update_freq(rf::Frequency f);
 
 	RFAmpField field_rf_amp {
 		{ 13 * 8, 0 * 16 }
@@ -68,38 +68,74 @@ private:
 	FrequencyField field_frequency {
 		{ 0 * 8, 0 * 16 },
 	};
-	
-	Text text_debug {
-		{ 0 * 8, 1 * 16, 10 * 8, 16 },
-		"DEBUG"
+
+	Labels labels {
+		{ { 0 * 8, 1 * 16 }, "Rate:     CRC:     Width:", Color::light_grey() },
+		{ { 0 * 8, 2 * 16 }, "Addr:", Color::light_grey() }
 	};
-	
-	
-	Button button_modem_setup {
-		{ 12 * 8, 1 * 16, 96, 24 },
-		"Modem setup"
+
+	OptionsField options_rate {
+		{ 5 * 8, 1 * 16 },
+		4,
+		{
+			{ "Auto", toUType(nrf24::DataRate::Auto) },
+			{ "250k", toUType(nrf24::DataRate::Rate250k) },
+			{ "1M", toUType(nrf24::DataRate::Rate1M) },
+			{ "2M", toUType(nrf24::DataRate::Rate2M) }
+		}
 	};
-	
-	// DEBUG
-	RecordView record_view {
-		{ 0 * 8, 3 * 16, 30 * 8, 1 * 16 },
-		u"AFS_????", RecordView::FileType::WAV, 4096, 4
+
+	OptionsField options_crc {
+		{ 14 * 8, 1 * 16 },
+		4,
+		{
+			{ "Auto", 0 },
+			{ "8", 1 },
+			{ "16", 2 }
+		}
+	};
+
+	OptionsField options_width {
+		{ 25 * 8, 1 * 16 },
+		1,
+		{
+			{ "3", 3 },
+			{ "4", 4 },
+			{ "5", 5 }
+		}
+	};
+
+	// Two pipe addresses, their widths' worth of leading bytes are used
+	SymField sym_address_0 {
+		{ 5 * 8, 2 * 16 },
+		10,
+		SymField::SYMFIELD_HEX
+	};
+
+	SymField sym_address_1 {
+		{ 16 * 8, 2 * 16 },
+		10,
+		SymField::SYMFIELD_HEX
+	};
+
+	Text text_stats {
+		{ 0 * 8, 3 * 16, 30 * 8, 16 },
+		""
 	};
 	
 	Console console {
 		{ 0, 4 * 16, 240, 240 }
 	};
 
-	void update_freq(rf::Frequency f);
-	//void on_data_afsk(const AFSKDataMessage& message);
-	
-	MessageHandlerRegistration message_handler_packet {
-		Message::ID::AFSKData,
-		[this](Message* const p) {
-			const auto message = static_cast<const AFSKDataMessage*>(p);
-			this->on_data(message->value, message->is_data);
-		}
-	};
+	void on_packet_message(const NRFPacketMessage* const message) {
+		on_packet(message->packet);
+	}
+	MessageHandler<NRFPacketMessage, NRFRxView, &NRFRxView::on_packet_message> message_handler_packet { this };
+
+	void on_statistics_message(const NRFRxStatisticsMessage* const message) {
+		on_statistics(*message);
+	}
+	MessageHandler<NRFRxStatisticsMessage, NRFRxView, &NRFRxView::on_statistics_message> message_handler_statistics { this };
 };
 
 } /* namespace ui */
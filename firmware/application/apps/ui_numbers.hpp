@@ -164,15 +164,12 @@ private:
 		"Exit"
 	};
 	
-	MessageHandlerRegistration message_handler_fifo_signal {
-		Message::ID::RequestSignal,
-		[this](const Message* const p) {
-			const auto message = static_cast<const RequestSignalMessage*>(p);
-			if (message->signal == RequestSignalMessage::Signal::FillRequest) {
-				this->prepare_audio();
-			}
+	void on_fifo_signal_message(const RequestSignalMessage* const message) {
+		if (message->signal == RequestSignalMessage::Signal::FillRequest) {
+			prepare_audio();
 		}
-	};
+	}
+	MessageHandler<RequestSignalMessage, NumbersStationView, &NumbersStationView::on_fifo_signal_message> message_handler_fifo_signal { this };
 };
 
 } /* namespace ui */
@@ -138,6 +138,7 @@ RDSThread::~RDSThread() {
 }
 
 msg_t RDSThread::static_fn(void* arg) {
+	chRegSetThreadName("rds");
 	auto obj = static_cast<RDSThread*>(arg);
 	obj->run();
 	return 0;
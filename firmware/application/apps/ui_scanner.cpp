@@ -31,8 +31,8 @@ using namespace portapack;
 namespace ui {
 
 ScannerThread::ScannerThread(
-	std::vector<rf::Frequency> frequency_list
-) : frequency_list_ {  std::move(frequency_list) }
+	std::vector<radio::HopEntry> hop_plan
+) : hop_plan_ { std::move(hop_plan) }
 {
 	thread = chThdCreateFromHeap(NULL, 1024, NORMALPRIO + 10, ScannerThread::static_fn, this);
 }
@@ -50,6 +50,7 @@ void ScannerThread::set_scanning(const bool v) {
 }
 
 msg_t ScannerThread::static_fn(void* arg) {
+	chRegSetThreadName("scanner");
 	auto obj = static_cast<ScannerThread*>(arg);
 	obj->run();
 	return 0;
@@ -62,14 +63,14 @@ void ScannerThread::run() {
 	while( !chThdShouldTerminate() ) {
 		if (_scanning) {
 			// Retune
-			receiver_model.set_tuning_frequency(frequency_list_[frequency_index]);
+			radio::set_tuning(hop_plan_[frequency_index]);
 			
 			message.range = frequency_index;
 			EventDispatcher::send_message(message);
 			
 			
 			frequency_index++;
-			if (frequency_index >= frequency_list_.size())
+			if (frequency_index >= hop_plan_.size())
 				frequency_index = 0;
 		}
 		
@@ -165,8 +166,14 @@ ScannerView::ScannerView(
 	receiver_model.set_nbfm_configuration(field_bw.selected_index());
 	audio::output::unmute();
 	
+	// Tuning offset depends on the sampling rate, so build the hop plan last
+	std::vector<radio::HopEntry> hop_plan;
+	hop_plan.reserve(frequency_list.size());
+	for (const auto f : frequency_list)
+		hop_plan.push_back(receiver_model.hop_entry(f));
+	
 	// TODO: Scanning thread here
-	scan_thread = std::make_unique<ScannerThread>(frequency_list);
+	scan_thread = std::make_unique<ScannerThread>(std::move(hop_plan));
 }
 
 void ScannerView::on_statistics_update(const ChannelStatistics& statistics) {
@@ -30,7 +30,7 @@ namespace ui {
 
 class ScannerThread {
 public:
-	ScannerThread(std::vector<rf::Frequency> frequency_list);
+	ScannerThread(std::vector<radio::HopEntry> hop_plan);
 	~ScannerThread();
 	
 	void set_scanning(const bool v);
@@ -41,7 +41,7 @@ public:
 	ScannerThread& operator=(ScannerThread&&) = delete;
 
 private:
-	std::vector<rf::Frequency> frequency_list_ { };
+	std::vector<radio::HopEntry> hop_plan_ { };
 	Thread* thread { nullptr };
 	
 	bool _scanning { true };
@@ -130,20 +130,15 @@ private:
 	
 	std::unique_ptr<ScannerThread> scan_thread { };
 	
-	MessageHandlerRegistration message_handler_retune {
-		Message::ID::Retune,
-		[this](const Message* const p) {
-			const auto message = *reinterpret_cast<const RetuneMessage*>(p);
-			this->handle_retune(message.range);
-		}
-	};
+	void on_retune_message(const RetuneMessage* const message) {
+		handle_retune(message->range);
+	}
+	MessageHandler<RetuneMessage, ScannerView, &ScannerView::on_retune_message> message_handler_retune { this };
 	
-	MessageHandlerRegistration message_handler_stats {
-		Message::ID::ChannelStatistics,
-		[this](const Message* const p) {
-			this->on_statistics_update(static_cast<const ChannelStatisticsMessage*>(p)->statistics);
-		}
-	};
+	void on_stats_message(const ChannelStatisticsMessage* const message) {
+		on_statistics_update(message->statistics);
+	}
+	MessageHandler<ChannelStatisticsMessage, ScannerView, &ScannerView::on_stats_message> message_handler_stats { this };
 };
 
 } /* namespace ui */
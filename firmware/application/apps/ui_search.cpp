@@ -36,16 +36,16 @@ void RecentEntriesTable<SearchRecentEntries>::draw(
 	Painter& painter,
 	const Style& style
 ) {
-	std::string str_duration = "";
+	FixedString<40> line;
+	line.short_freq(entry.frequency).append(' ').append(entry.time).append(' ');
 	
 	if (entry.duration < 600)
-		str_duration = to_string_dec_uint(entry.duration / 10) + "." + to_string_dec_uint(entry.duration % 10) + "s";
+		line.dec_uint(entry.duration / 10).append('.').dec_uint(entry.duration % 10).append('s');
 	else
-		str_duration = to_string_dec_uint(entry.duration / 600) + "m" + to_string_dec_uint((entry.duration / 10) % 60) + "s";
-		
-	str_duration.resize(target_rect.width() / 8, ' ');
+		line.dec_uint(entry.duration / 600).append('m').dec_uint((entry.duration / 10) % 60).append('s');
 	
-	painter.draw_string(target_rect.location(), style, to_string_short_freq(entry.frequency) + " " + entry.time + " " + str_duration);
+	line.resize(target_rect.width() / 8, ' ');
+	painter.draw_string(target_rect.location(), style, line.c_str());
 }
 
 void SearchView::focus() {
@@ -227,7 +227,7 @@ void SearchView::on_channel_spectrum(const ChannelSpectrum& spectrum) {
 			slice_counter = 0;
 		} else
 			slice_counter++;
-		receiver_model.set_tuning_frequency(slices[slice_counter].center_frequency);
+		radio::set_tuning(slices[slice_counter].hop);
 		baseband::set_spectrum(SEARCH_SLICE_WIDTH, 31);	// Clear
 	} else {
 		// Unique slice
@@ -273,6 +273,7 @@ void SearchView::on_range_changed() {
 		
 		for (slice = 0; slice < slices_nb; slice++) {
 			slices[slice].center_frequency = center_frequency;
+			slices[slice].hop = receiver_model.hop_entry(center_frequency);
 			center_frequency += SEARCH_SLICE_WIDTH;
 		}
 	} else {
@@ -421,11 +422,12 @@ SearchView::SearchView(
 	};
 	
 	progress_timers.set_max(DETECT_DELAY);
-	
-	on_range_changed();
 
 	receiver_model.set_modulation(ReceiverModel::Mode::SpectrumAnalysis);
 	receiver_model.set_sampling_rate(SEARCH_SLICE_WIDTH);
+	
+	// Hop plan uses the tuning offset of the mode set above
+	on_range_changed();
 	receiver_model.set_baseband_bandwidth(2500000);
 	receiver_model.enable();
 }
@@ -106,6 +106,7 @@ private:
 	
 	struct slice_t {
 		rf::Frequency center_frequency;
+		radio::HopEntry hop;
 		uint8_t max_power;
 		int16_t max_index;
 		uint8_t power;
@@ -226,25 +227,20 @@ private:
 		0
 	};
 	
-	MessageHandlerRegistration message_handler_spectrum_config {
-		Message::ID::ChannelSpectrumConfig,
-		[this](const Message* const p) {
-			const auto message = *reinterpret_cast<const ChannelSpectrumConfigMessage*>(p);
-			this->fifo = message.fifo;
-		}
-	};
-	MessageHandlerRegistration message_handler_frame_sync {
-		Message::ID::DisplayFrameSync,
-		[this](const Message* const) {
-			if( this->fifo ) {
-				ChannelSpectrum channel_spectrum;
-				while( fifo->out(channel_spectrum) ) {
-					this->on_channel_spectrum(channel_spectrum);
-				}
+	void on_spectrum_config_message(const ChannelSpectrumConfigMessage* const message) {
+		fifo = message->fifo;
+	}
+	MessageHandler<ChannelSpectrumConfigMessage, SearchView, &SearchView::on_spectrum_config_message> message_handler_spectrum_config { this };
+	void on_frame_sync_message(const DisplayFrameSyncMessage* const) {
+		if( fifo ) {
+			ChannelSpectrum channel_spectrum;
+			while( fifo->out(channel_spectrum) ) {
+				on_channel_spectrum(channel_spectrum);
 			}
-			this->do_timers();
 		}
-	};
+		do_timers();
+	}
+	MessageHandler<DisplayFrameSyncMessage, SearchView, &SearchView::on_frame_sync_message> message_handler_frame_sync { this };
 };
 
 } /* namespace ui */
@@ -33,24 +33,79 @@ void SondeLogger::on_packet(const sonde::Packet& packet) {
 	log_file.write_entry(packet.received_at(), formatted.data);
 }
 
+const SondeRecentEntry::Key SondeRecentEntry::invalid_key = 0;
+
+void SondeRecentEntry::update(const sonde::Packet& packet) {
+	received_count++;
+	
+	type = packet.type();
+	serial = packet.serial_number();
+	corrected = packet.corrected();
+	battery_voltage = packet.battery_voltage();
+	
+	if (packet.GPS_valid()) {
+		has_position = true;
+		altitude = packet.GPS_altitude();
+		latitude = packet.GPS_latitude();
+		longitude = packet.GPS_longitude();
+	}
+}
+
 namespace ui {
 
+template<>
+void RecentEntriesTable<SondeRecentEntries>::draw(
+	const Entry& entry,
+	const Rect& target_rect,
+	Painter& painter,
+	const Style& style
+) {
+	FixedString<32> line;
+	line.append(entry.serial).resize(11);
+	
+	switch (entry.type) {
+		case sonde::Packet::Type::Meteomodem_M10:	line.append(" M10 "); break;
+		case sonde::Packet::Type::Meteomodem_M2K2:	line.append(" M2K2"); break;
+		case sonde::Packet::Type::Vaisala_RS41_SG:	line.append(" RS41"); break;
+		default:									line.append(" ?   "); break;
+	}
+	
+	if (entry.has_position) {
+		line.append(' ').dec_int(entry.altitude, 5);
+	} else {
+		line.append(" " "     ");
+	}
+	
+	if (entry.received_count > 999) {
+		line.append(" +++");
+	} else {
+		line.append(' ').dec_uint(entry.received_count, 3);
+	}
+	
+	if (entry.type == sonde::Packet::Type::Meteomodem_M2K2) {
+		line.append("   ?");		// Not checked
+	} else if (entry.corrected < 0) {
+		line.append("   -");
+	} else {
+		line.append(' ').dec_uint(entry.corrected, 3);
+	}
+	
+	line.resize(target_rect.width() / 8, ' ');
+	painter.draw_string(target_rect.location(), style, line.c_str());
+}
+
 SondeView::SondeView(NavigationView& nav) {
 	baseband::run_image(portapack::spi_flash::image_tag_sonde);
 
 	add_children({
-		&labels,
 		&field_frequency,
 		&field_rf_amp,
 		&field_lna,
 		&field_vga,
 		&rssi,
 		&check_log,
-		&text_signature,
-		&text_serial,
-		&text_voltage,
-		&geopos,
-		&button_see_map
+		&text_frames,
+		&recent_entries_view
 	});
 
 	field_frequency.set_value(target_frequency_);
@@ -68,8 +123,6 @@ SondeView::SondeView(NavigationView& nav) {
 		};
 	};
 	
-	geopos.set_read_only(true);
-	
 	check_log.on_select = [this](Checkbox&, bool v) {
 		logging = v;
 	};
@@ -84,14 +137,8 @@ SondeView::SondeView(NavigationView& nav) {
 		static_cast<int8_t>(receiver_model.vga()),
 	});
 
-	button_see_map.on_select = [this, &nav](Button&) {
-		nav.push<GeoMapView>(
-			"",
-			altitude,
-			GeoPos::alt_unit::METERS,
-			latitude,
-			longitude,
-			0);
+	recent_entries_view.on_select = [this, &nav](const SondeRecentEntry& entry) {
+		on_select(nav, entry);
 	};
 	
 	logger = std::make_unique<SondeLogger>();
@@ -109,27 +156,61 @@ void SondeView::focus() {
 	field_vga.focus();
 }
 
+void SondeView::set_parent_rect(const Rect new_parent_rect) {
+	View::set_parent_rect(new_parent_rect);
+	recent_entries_view.set_parent_rect({ 0, header_height, new_parent_rect.width(), new_parent_rect.height() - header_height });
+}
+
 void SondeView::on_packet(const sonde::Packet& packet) {
-	//const auto hex_formatted = packet.symbols_formatted();
+	if (logger && logging) {
+		logger->on_packet(packet);
+	}
 	
-	text_signature.set(packet.type_string());
-	text_serial.set(packet.serial_number());
-	text_voltage.set(unit_auto_scale(packet.battery_voltage(), 2, 3) + "V");
+	frames_received++;
 	
-	altitude = packet.GPS_altitude();
-	latitude = packet.GPS_latitude();
-	longitude = packet.GPS_longitude();
+	// Frames that fail their checks even after repair aren't tracked: a
+	// corrupted serial number would show up as another sonde. M2K2 frames
+	// can't be checked, and share one row as before.
+	const auto key = packet.serial_key();
 	
-	geopos.set_altitude(altitude);
-	geopos.set_lat(latitude);
-	geopos.set_lon(longitude);
+	// One time in 50 a repaired M10 frame has two errors and was miscorrected:
+	// it can update a sonde already seen, but not add one
+	const bool new_from_repair = (packet.type() == sonde::Packet::Type::Meteomodem_M10) &&
+		(packet.corrected() > 0) && (recent.find(key) == std::end(recent));
 	
-	if (logger && logging) {
-		logger->on_packet(packet);
+	if ((key != SondeRecentEntry::invalid_key) && !new_from_repair) {
+		if (packet.corrected() > 0)
+			frames_corrected++;
+		
+		auto& entry = ::on_packet(recent, key);
+		entry.update(packet);
+		recent_entries_view.set_dirty();
+		
+		if (geomap_view && (key == tracked_key) && entry.has_position)
+			geomap_view->update_position(entry.latitude, entry.longitude);
 	}
 	
-	/*if( packet.crc_ok() ) {
-	}*/
+	text_frames.set(
+		"Frames:" + to_string_dec_uint(frames_received) +
+		" FEC:" + to_string_dec_uint(frames_corrected)
+	);
+}
+
+void SondeView::on_select(NavigationView& nav, const SondeRecentEntry& entry) {
+	if (!entry.has_position)
+		return;
+	
+	tracked_key = entry.key();
+	geomap_view = nav.push<GeoMapView>(
+		entry.serial,
+		entry.altitude,
+		GeoPos::alt_unit::METERS,
+		entry.latitude,
+		entry.longitude,
+		0,
+		[this]() {
+			geomap_view = nullptr;
+		});
 }
 
 void SondeView::set_target_frequency(const uint32_t new_value) {
@@ -31,12 +31,46 @@
 #include "event_m0.hpp"
 
 #include "log_file.hpp"
+#include "recent_entries.hpp"
 
 #include "sonde_packet.hpp"
 
 #include <cstddef>
 #include <string>
 
+/* One sonde, tracked by serial number: several can share a channel */
+struct SondeRecentEntry {
+	using Key = uint64_t;
+	
+	static const Key invalid_key;
+	
+	Key serial_key { invalid_key };
+	sonde::Packet::Type type { sonde::Packet::Type::Unknown };
+	std::string serial { };
+	size_t received_count { 0 };
+	int corrected { 0 };
+	uint32_t battery_voltage { 0 };
+	
+	bool has_position { false };
+	int32_t altitude { 0 };
+	float latitude { 0 };
+	float longitude { 0 };
+	
+	SondeRecentEntry(
+		const Key& key
+	) : serial_key { key }
+	{
+	}
+	
+	Key key() const {
+		return serial_key;
+	}
+	
+	void update(const sonde::Packet& packet);
+};
+
+using SondeRecentEntries = RecentEntries<SondeRecentEntry, 16>;
+
 class SondeLogger {
 public:
 	Optional<File::Error> append(const std::filesystem::path& filename) {
@@ -51,6 +85,8 @@ private:
 
 namespace ui {
 
+using SondeRecentEntriesView = RecentEntriesView<SondeRecentEntries>;
+
 class SondeView : public View {
 public:
 	static constexpr uint32_t sampling_rate = 2457600;
@@ -59,23 +95,26 @@ public:
 	SondeView(NavigationView& nav);
 	~SondeView();
 
+	void set_parent_rect(const Rect new_parent_rect) override;
+	
 	void focus() override;
 
 	std::string title() const override { return "Radiosonde RX"; };
 
 private:
+	static constexpr ui::Dim header_height = 2 * 16 + 8;
+	
 	std::unique_ptr<SondeLogger> logger { };
 	uint32_t target_frequency_ { 402000000 };
 	bool logging { false };
-	int32_t altitude { 0 };
-	float latitude { 0 };
-	float longitude { 0 };
+	uint32_t frames_received { 0 };
+	uint32_t frames_corrected { 0 };
 	
-	Labels labels {
-		{ { 0 * 8, 2 * 16 }, "Signature:", Color::light_grey() },
-		{ { 3 * 8, 3 * 16 }, "Serial:", Color::light_grey() },
-		{ { 4 * 8, 4 * 16 }, "Vbatt:", Color::light_grey() }
-	};
+	SondeRecentEntries recent { };
+	
+	// The map follows the sonde it was opened for
+	GeoMapView* geomap_view { nullptr };
+	SondeRecentEntry::Key tracked_key { SondeRecentEntry::invalid_key };
 
 	FrequencyField field_frequency {
 		{ 0 * 8, 0 * 8 },
@@ -97,44 +136,33 @@ private:
 	};
 	
 	Checkbox check_log {
-		{ 22 * 8, 3 * 16 },
+		{ 0 * 8, 1 * 16 },
 		3,
 		"Log"
 	};
 	
-	Text text_signature {
-		{ 10 * 8, 2 * 16, 10 * 8, 16 },
-		"..."
-	};
-	Text text_serial {
-		{ 10 * 8, 3 * 16, 11 * 8, 16 },
-		"..."
-	};
-	Text text_voltage {
-		{ 10 * 8, 4 * 16, 10 * 8, 16 },
-		"..."
-	};
-	
-	GeoPos geopos {
-		{ 0, 6 * 16 },
-		GeoPos::alt_unit::METERS
+	Text text_frames {
+		{ 8 * 8, 1 * 16 + 4, 22 * 8, 16 },
+		""
 	};
 	
-	Button button_see_map {
-		{ 8 * 8, 10 * 16, 14 * 8, 3 * 16 },
-		"See on map"
-	};
-
-	MessageHandlerRegistration message_handler_packet {
-		Message::ID::SondePacket,
-		[this](Message* const p) {
-			const auto message = static_cast<const SondePacketMessage*>(p);
-			const sonde::Packet packet { message->packet, message->type };
-			this->on_packet(packet);
-		}
-	};
+	const RecentEntriesColumns columns { {
+		{ "Serial", 11 },
+		{ "Type", 4 },
+		{ "Alt", 5 },
+		{ "Cnt", 3 },
+		{ "FEC", 3 },
+	} };
+	SondeRecentEntriesView recent_entries_view { columns, recent };
+
+	void on_packet_message(const SondePacketMessage* const message) {
+		const sonde::Packet packet { message->packet, message->type };
+		on_packet(packet);
+	}
+	MessageHandler<SondePacketMessage, SondeView, &SondeView::on_packet_message> message_handler_packet { this };
 
 	void on_packet(const sonde::Packet& packet);
+	void on_select(NavigationView& nav, const SondeRecentEntry& entry);
 	void set_target_frequency(const uint32_t new_value);
 	uint32_t tuning_frequency() const;
 };
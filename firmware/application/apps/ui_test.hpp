@@ -115,14 +115,11 @@ private:
 	
 	std::unique_ptr<TestLogger> logger { };
 
-	MessageHandlerRegistration message_handler_packet {
-		Message::ID::TestAppPacket,
-		[this](Message* const p) {
-			const auto message = static_cast<const TestAppPacketMessage*>(p);
-			const testapp::Packet packet { message->packet };
-			this->on_packet(packet);
-		}
-	};
+	void on_packet_message(const TestAppPacketMessage* const message) {
+		const testapp::Packet packet { message->packet };
+		on_packet(packet);
+	}
+	MessageHandler<TestAppPacketMessage, TestView, &TestView::on_packet_message> message_handler_packet { this };
 
 	void on_packet(const testapp::Packet& packet);
 	void set_target_frequency(const uint32_t new_value);
@@ -147,12 +147,10 @@ private:
 
 	void on_frame_sync();
 
-	MessageHandlerRegistration message_handler_frame_sync {
-		Message::ID::DisplayFrameSync,
-		[this](const Message* const) {
-			this->on_frame_sync();
-		}
-	};
+	void on_frame_sync_message(const DisplayFrameSyncMessage* const) {
+		on_frame_sync();
+	}
+	MessageHandler<DisplayFrameSyncMessage, TouchCalibrationView, &TouchCalibrationView::on_frame_sync_message> message_handler_frame_sync { this };
 };
 
 } /* namespace ui */
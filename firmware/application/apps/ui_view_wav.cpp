@@ -36,17 +36,37 @@ void ViewWavView::update_scale(int32_t new_scale) {
 	refresh_measurements();
 }
 
+void ViewWavView::refresh_overview() {
+	const uint32_t samples_per_pixel = (wav_reader->sample_count() + 239) / 240;
+	
+	if (samples_per_pixel && peaks.read(0, samples_per_pixel, peak_buffer, 240)) {
+		// 0~127 amplitude
+		for (size_t i = 0; i < 240; i++)
+			amplitude_buffer[i] = std::min(127, std::max(-peak_buffer[i].min, (int)peak_buffer[i].max));
+	} else {
+		memset(amplitude_buffer, 0, sizeof(amplitude_buffer));
+	}
+	
+	text_status.set(peaks.is_building() ? "Building overview..." : "");
+	set_dirty();
+}
+
 void ViewWavView::refresh_waveform() {
+	// Too far zoomed out to read directly until the index is built
+	if (!peaks.read(position, scale, peak_buffer, 240))
+		memset(peak_buffer, 0, sizeof(peak_buffer));
+	
 	for (size_t i = 0; i < 240; i++) {
-		wav_reader->data_seek(position + (i * scale));
-		wav_reader->read(&waveform_buffer[i], sizeof(int16_t));
+		waveform_buffer[i * 2] = peak_buffer[i].min << 8;
+		waveform_buffer[i * 2 + 1] = peak_buffer[i].max << 8;
 	}
 	
 	waveform.set_dirty();
 	
 	// Window
-	uint64_t w_start = (position * 240) / wav_reader->sample_count();
-	uint64_t w_width = (scale * 240) / (wav_reader->sample_count() / 240);
+	const uint64_t sample_count = std::max<uint64_t>(1, wav_reader->sample_count());
+	uint64_t w_start = std::min<uint64_t>((position * 240) / sample_count, 239);
+	uint64_t w_width = std::min<uint64_t>((scale * 240 * 240) / sample_count, 239 - w_start);
 	display.fill_rectangle({ 0, 10 * 16 + 1, 240, 16 }, Color::black());
 	display.fill_rectangle({ (Coord)w_start, 21 * 8, (Dim)w_width + 1, 8 }, Color::white());
 	display.draw_line({ 0, 10 * 16 + 1 }, { (Coord)w_start, 21 * 8 }, Color::white());
@@ -78,9 +98,8 @@ void ViewWavView::on_pos_changed() {
 }
 
 void ViewWavView::load_wav(std::filesystem::path file_path) {
-	int16_t sample;
-	uint32_t average;
-
+	peaks.close();
+	
 	if (!wav_reader->open(file_path)) {
 		nav_.display_modal("Error", "Couldn't open file.", INFO, nullptr);
 		return;
@@ -100,27 +119,16 @@ void ViewWavView::load_wav(std::filesystem::path file_path) {
 	text_samplerate.set(to_string_dec_uint(wav_reader->sample_rate()) + "Hz");
 	text_title.set(wav_reader->title());
 	
-	// Fill amplitude buffer, world's worst downsampling
-	uint64_t skip = wav_reader->sample_count() / (240 * subsampling_factor);
-	
-	for (size_t i = 0; i < 240; i++) {
-		average = 0;
-		
-		for (size_t s = 0; s < subsampling_factor; s++) {
-			wav_reader->data_seek(((i * subsampling_factor) + s) * skip);
-			wav_reader->read(&sample, 2);
-			average += (abs(sample) >> 8);
-		}
-		
-		amplitude_buffer[i] = average / subsampling_factor;
-	}
+	// Peaks come from the sidecar index, which is built in the background the first time
+	peaks.open(file_path, { wav_reader->data_offset(), wav_reader->sample_count(), peak_index::Format::S16 });
+	refresh_overview();
 	
 	reset_controls();
 	update_scale(1);
 }
 
 void ViewWavView::reset_controls() {
-	field_scale.set_value(1);
+	field_scale.set_selected_index(0);
 	field_pos_seconds.set_value(0);
 	field_pos_samples.set_value(0);
 	field_cursor_a.set_value(0);
@@ -139,6 +147,7 @@ ViewWavView::ViewWavView(
 		&text_samplerate,
 		&text_title,
 		&text_duration,
+		&text_status,
 		&button_open,
 		&waveform,
 		&field_pos_seconds,
@@ -157,7 +166,12 @@ ViewWavView::ViewWavView(
 		};
 	};
 	
-	field_scale.on_change = [this](int32_t value) {
+	OptionsField::options_t scales;
+	for (uint32_t s = 1; s <= 262144; s <<= 1)
+		scales.emplace_back((s < 1024) ? to_string_dec_uint(s, 4) : to_string_dec_uint(s >> 10, 3) + "K", s);
+	field_scale.set_options(scales);
+	
+	field_scale.on_change = [this](size_t, OptionsField::value_t value) {
 		update_scale(value);
 	};
 	field_pos_seconds.on_change = [this](int32_t) {
@@ -23,6 +23,7 @@
 #include "ui.hpp"
 #include "ui_navigation.hpp"
 #include "io_wave.hpp"
+#include "peak_index.hpp"
 #include "spectrum_color_lut.hpp"
 
 namespace ui {
@@ -38,9 +39,9 @@ public:
 
 private:
 	NavigationView& nav_;
-	static constexpr uint32_t subsampling_factor = 8;
 	
 	void update_scale(int32_t new_scale);
+	void refresh_overview();
 	void refresh_waveform();
 	void refresh_measurements();
 	void on_pos_changed();
@@ -48,8 +49,11 @@ private:
 	void reset_controls();
 
 	std::unique_ptr<WAVFileReader> wav_reader { };
+	peak_index::Reader peaks { };
+	peak_index::Peak peak_buffer[240] { };
 	
-	int16_t waveform_buffer[240] { };
+	// Min and max of each column, the line zig-zagging between them
+	int16_t waveform_buffer[480] { };
 	uint8_t amplitude_buffer[240] { };
 	int32_t scale { 1 };
 	uint64_t ns_per_pixel { };
@@ -60,7 +64,7 @@ private:
 		{ { 0 * 8, 1 * 16 }, "Samplerate:", Color::light_grey() },
 		{ { 0 * 8, 2 * 16 }, "Title:", Color::light_grey() },
 		{ { 0 * 8, 3 * 16 }, "Duration:", Color::light_grey() },
-		{ { 0 * 8, 11 * 16 }, "Position:   s         Scale:", Color::light_grey() },
+		{ { 0 * 8, 11 * 16 }, "Position:   s       Scale:", Color::light_grey() },
 		{ { 0 * 8, 12 * 16 }, "Cursor A:", Color::dark_cyan() },
 		{ { 0 * 8, 13 * 16 }, "Cursor B:", Color::dark_magenta() },
 		{ { 0 * 8, 14 * 16 }, "Delta:", Color::light_grey() }
@@ -82,6 +86,10 @@ private:
 		{ 9 * 8, 3 * 16, 18 * 8, 16 },
 		""
 	};
+	Text text_status {
+		{ 0 * 8, 4 * 16, 30 * 8, 16 },
+		""
+	};
 	Button button_open {
 		{ 24 * 8, 8, 6 * 8, 2 * 16 },
 		"Open"
@@ -90,7 +98,7 @@ private:
 	Waveform waveform {
 		{ 0, 5 * 16, 240, 64 },
 		waveform_buffer,
-		240,
+		480,
 		0,
 		false,
 		Color::white()
@@ -110,12 +118,11 @@ private:
 		1,
 		'0'
 	};
-	NumberField field_scale {
-		{ 28 * 8, 11 * 16 },
-		2,
-		{ 1, 40 },
-		1,
-		' '
+	// Samples per pixel
+	OptionsField field_scale {
+		{ 26 * 8, 11 * 16 },
+		4,
+		{ }
 	};
 	
 	NumberField field_cursor_a {
@@ -140,6 +147,13 @@ private:
 		{ 6 * 8, 14 * 16, 30 * 8, 16 },
 		"-"
 	};
+
+	void on_peak_index_done_message(const PeakIndexDoneMessage* const message) {
+		peaks.index_done(message->success);
+		refresh_overview();
+		refresh_waveform();
+	}
+	MessageHandler<PeakIndexDoneMessage, ViewWavView, &ViewWavView::on_peak_index_done_message> message_handler_peak_index_done { this };
 };
 
 } /* namespace ui */
@@ -35,12 +35,26 @@ using namespace portapack;
 
 namespace baseband {
 
+static BSEMAPHORE_DECL(message_ack, TRUE);
+
 static void send_message(const Message* const message) {
 	// If message is only sent by this function via one thread, no need to check if
 	// another message is present before setting new message.
 	shared_memory.baseband_message = message;
 	creg::m0apptxevent::assert();
-	while(shared_memory.baseband_message);
+
+	// Sleep until the M4 acknowledges via m4txevent instead of spinning. The
+	// timeout covers the periods where the M4Core interrupt is disabled
+	// (before run_image() completes and during shutdown()).
+	while(shared_memory.baseband_message) {
+		chBSemWaitTimeout(&message_ack, 1);
+	}
+}
+
+void message_ack_isr() {
+	if( !shared_memory.baseband_message ) {
+		chBSemSignalI(&message_ack);
+	}
 }
 
 void AMConfig::apply() const {
@@ -56,7 +70,7 @@ void AMConfig::apply() const {
 	audio::set_rate(audio::Rate::Hz_12000);
 }
 
-void NBFMConfig::apply(const uint8_t squelch_level) const {
+void NBFMConfig::apply(const uint8_t squelch_level, const uint32_t tone_squelch) const {
 	const NBFMConfigureMessage message {
 		decim_0,
 		decim_1,
@@ -65,7 +79,8 @@ void NBFMConfig::apply(const uint8_t squelch_level) const {
 		deviation,
 		audio_24k_hpf_300hz_config,
 		audio_24k_deemph_300_6_config,
-		squelch_level
+		squelch_level,
+		tone_squelch
 	};
 	send_message(&message);
 	audio::set_rate(audio::Rate::Hz_24000);
@@ -120,12 +135,11 @@ void set_sstv_data(const uint8_t vis_code, const uint32_t pixel_duration) {
 	send_message(&message);
 }
 
-void set_afsk(const uint32_t baudrate, const uint32_t word_length, const uint32_t trigger_value, const bool trigger_word) {
+void set_afsk(const uint32_t baudrate, const uint32_t word_length, const bool ax25) {
 	const AFSKRxConfigureMessage message {
 		baudrate,
 		word_length,
-		trigger_value,
-		trigger_word
+		ax25
 	};
 	send_message(&message);
 }
@@ -140,12 +154,12 @@ void set_btle(const uint32_t baudrate, const uint32_t word_length, const uint32_
 	send_message(&message);
 }
 
-void set_nrf(const uint32_t baudrate, const uint32_t word_length, const uint32_t trigger_value, const bool trigger_word) {
+void set_nrf(const nrf24::DataRate data_rate, const size_t address_count, const std::array<nrf24::Address, nrf24::addresses_max>& addresses, const uint32_t crc_width) {
 	const NRFRxConfigureMessage message {
-		baudrate,
-		word_length,
-		trigger_value,
-		trigger_word
+		data_rate,
+		address_count,
+		addresses,
+		crc_width
 	};
 	send_message(&message);
 }
@@ -177,13 +191,14 @@ void kill_afsk() {
 }
 
 void set_audiotx_config(const uint32_t divider, const float deviation_hz, const float audio_gain,
-					const uint32_t tone_key_delta) {
+					const uint32_t tone_key_delta, const uint8_t bits_per_sample) {
 	const AudioTXConfigMessage message {
 		divider,
 		deviation_hz,
 		audio_gain,
 		tone_key_delta,
-		(float)persistent_memory::tone_mix() / 100.0f
+		(float)persistent_memory::tone_mix() / 100.0f,
+		bits_per_sample
 	};
 	send_message(&message);
 }
@@ -203,6 +218,14 @@ void set_pitch_rssi(int32_t avg, bool enabled) {
 	send_message(&message);	
 }
 
+void set_audio_processing(const bool agc, const bool noise_blanker) {
+	const AudioProcessingConfigMessage message {
+		agc,
+		noise_blanker
+	};
+	send_message(&message);
+}
+
 void set_ook_data(const uint32_t stream_length, const uint32_t samples_per_bit, const uint8_t repeat,
 					const uint32_t pause_symbols) {
 	const OOKConfigureMessage message {
@@ -214,6 +237,22 @@ void set_ook_data(const uint32_t stream_length, const uint32_t samples_per_bit,
 	send_message(&message);
 }
 
+void set_bitstream_tx(const BitstreamTXConfigMessage::Modulation modulation, const uint32_t samples_per_symbol,
+					const uint32_t shaping_samples, const uint32_t symbol_count, const uint32_t progress_symbols,
+					const uint32_t deviation_hz, const uint32_t mark_hz, const uint32_t space_hz) {
+	const BitstreamTXConfigMessage message {
+		modulation,
+		samples_per_symbol,
+		shaping_samples,
+		symbol_count,
+		progress_symbols,
+		deviation_hz,
+		mark_hz,
+		space_hz
+	};
+	send_message(&message);
+}
+
 void set_fsk_data(const uint32_t stream_length, const uint32_t samples_per_bit, const uint32_t shift,
 					const uint32_t progress_notice) {
 	const FSKConfigureMessage message {
@@ -277,6 +316,14 @@ void set_siggen_config(const uint32_t bw, const uint32_t shape, const uint32_t d
 	send_message(&message);
 }
 
+void set_pulse_config(const uint32_t decimation, const int32_t threshold_db, const uint32_t min_width,
+					const uint32_t max_width) {
+	const PulseConfigureMessage message {
+		decimation, threshold_db, min_width, max_width
+	};
+	send_message(&message);
+}
+
 static bool baseband_image_running = false;
 
 void run_image(const portapack::spi_flash::image_tag_t image_tag) {
@@ -292,11 +339,27 @@ void run_image(const portapack::spi_flash::image_tag_t image_tag) {
 	creg::m4txevent::enable();
 }
 
+static MemoryStatistics last_memory_statistics { };
+
+MemoryStatistics memory_statistics() {
+	if( baseband_image_running ) {
+		MemoryStatistics statistics { };
+		MemoryStatisticsMessage message { &statistics };
+		send_message(&message);
+		return statistics;
+	}
+	return last_memory_statistics;
+}
+
 void shutdown() {
 	if( !baseband_image_running ) {
 		return;
 	}
 
+	// Keep the image's high-water marks around for the debug view.
+	MemoryStatisticsMessage statistics_message { &last_memory_statistics };
+	send_message(&statistics_message);
+
 	creg::m4txevent::disable();
 
 	ShutdownMessage message;
@@ -48,7 +48,7 @@ struct NBFMConfig {
 	const fir_taps_real<32> channel;
 	const size_t deviation;
 
-	void apply(const uint8_t squelch_level) const;
+	void apply(const uint8_t squelch_level, const uint32_t tone_squelch) const;
 };
 
 struct WFMConfig {
@@ -61,17 +61,21 @@ void set_tones_config(const uint32_t bw, const uint32_t pre_silence, const uint1
 void kill_tone();
 void set_sstv_data(const uint8_t vis_code, const uint32_t pixel_duration);
 void set_audiotx_config(const uint32_t divider, const float deviation_hz, const float audio_gain,
-					const uint32_t tone_key_delta);
+					const uint32_t tone_key_delta, const uint8_t bits_per_sample = 8);
 void set_fifo_data(const int8_t * data);
 void set_pitch_rssi(int32_t avg, bool enabled);
+void set_audio_processing(const bool agc, const bool noise_blanker);
 void set_afsk_data(const uint32_t afsk_samples_per_bit, const uint32_t afsk_phase_inc_mark, const uint32_t afsk_phase_inc_space,
 					const uint8_t afsk_repeat, const uint32_t afsk_bw, const uint8_t symbol_count);
 void kill_afsk();
-void set_afsk(const uint32_t baudrate, const uint32_t word_length, const uint32_t trigger_value, const bool trigger_word);
+void set_afsk(const uint32_t baudrate, const uint32_t word_length, const bool ax25);
 void set_btle(const uint32_t baudrate, const uint32_t word_length, const uint32_t trigger_value, const bool trigger_word);
-void set_nrf(const uint32_t baudrate, const uint32_t word_length, const uint32_t trigger_value, const bool trigger_word);
+void set_nrf(const nrf24::DataRate data_rate, const size_t address_count, const std::array<nrf24::Address, nrf24::addresses_max>& addresses, const uint32_t crc_width);
 void set_ook_data(const uint32_t stream_length, const uint32_t samples_per_bit, const uint8_t repeat,
 					const uint32_t pause_symbols);
+void set_bitstream_tx(const BitstreamTXConfigMessage::Modulation modulation, const uint32_t samples_per_symbol,
+					const uint32_t shaping_samples, const uint32_t symbol_count, const uint32_t progress_symbols,
+					const uint32_t deviation_hz = 0, const uint32_t mark_hz = 0, const uint32_t space_hz = 0);
 void set_fsk_data(const uint32_t stream_length, const uint32_t samples_per_bit, const uint32_t shift,
 					const uint32_t progress_notice);
 void set_pocsag(const pocsag::BitRate bitrate, bool phase);
@@ -81,11 +85,22 @@ void set_rds_data(const uint16_t message_length);
 void set_spectrum(const size_t sampling_rate, const size_t trigger);
 void set_siggen_tone(const uint32_t tone);
 void set_siggen_config(const uint32_t bw, const uint32_t shape, const uint32_t duration);
+void set_pulse_config(const uint32_t decimation, const int32_t threshold_db, const uint32_t min_width,
+					const uint32_t max_width);
 void request_beep();
 
 void run_image(const portapack::spi_flash::image_tag_t image_tag);
 void shutdown();
 
+/* M4 heap and stack usage of the running baseband image or, if none is
+ * running, of the last one as it was shut down (valid is false before any
+ * image has run). */
+MemoryStatistics memory_statistics();
+
+/* Called from the M4Core interrupt to wake a sender waiting for the M4 to
+ * consume its message. */
+void message_ack_isr();
+
 void spectrum_streaming_start();
 void spectrum_streaming_stop();
 
@@ -0,0 +1,395 @@
+/*
+ * Copyright (C) 2026 agent
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "capture_index.hpp"
+
+#include "string_format.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+namespace capture_index {
+
+static constexpr uint8_t magic[4] { 'P', 'P', 'C', 'X' };
+static constexpr uint8_t version = 1;
+/* Active blocks peak at least 12dB over the quietest one. */
+static constexpr uint32_t active_ratio = 4;
+
+std::filesystem::path index_path(const std::filesystem::path& path) {
+	auto result = path;
+	result.replace_extension(u".IDX");
+	return result;
+}
+
+std::filesystem::path meta_path(const std::filesystem::path& path) {
+	auto result = path;
+	result.replace_extension(u".sigmf-meta");
+	return result;
+}
+
+/* to_string_dec_uint() stops at 32 bits, center frequencies go past 4.2GHz. */
+static std::string to_string_frequency(const uint64_t f) {
+	if( f < 1000000 ) {
+		return to_string_dec_uint(f);
+	}
+	return to_string_dec_uint(f / 1000000) + to_string_dec_uint(f % 1000000, 6, '0');
+}
+
+static uint8_t clamp_gain(const int32_t db) {
+	return std::min<int32_t>(std::max<int32_t>(db, 0), 255);
+}
+
+static uint16_t block_peak(const void* const buffer, const File::Size bytes) {
+	const auto p = static_cast<const int16_t*>(buffer);
+	int32_t peak = 0;
+	for(size_t i=0; i<bytes / sizeof(int16_t); i++) {
+		peak = std::max(peak, std::abs(static_cast<int32_t>(p[i])));
+	}
+	return peak;
+}
+
+/* Writer ***************************************************************/
+
+Writer::~Writer() {
+	if( created ) {
+		flush();
+		header.complete = 1;
+		if( header.entry_count == 0 ) {
+			header.peak_min = 0;
+		}
+		if( index.seek(0).is_ok() ) {
+			index.write(&header, sizeof(header));
+		}
+	}
+}
+
+Optional<File::Error> Writer::create(std::filesystem::path base_path, const Capture& capture) {
+	rtc::RTC datetime;
+	rtcGetTime(&RTCD1, &datetime);
+
+	memcpy(header.magic, magic, sizeof(magic));
+	header.version = version;
+	header.complete = 0;
+	header.lna_db = clamp_gain(capture.lna_db);
+	header.vga_db = clamp_gain(capture.vga_db);
+	header.rf_amp = capture.rf_amp;
+	header.start_year = datetime.year();
+	header.start_month = datetime.month();
+	header.start_day = datetime.day();
+	header.start_hour = datetime.hour();
+	header.start_minute = datetime.minute();
+	header.start_second = datetime.second();
+	header.center_frequency = capture.center_frequency;
+	header.sample_rate = capture.sample_rate;
+	header.entry_count = 0;
+	header.peak_min = 0xffff;
+	header.peak_max = 0;
+	header.reserved = 0;
+
+	const auto data_path = base_path.replace_extension(u".C16");
+	const auto data_error = data.create(data_path);
+	if( data_error.is_valid() ) {
+		return data_error;
+	}
+
+	const auto meta_error = write_meta(meta_path(data_path), data_path.filename());
+	if( meta_error.is_valid() ) {
+		return meta_error;
+	}
+
+	const auto index_error = index.create(index_path(data_path));
+	if( index_error.is_valid() ) {
+		return index_error;
+	}
+	const auto header_result = index.write(&header, sizeof(header));
+	if( header_result.is_error() ) {
+		return header_result.error();
+	}
+
+	created = true;
+	start_time = chTimeNow();
+	return { };
+}
+
+File::Result<File::Size> Writer::write(const void* const buffer, const File::Size bytes) {
+	if( bytes == 0 ) {
+		// Empty end of a triggered segment, nothing to index.
+		return File::Size { 0 };
+	}
+
+	// Time taken before the write, so it marks when the block arrived.
+	// 64-bit, as ticks * 1000 wraps 32 bits after 71 minutes at 1kHz.
+	const uint64_t elapsed_ticks = chTimeNow() - start_time;
+	const auto time_ms = static_cast<uint32_t>(elapsed_ticks * 1000 / CH_FREQUENCY);
+
+	const auto write_result = data.write(buffer, bytes);
+	if( write_result.is_error() ) {
+		// No entry for samples that never made it to the card.
+		return write_result;
+	}
+
+	const auto peak = block_peak(buffer, bytes);
+	entries[entries_buffered++] = {
+		sample_offset,
+		time_ms,
+		peak,
+		0
+	};
+	sample_offset += bytes / bytes_per_sample;
+	header.entry_count++;
+	header.peak_min = std::min(header.peak_min, peak);
+	header.peak_max = std::max(header.peak_max, peak);
+
+	if( entries_buffered == entries.size() ) {
+		const auto flush_error = flush();
+		if( flush_error.is_valid() ) {
+			return flush_error.value();
+		}
+	}
+
+	return write_result;
+}
+
+Optional<File::Error> Writer::flush() {
+	if( entries_buffered == 0 ) {
+		return { };
+	}
+
+	const auto write_result = index.write(entries.data(), entries_buffered * sizeof(Entry));
+	entries_buffered = 0;
+	if( write_result.is_error() ) {
+		return write_result.error();
+	}
+	return { };
+}
+
+Optional<File::Error> Writer::write_meta(const std::filesystem::path& path, const std::filesystem::path& dataset) {
+	// On the heap: in triggered mode this runs on the capture thread, under
+	// FATFS's long file name buffer.
+	auto meta = std::make_unique<File>();
+	const auto create_error = meta->create(path);
+	if( create_error.is_valid() ) {
+		return create_error;
+	}
+
+	// Written a line at a time so only one string is alive at once.
+	Optional<File::Error> error { };
+	const auto line = [&meta, &error](const std::string& s) {
+		if( !error.is_valid() ) {
+			error = meta->write_line(s);
+		}
+	};
+
+	line("{");
+	line("  \"global\": {");
+	line("    \"core:datatype\": \"ci16_le\",");
+	line("    \"core:sample_rate\": " + to_string_dec_uint(header.sample_rate) + ",");
+	line("    \"core:version\": \"1.0.0\",");
+	line("    \"core:dataset\": \"" + dataset.string() + "\",");
+	line("    \"core:hw\": \"PortaPack\",");
+	line("    \"core:extensions\": [ { \"name\": \"portapack\", \"version\": \"1.0.0\", \"optional\": true } ],");
+	line("    \"portapack:lna_gain\": " + to_string_dec_uint(header.lna_db) + ",");
+	line("    \"portapack:vga_gain\": " + to_string_dec_uint(header.vga_db) + ",");
+	line(std::string("    \"portapack:rf_amp\": ") + (header.rf_amp ? "true" : "false") + ",");
+	line("    \"portapack:index\": \"" + index_path(dataset).string() + "\"");
+	line("  },");
+	line("  \"captures\": [");
+	// SigMF wants UTC, the RTC is assumed to be set to it.
+	line("    { \"core:sample_start\": 0, \"core:frequency\": " + to_string_frequency(header.center_frequency) +
+		", \"core:datetime\": \"" +
+		to_string_dec_uint(header.start_year, 4, '0') + "-" +
+		to_string_dec_uint(header.start_month, 2, '0') + "-" +
+		to_string_dec_uint(header.start_day, 2, '0') + "T" +
+		to_string_dec_uint(header.start_hour, 2, '0') + ":" +
+		to_string_dec_uint(header.start_minute, 2, '0') + ":" +
+		to_string_dec_uint(header.start_second, 2, '0') + "Z\" }");
+	line("  ],");
+	line("  \"annotations\": []");
+	line("}");
+
+	return error;
+}
+
+/* Reader ***************************************************************/
+
+bool Reader::open(const std::filesystem::path& path) {
+	close();
+
+	auto new_file = std::make_unique<File>();
+	if( new_file->open(path).is_valid() ) {
+		return false;
+	}
+
+	const auto read_result = new_file->read(&header_, sizeof(header_));
+	if( read_result.is_error() || (read_result.value() != sizeof(header_)) ||
+		(memcmp(header_.magic, magic, sizeof(magic)) != 0) ||
+		(header_.version != version) ) {
+		return false;
+	}
+
+	if( header_.complete ) {
+		const uint32_t floor = std::max<uint32_t>(header_.peak_min, 1);
+		active_peak = (header_.peak_max >= floor * active_ratio) ? std::min<uint32_t>(floor * active_ratio, 0xffff) : 0;
+	} else {
+		// Capture was cut short, count what made it to the card.
+		header_.entry_count = (new_file->size() - sizeof(header_)) / sizeof(Entry);
+		active_peak = 0;
+	}
+
+	file = std::move(new_file);
+	return true;
+}
+
+void Reader::close() {
+	file.reset();
+	header_ = { };
+	active_peak = 0;
+}
+
+Optional<Entry> Reader::entry(const uint32_t n) {
+	if( !file || (n >= header_.entry_count) ) {
+		return { };
+	}
+
+	Entry result;
+	if( file->seek(sizeof(header_) + static_cast<uint64_t>(n) * sizeof(Entry)).is_error() ) {
+		return { };
+	}
+	const auto read_result = file->read(&result, sizeof(result));
+	if( read_result.is_error() || (read_result.value() != sizeof(result)) ) {
+		return { };
+	}
+	return result;
+}
+
+Optional<uint32_t> Reader::find(const uint64_t sample) {
+	if( header_.entry_count == 0 ) {
+		return { };
+	}
+
+	// Offsets only grow, bisect for the last entry starting at or before sample.
+	uint32_t low = 0;
+	uint32_t high = header_.entry_count;
+	while( high - low > 1 ) {
+		const uint32_t middle = low + (high - low) / 2;
+		const auto e = entry(middle);
+		if( !e.is_valid() ) {
+			return { };
+		}
+		if( e.value().sample_offset <= sample ) {
+			low = middle;
+		} else {
+			high = middle;
+		}
+	}
+	return low;
+}
+
+Optional<uint32_t> Reader::next_active(uint32_t n) {
+	if( !file || (n >= header_.entry_count) ) {
+		return { };
+	}
+	if( file->seek(sizeof(header_) + static_cast<uint64_t>(n) * sizeof(Entry)).is_error() ) {
+		return { };
+	}
+
+	while( n < header_.entry_count ) {
+		const size_t count = std::min<uint32_t>(header_.entry_count - n, buffer.size());
+		const auto read_result = file->read(buffer.data(), count * sizeof(Entry));
+		if( read_result.is_error() || (read_result.value() != count * sizeof(Entry)) ) {
+			return { };
+		}
+
+		for(size_t i=0; i<count; i++, n++) {
+			if( is_active(buffer[i]) ) {
+				return n;
+			}
+		}
+	}
+
+	return { };
+}
+
+/* ActiveReader *********************************************************/
+
+Optional<File::Error> ActiveReader::open(const std::filesystem::path& path, const uint64_t offset) {
+	const auto open_error = file.open(path);
+	if( open_error.is_valid() ) {
+		return open_error;
+	}
+
+	if( !index.open(index_path(path)) ) {
+		return File::Error { FR_NO_FILE };
+	}
+
+	const auto start = index.find(offset / bytes_per_sample);
+	next_entry = start.is_valid() ? start.value() : 0;
+	position = 0;
+	block_end = 0;
+	return { };
+}
+
+bool ActiveReader::next_block() {
+	const auto active = index.next_active(next_entry);
+	if( !active.is_valid() ) {
+		return false;
+	}
+
+	const auto block = index.entry(active.value());
+	if( !block.is_valid() ) {
+		return false;
+	}
+	const auto following = index.entry(active.value() + 1);
+
+	next_entry = active.value() + 1;
+	position = block.value().sample_offset * bytes_per_sample;
+	block_end = following.is_valid() ? following.value().sample_offset * bytes_per_sample : file.size();
+
+	return file.seek(position).is_ok();
+}
+
+File::Result<File::Size> ActiveReader::read(void* const buffer, const File::Size bytes) {
+	const auto p = static_cast<uint8_t*>(buffer);
+	File::Size done = 0;
+
+	while( done < bytes ) {
+		if( (position >= block_end) && !next_block() ) {
+			// No active blocks left, reads as the end of the file.
+			break;
+		}
+
+		const File::Size count = std::min<uint64_t>(bytes - done, block_end - position);
+		const auto read_result = file.read(&p[done], count);
+		if( read_result.is_error() ) {
+			return read_result.error();
+		}
+		if( read_result.value() == 0 ) {
+			break;
+		}
+		done += read_result.value();
+		position += read_result.value();
+	}
+
+	return done;
+}
+
+} /* namespace capture_index */
@@ -0,0 +1,199 @@
+/*
+ * Copyright (C) 2026 agent
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __CAPTURE_INDEX_H__
+#define __CAPTURE_INDEX_H__
+
+#include "ch.h"
+
+#include "io.hpp"
+#include "file.hpp"
+#include "optional.hpp"
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <memory>
+
+/* Capture container for C16 recordings. Next to the sample file BBD_nnnn.C16
+ * the writer keeps:
+ * - BBD_nnnn.sigmf-meta, SigMF metadata pointing at the C16 file through
+ *   core:dataset, with receiver gains in a "portapack" extension.
+ * - BBD_nnnn.IDX, a header followed by one Entry per block written, giving
+ *   the block's sample offset, time since the start and peak level, so
+ *   replay can seek by time and skip quiet blocks without reading samples.
+ */
+namespace capture_index {
+
+constexpr size_t bytes_per_sample = 4;	// ci16_le: I and Q as int16
+
+struct header_t {
+	uint8_t magic[4];
+	uint8_t version;
+	uint8_t complete;			// Set on close, entry_count and peaks are final
+	uint8_t lna_db;
+	uint8_t vga_db;
+	uint8_t rf_amp;
+	uint8_t start_month;		// RTC when the capture was created
+	uint8_t start_day;
+	uint8_t start_hour;
+	uint8_t start_minute;
+	uint8_t start_second;
+	uint16_t start_year;
+	uint64_t center_frequency;
+	uint32_t sample_rate;
+	uint32_t entry_count;
+	uint16_t peak_min;			// Quietest and loudest block
+	uint16_t peak_max;
+	uint32_t reserved;
+};
+
+static_assert(sizeof(header_t) == 40, "header_t is a file format, keep it 40 bytes");
+
+struct Entry {
+	uint64_t sample_offset;		// First sample of the block in the C16 file
+	uint32_t time_ms;			// When the block was stored, since the start
+	uint16_t peak;				// max(|I|, |Q|) over the block
+	uint16_t reserved;
+};
+
+static_assert(sizeof(Entry) == 16, "Entry is a file format, keep it 16 bytes");
+
+struct Capture {
+	uint32_t sample_rate;
+	uint64_t center_frequency;
+	int32_t lna_db;
+	int32_t vga_db;
+	bool rf_amp;
+};
+
+std::filesystem::path index_path(const std::filesystem::path& path);
+std::filesystem::path meta_path(const std::filesystem::path& path);
+
+/* Writes the C16 file, one index entry per write(). Entries are buffered and
+ * stored a sector at a time. Closing rewrites the header as complete.
+ */
+class Writer : public stream::Writer {
+public:
+	Writer() = default;
+	~Writer();
+
+	Writer(const Writer&) = delete;
+	Writer(Writer&&) = delete;
+	Writer& operator=(const Writer&) = delete;
+	Writer& operator=(Writer&&) = delete;
+
+	/* Creates base_path with the .C16, .IDX and .sigmf-meta extensions. */
+	Optional<File::Error> create(std::filesystem::path base_path, const Capture& capture);
+
+	File::Result<File::Size> write(const void* const buffer, const File::Size bytes) override;
+
+private:
+	File data { };
+	File index { };
+	header_t header { };
+	bool created { false };
+	systime_t start_time { 0 };
+	uint64_t sample_offset { 0 };
+	std::array<Entry, 32> entries { };
+	size_t entries_buffered { 0 };
+
+	Optional<File::Error> flush();
+	Optional<File::Error> write_meta(const std::filesystem::path& path, const std::filesystem::path& dataset);
+};
+
+/* Random access to an index. Blocks are active when their peak is 12dB over
+ * the quietest block's; an index left unfinished (capture interrupted) has
+ * every block active.
+ */
+class Reader {
+public:
+	Reader() = default;
+
+	Reader(const Reader&) = delete;
+	Reader(Reader&&) = delete;
+	Reader& operator=(const Reader&) = delete;
+	Reader& operator=(Reader&&) = delete;
+
+	bool open(const std::filesystem::path& path);
+	void close();
+
+	bool is_open() const {
+		return (bool)file;
+	}
+
+	const header_t& header() const {
+		return header_;
+	}
+
+	uint32_t entry_count() const {
+		return header_.entry_count;
+	}
+
+	Optional<Entry> entry(const uint32_t n);
+
+	/* Entry of the block holding sample, the last one starting at or
+	 * before it. */
+	Optional<uint32_t> find(const uint64_t sample);
+
+	/* First active block from entry n on. */
+	Optional<uint32_t> next_active(uint32_t n);
+
+	bool is_active(const Entry& entry) const {
+		return entry.peak >= active_peak;
+	}
+
+private:
+	std::unique_ptr<File> file { };
+	header_t header_ { };
+	uint16_t active_peak { 0 };
+	// Off the stack, next_active() runs on the replay thread
+	std::array<Entry, 32> buffer { };
+};
+
+/* Replays only the active blocks of a C16 file, seeking over quiet ones. */
+class ActiveReader : public stream::Reader {
+public:
+	ActiveReader() = default;
+
+	ActiveReader(const ActiveReader&) = delete;
+	ActiveReader(ActiveReader&&) = delete;
+	ActiveReader& operator=(const ActiveReader&) = delete;
+	ActiveReader& operator=(ActiveReader&&) = delete;
+
+	/* Starts from the block holding byte offset in the C16 file. */
+	Optional<File::Error> open(const std::filesystem::path& path, const uint64_t offset);
+
+	File::Result<File::Size> read(void* const buffer, const File::Size bytes) override;
+
+private:
+	File file { };
+	capture_index::Reader index { };
+	uint32_t next_entry { 0 };
+	uint64_t position { 0 };
+	uint64_t block_end { 0 };
+
+	bool next_block();
+};
+
+} /* namespace capture_index */
+
+#endif/*__CAPTURE_INDEX_H__*/
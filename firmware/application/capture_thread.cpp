@@ -51,6 +51,24 @@ CaptureThread::CaptureThread(
 	thread = chThdCreateFromHeap(NULL, 1024, NORMALPRIO + 10, CaptureThread::static_fn, this);
 }
 
+CaptureThread::CaptureThread(
+	SegmentCallback segment_callback,
+	const CaptureTrigger trigger,
+	size_t write_size,
+	size_t buffer_count,
+	std::function<void()> success_callback,
+	std::function<void(File::Error)> error_callback
+) : config { write_size, buffer_count, trigger },
+	writer { },
+	segment_callback { std::move(segment_callback) },
+	success_callback { std::move(success_callback) },
+	error_callback { std::move(error_callback) }
+{
+	// Segment files are created from this thread too, and FATFS keeps its
+	// long file name buffer on the stack
+	thread = chThdCreateFromHeap(NULL, 2048, NORMALPRIO + 10, CaptureThread::static_fn, this);
+}
+
 CaptureThread::~CaptureThread() {
 	if( thread ) {
 		chThdTerminate(thread);
@@ -60,6 +78,7 @@ CaptureThread::~CaptureThread() {
 }
 
 msg_t CaptureThread::static_fn(void* arg) {
+	chRegSetThreadName("capture");
 	auto obj = static_cast<CaptureThread*>(arg);
 	const auto error = obj->run();
 	if( error.is_valid() && obj->error_callback ) {
@@ -78,9 +97,24 @@ Optional<File::Error> CaptureThread::run() {
 
 	while( !chThdShouldTerminate() ) {
 		auto buffer = buffers.get();
-		auto write_result = writer->write(buffer->data(), buffer->size());
-		if( write_result.is_error() ) {
-			return write_result.error();
+		if( !buffer ) {
+			break;
+		}
+		if( !writer && segment_callback ) {
+			const auto segment_error = segment_callback(writer);
+			if( segment_error.is_valid() ) {
+				return segment_error;
+			}
+		}
+		if( writer ) {
+			auto write_result = writer->write(buffer->data(), buffer->size());
+			if( write_result.is_error() ) {
+				return write_result.error();
+			}
+		}
+		if( buffer->is_segment_end() && segment_callback ) {
+			// Closes this segment's file
+			writer.reset();
 		}
 		buffer->empty();
 		buffers.put(buffer);
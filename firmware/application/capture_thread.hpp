@@ -35,6 +35,10 @@
 
 class CaptureThread {
 public:
+	/* Opens the writer for the next segment of a triggered capture. Runs on
+	 * the capture thread, leaving the writer empty skips the segment. */
+	using SegmentCallback = std::function<Optional<File::Error>(std::unique_ptr<stream::Writer>&)>;
+
 	CaptureThread(
 		std::unique_ptr<stream::Writer> writer,
 		size_t write_size,
@@ -42,6 +46,16 @@ public:
 		std::function<void()> success_callback,
 		std::function<void(File::Error)> error_callback
 	);
+
+	/* Triggered capture, a writer is opened per burst as it arrives. */
+	CaptureThread(
+		SegmentCallback segment_callback,
+		const CaptureTrigger trigger,
+		size_t write_size,
+		size_t buffer_count,
+		std::function<void()> success_callback,
+		std::function<void(File::Error)> error_callback
+	);
 	~CaptureThread();
 
 	CaptureThread(const CaptureThread&) = delete;
@@ -56,6 +70,7 @@ public:
 private:
 	CaptureConfig config;
 	std::unique_ptr<stream::Writer> writer;
+	SegmentCallback segment_callback { };
 	std::function<void()> success_callback;
 	std::function<void(File::Error)> error_callback;
 	Thread* thread { nullptr };
@@ -28,6 +28,7 @@ using namespace lpc43xx;
 
 #include "message.hpp"
 #include "baseband_api.hpp"
+#include "lz4.hpp"
 
 #include <cstring>
 
@@ -39,26 +40,34 @@ using namespace lpc43xx;
  * cause an exception and effectively halt the M4. But that feels gross.
  */
 void m4_init(const portapack::spi_flash::image_tag_t image_tag, const portapack::memory::region_t to) {
-	const portapack::spi_flash::chunk_t* chunk = reinterpret_cast<const portapack::spi_flash::chunk_t*>(portapack::spi_flash::images.base());
-	while(chunk->tag) {
-		if( chunk->tag == image_tag ) {
-			/* Initialize M4 code RAM */
-			std::memcpy(reinterpret_cast<void*>(to.base()), &chunk->data[0], chunk->length);
-
-			/* M4 core is assumed to be sleeping with interrupts off, so we can mess
-			 * with its address space and RAM without concern.
-			 */
-			LPC_CREG->M4MEMMAP = to.base();
+	const auto directory = reinterpret_cast<const portapack::spi_flash::image_directory_t*>(portapack::spi_flash::images.base());
+	if( !directory->is_valid() ) {
+		chDbgPanic("NoImgDir");
+	}
 
-			/* Reset M4 core */
-			LPC_RGU->RESET_CTRL[0] = (1 << 13);
+	const auto entry = directory->find(image_tag);
+	if( (entry == nullptr) || (entry->length > to.size()) ) {
+		chDbgPanic("NoImg");
+	}
 
-			return;
+	/* Initialize M4 code RAM, decompressing straight out of SPI flash. */
+	const auto src = directory->data(*entry);
+	const auto dst = reinterpret_cast<uint8_t*>(to.base());
+	if( entry->is_compressed() ) {
+		if( lz4::decompress_block(src, entry->compressed_length, dst, entry->length) != entry->length ) {
+			chDbgPanic("BadImg");
 		}
-		chunk = chunk->next();
+	} else {
+		std::memcpy(dst, src, entry->length);
 	}
 
-	chDbgPanic("NoImg");
+	/* M4 core is assumed to be sleeping with interrupts off, so we can mess
+	 * with its address space and RAM without concern.
+	 */
+	LPC_CREG->M4MEMMAP = to.base();
+
+	/* Reset M4 core */
+	LPC_RGU->RESET_CTRL[0] = (1 << 13);
 }
 
 void m4_request_shutdown() {
@@ -0,0 +1,682 @@
+/*
+ * Copyright (C) 2026 agent
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "directory_index.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+static constexpr uint8_t index_magic[4] { 'D', 'I', 'X', '1' };
+static constexpr char16_t index_name[] = u".DIRIDX";
+static constexpr char16_t temp_name[] = u".DIRIDX.TMP";
+
+static uint8_t fold(const char16_t c) {
+	if( (c >= u'a') && (c <= u'z') ) {
+		return c - u'a' + u'A';
+	}
+	return (c < 0x80) ? c : 0xff;
+}
+
+static void put_be32(uint8_t* const p, const uint32_t v) {
+	p[0] = v >> 24;
+	p[1] = v >> 16;
+	p[2] = v >> 8;
+	p[3] = v;
+}
+
+/* Up to n folded characters of name into key, zero padded. Names that agree
+ * on the characters kept here stay in directory order.
+ */
+static void put_name(uint8_t* const key, const char16_t* name, const size_t n) {
+	size_t i = 0;
+	for(; (i < n) && name[i]; i++) {
+		key[i] = fold(name[i]);
+	}
+	for(; i < n; i++) {
+		key[i] = 0;
+	}
+}
+
+static bool item_less(const uint8_t* const a_key, const uint32_t a_offset, const uint8_t* const b_key, const uint32_t b_offset) {
+	const auto c = memcmp(a_key, b_key, 16);
+	return (c < 0) || ((c == 0) && (a_offset < b_offset));
+}
+
+static uint32_t fnv1a(uint32_t hash, const void* const data, const size_t length) {
+	const auto p = static_cast<const uint8_t*>(data);
+	for(size_t i=0; i<length; i++) {
+		hash = (hash ^ p[i]) * 16777619U;
+	}
+	return hash;
+}
+
+static bool read_at(File& file, const uint32_t offset, void* const data, const size_t length) {
+	if( file.seek(offset).is_error() ) {
+		return false;
+	}
+	const auto read_result = file.read(data, length);
+	return !read_result.is_error() && (read_result.value() == length);
+}
+
+static const char16_t* entry_name(const std::filesystem::directory_entry& entry) {
+	return reinterpret_cast<const char16_t*>(entry.fname);
+}
+
+static size_t name_length(const char16_t* const name) {
+	size_t n = 0;
+	while( name[n] ) {
+		n++;
+	}
+	return n;
+}
+
+/* Also catches the empty entry FatFs returns when nothing matches. */
+bool DirectoryIndex::is_index_file(const std::filesystem::path::value_type* const name) {
+	if( name[0] == 0 ) {
+		return true;
+	}
+	return !std::char_traits<char16_t>::compare(name, index_name, 7) &&
+		((name[7] == 0) || (name[7] == u'.'));
+}
+
+std::filesystem::path DirectoryIndex::index_path() const {
+	return dir_path.native() + u"/" + index_name;
+}
+
+std::filesystem::path DirectoryIndex::temp_path() const {
+	return dir_path.native() + u"/" + temp_name;
+}
+
+/* Hash of one raw listing entry, without building its path: changes
+ * whenever an entry is added, removed, renamed, resized or touched.
+ */
+static uint32_t hash_entry(uint32_t hash, const std::filesystem::directory_entry& entry) {
+	const auto name = entry_name(entry);
+	hash = fnv1a(hash, name, name_length(name) * sizeof(char16_t));
+	hash = fnv1a(hash, &entry.fsize, sizeof(entry.fsize));
+	hash = fnv1a(hash, &entry.fdate, sizeof(entry.fdate));
+	hash = fnv1a(hash, &entry.ftime, sizeof(entry.ftime));
+	hash = fnv1a(hash, &entry.fattrib, sizeof(entry.fattrib));
+	return hash;
+}
+
+static constexpr uint32_t hash_initial = 2166136261U;
+
+/* Modified in the last couple of minutes, or dated in the future: most
+ * likely a file still being written, so the listing won't last.
+ */
+static bool is_recent(const std::filesystem::directory_entry& entry, const uint32_t now) {
+	static constexpr int32_t recent_seconds = 120;
+
+	if( entry.fdate != (now >> 16) ) {
+		return entry.fdate > (now >> 16);
+	}
+
+	const auto seconds = [](const uint16_t t) {
+		return ((t >> 11) * 3600) + (((t >> 5) & 0x3f) * 60) + ((t & 0x1f) * 2);
+	};
+	return (seconds(now & 0xffff) - seconds(entry.ftime)) < recent_seconds;
+}
+
+/* Case-folded, then directory order (the sort is stable). */
+static bool name_less(const std::filesystem::path& a, const std::filesystem::path& b) {
+	const auto& a_name = a.native();
+	const auto& b_name = b.native();
+	const size_t n = std::min(a_name.size(), b_name.size());
+	for(size_t i=0; i<n; i++) {
+		const auto a_c = fold(a_name[i]);
+		const auto b_c = fold(b_name[i]);
+		if( a_c != b_c ) {
+			return a_c < b_c;
+		}
+	}
+	return a_name.size() < b_name.size();
+}
+
+/* Writes the index while the directory is read: records go straight to the
+ * index file, sort keys are sorted in runs of chunk_size to the temporary
+ * file and merged into the index by finish(). Both files are deleted unless
+ * finish() succeeds.
+ */
+class DirectoryIndex::Builder {
+public:
+	Builder(
+		std::filesystem::path new_index_path,
+		std::filesystem::path new_temp_path
+	) : index_path { std::move(new_index_path) },
+		temp_path { std::move(new_temp_path) }
+	{
+		ok = !index->create(index_path).is_valid() &&
+			!runs->create(temp_path).is_valid();
+
+		// Placeholder, an index without the magic is never used.
+		const header_t blank { };
+		ok = ok && !index->write(&blank, sizeof(blank)).is_error();
+
+		chunk.reserve(chunk_size);
+	}
+
+	~Builder() {
+		index.reset();
+		runs.reset();
+		delete_file(temp_path);
+		if( !finished ) {
+			delete_file(index_path);
+		}
+	}
+
+	Builder(const Builder&) = delete;
+	Builder& operator=(const Builder&) = delete;
+
+	bool add(
+		const char16_t* const name,
+		const uint32_t size,
+		const uint16_t date,
+		const uint16_t time,
+		const bool is_directory
+	) {
+		if( !ok ) {
+			return false;
+		}
+
+		const size_t length = std::min<size_t>(name_length(name), 255);
+		const record_t record {
+			size,
+			date,
+			time,
+			static_cast<uint8_t>(is_directory ? AM_DIR : 0),
+			static_cast<uint8_t>(length)
+		};
+		if( index->write(&record, sizeof(record)).is_error() ||
+			index->write(name, length * sizeof(char16_t)).is_error() ) {
+			ok = false;
+			return false;
+		}
+
+		// Directories first in every order, date and size descending.
+		const uint8_t kind = is_directory ? 0 : 1;
+		std::array<sort_item_t, sort_count> items;
+		items[0].key[0] = kind;
+		put_name(&items[0].key[1], name, 15);
+		items[1].key[0] = kind;
+		put_be32(&items[1].key[1], ~((static_cast<uint32_t>(date) << 16) | time));
+		put_name(&items[1].key[5], name, 11);
+		items[2].key[0] = kind;
+		put_be32(&items[2].key[1], ~size);
+		put_name(&items[2].key[5], name, 11);
+		for(auto& item : items) {
+			item.offset = offset;
+		}
+		chunk.push_back(items);
+
+		offset += sizeof(record) + length * sizeof(char16_t);
+		count++;
+
+		if( chunk.size() == chunk_size ) {
+			ok = write_runs();
+		}
+		return ok;
+	}
+
+	bool finish(const uint32_t signature) {
+		ok = ok && (chunk.empty() || write_runs());
+
+		// Reopen both for the merge: FatFs handles are one way here.
+		index.reset();
+		runs.reset();
+		if( !ok ) {
+			return false;
+		}
+
+		File runs_in;
+		File index_out;
+		if( runs_in.open(temp_path).is_valid() ||
+			index_out.append(index_path).is_valid() ) {
+			return false;
+		}
+
+		header_t header { };
+		memcpy(header.magic, index_magic, sizeof(index_magic));
+		header.signature = signature;
+		header.count = count;
+
+		for(size_t s=0; s<sort_count; s++) {
+			header.order_offset[s] = offset;
+			if( !merge(runs_in, index_out, run_positions[s], run_lengths[s]) ) {
+				return false;
+			}
+			offset += count * sizeof(uint32_t);
+		}
+
+		finished = !index_out.seek(0).is_error() &&
+			!index_out.write(&header, sizeof(header)).is_error();
+		return finished;
+	}
+
+private:
+	const std::filesystem::path index_path;
+	const std::filesystem::path temp_path;
+	std::unique_ptr<File> index { std::make_unique<File>() };
+	std::unique_ptr<File> runs { std::make_unique<File>() };
+	std::vector<std::array<sort_item_t, sort_count>> chunk { };
+	std::vector<uint32_t> run_positions[sort_count] { };
+	std::vector<uint32_t> run_lengths[sort_count] { };
+	uint32_t count { 0 };
+	uint32_t offset { sizeof(header_t) };
+	uint32_t runs_offset { 0 };
+	bool ok { false };
+	bool finished { false };
+
+	bool write_runs() {
+		for(size_t s=0; s<sort_count; s++) {
+			std::vector<sort_item_t> run;
+			run.reserve(chunk.size());
+			for(const auto& items : chunk) {
+				run.push_back(items[s]);
+			}
+			std::sort(run.begin(), run.end(), [](const sort_item_t& a, const sort_item_t& b) {
+				return item_less(a.key, a.offset, b.key, b.offset);
+			});
+
+			if( runs->write(run.data(), run.size() * sizeof(sort_item_t)).is_error() ) {
+				return false;
+			}
+			run_positions[s].push_back(runs_offset);
+			run_lengths[s].push_back(run.size());
+			runs_offset += run.size() * sizeof(sort_item_t);
+		}
+		chunk.clear();
+		return true;
+	}
+
+	static bool merge(
+		File& runs,
+		File& index,
+		const std::vector<uint32_t>& run_positions,
+		const std::vector<uint32_t>& run_lengths
+	);
+};
+
+void DirectoryIndex::open(
+	const std::filesystem::path& new_dir_path,
+	const Sort new_sort,
+	const std::string& new_extension_filter
+) {
+	dir_path = new_dir_path;
+	sort = new_sort;
+	extension_filter = new_extension_filter;
+
+	index_file.reset();
+	verify_iterator.reset();
+	iterator.reset();
+	entries.clear();
+	entries.shrink_to_fit();
+	entries_position = 0;
+	position = 0;
+	order_buffered = 0;
+	order_index = 0;
+	end = false;
+	stale = false;
+
+	// An existing index is trusted for now, and checked as pages are read.
+	if( open_index() ) {
+		mode = Mode::Indexed;
+		verify_iterator = std::make_unique<std::filesystem::directory_iterator>(dir_path, u"*");
+		verify_hash = hash_initial;
+	} else {
+		mode = Mode::Unread;
+	}
+}
+
+bool DirectoryIndex::open_index() {
+	index_file = std::make_unique<File>();
+	if( index_file->open(index_path()).is_valid() ) {
+		index_file.reset();
+		return false;
+	}
+
+	const auto read_result = index_file->read(&header, sizeof(header));
+	if( read_result.is_error() || (read_result.value() != sizeof(header)) ||
+		memcmp(header.magic, index_magic, sizeof(index_magic)) ) {
+		index_file.reset();
+		return false;
+	}
+
+	return true;
+}
+
+/* One pass over the directory: a small one ends up sorted in entries, a
+ * large one in a new index, or failing that, its directories in entries
+ * and its files left to read_stream().
+ */
+void DirectoryIndex::scan() {
+	const auto now = get_fattime();
+	uint32_t hash = hash_initial;
+	size_t count = 0;
+	bool indexable = true;
+	std::unique_ptr<Builder> builder;
+
+	for(const auto& entry : std::filesystem::directory_iterator(dir_path, u"*")) {
+		const auto name = entry_name(entry);
+		if( is_index_file(name) ) {
+			continue;
+		}
+		hash = hash_entry(hash, entry);
+
+		const bool is_directory = std::filesystem::is_directory(entry.status());
+		if( !is_directory && !std::filesystem::is_regular_file(entry.status()) ) {
+			continue;
+		}
+
+		if( indexable && is_recent(entry, now) ) {
+			indexable = false;
+			builder.reset();
+		}
+
+		count++;
+		if( count == memory_max + 1 ) {
+			// Too many to sort in RAM, keep only the directories from now on.
+			if( indexable ) {
+				builder = std::make_unique<Builder>(index_path(), temp_path());
+				for(const auto& e : entries) {
+					builder->add(e.path.native().c_str(), e.size, e.timestamp.FAT_date, e.timestamp.FAT_time, e.is_directory);
+				}
+			}
+			entries.erase(
+				std::remove_if(entries.begin(), entries.end(), [](const Entry& e) { return !e.is_directory; }),
+				entries.end()
+			);
+		}
+
+		if( builder ) {
+			builder->add(name, entry.fsize, entry.fdate, entry.ftime, is_directory);
+		}
+		if( count <= memory_max ) {
+			entries.push_back({ entry.path(), static_cast<uint32_t>(entry.fsize), { entry.fdate, entry.ftime }, is_directory });
+		} else if( is_directory ) {
+			entries.push_back({ entry.path(), 0, { entry.fdate, entry.ftime }, true });
+		}
+	}
+
+	if( count <= memory_max ) {
+		entries.erase(
+			std::remove_if(entries.begin(), entries.end(), [this](const Entry& e) {
+				return !matches(e.path, e.is_directory);
+			}),
+			entries.end()
+		);
+		sort_entries();
+		mode = Mode::Memory;
+		return;
+	}
+
+	if( builder && builder->finish(hash) ) {
+		builder.reset();
+		if( open_index() ) {
+			entries.clear();
+			entries.shrink_to_fit();
+			mode = Mode::Indexed;
+			return;
+		}
+	}
+	builder.reset();
+
+	mode = Mode::Streaming;
+	iterator = std::make_unique<std::filesystem::directory_iterator>(dir_path, u"*");
+}
+
+void DirectoryIndex::sort_entries() {
+	const auto sort_by = sort;
+	std::stable_sort(entries.begin(), entries.end(), [sort_by](const Entry& a, const Entry& b) {
+		if( a.is_directory != b.is_directory ) {
+			return a.is_directory;
+		}
+		if( sort_by == Sort::Date ) {
+			const uint32_t a_time = (static_cast<uint32_t>(a.timestamp.FAT_date) << 16) | a.timestamp.FAT_time;
+			const uint32_t b_time = (static_cast<uint32_t>(b.timestamp.FAT_date) << 16) | b.timestamp.FAT_time;
+			if( a_time != b_time ) {
+				return a_time > b_time;
+			}
+		} else if( sort_by == Sort::Size ) {
+			if( a.size != b.size ) {
+				return a.size > b.size;
+			}
+		}
+		return name_less(a.path, b.path);
+	});
+}
+
+/* Hashes the next verify_step raw entries, the whole listing being checked
+ * against the index over the first few pages.
+ */
+void DirectoryIndex::verify() {
+	for(size_t i=0; (i < verify_step) && verify_iterator; i++) {
+		if( !(*verify_iterator != std::filesystem::directory_iterator { }) ) {
+			verify_iterator.reset();
+			if( verify_hash != header.signature ) {
+				index_file.reset();
+				delete_file(index_path());
+				stale = true;
+			}
+			return;
+		}
+
+		const auto& entry = **verify_iterator;
+		if( !is_index_file(entry_name(entry)) ) {
+			verify_hash = hash_entry(verify_hash, entry);
+		}
+		++(*verify_iterator);
+	}
+}
+bool DirectoryIndex::Builder::merge(
+	File& runs,
+	File& index,
+	const std::vector<uint32_t>& run_positions,
+	const std::vector<uint32_t>& run_lengths
+) {
+	struct cursor_t {
+		uint32_t position;
+		uint32_t remaining;
+		size_t buffered;
+		size_t index;
+		std::array<sort_item_t, 8> buffer;
+	};
+
+	std::vector<cursor_t> cursors(run_positions.size());
+
+	const auto refill = [&runs](cursor_t& c) {
+		const size_t n = std::min<size_t>(c.remaining, c.buffer.size());
+		c.index = 0;
+		c.buffered = 0;
+		if( n == 0 ) {
+			return true;
+		}
+		if( !read_at(runs, c.position, c.buffer.data(), n * sizeof(sort_item_t)) ) {
+			return false;
+		}
+		c.position += n * sizeof(sort_item_t);
+		c.remaining -= n;
+		c.buffered = n;
+		return true;
+	};
+
+	for(size_t i=0; i<cursors.size(); i++) {
+		cursors[i].position = run_positions[i];
+		cursors[i].remaining = run_lengths[i];
+		if( !refill(cursors[i]) ) {
+			return false;
+		}
+	}
+
+	std::array<uint32_t, 64> out;
+	size_t out_count = 0;
+
+	while( true ) {
+		cursor_t* best = nullptr;
+		for(auto& c : cursors) {
+			if( c.index < c.buffered ) {
+				const auto& item = c.buffer[c.index];
+				if( !best || item_less(item.key, item.offset, best->buffer[best->index].key, best->buffer[best->index].offset) ) {
+					best = &c;
+				}
+			}
+		}
+
+		if( !best || (out_count == out.size()) ) {
+			if( out_count && index.write(out.data(), out_count * sizeof(uint32_t)).is_error() ) {
+				return false;
+			}
+			out_count = 0;
+			if( !best ) {
+				return true;
+			}
+		}
+
+		out[out_count++] = best->buffer[best->index].offset;
+		if( (++best->index == best->buffered) && !refill(*best) ) {
+			return false;
+		}
+	}
+}
+
+bool DirectoryIndex::matches(const std::filesystem::path& name, const bool is_directory) const {
+	if( is_directory || extension_filter.empty() ) {
+		return true;
+	}
+
+	auto extension = name.extension().string();
+	for(auto& c : extension) {
+		c = toupper(c);
+	}
+	return extension == extension_filter;
+}
+
+size_t DirectoryIndex::read_page(std::vector<Entry>& out, const size_t max_count) {
+	if( mode == Mode::Unread ) {
+		scan();
+	}
+
+	if( mode == Mode::Indexed ) {
+		verify();
+		if( stale && (position == 0) ) {
+			// Nothing listed from the index yet, start over from the directory.
+			stale = false;
+			scan();
+		}
+	}
+
+	switch(mode) {
+	case Mode::Indexed:
+		if( stale ) {
+			end = true;
+			return 0;
+		}
+		return read_index(out, max_count);
+
+	case Mode::Memory:
+		return read_entries(out, max_count);
+
+	case Mode::Streaming:
+	{
+		const auto added = read_entries(out, max_count);
+		return added + read_stream(out, max_count - added);
+	}
+
+	default:
+		return 0;
+	}
+}
+
+size_t DirectoryIndex::read_entries(std::vector<Entry>& out, const size_t max_count) {
+	size_t added = 0;
+	while( (added < max_count) && (entries_position < entries.size()) ) {
+		out.push_back(entries[entries_position++]);
+		added++;
+	}
+	if( (mode == Mode::Memory) && (entries_position == entries.size()) ) {
+		end = true;
+	}
+	return added;
+}
+
+/* Files only, the directories came from entries. */
+size_t DirectoryIndex::read_stream(std::vector<Entry>& out, const size_t max_count) {
+	size_t added = 0;
+	while( !end && (added < max_count) ) {
+		if( !iterator || !(*iterator != std::filesystem::directory_iterator { }) ) {
+			end = true;
+			break;
+		}
+
+		const auto& entry = **iterator;
+		if( !is_index_file(entry_name(entry)) && std::filesystem::is_regular_file(entry.status()) ) {
+			auto name = entry.path();
+			if( matches(name, false) ) {
+				out.push_back({ std::move(name), static_cast<uint32_t>(entry.size()), { entry.fdate, entry.ftime }, false });
+				added++;
+			}
+		}
+		++(*iterator);
+	}
+	return added;
+}
+
+size_t DirectoryIndex::read_index(std::vector<Entry>& out, const size_t max_count) {
+	size_t added = 0;
+	const uint32_t order_offset = header.order_offset[static_cast<size_t>(sort)];
+	char16_t name[256];
+
+	while( !end && (added < max_count) ) {
+		if( position >= header.count ) {
+			end = true;
+			break;
+		}
+
+		if( order_index == order_buffered ) {
+			const size_t n = std::min<size_t>(header.count - position, order_buffer.size());
+			if( !read_at(*index_file, order_offset + position * sizeof(uint32_t), order_buffer.data(), n * sizeof(uint32_t)) ) {
+				end = true;
+				break;
+			}
+			order_buffered = n;
+			order_index = 0;
+		}
+
+		record_t record;
+		const auto record_offset = order_buffer[order_index++];
+		position++;
+
+		if( !read_at(*index_file, record_offset, &record, sizeof(record)) ||
+			!read_at(*index_file, record_offset + sizeof(record), name, record.name_length * sizeof(char16_t)) ) {
+			end = true;
+			break;
+		}
+
+		std::filesystem::path path { &name[0], &name[record.name_length] };
+		const bool is_directory = std::filesystem::is_directory(record.attrib);
+		if( matches(path, is_directory) ) {
+			out.push_back({ std::move(path), record.size, { record.date, record.time }, is_directory });
+			added++;
+		}
+	}
+
+	return added;
+}
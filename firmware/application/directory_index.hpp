@@ -0,0 +1,170 @@
+/*
+ * Copyright (C) 2026 agent
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __DIRECTORY_INDEX_H__
+#define __DIRECTORY_INDEX_H__
+
+#include "file.hpp"
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <memory>
+#include <array>
+
+/* Sorted, paged directory listing, directories first.
+ *
+ * A large directory gets a .DIRIDX file holding one record per entry and,
+ * for each sort order, the record positions in that order. Opening a
+ * directory with an index costs one header read: the index is checked
+ * against a hash of the raw listing a step at a time as pages are read, and
+ * is_stale() tells the caller to reopen when it no longer matches.
+ *
+ * Without an index, the first read_page() goes through the directory once.
+ * Small directories are sorted in RAM and never indexed. Larger ones are
+ * indexed by an external merge sort (sorted runs of chunk_size entries in a
+ * temporary file, then a k-way merge), so RAM use does not grow with the
+ * directory. If the index can't be written (write-protected card...) or an
+ * entry was modified in the last couple of minutes (a log being written),
+ * directories are listed first and files streamed after them, unsorted.
+ */
+class DirectoryIndex {
+public:
+	enum class Sort : uint8_t {
+		Name = 0,
+		Date = 1,		// Newest first
+		Size = 2,		// Largest first
+	};
+
+	struct Entry {
+		std::filesystem::path path;
+		uint32_t size;
+		FATTimestamp timestamp;
+		bool is_directory;
+	};
+
+	DirectoryIndex() = default;
+
+	DirectoryIndex(const DirectoryIndex&) = delete;
+	DirectoryIndex(DirectoryIndex&&) = delete;
+	DirectoryIndex& operator=(const DirectoryIndex&) = delete;
+	DirectoryIndex& operator=(DirectoryIndex&&) = delete;
+
+	/* extension_filter is upper case with the dot (".C16"), or empty. */
+	void open(
+		const std::filesystem::path& dir_path,
+		const Sort sort,
+		const std::string& extension_filter
+	);
+
+	/* Appends up to max_count more entries to out, returns how many. */
+	size_t read_page(std::vector<Entry>& out, const size_t max_count);
+
+	bool at_end() const {
+		return end;
+	}
+
+	bool is_sorted() const {
+		return (mode == Mode::Indexed) || (mode == Mode::Memory);
+	}
+
+	/* The index turned out not to match the directory, and was deleted. */
+	bool is_stale() const {
+		return stale;
+	}
+
+	/* The index and its temporary file, kept out of listings. */
+	static bool is_index_file(const std::filesystem::path::value_type* const name);
+
+private:
+	enum class Mode : uint8_t {
+		Unread,
+		Indexed,
+		Memory,
+		Streaming,
+	};
+
+	static constexpr size_t chunk_size = 128;
+	static constexpr size_t sort_count = 3;
+	// Directories up to this size are sorted in RAM and never indexed
+	static constexpr size_t memory_max = 64;
+	// Raw entries hashed per read_page() when checking an index
+	static constexpr size_t verify_step = 64;
+
+	struct header_t {
+		uint8_t magic[4];
+		uint32_t signature;
+		uint32_t count;
+		uint32_t order_offset[sort_count];
+	};
+
+	struct record_t {
+		uint32_t size;
+		uint16_t date;
+		uint16_t time;
+		uint8_t attrib;
+		uint8_t name_length;
+	} __attribute__((packed));
+
+	struct sort_item_t {
+		uint8_t key[16];
+		uint32_t offset;
+	};
+
+	class Builder;
+
+	std::filesystem::path dir_path { };
+	Sort sort { Sort::Name };
+	std::string extension_filter { };
+	Mode mode { Mode::Unread };
+	bool end { true };
+	bool stale { false };
+
+	// Indexed
+	std::unique_ptr<File> index_file { };
+	header_t header { };
+	uint32_t position { 0 };
+	std::array<uint32_t, 32> order_buffer { };
+	size_t order_buffered { 0 };
+	size_t order_index { 0 };
+	std::unique_ptr<std::filesystem::directory_iterator> verify_iterator { };
+	uint32_t verify_hash { 0 };
+
+	// Memory: the matching entries, sorted. Streaming: the directories.
+	std::vector<Entry> entries { };
+	size_t entries_position { 0 };
+	// Streaming: the files, after the directories
+	std::unique_ptr<std::filesystem::directory_iterator> iterator { };
+
+	std::filesystem::path index_path() const;
+	std::filesystem::path temp_path() const;
+	bool open_index();
+	void scan();
+	void verify();
+	void sort_entries();
+	size_t read_index(std::vector<Entry>& out, const size_t max_count);
+	size_t read_entries(std::vector<Entry>& out, const size_t max_count);
+	size_t read_stream(std::vector<Entry>& out, const size_t max_count);
+	bool matches(const std::filesystem::path& name, const bool is_directory) const;
+};
+
+#endif/*__DIRECTORY_INDEX_H__*/
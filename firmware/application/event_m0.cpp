@@ -33,6 +33,7 @@
 #include "irq_controls.hpp"
 
 #include "buffer_exchange.hpp"
+#include "baseband_api.hpp"
 
 #include "ch.h"
 
@@ -50,6 +51,7 @@ CH_IRQ_HANDLER(M4Core_IRQHandler) {
 
 	chSysLockFromIsr();
 	BufferExchange::handle_isr();
+	baseband::message_ack_isr();
 	EventDispatcher::check_fifo_isr();
 	chSysUnlockFromIsr();
 
@@ -60,36 +62,29 @@ CH_IRQ_HANDLER(M4Core_IRQHandler) {
 
 }
 
-class MessageHandlerMap {
-public:
-	using MessageHandler = std::function<void(Message* const p)>;
+MessageHandlerMap::MapType MessageHandlerMap::map_ { };
 
-	void register_handler(const Message::ID id, MessageHandler&& handler) {
-		if( map_[toUType(id)] != nullptr ) {
-			chDbgPanic("MsgDblReg");
-		}
-		map_[toUType(id)] = std::move(handler);
+void MessageHandlerMap::register_handler(const Message::ID id, const Handler handler, void* const context) {
+	auto& entry = map_[toUType(id)];
+	if( entry.handler != nullptr ) {
+		chDbgPanic("MsgDblReg");
 	}
+	entry = { handler, context };
+}
 
-	void unregister_handler(const Message::ID id) {
-		map_[toUType(id)] = nullptr;
-	}
+void MessageHandlerMap::unregister_handler(const Message::ID id) {
+	map_[toUType(id)] = { nullptr, nullptr };
+}
 
-	void send(Message* const message) {
-		if( message->id < Message::ID::MAX ) {
-			auto& fn = map_[toUType(message->id)];
-			if( fn ) {
-				fn(message);
-			}
+void MessageHandlerMap::send(Message* const message) {
+	if( message->id < Message::ID::MAX ) {
+		const auto& entry = map_[toUType(message->id)];
+		if( entry.handler ) {
+			entry.handler(entry.context, message);
 		}
 	}
+}
 
-private:
-	using MapType = std::array<MessageHandler, toUType(Message::ID::MAX)>;
-	MapType map_ { };
-};
-
-static MessageHandlerMap message_map;
 Thread* EventDispatcher::thread_event_loop = nullptr;
 bool EventDispatcher::is_running = false;
 bool EventDispatcher::display_sleep = false;
@@ -211,13 +206,13 @@ void EventDispatcher::dispatch(const eventmask_t events) {
 
 void EventDispatcher::handle_application_queue() {
 	shared_memory.application_queue.handle([](Message* const message) {
-		message_map.send(message);
+		MessageHandlerMap::send(message);
 	});
 }
 
 void EventDispatcher::handle_local_queue() {
 	shared_memory.app_local_queue.handle([](Message* const message) {
-		message_map.send(message);
+		MessageHandlerMap::send(message);
 	});
 }
 
@@ -281,8 +276,9 @@ void EventDispatcher::on_touch_event(ui::TouchEvent event) {
 
 void EventDispatcher::handle_lcd_frame_sync() {
 	DisplayFrameSyncMessage message;
-	message_map.send(&message);
+	MessageHandlerMap::send(&message);
 	painter.paint_widget_tree(top_widget);
+	portapack::screen_recorder.frame_sync();
 
 	portapack::backlight()->on();
 }
@@ -369,12 +365,17 @@ void EventDispatcher::init_message_queues() {
 
 MessageHandlerRegistration::MessageHandlerRegistration(
 	const Message::ID message_id,
-	MessageHandlerMap::MessageHandler&& callback
-) : message_id { message_id }
+	std::function<void(Message* const p)>&& callback
+) : message_id { message_id },
+	callback { std::move(callback) }
 {
-	message_map.register_handler(message_id, std::move(callback));
+	MessageHandlerMap::register_handler(message_id, &MessageHandlerRegistration::dispatch, this);
 }
 
 MessageHandlerRegistration::~MessageHandlerRegistration() {
-	message_map.unregister_handler(message_id);
+	MessageHandlerMap::unregister_handler(message_id);
+}
+
+void MessageHandlerRegistration::dispatch(void* const context, Message* const p) {
+	static_cast<MessageHandlerRegistration*>(context)->callback(p);
 }
@@ -37,6 +37,9 @@
 #include "ch.h"
 
 #include <cstdint>
+#include <array>
+#include <functional>
+#include <type_traits>
 
 constexpr auto EVT_MASK_RTC_TICK        = EVENT_MASK(0);
 constexpr auto EVT_MASK_LCD_FRAME_SYNC  = EVENT_MASK(1);
@@ -126,6 +129,63 @@ private:
 	void init_message_queues();
 };
 
+/* Flat table of message handlers, indexed by Message::ID. Each slot is a
+ * plain function pointer and an opaque context, so dispatch is one indirect
+ * call with no std::function in the way.
+ */
+class MessageHandlerMap {
+public:
+	using Handler = void (*)(void* const context, Message* const p);
+
+	static void register_handler(const Message::ID id, const Handler handler, void* const context);
+	static void unregister_handler(const Message::ID id);
+	static void send(Message* const message);
+
+private:
+	struct Entry {
+		Handler handler;
+		void* context;
+	};
+
+	using MapType = std::array<Entry, toUType(Message::ID::MAX)>;
+	static MapType map_;
+};
+
+/* Binds a member function to the message type it handles. The ID comes from
+ * T::message_id and the payload cast is checked against the handler's
+ * signature at compile time.
+ */
+template<typename T, typename Owner, void (Owner::*Fn)(const T* const)>
+class MessageHandler {
+public:
+	static_assert(std::is_base_of<Message, T>::value, "type is not based on Message");
+
+	explicit MessageHandler(
+		Owner* const owner
+	) {
+		MessageHandlerMap::register_handler(T::message_id, &MessageHandler::dispatch, owner);
+	}
+
+	~MessageHandler() {
+		MessageHandlerMap::unregister_handler(T::message_id);
+	}
+
+	MessageHandler(const MessageHandler&) = delete;
+	MessageHandler(MessageHandler&&) = delete;
+	MessageHandler& operator=(const MessageHandler&) = delete;
+	MessageHandler& operator=(MessageHandler&&) = delete;
+
+private:
+	static void dispatch(void* const context, Message* const p) {
+		(static_cast<Owner*>(context)->*Fn)(static_cast<const T*>(p));
+	}
+};
+
+/* Untyped registration for handlers written as lambdas. Dispatch goes
+ * through the table thunk and then the std::function, so it's slower than
+ * the std::function table it replaced: keep it for one-off handlers with no
+ * owning class, and use MessageHandler for everything else.
+ */
 class MessageHandlerRegistration {
 public:
 	MessageHandlerRegistration(
@@ -134,9 +194,15 @@ public:
 	);
 
 	~MessageHandlerRegistration();
+
+	MessageHandlerRegistration(const MessageHandlerRegistration&) = delete;
+	MessageHandlerRegistration& operator=(const MessageHandlerRegistration&) = delete;
 	
 private:
 	const Message::ID message_id;
+	const std::function<void(Message* const p)> callback;
+
+	static void dispatch(void* const context, Message* const p);
 };
 
 #endif/*__EVENT_M0_H__*/
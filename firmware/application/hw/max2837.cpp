@@ -206,42 +206,91 @@ void MAX2837::set_lpf_rf_bandwidth(const uint32_t bandwidth_minimum) {
 	flush();
 }
 
-bool MAX2837::set_frequency(const rf::Frequency lo_frequency) {
+SynthImage synth_image(const rf::Frequency lo_frequency) {
+	SynthImage image;
+
 	/* TODO: This is a sad implementation. Refactor. */
 	if( lo::band[0].contains(lo_frequency) ) {
-		_map.r.syn_int_div.LOGEN_BSW = 0b00;	/* 2300 - 2399.99MHz */
-		_map.r.rxrf_1.LNAband = 0;				/* 2.3 - 2.5GHz */
+		image.logen_bsw = 0b00;		/* 2300 - 2399.99MHz */
+		image.lna_band = 0;			/* 2.3 - 2.5GHz */
 	} else if( lo::band[1].contains(lo_frequency)  ) {
-		_map.r.syn_int_div.LOGEN_BSW = 0b01;	/* 2400 - 2499.99MHz */
-		_map.r.rxrf_1.LNAband = 0;				/* 2.3 - 2.5GHz */
+		image.logen_bsw = 0b01;		/* 2400 - 2499.99MHz */
+		image.lna_band = 0;			/* 2.3 - 2.5GHz */
 	} else if( lo::band[2].contains(lo_frequency) ) {
-		_map.r.syn_int_div.LOGEN_BSW = 0b10;	/* 2500 - 2599.99MHz */
-		_map.r.rxrf_1.LNAband = 1;				/* 2.5 - 2.7GHz */
+		image.logen_bsw = 0b10;		/* 2500 - 2599.99MHz */
+		image.lna_band = 1;			/* 2.5 - 2.7GHz */
 	} else if( lo::band[3].contains(lo_frequency) ) {
-		_map.r.syn_int_div.LOGEN_BSW = 0b11;	/* 2600 - 2700Hz */
-		_map.r.rxrf_1.LNAband = 1;				/* 2.5 - 2.7GHz */
+		image.logen_bsw = 0b11;		/* 2600 - 2700Hz */
+		image.lna_band = 1;			/* 2.5 - 2.7GHz */
 	} else {
-		return false;
+		return image;
 	}
-	_dirty[Register::SYN_INT_DIV] = 1;
-	_dirty[Register::RXRF_1] = 1;
 
 	const uint64_t div_q20 = (lo_frequency * (1 << 20)) / pll_factor;
 
-	_map.r.syn_int_div.SYN_INTDIV = div_q20 >> 20;
-	_dirty[Register::SYN_INT_DIV] = 1;
-	_map.r.syn_fr_div_2.SYN_FRDIV_19_10 = (div_q20 >> 10) & 0x3ff;
-	_dirty[Register::SYN_FR_DIV_2] = 1;
+	image.intdiv = div_q20 >> 20;
+	image.frdiv_19_10 = (div_q20 >> 10) & 0x3ff;
+	image.frdiv_9_0 = div_q20 & 0x3ff;
+	image.valid = true;
+
+	return image;
+}
+
+bool MAX2837::set_frequency(const rf::Frequency lo_frequency) {
+	return set_frequency(synth_image(lo_frequency));
+}
+
+bool MAX2837::set_frequency(const SynthImage& image) {
+	if( !image.valid ) {
+		return false;
+	}
+
+	if( _map.r.rxrf_1.LNAband != image.lna_band ) {
+		_map.r.rxrf_1.LNAband = image.lna_band;
+		_dirty[Register::RXRF_1] = 1;
+	}
+
+	const bool synth_changed =
+		   (_map.r.syn_int_div.SYN_INTDIV != image.intdiv)
+		|| (_map.r.syn_int_div.LOGEN_BSW != image.logen_bsw)
+		|| (_map.r.syn_fr_div_2.SYN_FRDIV_19_10 != image.frdiv_19_10)
+		|| (_map.r.syn_fr_div_1.SYN_FRDIV_9_0 != image.frdiv_9_0)
+		;
+
+	if( (_map.r.syn_int_div.SYN_INTDIV != image.intdiv)
+	 || (_map.r.syn_int_div.LOGEN_BSW != image.logen_bsw) ) {
+		_map.r.syn_int_div.SYN_INTDIV = image.intdiv;
+		_map.r.syn_int_div.LOGEN_BSW = image.logen_bsw;
+		_dirty[Register::SYN_INT_DIV] = 1;
+	}
+	if( _map.r.syn_fr_div_2.SYN_FRDIV_19_10 != image.frdiv_19_10 ) {
+		_map.r.syn_fr_div_2.SYN_FRDIV_19_10 = image.frdiv_19_10;
+		_dirty[Register::SYN_FR_DIV_2] = 1;
+	}
 	/* flush to commit high FRDIV first, as low FRDIV commits the change */
 	flush();
 
-	_map.r.syn_fr_div_1.SYN_FRDIV_9_0 = (div_q20 & 0x3ff);
-	_dirty[Register::SYN_FR_DIV_1] = 1;
-	flush();
+	if( synth_changed ) {
+		/* Low FRDIV is written whenever any divisor moved, even if its own
+		 * value is unchanged, because that write is what loads the new ratio.
+		 */
+		_map.r.syn_fr_div_1.SYN_FRDIV_9_0 = image.frdiv_9_0;
+		flush_one(Register::SYN_FR_DIV_1);
+	}
 
 	return true;
 }
 
+bool MAX2837::is_tuned_to(const SynthImage& image) const {
+	return image.valid
+		&& (_map.r.rxrf_1.LNAband == image.lna_band)
+		&& (_map.r.syn_int_div.SYN_INTDIV == image.intdiv)
+		&& (_map.r.syn_int_div.LOGEN_BSW == image.logen_bsw)
+		&& (_map.r.syn_fr_div_2.SYN_FRDIV_19_10 == image.frdiv_19_10)
+		&& (_map.r.syn_fr_div_1.SYN_FRDIV_9_0 == image.frdiv_9_0)
+		;
+}
+
 void MAX2837::set_rx_lo_iq_calibration(const size_t v) {
 	_map.r.rx_top_rx_bias.RX_IQERR_SPI_EN = 1;
 	_dirty[Register::RX_TOP_RX_BIAS] = 1;
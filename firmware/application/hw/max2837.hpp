@@ -826,6 +826,20 @@ constexpr RegisterMap initial_register_values { Register_Type {
 	},
 } };
 
+/* Synthesizer and LNA band fields for one LO frequency, computed ahead of
+ * time so a frequency hop only pays for the SPI writes that change.
+ */
+struct SynthImage {
+	uint16_t frdiv_9_0 { 0 };
+	uint16_t frdiv_19_10 { 0 };
+	uint8_t intdiv { 0 };
+	uint8_t logen_bsw { 0 };
+	uint8_t lna_band { 0 };
+	bool valid { false };
+};
+
+SynthImage synth_image(const rf::Frequency lo_frequency);
+
 class MAX2837 {
 public:
 	constexpr MAX2837(
@@ -883,6 +897,8 @@ public:
 #endif
 
 	bool set_frequency(const rf::Frequency lo_frequency);
+	bool set_frequency(const SynthImage& image);
+	bool is_tuned_to(const SynthImage& image) const;
 
 	void set_rx_lo_iq_calibration(const size_t v);
 	void set_rx_bias_trim(const size_t v);
@@ -232,30 +232,67 @@ void RFFC507x::set_mixer_current(const uint8_t value) {
 	flush_one(Register::MIX_CONT);
 }
 
-void RFFC507x::set_frequency(const rf::Frequency lo_frequency) {
+SynthImage synth_image(const rf::Frequency lo_frequency) {
 	const SynthConfig synth_config = SynthConfig::calculate(lo_frequency);
 
+	SynthImage image;
+	image.n = synth_config.n_divider_q24 >> 24;
+	image.n_msb = (synth_config.n_divider_q24 >> 8) & 0xffff;
+	image.n_lsb = synth_config.n_divider_q24 & 0xff;
+	image.lo_divider_log2 = synth_config.lo_divider_log2;
+	image.prescaler_divider_log2 = synth_config.prescaler_divider_log2;
+
 	/* Boost charge pump leakage if VCO frequency > 3.2GHz, indicated by
 	 * prescaler divider set to 4 (log2=2) instead of 2 (log2=1).
 	 */
-	if( synth_config.prescaler_divider_log2 == 2 ) {
-		_map.r.lf.pllcpl = 3;
-	} else {
-		_map.r.lf.pllcpl = 2;
+	image.pllcpl = (synth_config.prescaler_divider_log2 == 2) ? 3 : 2;
+
+	return image;
+}
+
+void RFFC507x::set_frequency(const rf::Frequency lo_frequency) {
+	set_frequency(synth_image(lo_frequency));
+}
+
+void RFFC507x::set_frequency(const SynthImage& image) {
+	if( _map.r.lf.pllcpl != image.pllcpl ) {
+		_map.r.lf.pllcpl = image.pllcpl;
+		flush_one(Register::LF);
+	}
+
+	if( (_map.r.p2_freq1.p2n != image.n)
+	 || (_map.r.p2_freq1.p2lodiv != image.lo_divider_log2)
+	 || (_map.r.p2_freq1.p2presc != image.prescaler_divider_log2) ) {
+		_map.r.p2_freq1.p2n = image.n;
+		_map.r.p2_freq1.p2lodiv = image.lo_divider_log2;
+		_map.r.p2_freq1.p2presc = image.prescaler_divider_log2;
+		_dirty[Register::P2_FREQ1] = 1;
+	}
+	if( _map.r.p2_freq2.p2nmsb != image.n_msb ) {
+		_map.r.p2_freq2.p2nmsb = image.n_msb;
+		_dirty[Register::P2_FREQ2] = 1;
+	}
+	if( _map.r.p2_freq3.p2nlsb != image.n_lsb ) {
+		_map.r.p2_freq3.p2nlsb = image.n_lsb;
+		_dirty[Register::P2_FREQ3] = 1;
 	}
-	flush_one(Register::LF);
-
-	_map.r.p2_freq1.p2n = synth_config.n_divider_q24 >> 24;
-	_map.r.p2_freq1.p2lodiv = synth_config.lo_divider_log2;
-	_map.r.p2_freq1.p2presc = synth_config.prescaler_divider_log2;
-	_map.r.p2_freq2.p2nmsb = (synth_config.n_divider_q24 >> 8) & 0xffff;
-	_map.r.p2_freq3.p2nlsb = synth_config.n_divider_q24 & 0xff;
-	_dirty[Register::P2_FREQ1] = 1;
-	_dirty[Register::P2_FREQ2] = 1;
-	_dirty[Register::P2_FREQ3] = 1;
 	flush();
 }
 
+bool RFFC507x::is_tuned_to(const SynthImage& image) const {
+	return (_map.r.lf.pllcpl == image.pllcpl)
+		&& (_map.r.p2_freq1.p2n == image.n)
+		&& (_map.r.p2_freq1.p2lodiv == image.lo_divider_log2)
+		&& (_map.r.p2_freq1.p2presc == image.prescaler_divider_log2)
+		&& (_map.r.p2_freq2.p2nmsb == image.n_msb)
+		&& (_map.r.p2_freq3.p2nlsb == image.n_lsb)
+		;
+}
+
+bool RFFC507x::is_enabled() const {
+	return _map.r.sdi_ctrl.enbl;
+}
+
 void RFFC507x::set_gpo1(const bool new_value) {
 	if( new_value ) {
 		_map.r.gpo.p2gpo |= 1;
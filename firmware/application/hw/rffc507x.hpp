@@ -796,6 +796,20 @@ constexpr RegisterMap default_hackrf_one { Register_Type {
 	},
 } };
 
+/* Synthesizer fields for one LO frequency, computed ahead of time so a
+ * frequency hop only pays for the SPI writes of registers that change.
+ */
+struct SynthImage {
+	uint16_t n_msb { 0 };
+	uint16_t n { 0 };
+	uint8_t n_lsb { 0 };
+	uint8_t lo_divider_log2 { 0 };
+	uint8_t prescaler_divider_log2 { 0 };
+	uint8_t pllcpl { 0 };
+};
+
+SynthImage synth_image(const rf::Frequency lo_frequency);
+
 class RFFC507x {
 public:
 	void init();
@@ -808,6 +822,9 @@ public:
 
 	void set_mixer_current(const uint8_t value);
 	void set_frequency(const rf::Frequency lo_frequency);
+	void set_frequency(const SynthImage& image);
+	bool is_tuned_to(const SynthImage& image) const;
+	bool is_enabled() const;
 	void set_gpo1(const bool new_value);
 	
 	reg_t read(const address_t reg_num);
@@ -0,0 +1,61 @@
+/*
+ * Copyright (C) 2026 agent
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "io_bitstream.hpp"
+
+#include <utility>
+
+BitstreamReader::BitstreamReader(
+	std::string frame,
+	const size_t repeat,
+	const size_t pause_symbols
+) : frame { std::move(frame) },
+	repeat { repeat },
+	pause_symbols { pause_symbols }
+{
+}
+
+File::Result<File::Size> BitstreamReader::read(void* const buffer, const File::Size bytes) {
+	auto p = static_cast<uint8_t*>(buffer);
+	
+	for (File::Size n = 0; n < bytes; n++) {
+		uint8_t byte = 0;
+		for (size_t i = 0; i < 8; i++)
+			byte = (byte << 1) | next_symbol();
+		p[n] = byte;
+	}
+	
+	return { bytes };
+}
+
+bool BitstreamReader::next_symbol() {
+	if ((repeat_index >= repeat) || !period())
+		return false;
+	
+	const bool symbol = (position < frame.size()) && (frame[position] != '0');
+	
+	if (++position == period()) {
+		position = 0;
+		repeat_index++;
+	}
+	
+	return symbol;
+}
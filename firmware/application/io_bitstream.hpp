@@ -0,0 +1,67 @@
+/*
+ * Copyright (C) 2026 agent
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#pragma once
+
+#include "io.hpp"
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+
+/* Packs a frame of symbols (MSB first) for BitstreamTX: the frame is sent
+ * repeat times, each followed by pause_symbols of idle. The stream then
+ * idles instead of ending, so stopping the replay can't drop the tail
+ * still buffered in baseband: the processor stops after symbol_count(). */
+class BitstreamReader : public stream::Reader {
+public:
+	// '0' is idle, any other character is an active symbol
+	BitstreamReader(
+		std::string frame,
+		const size_t repeat,
+		const size_t pause_symbols
+	);
+
+	BitstreamReader(const BitstreamReader&) = delete;
+	BitstreamReader& operator=(const BitstreamReader&) = delete;
+	BitstreamReader(BitstreamReader&&) = delete;
+	BitstreamReader& operator=(BitstreamReader&&) = delete;
+
+	File::Result<File::Size> read(void* const buffer, const File::Size bytes) override;
+
+	uint32_t symbol_count() const {
+		return (frame.size() + pause_symbols) * repeat;
+	}
+
+	uint32_t period() const {
+		return frame.size() + pause_symbols;
+	}
+
+private:
+	const std::string frame;
+	const size_t repeat;
+	const size_t pause_symbols;
+	
+	size_t position { 0 };
+	size_t repeat_index { 0 };
+
+	bool next_symbol();
+};
@@ -42,6 +42,10 @@ public:
 	}
 	
 	File::Result<File::Size> read(void* const buffer, const File::Size bytes) override;
+
+	File::Result<File::Offset> seek(const uint64_t new_position) {
+		return file.seek(new_position);
+	}
 	
 protected:
 	File file { };
@@ -118,6 +118,10 @@ uint32_t WAVFileReader::sample_rate() {
 	return sample_rate_;
 }
 
+uint32_t WAVFileReader::data_offset() {
+	return data_start;
+}
+
 uint32_t WAVFileReader::data_size() {
 	return data_size_;
 }
@@ -118,6 +118,7 @@ public:
 	//int seek_mss(const uint16_t minutes, const uint8_t seconds, const uint32_t samples);
 	uint16_t channels();
 	uint32_t sample_rate();
+	uint32_t data_offset();
 	uint32_t data_size();
 	uint32_t sample_count();
 	uint16_t bits_per_sample();
@@ -23,15 +23,35 @@
 
 #include "string_format.hpp"
 
-Optional<File::Error> LogFile::write_entry(const rtc::RTC& datetime, const std::string& entry) {
-	std::string timestamp = to_string_timestamp(datetime);
-	return write_line(timestamp + " " + entry);
-}
+#include <cstring>
 
-Optional<File::Error> LogFile::write_line(const std::string& message) {
-	auto error = file.write_line(message);
+Optional<File::Error> LogFile::append(const std::filesystem::path& filename) {
+	writer.reset();
+
+	auto error = file.append(filename);
 	if( !error.is_valid() ) {
-		file.sync();
+		writer = std::make_unique<LogThread>(file, sync_interval_ms);
 	}
 	return error;
 }
+
+Optional<File::Error> LogFile::write_entry(const rtc::RTC& datetime, const std::string& entry) {
+	return write_line(datetime, entry.data(), entry.size());
+}
+
+Optional<File::Error> LogFile::write_entry(const rtc::RTC& datetime, const char* const entry) {
+	return write_line(datetime, entry, strlen(entry));
+}
+
+Optional<File::Error> LogFile::write_line(const rtc::RTC& datetime, const char* const entry, const size_t length) {
+	if( !writer ) {
+		return { FR_NOT_ENABLED };
+	}
+
+	FixedString<16> timestamp;
+	timestamp.timestamp(datetime).append(' ');
+
+	// Lines that don't fit in the ring are dropped and counted, not waited on.
+	writer->push(timestamp.c_str(), timestamp.length(), entry, length);
+	return writer->error();
+}
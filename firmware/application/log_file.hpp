@@ -23,24 +23,33 @@
 #define __LOG_FILE_H__
 
 #include <string>
+#include <memory>
 
 #include "file.hpp"
+#include "log_thread.hpp"
 
 #include "lpc43xx_cpp.hpp"
 using namespace lpc43xx;
 
 class LogFile {
 public:
-	Optional<File::Error> append(const std::filesystem::path& filename) {
-		return file.append(filename);
+	LogFile(
+		const uint32_t sync_interval_ms = LogThread::default_sync_interval_ms
+	) : sync_interval_ms { sync_interval_ms }
+	{
 	}
 
+	Optional<File::Error> append(const std::filesystem::path& filename);
+
 	Optional<File::Error> write_entry(const rtc::RTC& datetime, const std::string& entry);
+	Optional<File::Error> write_entry(const rtc::RTC& datetime, const char* const entry);
 
 private:
+	const uint32_t sync_interval_ms;
 	File file { };
+	std::unique_ptr<LogThread> writer { };
 
-	Optional<File::Error> write_line(const std::string& message);
+	Optional<File::Error> write_line(const rtc::RTC& datetime, const char* const entry, const size_t length);
 };
 
 #endif/*__LOG_FILE_H__*/
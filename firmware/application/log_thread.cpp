@@ -0,0 +1,149 @@
+/*
+ * Copyright (C) 2026 agent
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "log_thread.hpp"
+
+#include <algorithm>
+
+// LogThread //////////////////////////////////////////////////////////////
+
+static LogStatistics closed_totals { };
+
+LogStatistics LogThread::totals() {
+	return closed_totals;
+}
+
+LogThread::LogThread(
+	File& file,
+	const uint32_t sync_interval_ms
+) : file(file),
+	sync_interval { MS2ST(sync_interval_ms) },
+	file_offset { file.size() }
+{
+	// Need significant stack for FATFS
+	thread = chThdCreateFromHeap(NULL, 1024, NORMALPRIO + 10, LogThread::static_fn, this);
+}
+
+LogThread::~LogThread() {
+	if( thread ) {
+		chThdTerminate(thread);
+		chEvtSignal(thread, EVT_MASK_LOG_DATA);
+		chThdWait(thread);
+		thread = nullptr;
+	}
+
+	closed_totals.lines_queued += stats.lines_queued;
+	closed_totals.lines_dropped += stats.lines_dropped;
+	closed_totals.bytes_written += stats.bytes_written;
+	closed_totals.writes += stats.writes;
+	closed_totals.syncs += stats.syncs;
+}
+
+bool LogThread::push(const std::string& line) {
+	return push(nullptr, 0, line.data(), line.size());
+}
+
+bool LogThread::push(
+	const char* const prefix, const size_t prefix_length,
+	const char* const line, const size_t line_length
+) {
+	const size_t length = prefix_length + line_length + 2;
+	if( error_.is_valid() || (length > ring.unused()) ) {
+		stats.lines_dropped++;
+		return false;
+	}
+
+	ring.in(reinterpret_cast<const uint8_t*>(prefix), prefix_length);
+	ring.in(reinterpret_cast<const uint8_t*>(line), line_length);
+	ring.in(reinterpret_cast<const uint8_t*>("\r\n"), 2);
+	stats.lines_queued++;
+
+	// Only wake the writer once there's at least a sector to write.
+	if( thread && (ring.len() >= sector_size) ) {
+		chEvtSignal(thread, EVT_MASK_LOG_DATA);
+	}
+
+	return true;
+}
+
+msg_t LogThread::static_fn(void* arg) {
+	chRegSetThreadName("log");
+	auto obj = static_cast<LogThread*>(arg);
+	obj->run();
+	return 0;
+}
+
+void LogThread::run() {
+	systime_t last_sync = chTimeNow();
+
+	while( !chThdShouldTerminate() ) {
+		chEvtWaitAnyTimeout(EVT_MASK_LOG_DATA, sync_interval);
+
+		const bool sync_due = (chTimeNow() - last_sync) >= sync_interval;
+		const bool wrote = write_batches(sync_due);
+
+		if( sync_due ) {
+			if( wrote ) {
+				file.sync();
+				stats.syncs++;
+			}
+			last_sync = chTimeNow();
+		}
+
+		if( error_.is_valid() ) {
+			return;
+		}
+	}
+
+	if( write_batches(true) ) {
+		file.sync();
+		stats.syncs++;
+	}
+}
+
+/* Writes whole sector-aligned batches from the ring. When draining, a final
+ * partial batch is written as well. Returns true if anything was written.
+ */
+bool LogThread::write_batches(const bool drain) {
+	bool wrote = false;
+
+	while( !error_.is_valid() ) {
+		const size_t to_boundary = sector_size - (file_offset & (sector_size - 1));
+		const size_t available = ring.len();
+		if( (available < to_boundary) && (!drain || (available == 0)) ) {
+			break;
+		}
+
+		const size_t length = ring.out(batch.data(), std::min(available, to_boundary));
+		const auto result = file.write(batch.data(), length);
+		if( result.is_error() ) {
+			error_ = { result.error() };
+			break;
+		}
+
+		file_offset += length;
+		stats.bytes_written += length;
+		stats.writes++;
+		wrote = true;
+	}
+
+	return wrote;
+}
@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2026 agent
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __LOG_THREAD_H__
+#define __LOG_THREAD_H__
+
+#include "ch.h"
+
+#include "file.hpp"
+#include "fifo.hpp"
+#include "optional.hpp"
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <string>
+
+struct LogStatistics {
+	uint32_t lines_queued { 0 };
+	uint32_t lines_dropped { 0 };
+	uint32_t bytes_written { 0 };
+	uint32_t writes { 0 };
+	uint32_t syncs { 0 };
+};
+
+/* Buffers log lines in a lock-free ring and writes them to the SD card from
+ * a dedicated thread, so producers on the event loop never block on FatFs.
+ * push() must only be called from a single thread (the event loop, which
+ * also runs the decoder message handlers).
+ */
+class LogThread {
+public:
+	static constexpr uint32_t default_sync_interval_ms = 1000;
+
+	LogThread(File& file, const uint32_t sync_interval_ms);
+	~LogThread();
+
+	LogThread(const LogThread&) = delete;
+	LogThread(LogThread&&) = delete;
+	LogThread& operator=(const LogThread&) = delete;
+	LogThread& operator=(LogThread&&) = delete;
+
+	/* Queues a complete line (CR/LF is appended). Returns false and counts
+	 * a drop if the ring can't hold the whole line. */
+	bool push(const std::string& line);
+
+	/* Queues prefix and line back to back as a single line, so callers can
+	 * prepend a timestamp without concatenating on the heap. */
+	bool push(
+		const char* const prefix, const size_t prefix_length,
+		const char* const line, const size_t line_length
+	);
+
+	Optional<File::Error> error() const {
+		return error_;
+	}
+
+	/* Summed over every log closed since boot. */
+	static LogStatistics totals();
+
+private:
+	static constexpr size_t ring_k = 11;
+	static constexpr size_t sector_size = 512;
+	static constexpr eventmask_t EVT_MASK_LOG_DATA = EVENT_MASK(0);
+
+	std::array<uint8_t, 1 << ring_k> ring_data { };
+	FIFO<uint8_t> ring { ring_data.data(), ring_k };
+	std::array<uint8_t, sector_size> batch { };
+
+	File& file;
+	const systime_t sync_interval;
+	File::Size file_offset;
+	Optional<File::Error> error_ { };
+	LogStatistics stats { };
+	Thread* thread { nullptr };
+
+	static msg_t static_fn(void* arg);
+
+	void run();
+	bool write_batches(const bool drain);
+};
+
+#endif/*__LOG_THREAD_H__*/
@@ -0,0 +1,480 @@
+/*
+ * Copyright (C) 2026 agent
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "peak_index.hpp"
+
+#include "event_m0.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace peak_index {
+
+static constexpr uint8_t magic[4] { 'P', 'K', 'I', '1' };
+static constexpr size_t chunk_size = 512;
+
+static size_t frame_size(const Format format) {
+	switch(format) {
+	case Format::U8:	return 1;
+	case Format::CS16:	return 4;
+	default:			return 2;
+	}
+}
+
+static uint64_t block_size(const size_t level) {
+	return static_cast<uint64_t>(base_block) << (level * level_factor_log2);
+}
+
+static uint64_t level_entries(const header_t& header, const size_t level) {
+	const auto block = block_size(level);
+	return (header.sample_count + block - 1) / block;
+}
+
+static void layout(header_t& header, const Source& source) {
+	memcpy(header.magic, magic, sizeof(magic));
+	header.format = static_cast<uint8_t>(source.format);
+	header.complete = 0;
+	header.reserved = 0;
+	header.data_offset = source.data_offset;
+	header.sample_count = source.sample_count;
+
+	uint32_t offset = sizeof(header_t);
+	size_t level = 0;
+	do {
+		header.level_offset[level] = offset;
+		offset += level_entries(header, level) * sizeof(Peak);
+		level++;
+	} while( (level < max_levels) && (level_entries(header, level - 1) > 1) );
+	header.level_count = level;
+}
+
+static void merge(Peak& acc, const Peak p) {
+	acc.min = std::min(acc.min, p.min);
+	acc.max = std::max(acc.max, p.max);
+}
+
+static constexpr Peak peak_empty { 127, -128 };
+
+/* Decodes one frame at p, which is aligned to the frame size. */
+static Peak sample_peak(const uint8_t* const p, const Format format) {
+	switch(format) {
+	case Format::U8: {
+		const int8_t v = static_cast<int8_t>(p[0] - 128);
+		return { v, v };
+	}
+
+	case Format::CS16: {
+		const auto iq = reinterpret_cast<const int16_t*>(p);
+		const int32_t m = std::min(std::max(std::abs(iq[0]), std::abs(iq[1])) >> 8, 127);
+		return { static_cast<int8_t>(-m), static_cast<int8_t>(m) };
+	}
+
+	default: {
+		const int8_t v = *reinterpret_cast<const int16_t*>(p) >> 8;
+		return { v, v };
+	}
+	}
+}
+
+static void finish(Peak* const out, const size_t count) {
+	for(size_t i=0; i<count; i++) {
+		if( out[i].min > out[i].max ) {
+			out[i] = { 0, 0 };
+		}
+	}
+}
+
+std::filesystem::path sidecar_path(const std::filesystem::path& path) {
+	auto result = path;
+	result.replace_extension(u".PKI");
+	return result;
+}
+
+bool read_raw(
+	File& file,
+	const Source& source,
+	const uint64_t start,
+	const uint32_t samples_per_pixel,
+	Peak* const out,
+	const size_t count
+) {
+	std::fill(out, out + count, peak_empty);
+
+	const size_t frame = frame_size(source.format);
+	const uint64_t end = std::min(source.sample_count, start + static_cast<uint64_t>(samples_per_pixel) * count);
+
+	if( (samples_per_pixel == 0) || (start >= end) ) {
+		finish(out, count);
+		return true;
+	}
+
+	if( file.seek(source.data_offset + start * frame).is_error() ) {
+		return false;
+	}
+
+	uint32_t buffer[chunk_size / sizeof(uint32_t)];
+	const auto bytes = reinterpret_cast<const uint8_t*>(buffer);
+
+	size_t pixel = 0;
+	uint32_t in_pixel = 0;
+	uint64_t remaining = end - start;
+	while( remaining ) {
+		const size_t frames = std::min<uint64_t>(remaining, chunk_size / frame);
+		const auto read_result = file.read(buffer, frames * frame);
+		if( read_result.is_error() ) {
+			return false;
+		}
+		const size_t got = read_result.value() / frame;
+		if( got == 0 ) {
+			break;
+		}
+
+		for(size_t i=0; i<got; i++) {
+			merge(out[pixel], sample_peak(&bytes[i * frame], source.format));
+			if( ++in_pixel == samples_per_pixel ) {
+				in_pixel = 0;
+				pixel++;
+			}
+		}
+		remaining -= got;
+	}
+
+	finish(out, count);
+	return true;
+}
+
+/* Index ****************************************************************/
+
+bool Index::open(const std::filesystem::path& sidecar, const Source& source) {
+	close();
+
+	file = std::make_unique<File>();
+	if( file->open(sidecar).is_valid() ) {
+		file.reset();
+		return false;
+	}
+
+	const auto read_result = file->read(&header, sizeof(header));
+	if( read_result.is_error() || (read_result.value() != sizeof(header)) ) {
+		return false;
+	}
+
+	header_t expected { };
+	layout(expected, source);
+
+	valid = (memcmp(header.magic, magic, sizeof(magic)) == 0) &&
+		header.complete &&
+		(header.format == expected.format) &&
+		(header.data_offset == expected.data_offset) &&
+		(header.sample_count == expected.sample_count) &&
+		(header.level_count == expected.level_count);
+
+	if( !valid ) {
+		// Let the builder recreate it.
+		file.reset();
+	}
+
+	return valid;
+}
+
+void Index::close() {
+	valid = false;
+	file.reset();
+}
+
+bool Index::read(
+	const uint64_t start,
+	const uint32_t samples_per_pixel,
+	Peak* const out,
+	const size_t count
+) {
+	if( !valid || (samples_per_pixel < base_block) ) {
+		return false;
+	}
+
+	// Coarsest level that still gives at least one entry per pixel.
+	size_t level = 0;
+	while( (level + 1 < header.level_count) && (block_size(level + 1) <= samples_per_pixel) ) {
+		level++;
+	}
+
+	const uint64_t block = block_size(level);
+	const uint64_t end = start + static_cast<uint64_t>(samples_per_pixel) * count;
+	uint64_t entry = start / block;
+	const uint64_t entry_end = std::min(level_entries(header, level), (end + block - 1) / block);
+
+	std::fill(out, out + count, peak_empty);
+
+	if( entry < entry_end ) {
+		if( file->seek(header.level_offset[level] + entry * sizeof(Peak)).is_error() ) {
+			return false;
+		}
+	}
+
+	Peak buffer[64];
+	while( entry < entry_end ) {
+		const size_t n = std::min<uint64_t>(entry_end - entry, 64);
+		const auto read_result = file->read(buffer, n * sizeof(Peak));
+		if( read_result.is_error() || (read_result.value() != n * sizeof(Peak)) ) {
+			return false;
+		}
+
+		// Each entry goes to the pixel holding its center. A pixel is at
+		// least one block wide, so none is left without an entry.
+		for(size_t i=0; i<n; i++, entry++) {
+			const uint64_t center = entry * block + block / 2;
+			if( center >= start ) {
+				const uint64_t pixel = (center - start) / samples_per_pixel;
+				if( pixel < count ) {
+					merge(out[pixel], buffer[i]);
+				}
+			}
+		}
+	}
+
+	finish(out, count);
+	return true;
+}
+
+/* Builder **************************************************************/
+
+Builder::Builder(
+	const std::filesystem::path& source_path,
+	const Source& source,
+	std::function<void(bool success)> done_callback
+) : source_path { source_path },
+	source { source },
+	done_callback { std::move(done_callback) }
+{
+	// FATFS keeps its long file name buffer on the stack, the file objects
+	// and read chunk are members to keep the rest small
+	thread = chThdCreateFromHeap(NULL, 2048, NORMALPRIO - 10, Builder::static_fn, this);
+}
+
+Builder::~Builder() {
+	if( thread ) {
+		chThdTerminate(thread);
+		chThdWait(thread);
+		thread = nullptr;
+	}
+}
+
+msg_t Builder::static_fn(void* arg) {
+	chRegSetThreadName("peak_index");
+	auto obj = static_cast<Builder*>(arg);
+	const auto success = obj->run();
+	obj->done = true;
+	if( obj->done_callback ) {
+		obj->done_callback(success);
+	}
+	return 0;
+}
+
+void Builder::flush(const size_t level) {
+	auto& l = levels[level];
+	if( l.buffered == 0 ) {
+		return;
+	}
+
+	if( sidecar.seek(header.level_offset[level] + l.written * sizeof(Peak)).is_error() ||
+		sidecar.write(l.buffer.data(), l.buffered * sizeof(Peak)).is_error() ) {
+		write_error = true;
+	}
+
+	l.written += l.buffered;
+	l.buffered = 0;
+}
+
+void Builder::emit(const size_t level, const Peak peak) {
+	auto& l = levels[level];
+	l.buffer[l.buffered++] = peak;
+	if( l.buffered == l.buffer.size() ) {
+		flush(level);
+	}
+
+	if( level + 1 < header.level_count ) {
+		auto& up = levels[level + 1];
+		merge(up.acc, peak);
+		if( ++up.acc_count == (1U << level_factor_log2) ) {
+			emit(level + 1, up.acc);
+			up.acc = peak_empty;
+			up.acc_count = 0;
+		}
+	}
+}
+
+bool Builder::run() {
+	if( file.open(source_path).is_valid() ) {
+		return false;
+	}
+	if( file.seek(source.data_offset).is_error() ) {
+		return false;
+	}
+
+	layout(header, source);
+	for(auto& l : levels) {
+		l.acc = peak_empty;
+		l.acc_count = 0;
+		l.written = 0;
+		l.buffered = 0;
+	}
+
+	if( sidecar.create(sidecar_path(source_path)).is_valid() ) {
+		return false;
+	}
+	if( sidecar.write(&header, sizeof(header)).is_error() ) {
+		return false;
+	}
+
+	const size_t frame = frame_size(source.format);
+	static_assert(sizeof(chunk) == chunk_size, "Builder chunk must hold chunk_size bytes");
+	const auto bytes = reinterpret_cast<const uint8_t*>(chunk.data());
+
+	auto& base = levels[0];
+	uint64_t remaining = source.sample_count;
+	while( remaining ) {
+		if( chThdShouldTerminate() ) {
+			return false;
+		}
+
+		const size_t frames = std::min<uint64_t>(remaining, chunk_size / frame);
+		const auto read_result = file.read(chunk.data(), frames * frame);
+		if( read_result.is_error() ) {
+			return false;
+		}
+		const size_t got = read_result.value() / frame;
+		if( got == 0 ) {
+			break;
+		}
+
+		for(size_t i=0; i<got; i++) {
+			merge(base.acc, sample_peak(&bytes[i * frame], source.format));
+			if( ++base.acc_count == base_block ) {
+				emit(0, base.acc);
+				base.acc = peak_empty;
+				base.acc_count = 0;
+			}
+		}
+		remaining -= got;
+
+		if( write_error ) {
+			return false;
+		}
+	}
+
+	if( remaining ) {
+		// Source shorter than its header says, leave the index unfinished.
+		return false;
+	}
+
+	// Partial blocks at the end of each level, finest first so that they
+	// ripple up into the levels above.
+	if( base.acc_count ) {
+		emit(0, base.acc);
+	}
+	for(size_t level=1; level<header.level_count; level++) {
+		if( levels[level].acc_count ) {
+			emit(level, levels[level].acc);
+		}
+	}
+
+	for(size_t level=0; level<header.level_count; level++) {
+		flush(level);
+	}
+
+	header.complete = 1;
+	if( write_error ||
+		sidecar.seek(0).is_error() ||
+		sidecar.write(&header, sizeof(header)).is_error() ||
+		sidecar.sync().is_valid() ) {
+		return false;
+	}
+
+	return true;
+}
+
+/* Reader ***************************************************************/
+
+bool Reader::open(const std::filesystem::path& new_path, const Source& source) {
+	close();
+
+	path = new_path;
+	source_ = source;
+
+	raw = std::make_unique<File>();
+	if( raw->open(path).is_valid() ) {
+		raw.reset();
+		return false;
+	}
+
+	if( !index.open(sidecar_path(path), source_) ) {
+		builder = std::make_unique<Builder>(
+			path, source_,
+			[](bool success) {
+				PeakIndexDoneMessage message { success };
+				EventDispatcher::send_message(message);
+			}
+		);
+	}
+
+	return true;
+}
+
+void Reader::close() {
+	builder.reset();
+	index.close();
+	raw.reset();
+}
+
+void Reader::index_done(const bool success) {
+	// Stale message from a builder that was cancelled when another file was opened.
+	if( !builder || !builder->is_done() ) {
+		return;
+	}
+
+	builder.reset();
+	if( success && raw ) {
+		index.open(sidecar_path(path), source_);
+	}
+}
+
+bool Reader::read(
+	const uint64_t start,
+	const uint32_t samples_per_pixel,
+	Peak* const out,
+	const size_t count
+) {
+	if( !raw ) {
+		return false;
+	}
+
+	if( index.read(start, samples_per_pixel, out, count) ) {
+		return true;
+	}
+
+	if( (static_cast<uint64_t>(samples_per_pixel) * count) <= raw_span_max ) {
+		return read_raw(*raw, source_, start, samples_per_pixel, out, count);
+	}
+
+	return false;
+}
+
+} /* namespace peak_index */
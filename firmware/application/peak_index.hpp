@@ -0,0 +1,224 @@
+/*
+ * Copyright (C) 2026 agent
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __PEAK_INDEX_H__
+#define __PEAK_INDEX_H__
+
+#include "ch.h"
+
+#include "file.hpp"
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <functional>
+#include <memory>
+
+/* Min/max peak pyramid of a sample file, cached in a sidecar file next to it.
+ * Level 0 holds one peak per base_block source samples, each further level
+ * merges level_factor entries of the one below. Any zoom coarser than
+ * base_block samples per pixel is drawn from one contiguous range of one
+ * level; finer zooms read the source samples directly.
+ */
+namespace peak_index {
+
+enum class Format : uint8_t {
+	U8 = 0,		// 8-bit unsigned mono (WAV)
+	S16 = 1,	// 16-bit signed mono (WAV)
+	CS16 = 2,	// 16-bit signed I/Q pairs (C16 captures), peak of max(|I|,|Q|)
+};
+
+struct Source {
+	uint32_t data_offset;
+	uint64_t sample_count;
+	Format format;
+};
+
+struct Peak {
+	int8_t min;
+	int8_t max;
+};
+
+constexpr uint32_t base_block = 64;
+constexpr size_t level_factor_log2 = 2;
+constexpr size_t max_levels = 12;
+
+std::filesystem::path sidecar_path(const std::filesystem::path& path);
+
+/* Peaks straight from the source samples, for samples_per_pixel below
+ * base_block: one seek, then sequential reads of samples_per_pixel * count
+ * samples.
+ */
+bool read_raw(
+	File& file,
+	const Source& source,
+	const uint64_t start,
+	const uint32_t samples_per_pixel,
+	Peak* const out,
+	const size_t count
+);
+
+struct header_t {
+	uint8_t magic[4];
+	uint8_t format;
+	uint8_t level_count;
+	uint8_t complete;
+	uint8_t reserved;
+	uint32_t data_offset;
+	uint64_t sample_count;
+	uint32_t level_offset[max_levels];
+};
+
+class Index {
+public:
+	Index() = default;
+
+	Index(const Index&) = delete;
+	Index(Index&&) = delete;
+	Index& operator=(const Index&) = delete;
+	Index& operator=(Index&&) = delete;
+
+	/* Fails if the sidecar is missing, unfinished or was built for
+	 * different source data. */
+	bool open(const std::filesystem::path& sidecar, const Source& source);
+	void close();
+
+	bool is_open() const {
+		return valid;
+	}
+
+	/* One peak per pixel, pixel n spanning samples_per_pixel source samples
+	 * from start + n * samples_per_pixel. Pixels past the end read as zero.
+	 */
+	bool read(
+		const uint64_t start,
+		const uint32_t samples_per_pixel,
+		Peak* const out,
+		const size_t count
+	);
+
+private:
+	std::unique_ptr<File> file { };
+	header_t header { };
+	bool valid { false };
+};
+
+/* Builds the sidecar from a low priority thread so that the UI keeps
+ * working while the source is streamed through once.
+ */
+class Builder {
+public:
+	Builder(
+		const std::filesystem::path& source_path,
+		const Source& source,
+		std::function<void(bool success)> done_callback
+	);
+	~Builder();
+
+	Builder(const Builder&) = delete;
+	Builder(Builder&&) = delete;
+	Builder& operator=(const Builder&) = delete;
+	Builder& operator=(Builder&&) = delete;
+
+	bool is_done() const {
+		return done;
+	}
+
+private:
+	struct Level {
+		Peak acc;
+		uint32_t acc_count;
+		uint32_t written;
+		size_t buffered;
+		std::array<Peak, 64> buffer;
+	};
+
+	std::filesystem::path source_path;
+	Source source;
+	std::function<void(bool success)> done_callback;
+	Thread* thread { nullptr };
+	volatile bool done { false };
+
+	File file { };
+	File sidecar { };
+	std::array<uint32_t, 512 / sizeof(uint32_t)> chunk { };
+	header_t header { };
+	std::array<Level, max_levels> levels { };
+	bool write_error { false };
+
+	static msg_t static_fn(void* arg);
+
+	bool run();
+	void emit(const size_t level, const Peak peak);
+	void flush(const size_t level);
+};
+
+/* What the views use: reads through the index when it is there, falls back
+ * to the source samples for fine zooms and short spans, and builds the
+ * sidecar in the background when it is missing or stale. Completion is
+ * posted as a PeakIndexDoneMessage, which the view passes to index_done().
+ */
+class Reader {
+public:
+	static constexpr uint64_t raw_span_max = 65536;
+
+	Reader() = default;
+
+	Reader(const Reader&) = delete;
+	Reader(Reader&&) = delete;
+	Reader& operator=(const Reader&) = delete;
+	Reader& operator=(Reader&&) = delete;
+
+	bool open(const std::filesystem::path& path, const Source& source);
+	void close();
+
+	void index_done(const bool success);
+
+	bool is_indexed() const {
+		return index.is_open();
+	}
+
+	bool is_building() const {
+		return (bool)builder;
+	}
+
+	const Source& source() const {
+		return source_;
+	}
+
+	bool read(
+		const uint64_t start,
+		const uint32_t samples_per_pixel,
+		Peak* const out,
+		const size_t count
+	);
+
+private:
+	std::filesystem::path path { };
+	Source source_ { };
+	std::unique_ptr<File> raw { };
+	Index index { };
+	std::unique_ptr<Builder> builder { };
+};
+
+} /* namespace peak_index */
+
+#endif/*__PEAK_INDEX_H__*/
@@ -81,6 +81,7 @@ ReceiverModel receiver_model;
 TransmitterModel transmitter_model;
 
 TemperatureLogger temperature_logger;
+ScreenRecorder screen_recorder;
 
 bool antenna_bias { false };
 uint8_t bl_tick_counter { 0 };
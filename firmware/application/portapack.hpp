@@ -35,6 +35,7 @@
 #include "radio.hpp"
 #include "clock_manager.hpp"
 #include "temperature_logger.hpp"
+#include "screen_recorder.hpp"
 
 namespace portapack {
 
@@ -60,6 +61,7 @@ extern uint8_t bl_tick_counter;
 extern bool antenna_bias;
 
 extern TemperatureLogger temperature_logger;
+extern ScreenRecorder screen_recorder;
 
 void set_antenna_bias(const bool v);
 bool get_antenna_bias();
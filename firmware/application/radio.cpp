@@ -135,24 +135,50 @@ void set_direction(const rf::Direction new_direction) {
 }
 
 bool set_tuning_frequency(const rf::Frequency frequency) {
+	return set_tuning(hop_entry(frequency));
+}
+
+HopEntry hop_entry(const rf::Frequency frequency) {
+	HopEntry entry;
+
 	const auto tuning_config = tuning::config::create(frequency);
 	if( tuning_config.is_valid() ) {
-		first_if.disable();
-
 		if( tuning_config.first_lo_frequency ) {
-			first_if.set_frequency(tuning_config.first_lo_frequency);
-			first_if.enable();
+			entry.first_lo = rffc507x::synth_image(tuning_config.first_lo_frequency);
+			entry.first_lo_enabled = true;
 		}
+		entry.second_lo = max2837::synth_image(tuning_config.second_lo_frequency);
+		entry.rf_path_band = tuning_config.rf_path_band;
+		entry.baseband_invert = tuning_config.baseband_invert;
+	}
 
-		const auto result_second_if = second_if.set_frequency(tuning_config.second_lo_frequency);
-
-		rf_path.set_band(tuning_config.rf_path_band);
-		baseband_cpld.set_invert(tuning_config.baseband_invert);
+	return entry;
+}
 
-		return result_second_if;
-	} else {
+bool set_tuning(const HopEntry& entry) {
+	if( !entry.is_valid() ) {
 		return false;
 	}
+
+	if( entry.first_lo_enabled ) {
+		/* Only toggle ENBL (and pay for recalibration) if the LO moves. */
+		if( !first_if.is_enabled() || !first_if.is_tuned_to(entry.first_lo) ) {
+			first_if.disable();
+			first_if.set_frequency(entry.first_lo);
+			first_if.enable();
+		}
+	} else if( first_if.is_enabled() ) {
+		first_if.disable();
+	}
+
+	if( !second_if.is_tuned_to(entry.second_lo) ) {
+		second_if.set_frequency(entry.second_lo);
+	}
+
+	rf_path.set_band(entry.rf_path_band);
+	baseband_cpld.set_invert(entry.baseband_invert);
+
+	return true;
 }
 
 void set_rf_amp(const bool rf_amp) {
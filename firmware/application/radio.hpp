@@ -24,6 +24,9 @@
 
 #include "rf_path.hpp"
 
+#include "rffc507x.hpp"
+#include "max2837.hpp"
+
 #include <cstdint>
 #include <cstddef>
 
@@ -39,10 +42,29 @@ struct Configuration {
 	int8_t vga_gain;
 };
 
+/* One precomputed retune: everything set_tuning_frequency() would derive
+ * from a frequency, reduced to register fields. Build a list of these once
+ * (a hop plan) and replay them with set_tuning(); only registers that differ
+ * from the current radio state are written.
+ */
+struct HopEntry {
+	rffc507x::SynthImage first_lo { };
+	max2837::SynthImage second_lo { };
+	rf::path::Band rf_path_band { rf::path::Band::Mid };
+	bool first_lo_enabled { false };
+	bool baseband_invert { false };
+
+	bool is_valid() const {
+		return second_lo.valid;
+	}
+};
+
 void init();
 
 void set_direction(const rf::Direction new_direction);
 bool set_tuning_frequency(const rf::Frequency frequency);
+HopEntry hop_entry(const rf::Frequency frequency);
+bool set_tuning(const HopEntry& entry);
 void set_rf_amp(const bool rf_amp);
 void set_lna_gain(const int_fast8_t db);
 void set_vga_gain(const int_fast8_t db);
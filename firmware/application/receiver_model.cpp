@@ -65,6 +65,10 @@ void ReceiverModel::set_tuning_frequency(rf::Frequency f) {
 	update_tuning_frequency();
 }
 
+radio::HopEntry ReceiverModel::hop_entry(rf::Frequency f) {
+	return radio::hop_entry(f + tuning_offset());
+}
+
 rf::Frequency ReceiverModel::frequency_step() const {
 	return frequency_step_;
 }
@@ -158,6 +162,29 @@ void ReceiverModel::set_squelch_level(uint8_t v) {
 	update_modulation();
 }
 
+uint32_t ReceiverModel::tone_squelch() const {
+	return tone_squelch_;
+}
+
+void ReceiverModel::set_tone_squelch(const uint32_t v) {
+	tone_squelch_ = v;
+	update_modulation();
+}
+
+bool ReceiverModel::audio_agc() const {
+	return audio_agc_;
+}
+
+bool ReceiverModel::noise_blanker() const {
+	return noise_blanker_;
+}
+
+void ReceiverModel::set_audio_processing(const bool agc, const bool noise_blanker) {
+	audio_agc_ = agc;
+	noise_blanker_ = noise_blanker;
+	update_modulation();
+}
+
 void ReceiverModel::enable() {
 	enabled_ = true;
 	radio::set_direction(rf::Direction::Receive);
@@ -276,8 +303,10 @@ void ReceiverModel::update_modulation() {
 
 	case Mode::SpectrumAnalysis:
 	case Mode::Capture:
-		break;
+		return;
 	}
+
+	baseband::set_audio_processing(audio_agc_, noise_blanker_);
 }
 
 size_t ReceiverModel::am_configuration() const {
@@ -293,7 +322,7 @@ size_t ReceiverModel::nbfm_configuration() const {
 }
 
 void ReceiverModel::update_nbfm_configuration() {
-	nbfm_configs[nbfm_config_index].apply(squelch_level_);
+	nbfm_configs[nbfm_config_index].apply(squelch_level_, tone_squelch_);
 }
 
 size_t ReceiverModel::wfm_configuration() const {
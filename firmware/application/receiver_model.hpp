@@ -28,6 +28,7 @@
 #include "message.hpp"
 #include "rf_path.hpp"
 #include "max2837.hpp"
+#include "radio.hpp"
 #include "volume.hpp"
 
 class ReceiverModel {
@@ -43,6 +44,12 @@ public:
 	rf::Frequency tuning_frequency() const;
 	void set_tuning_frequency(rf::Frequency f);
 
+	/* Retune precomputed for hop plans, including the current mode's tuning
+	 * offset. Replay with radio::set_tuning(); the tuned frequency in
+	 * persistent memory is left alone.
+	 */
+	radio::HopEntry hop_entry(rf::Frequency f);
+
 	rf::Frequency frequency_step() const;
 	void set_frequency_step(rf::Frequency f);
 
@@ -75,6 +82,14 @@ public:
 	uint8_t squelch_level() const;
 	void set_squelch_level(uint8_t v);
 
+	/* See NBFMConfigureMessage::tone_squelch. */
+	uint32_t tone_squelch() const;
+	void set_tone_squelch(const uint32_t v);
+
+	bool audio_agc() const;
+	bool noise_blanker() const;
+	void set_audio_processing(const bool agc, const bool noise_blanker);
+
 	void enable();
 	void disable();
 
@@ -102,6 +117,9 @@ private:
 	size_t wfm_config_index = 0;
 	volume_t headphone_volume_ { -43.0_dB };
 	uint8_t squelch_level_ { 80 };
+	uint32_t tone_squelch_ { NBFMConfigureMessage::tone_squelch_off };
+	bool audio_agc_ { false };
+	bool noise_blanker_ { false };
 
 	int32_t tuning_offset();
 
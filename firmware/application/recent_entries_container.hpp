@@ -0,0 +1,322 @@
+/*
+ * Copyright (C) 2026 agent
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __RECENT_ENTRIES_CONTAINER_H__
+#define __RECENT_ENTRIES_CONTAINER_H__
+
+#include "utility.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <array>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <iterator>
+#include <algorithm>
+
+/* Key hashing for RecentEntries. Keys that aren't integers provide their own
+ * hash_key() overload next to their definition, found by argument-dependent
+ * lookup.
+ */
+inline uint32_t hash_key(const uint64_t k) {
+	// Fold to 32 bits (the M0 has no 64-bit multiply), then MurmurHash3 fmix32.
+	uint32_t h = static_cast<uint32_t>(k) ^ static_cast<uint32_t>(k >> 32);
+	h ^= h >> 16;
+	h *= 0x85ebca6b;
+	h ^= h >> 13;
+	h *= 0xc2b2ae35;
+	h ^= h >> 16;
+	return h;
+}
+
+/* Fixed-capacity recent entries, most recently seen first.
+ *
+ * Entries live in a fixed slot array and never move, so references and
+ * iterators stay valid until the entry is evicted. A small open-addressed
+ * (linear probing) table maps keys to slots, and an intrusive doubly linked
+ * list over slot indices keeps the most-recently-seen order. Finding or
+ * promoting an entry is O(1) and nothing is allocated after construction.
+ * When full, touching a new key evicts the least recently seen entry.
+ */
+template<class Entry, size_t N = 64>
+class RecentEntries {
+	using index_t = uint8_t;
+	static_assert(N > 0 && N < 255, "RecentEntries capacity must fit slot index type");
+
+	static constexpr index_t npos = 0xff;
+	// At most half full, rounded up to a power of two for masking.
+	static constexpr size_t table_size = size_t(1) << (log_2(N * 2 - 1) + 1);
+	static constexpr size_t table_mask = table_size - 1;
+
+	template<typename Container, typename Value>
+	class basic_iterator {
+	public:
+		using iterator_category = std::bidirectional_iterator_tag;
+		using value_type = Entry;
+		using difference_type = std::ptrdiff_t;
+		using pointer = Value*;
+		using reference = Value&;
+
+		basic_iterator(
+			Container* const entries,
+			const index_t index
+		) : entries { entries },
+			index { index }
+		{
+		}
+
+		// iterator -> const_iterator
+		template<typename OtherContainer, typename OtherValue>
+		basic_iterator(
+			const basic_iterator<OtherContainer, OtherValue>& other
+		) : entries { other.entries },
+			index { other.index }
+		{
+		}
+
+		reference operator*() const { return entries->slot(index); }
+		pointer operator->() const { return &entries->slot(index); }
+
+		basic_iterator& operator++() {
+			index = entries->next[index];
+			return *this;
+		}
+
+		basic_iterator operator++(int) {
+			auto result = *this;
+			++*this;
+			return result;
+		}
+
+		basic_iterator& operator--() {
+			index = (index == npos) ? entries->tail : entries->prev[index];
+			return *this;
+		}
+
+		basic_iterator operator--(int) {
+			auto result = *this;
+			--*this;
+			return result;
+		}
+
+		bool operator==(const basic_iterator& other) const { return index == other.index; }
+		bool operator!=(const basic_iterator& other) const { return index != other.index; }
+
+	private:
+		Container* entries;
+		index_t index;
+
+		template<typename, typename> friend class basic_iterator;
+		friend class RecentEntries;
+	};
+
+public:
+	using Key = typename Entry::Key;
+	using value_type = Entry;
+	using size_type = size_t;
+	using reference = Entry&;
+	using const_reference = const Entry&;
+	using iterator = basic_iterator<RecentEntries, Entry>;
+	using const_iterator = basic_iterator<const RecentEntries, const Entry>;
+
+	RecentEntries() {
+		table.fill(npos);
+		for(size_t i=0; i<N; i++) {
+			next[i] = (i + 1 < N) ? (i + 1) : npos;
+		}
+		free_head = 0;
+	}
+
+	~RecentEntries() {
+		clear();
+	}
+
+	RecentEntries(const RecentEntries&) = delete;
+	RecentEntries(RecentEntries&&) = delete;
+	RecentEntries& operator=(const RecentEntries&) = delete;
+	RecentEntries& operator=(RecentEntries&&) = delete;
+
+	iterator begin() { return { this, head }; }
+	iterator end() { return { this, npos }; }
+	const_iterator begin() const { return { this, head }; }
+	const_iterator end() const { return { this, npos }; }
+
+	bool empty() const { return count == 0; }
+	size_t size() const { return count; }
+	static constexpr size_t capacity() { return N; }
+
+	reference front() { return slot(head); }
+	const_reference front() const { return slot(head); }
+
+	const_iterator find(const Key& key) const {
+		return { this, find_slot(key) };
+	}
+
+	iterator find(const Key& key) {
+		return { this, find_slot(key) };
+	}
+
+	/* Moves the entry for key to the front, creating it (and evicting the
+	 * least recently seen entry if full) if it isn't present. */
+	reference touch(const Key& key) {
+		auto index = find_slot(key);
+		if( index != npos ) {
+			unlink(index);
+		} else {
+			if( count == N ) {
+				evict(tail);
+			}
+			index = free_head;
+			free_head = next[index];
+			new (&storage[index]) Entry(key);
+			table_insert(index);
+			count++;
+		}
+		link_front(index);
+		return slot(index);
+	}
+
+	void truncate(const size_t entries_max) {
+		while( count > entries_max ) {
+			evict(tail);
+		}
+	}
+
+	void clear() {
+		truncate(0);
+	}
+
+private:
+	using storage_t = typename std::aligned_storage<sizeof(Entry), alignof(Entry)>::type;
+
+	std::array<storage_t, N> storage { };
+	std::array<index_t, N> next { };
+	std::array<index_t, N> prev { };
+	std::array<index_t, table_size> table { };
+	index_t head { npos };
+	index_t tail { npos };
+	index_t free_head { npos };
+	size_t count { 0 };
+
+	Entry& slot(const index_t index) {
+		return *reinterpret_cast<Entry*>(&storage[index]);
+	}
+
+	const Entry& slot(const index_t index) const {
+		return *reinterpret_cast<const Entry*>(&storage[index]);
+	}
+
+	static size_t home(const Key& key) {
+		return hash_key(key) & table_mask;
+	}
+
+	index_t find_slot(const Key& key) const {
+		for(size_t t = home(key); table[t] != npos; t = (t + 1) & table_mask) {
+			if( slot(table[t]).key() == key ) {
+				return table[t];
+			}
+		}
+		return npos;
+	}
+
+	void table_insert(const index_t index) {
+		size_t t = home(slot(index).key());
+		while( table[t] != npos ) {
+			t = (t + 1) & table_mask;
+		}
+		table[t] = index;
+	}
+
+	void table_erase(const index_t index) {
+		size_t i = home(slot(index).key());
+		while( table[i] != index ) {
+			i = (i + 1) & table_mask;
+		}
+
+		// Backward-shift deletion: pull later members of the probe run into
+		// the hole so lookups never need tombstones.
+		size_t j = i;
+		while( true ) {
+			table[i] = npos;
+			size_t k;
+			do {
+				j = (j + 1) & table_mask;
+				if( table[j] == npos ) {
+					return;
+				}
+				k = home(slot(table[j]).key());
+			} while( (i <= j) ? ((i < k) && (k <= j)) : ((i < k) || (k <= j)) );
+			table[i] = table[j];
+			i = j;
+		}
+	}
+
+	void link_front(const index_t index) {
+		prev[index] = npos;
+		next[index] = head;
+		if( head != npos ) {
+			prev[head] = index;
+		} else {
+			tail = index;
+		}
+		head = index;
+	}
+
+	void unlink(const index_t index) {
+		if( prev[index] != npos ) {
+			next[prev[index]] = next[index];
+		} else {
+			head = next[index];
+		}
+		if( next[index] != npos ) {
+			prev[next[index]] = prev[index];
+		} else {
+			tail = prev[index];
+		}
+	}
+
+	void evict(const index_t index) {
+		table_erase(index);
+		unlink(index);
+		slot(index).~Entry();
+		next[index] = free_head;
+		free_head = index;
+		count--;
+	}
+};
+
+template<class Entry, size_t N, typename Key>
+typename RecentEntries<Entry, N>::const_iterator find(const RecentEntries<Entry, N>& entries, const Key key) {
+	return entries.find(key);
+}
+
+template<class Entry, size_t N>
+static void truncate_entries(RecentEntries<Entry, N>& entries, const size_t entries_max = N) {
+	entries.truncate(entries_max);
+}
+
+template<class Entry, size_t N, typename Key>
+typename RecentEntries<Entry, N>::reference on_packet(RecentEntries<Entry, N>& entries, const Key key) {
+	return entries.touch(key);
+}
+
+#endif/*__RECENT_ENTRIES_CONTAINER_H__*/
@@ -61,6 +61,7 @@ ReplayThread::~ReplayThread() {
 }
 
 msg_t ReplayThread::static_fn(void* arg) {
+	chRegSetThreadName("replay");
 	auto obj = static_cast<ReplayThread*>(arg);
 	const auto return_code = obj->run();
 	if( obj->terminate_callback ) {
@@ -78,6 +79,8 @@ uint32_t ReplayThread::run() {
 	// Wait for FIFOs to be allocated in baseband
 	// Wait for ui_replay_view to tell us that the buffers are ready (awful :( )
 	while (!(*ready_sig)) {
+		if (chThdShouldTerminate())
+			return TERMINATED;
 		chThdSleep(100);
 	};
 	
@@ -107,6 +110,8 @@ uint32_t ReplayThread::run() {
 
 	while( !chThdShouldTerminate() ) {
 		auto buffer = buffers.get();
+		if (!buffer)
+			break;
 		
 		auto read_result = reader->read(buffer->data(), buffer->capacity());
 		if( read_result.is_error() ) {
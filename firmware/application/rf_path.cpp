@@ -191,6 +191,9 @@ void Path::set_direction(const Direction new_direction) {
 }
 
 void Path::set_band(const Band new_band) {
+	if( new_band == band ) {
+		return;
+	}
 	band = new_band;
 	update();
 }
@@ -0,0 +1,240 @@
+/*
+ * Copyright (C) 2026 agent
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "screen_recorder.hpp"
+
+#include "portapack.hpp"
+
+#include <algorithm>
+
+// ScreenRecorder::Writer /////////////////////////////////////////////////
+
+ScreenRecorder::Writer::Writer(
+	File& file
+) : file(file)
+{
+	// Need significant stack for FATFS
+	thread = chThdCreateFromHeap(NULL, 1024, NORMALPRIO + 10, Writer::static_fn, this);
+}
+
+ScreenRecorder::Writer::~Writer() {
+	if( thread ) {
+		chThdTerminate(thread);
+		chEvtSignal(thread, EVT_MASK_DATA);
+		chThdWait(thread);
+		thread = nullptr;
+	}
+}
+
+void ScreenRecorder::Writer::push(const uint8_t* const data, const size_t length) {
+	ring.in(data, length);
+
+	// Only wake the writer once there's at least a sector to write.
+	if( thread && (ring.len() >= sector_size) ) {
+		chEvtSignal(thread, EVT_MASK_DATA);
+	}
+}
+
+msg_t ScreenRecorder::Writer::static_fn(void* arg) {
+	chRegSetThreadName("screen_rec");
+	auto obj = static_cast<Writer*>(arg);
+	obj->run();
+	return 0;
+}
+
+void ScreenRecorder::Writer::run() {
+	while( !chThdShouldTerminate() ) {
+		chEvtWaitAny(EVT_MASK_DATA);
+		write_batches(false);
+
+		if( write_failed ) {
+			return;
+		}
+	}
+
+	write_batches(true);
+}
+
+/* The file starts sector aligned and only whole sectors are written until
+ * the final drain. */
+void ScreenRecorder::Writer::write_batches(const bool drain) {
+	while( !write_failed ) {
+		const size_t available = ring.len();
+		if( (available < sector_size) && (!drain || (available == 0)) ) {
+			break;
+		}
+
+		const size_t length = ring.out(batch.data(), std::min(available, sector_size));
+		const auto result = file.write(batch.data(), length);
+		if( result.is_error() ) {
+			write_failed = true;
+		}
+	}
+}
+
+// ScreenRecorder /////////////////////////////////////////////////////////
+
+Optional<File::Error> ScreenRecorder::start(const std::filesystem::path& filename) {
+	stop();
+
+	std::unique_ptr<File> new_file { new File() };
+	const auto create_error = new_file->create(filename);
+	if( create_error.is_valid() ) {
+		return create_error;
+	}
+	file = std::move(new_file);
+	writer = std::make_unique<Writer>(*file);
+
+	start_time = chTimeNow();
+	frame_phase = 0;
+	frames_written = 0;
+	row_recorded.fill(false);
+
+	record_length = 0;
+	put_u8('P'); put_u8('P'); put_u8('S'); put_u8('R');
+	put_u16(version);
+	put_u16(width);
+	put_u16(height);
+	put_u16(format_rgb565);
+	put_u16(frame_interval_ms);
+	put_u16(0);
+	push_record(0);
+
+	return { };
+}
+
+void ScreenRecorder::stop() {
+	if( !file ) {
+		return;
+	}
+
+	// Drains what's queued, and must go before the file it writes
+	writer.reset();
+	file.reset();
+}
+
+void ScreenRecorder::frame_sync() {
+	if( !file ) {
+		return;
+	}
+
+	if( writer->failed() ) {
+		// Most likely the SD card is full or was pulled, give up.
+		stop();
+		return;
+	}
+
+	if( ++frame_phase < frame_interval ) {
+		return;
+	}
+	frame_phase = 0;
+
+	capture_frame();
+}
+
+/* One read of each row: hashed, and if it changed, encoded and queued
+ * straight away. The frame header goes out with the first changed row. A row
+ * the ring has no room for keeps its old hash, so the next frame retries it;
+ * room for the frame end is always kept. */
+void ScreenRecorder::capture_frame() {
+	const uint32_t time_ms = (chTimeNow() - start_time) * 1000 / CH_FREQUENCY;
+	bool frame_started = false;
+
+	for(int y=0; y<height; y++) {
+		portapack::display.read_pixels({ 0, y, width, 1 }, row);
+		const auto hash = row_hash();
+		if( row_recorded[y] && (hash == row_hashes[y]) ) {
+			continue;
+		}
+
+		record_length = 0;
+		if( !frame_started ) {
+			put_u32(time_ms);
+		}
+		encode_row(y);
+
+		if( push_record(sizeof(frame_end)) ) {
+			frame_started = true;
+			row_hashes[y] = hash;
+			row_recorded[y] = true;
+		}
+	}
+
+	if( frame_started ) {
+		record_length = 0;
+		put_u16(frame_end);
+		push_record(0);
+		frames_written++;
+	}
+}
+
+/* FNV-1a over the row as read back. */
+uint32_t ScreenRecorder::row_hash() const {
+	const auto p = reinterpret_cast<const uint8_t*>(row.data());
+	uint32_t hash = 0x811c9dc5;
+	for(size_t i=0; i<sizeof(row); i++) {
+		hash = (hash ^ p[i]) * 0x01000193;
+	}
+	return hash;
+}
+
+void ScreenRecorder::encode_row(const int y) {
+	put_u16(y);
+
+	size_t x = 0;
+	while( x < row.size() ) {
+		const auto& c = row[x];
+		const uint16_t rgb565 = ((c.r & 0xf8) << 8) | ((c.g & 0xfc) << 3) | (c.b >> 3);
+
+		size_t run = 1;
+		while( (x + run < row.size()) && (run < 255) &&
+			(row[x + run].r == c.r) && (row[x + run].g == c.g) && (row[x + run].b == c.b) ) {
+			run++;
+		}
+
+		put_u8(run);
+		put_u16(rgb565);
+		x += run;
+	}
+}
+
+/* Queues the record if it fits with reserve bytes to spare. */
+bool ScreenRecorder::push_record(const size_t reserve) {
+	if( (record_length + reserve) > writer->unused() ) {
+		return false;
+	}
+	writer->push(record.data(), record_length);
+	return true;
+}
+
+void ScreenRecorder::put_u8(const uint8_t v) {
+	record[record_length++] = v;
+}
+
+void ScreenRecorder::put_u16(const uint16_t v) {
+	put_u8((v >> 0) & 0xff);
+	put_u8((v >> 8) & 0xff);
+}
+
+void ScreenRecorder::put_u32(const uint32_t v) {
+	put_u16((v >>  0) & 0xffff);
+	put_u16((v >> 16) & 0xffff);
+}
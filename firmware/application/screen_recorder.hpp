@@ -0,0 +1,150 @@
+/*
+ * Copyright (C) 2026 agent
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __SCREEN_RECORDER_H__
+#define __SCREEN_RECORDER_H__
+
+#include "ch.h"
+
+#include "ui.hpp"
+#include "file.hpp"
+#include "fifo.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <array>
+#include <memory>
+
+/* Continuous screen capture to a compact "PPSR" file, for turning into a
+ * video on a PC (see tools/screen_recording_to_video.py).
+ *
+ * Every frame_interval LCD frames, each row is read back from the display
+ * once and hashed. Only rows whose hash changed are written, RLE-encoded as
+ * RGB565 runs:
+ *
+ *   header: "PPSR", u16 version, u16 width, u16 height, u16 format,
+ *           u16 frame interval (ms), u16 reserved
+ *   frame:  u32 time (ms),
+ *           rows { u16 y, runs { u8 count, u16 rgb565 } covering width },
+ *           u16 0xffff
+ *
+ * All values little-endian.
+ */
+class ScreenRecorder {
+public:
+	ScreenRecorder() = default;
+
+	ScreenRecorder(const ScreenRecorder&) = delete;
+	ScreenRecorder(ScreenRecorder&&) = delete;
+	ScreenRecorder& operator=(const ScreenRecorder&) = delete;
+	ScreenRecorder& operator=(ScreenRecorder&&) = delete;
+
+	Optional<File::Error> start(const std::filesystem::path& filename);
+	void stop();
+
+	bool is_recording() const {
+		return file != nullptr;
+	}
+
+	size_t frames() const {
+		return frames_written;
+	}
+
+	/* Call once per LCD frame, after the widget tree has been painted. */
+	void frame_sync();
+
+private:
+	/* Writes the encoded stream to the SD card from its own thread, like
+	 * LogThread, so the event loop never blocks on FatFs. Records are only
+	 * queued whole: when the ring is short of space the caller keeps the
+	 * record for a later frame instead. */
+	class Writer {
+	public:
+		Writer(File& file);
+		~Writer();
+
+		Writer(const Writer&) = delete;
+		Writer(Writer&&) = delete;
+		Writer& operator=(const Writer&) = delete;
+		Writer& operator=(Writer&&) = delete;
+
+		size_t unused() const {
+			return ring.unused();
+		}
+
+		bool failed() const {
+			return write_failed;
+		}
+
+		void push(const uint8_t* const data, const size_t length);
+
+	private:
+		static constexpr size_t ring_k = 12;
+		static constexpr size_t sector_size = 512;
+		static constexpr eventmask_t EVT_MASK_DATA = EVENT_MASK(0);
+
+		std::array<uint8_t, 1 << ring_k> ring_data { };
+		FIFO<uint8_t> ring { ring_data.data(), ring_k };
+		std::array<uint8_t, sector_size> batch { };
+
+		File& file;
+		volatile bool write_failed { false };
+		Thread* thread { nullptr };
+
+		static msg_t static_fn(void* arg);
+
+		void run();
+		void write_batches(const bool drain);
+	};
+
+	static constexpr int width { 240 };
+	static constexpr int height { 320 };
+	static constexpr uint16_t version { 2 };
+	static constexpr uint16_t format_rgb565 { 1 };
+	static constexpr uint16_t frame_end { 0xffff };
+	static constexpr size_t frame_interval { 6 };	// 10 frames/s at 60Hz
+	static constexpr uint32_t frame_interval_ms { 1000 * frame_interval / 60 };
+
+	std::unique_ptr<File> file { };
+	std::unique_ptr<Writer> writer { };
+	uint32_t start_time { 0 };
+	size_t frame_phase { 0 };
+	size_t frames_written { 0 };
+
+	std::array<uint32_t, height> row_hashes { };
+	std::array<bool, height> row_recorded { };
+	std::array<ui::ColorRGB888, width> row { };
+
+	// Largest record: the frame time, then a row of single-pixel runs
+	std::array<uint8_t, 4 + 2 + width * 3> record { };
+	size_t record_length { 0 };
+
+	void capture_frame();
+	uint32_t row_hash() const;
+	void encode_row(const int y);
+	bool push_record(const size_t reserve);
+
+	void put_u8(const uint8_t v);
+	void put_u16(const uint16_t v);
+	void put_u32(const uint32_t v);
+};
+
+#endif/*__SCREEN_RECORDER_H__*/
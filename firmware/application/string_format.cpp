@@ -21,6 +21,9 @@
 
 #include "string_format.hpp"
 
+#include <algorithm>
+#include <cstring>
+
 static char* to_string_dec_uint_internal(
 	char* p,
 	uint32_t n
@@ -70,13 +73,73 @@ std::string to_string_bin(
 	return p;
 }
 
-std::string to_string_dec_uint(
+static void to_string_hex_internal(char* p, const uint64_t n, const int32_t l) {
+	const uint32_t d = n & 0xf;
+	p[l] = (d > 9) ? (d + 55) : (d + 48);
+	if( l > 0 ) {
+		to_string_hex_internal(p, n >> 4, l - 1);
+	}
+}
+
+// StringWriter ///////////////////////////////////////////////////////////
+
+StringWriter::StringWriter(
+	char* const buffer,
+	const size_t capacity
+) : buffer { buffer },
+	capacity { capacity }
+{
+	buffer[0] = 0;
+}
+
+void StringWriter::clear() {
+	length_ = 0;
+	buffer[0] = 0;
+}
+
+StringWriter& StringWriter::append(const char c) {
+	if( (length_ + 1) < capacity ) {
+		buffer[length_++] = c;
+		buffer[length_] = 0;
+	}
+	return *this;
+}
+
+StringWriter& StringWriter::append(const char* const s, const size_t n) {
+	const size_t count = std::min(n, capacity - 1 - length_);
+	memcpy(&buffer[length_], s, count);
+	length_ += count;
+	buffer[length_] = 0;
+	return *this;
+}
+
+StringWriter& StringWriter::append(const char* const s) {
+	return append(s, strlen(s));
+}
+
+StringWriter& StringWriter::append(const std::string& s) {
+	return append(s.data(), s.size());
+}
+
+StringWriter& StringWriter::resize(const size_t width, const char fill) {
+	if( width < length_ ) {
+		length_ = width;
+		buffer[length_] = 0;
+	}
+	while( length_ < std::min(width, capacity - 1) ) {
+		append(fill);
+	}
+	return *this;
+}
+
+StringWriter& StringWriter::dec_uint(
 	const uint32_t n,
-	const int32_t l,
+	int32_t l,
 	const char fill
 ) {
 	char p[16];
 	auto term = p + sizeof(p) - 1;
+	l = std::min(l, (int32_t)(sizeof(p) - 1));
 	auto q = to_string_dec_uint_pad_internal(term, n, l, fill);
 
 	// Right justify.
@@ -84,12 +147,12 @@ std::string to_string_dec_uint(
 		*(--q) = ' ';
 	}
 
-	return q;
+	return append(q, term - q);
 }
 
-std::string to_string_dec_int(
+StringWriter& StringWriter::dec_int(
 	const int32_t n,
-	const int32_t l,
+	int32_t l,
 	const char fill
 ) {
 	const size_t negative = (n < 0) ? 1 : 0;
@@ -97,6 +160,7 @@ std::string to_string_dec_int(
 
 	char p[16];
 	auto term = p + sizeof(p) - 1;
+	l = std::min(l, (int32_t)(sizeof(p) - 1));
 	auto q = to_string_dec_uint_pad_internal(term, n_abs, l - negative, fill);
 
 	// Add sign.
@@ -109,46 +173,77 @@ std::string to_string_dec_int(
 		*(--q) = ' ';
 	}
 
-	return q;
+	return append(q, term - q);
 }
 
-std::string to_string_short_freq(const uint64_t f) {
-	auto final_str = to_string_dec_int(f / 1000000, 4) + "." + to_string_dec_int((f / 100) % 10000, 4, '0');
-	return final_str;
-}
+StringWriter& StringWriter::hex(const uint64_t n, int32_t l) {
+	char p[32];
 
-std::string to_string_time_ms(const uint32_t ms) {
-	std::string final_str { "" };
-	
-	if (ms < 1000) {
-		final_str = to_string_dec_uint(ms) + "ms";
-	} else {
-		auto seconds = ms / 1000;
-		
-		if (seconds >= 60)
-			final_str = to_string_dec_uint(seconds / 60) + "m";
-		
-		return final_str + to_string_dec_uint(seconds % 60) + "s";
+	l = std::min(l, (int32_t)(sizeof(p) - 1));
+	if( l > 0 ) {
+		to_string_hex_internal(p, n, l - 1);
+		append(p, l);
 	}
-	
-	return final_str;
+	return *this;
 }
 
-static void to_string_hex_internal(char* p, const uint64_t n, const int32_t l) {
-	const uint32_t d = n & 0xf;
-	p[l] = (d > 9) ? (d + 55) : (d + 48);
-	if( l > 0 ) {
-		to_string_hex_internal(p, n >> 4, l - 1);
-	}
+StringWriter& StringWriter::short_freq(const uint64_t f) {
+	return dec_int(f / 1000000, 4).append('.').dec_int((f / 100) % 10000, 4, '0');
+}
+
+StringWriter& StringWriter::time_ms(const uint32_t ms) {
+	if (ms < 1000)
+		return dec_uint(ms).append("ms");
+
+	const auto seconds = ms / 1000;
+	if (seconds >= 60)
+		dec_uint(seconds / 60).append('m');
+
+	return dec_uint(seconds % 60).append('s');
+}
+
+StringWriter& StringWriter::timestamp(const rtc::RTC& value) {
+	return dec_uint(value.year(), 4, '0')
+		.dec_uint(value.month(), 2, '0')
+		.dec_uint(value.day(), 2, '0')
+		.dec_uint(value.hour(), 2, '0')
+		.dec_uint(value.minute(), 2, '0')
+		.dec_uint(value.second(), 2, '0');
+}
+
+// std::string wrappers ///////////////////////////////////////////////////
+
+std::string to_string_dec_uint(
+	const uint32_t n,
+	const int32_t l,
+	const char fill
+) {
+	FixedString<16> s;
+	return s.dec_uint(n, l, fill).c_str();
+}
+
+std::string to_string_dec_int(
+	const int32_t n,
+	const int32_t l,
+	const char fill
+) {
+	FixedString<16> s;
+	return s.dec_int(n, l, fill).c_str();
+}
+
+std::string to_string_short_freq(const uint64_t f) {
+	FixedString<16> s;
+	return s.short_freq(f).c_str();
+}
+
+std::string to_string_time_ms(const uint32_t ms) {
+	FixedString<16> s;
+	return s.time_ms(ms).c_str();
 }
 
 std::string to_string_hex(const uint64_t n, int32_t l) {
-	char p[32];
-	
-	l = std::min(l, 31L);
-	to_string_hex_internal(p, n, l - 1);
-	p[l] = 0;
-	return p;
+	FixedString<32> s;
+	return s.hex(n, l).c_str();
 }
 
 std::string to_string_hex_array(uint8_t * const array, const int32_t l) {
@@ -180,12 +275,8 @@ std::string to_string_datetime(const rtc::RTC& value, const TimeFormat format) {
 }
 
 std::string to_string_timestamp(const rtc::RTC& value) {
-	return to_string_dec_uint(value.year(), 4, '0') +
-		to_string_dec_uint(value.month(), 2, '0') +
-		to_string_dec_uint(value.day(), 2, '0') +
-		to_string_dec_uint(value.hour(), 2, '0') +
-		to_string_dec_uint(value.minute(), 2, '0') +
-		to_string_dec_uint(value.second(), 2, '0');
+	FixedString<16> s;
+	return s.timestamp(value).c_str();
 }
 
 std::string to_string_FAT_timestamp(const FATTimestamp& timestamp) {
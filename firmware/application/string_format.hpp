@@ -23,6 +23,7 @@
 #define __STRING_FORMAT_H__
 
 #include <cstdint>
+#include <cstddef>
 #include <string>
 
 #include "file.hpp"
@@ -39,6 +40,63 @@ enum TimeFormat {
 
 const char unit_prefix[7] { 'n', 'u', 'm', 0, 'k', 'M', 'G' };
 
+/* Formats into a caller-provided buffer without touching the heap. The
+ * buffer is always NUL terminated, and output past the capacity is silently
+ * dropped. Meant for strings rebuilt on every paint or every received
+ * packet, where std::string temporaries churn and fragment the M0 heap.
+ * Field widths and fill behave as in the to_string_*() functions below.
+ */
+class StringWriter {
+public:
+	/* capacity includes the terminating NUL. */
+	StringWriter(char* const buffer, const size_t capacity);
+
+	StringWriter(const StringWriter&) = delete;
+	StringWriter(StringWriter&&) = delete;
+	StringWriter& operator=(const StringWriter&) = delete;
+	StringWriter& operator=(StringWriter&&) = delete;
+
+	const char* c_str() const {
+		return buffer;
+	}
+
+	size_t length() const {
+		return length_;
+	}
+
+	void clear();
+
+	StringWriter& append(const char c);
+	StringWriter& append(const char* const s);
+	StringWriter& append(const char* const s, const size_t n);
+	StringWriter& append(const std::string& s);
+
+	/* Pads with fill or cuts to exactly width characters. */
+	StringWriter& resize(const size_t width, const char fill = ' ');
+
+	StringWriter& dec_uint(const uint32_t n, const int32_t l = 0, const char fill = ' ');
+	StringWriter& dec_int(const int32_t n, const int32_t l = 0, const char fill = 0);
+	StringWriter& hex(const uint64_t n, const int32_t l = 0);
+	StringWriter& short_freq(const uint64_t f);
+	StringWriter& time_ms(const uint32_t ms);
+	StringWriter& timestamp(const rtc::RTC& value);
+
+private:
+	char* const buffer;
+	const size_t capacity;
+	size_t length_ { 0 };
+};
+
+template<size_t N>
+class FixedString : public StringWriter {
+public:
+	FixedString() : StringWriter { storage, N } {
+	}
+
+private:
+	char storage[N];
+};
+
 // TODO: Allow l=0 to not fill/justify? Already using this way in ui_spectrum.hpp...
 std::string to_string_bin(const uint32_t n, const uint8_t l = 0);
 std::string to_string_dec_uint(const uint32_t n, const int32_t l = 0, const char fill = ' ');
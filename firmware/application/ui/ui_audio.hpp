@@ -48,12 +48,10 @@ private:
 	int32_t rms_db_;
 	int32_t max_db_;
 
-	MessageHandlerRegistration message_handler_statistics {
-		Message::ID::AudioStatistics,
-		[this](const Message* const p) {
-			this->on_statistics_update(static_cast<const AudioStatisticsMessage*>(p)->statistics);
-		}
-	};
+	void on_statistics_message(const AudioStatisticsMessage* const message) {
+		on_statistics_update(message->statistics);
+	}
+	MessageHandler<AudioStatisticsMessage, Audio, &Audio::on_statistics_message> message_handler_statistics { this };
 	
 	void on_statistics_update(const AudioStatistics& statistics);
 };
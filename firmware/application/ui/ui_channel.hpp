@@ -48,12 +48,10 @@ public:
 private:
 	int32_t max_db_;
 
-	MessageHandlerRegistration message_handler_stats {
-		Message::ID::ChannelStatistics,
-		[this](const Message* const p) {
-			this->on_statistics_update(static_cast<const ChannelStatisticsMessage*>(p)->statistics);
-		}
-	};
+	void on_stats_message(const ChannelStatisticsMessage* const message) {
+		on_statistics_update(message->statistics);
+	}
+	MessageHandler<ChannelStatisticsMessage, Channel, &Channel::on_stats_message> message_handler_stats { this };
 
 	void on_statistics_update(const ChannelStatistics& statistics);
 };
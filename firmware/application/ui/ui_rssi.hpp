@@ -54,20 +54,15 @@ private:
 	
 	bool pitch_rssi_enabled = false;
 
-	MessageHandlerRegistration message_handler_stats {
-		Message::ID::RSSIStatistics,
-		[this](const Message* const p) {
-			this->on_statistics_update(static_cast<const RSSIStatisticsMessage*>(p)->statistics);
-		}
-	};
+	void on_stats_message(const RSSIStatisticsMessage* const message) {
+		on_statistics_update(message->statistics);
+	}
+	MessageHandler<RSSIStatisticsMessage, RSSI, &RSSI::on_stats_message> message_handler_stats { this };
 	
-	MessageHandlerRegistration message_handler_pitch_rssi {
-		Message::ID::PitchRSSIConfigure,
-		[this](const Message* const p) {
-			const auto message = *reinterpret_cast<const PitchRSSIConfigureMessage*>(p);
-			this->set_pitch_rssi(message.enabled);
-		}
-	};
+	void on_pitch_rssi_message(const PitchRSSIConfigureMessage* const message) {
+		set_pitch_rssi(message->enabled);
+	}
+	MessageHandler<PitchRSSIConfigureMessage, RSSI, &RSSI::on_pitch_rssi_message> message_handler_pitch_rssi { this };
 
 	void on_statistics_update(const RSSIStatistics& statistics);
 	void set_pitch_rssi(bool enabled);
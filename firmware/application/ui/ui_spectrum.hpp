@@ -160,36 +160,28 @@ private:
 	ui::Rect waterfall_normal_rect { };
 	ui::Rect waterfall_reduced_rect { };
 
-	MessageHandlerRegistration message_handler_channel_spectrum_config {
-		Message::ID::ChannelSpectrumConfig,
-		[this](const Message* const p) {
-			const auto message = *reinterpret_cast<const ChannelSpectrumConfigMessage*>(p);
-			this->channel_fifo = message.fifo;
-		}
-	};
-	MessageHandlerRegistration message_handler_audio_spectrum {
-		Message::ID::AudioSpectrum,
-		[this](const Message* const p) {
-			const auto message = *reinterpret_cast<const AudioSpectrumMessage*>(p);
-			this->audio_spectrum_data = message.data;
-			this->audio_spectrum_update = true;
-		}
-	};
-	MessageHandlerRegistration message_handler_frame_sync {
-		Message::ID::DisplayFrameSync,
-		[this](const Message* const) {
-			if( this->channel_fifo ) {
-				ChannelSpectrum channel_spectrum;
-				while( channel_fifo->out(channel_spectrum) ) {
-					this->on_channel_spectrum(channel_spectrum);
-				}
-			}
-			if (this->audio_spectrum_update) {
-				this->audio_spectrum_update = false;
-				this->on_audio_spectrum();
+	void on_channel_spectrum_config_message(const ChannelSpectrumConfigMessage* const message) {
+		channel_fifo = message->fifo;
+	}
+	MessageHandler<ChannelSpectrumConfigMessage, WaterfallWidget, &WaterfallWidget::on_channel_spectrum_config_message> message_handler_channel_spectrum_config { this };
+	void on_audio_spectrum_message(const AudioSpectrumMessage* const message) {
+		audio_spectrum_data = message->data;
+		audio_spectrum_update = true;
+	}
+	MessageHandler<AudioSpectrumMessage, WaterfallWidget, &WaterfallWidget::on_audio_spectrum_message> message_handler_audio_spectrum { this };
+	void on_frame_sync_message(const DisplayFrameSyncMessage* const) {
+		if( channel_fifo ) {
+			ChannelSpectrum channel_spectrum;
+			while( channel_fifo->out(channel_spectrum) ) {
+				on_channel_spectrum(channel_spectrum);
 			}
 		}
-	};
+		if (audio_spectrum_update) {
+			audio_spectrum_update = false;
+			on_audio_spectrum();
+		}
+	}
+	MessageHandler<DisplayFrameSyncMessage, WaterfallWidget, &WaterfallWidget::on_frame_sync_message> message_handler_frame_sync { this };
 
 	void on_channel_spectrum(const ChannelSpectrum& spectrum);
 	void on_audio_spectrum();
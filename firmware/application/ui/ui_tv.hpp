@@ -77,15 +77,13 @@ public:
 	void on_hide() override;
 
 	void paint(Painter& painter) override;
-	void on_channel_spectrum(const ChannelSpectrum& spectrum);
-	void on_adjust_xcorr(uint8_t xcorr);
-	//ui::Color video_buffer[13312];
-        uint8_t video_buffer_int[13312+128] { 0 }; //128 is for the over length caused by x_correction
-	uint32_t count=0;
-        uint8_t x_correction=0;
+	void on_video_line(const VideoLine& line);
+	void set_vertical_position(const Coord position);
+
 private:
+	Coord vertical_position { 0 };
+
 	void clear();
-	
 };
 
 class TVWidget : public View {
@@ -107,10 +105,10 @@ public:
 	void show_audio_spectrum_view(const bool show);
 
 	void paint(Painter& painter) override;
-	NumberField field_xcorr {
+	NumberField field_vpos {
 		{ 0 * 8, 0 * 16 },
-		5,
-		{ 0, 128 },
+		3,
+		{ 0, 255 },
 		1,
 		' '
 	};
@@ -124,49 +122,39 @@ private:
 	
 	TVView tv_view { };
 
-	ChannelSpectrumFIFO* channel_fifo { nullptr };
+	VideoLineFIFO* video_fifo { nullptr };
 	AudioSpectrum* audio_spectrum_data { nullptr };
 	bool audio_spectrum_update { false };
 	
 	std::unique_ptr<TimeScopeView> audio_spectrum_view { };
 	
-	int sampling_rate { 0 };
 	int32_t cursor_position { 0 };
 	ui::Rect tv_normal_rect { };
 	ui::Rect tv_reduced_rect { };
 
-	MessageHandlerRegistration message_handler_channel_spectrum_config {
-		Message::ID::ChannelSpectrumConfig,
-		[this](const Message* const p) {
-			const auto message = *reinterpret_cast<const ChannelSpectrumConfigMessage*>(p);
-			this->channel_fifo = message.fifo;
-		}
-	};
-	MessageHandlerRegistration message_handler_audio_spectrum {
-		Message::ID::AudioSpectrum,
-		[this](const Message* const p) {
-			const auto message = *reinterpret_cast<const AudioSpectrumMessage*>(p);
-			this->audio_spectrum_data = message.data;
-			this->audio_spectrum_update = true;
-		}
-	};
-	MessageHandlerRegistration message_handler_frame_sync {
-		Message::ID::DisplayFrameSync,
-		[this](const Message* const) {
-			if( this->channel_fifo ) {
-				ChannelSpectrum channel_spectrum;
-				while( channel_fifo->out(channel_spectrum) ) {
-					this->on_channel_spectrum(channel_spectrum);
-				}
-			}
-			if (this->audio_spectrum_update) {
-				this->audio_spectrum_update = false;
-				this->on_audio_spectrum();
+	void on_video_line_config_message(const VideoLineConfigMessage* const message) {
+		video_fifo = message->fifo;
+	}
+	MessageHandler<VideoLineConfigMessage, TVWidget, &TVWidget::on_video_line_config_message> message_handler_video_line_config { this };
+	void on_audio_spectrum_message(const AudioSpectrumMessage* const message) {
+		audio_spectrum_data = message->data;
+		audio_spectrum_update = true;
+	}
+	MessageHandler<AudioSpectrumMessage, TVWidget, &TVWidget::on_audio_spectrum_message> message_handler_audio_spectrum { this };
+	void on_frame_sync_message(const DisplayFrameSyncMessage* const) {
+		if( video_fifo ) {
+			VideoLine line;
+			while( video_fifo->out(line) ) {
+				tv_view.on_video_line(line);
 			}
 		}
-	};
+		if (audio_spectrum_update) {
+			audio_spectrum_update = false;
+			on_audio_spectrum();
+		}
+	}
+	MessageHandler<DisplayFrameSyncMessage, TVWidget, &TVWidget::on_frame_sync_message> message_handler_frame_sync { this };
 
-	void on_channel_spectrum(const ChannelSpectrum& spectrum);
 	void on_audio_spectrum();
 };
 
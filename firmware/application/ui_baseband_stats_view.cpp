@@ -56,6 +56,12 @@ void BasebandStatsView::on_statistics_update(const BasebandStatistics& statistic
 		+ " " + ticks_to_percent_string(statistics.rssi_ticks)
 		+ " " + ticks_to_percent_string(statistics.baseband_ticks);
 
+	// Samples the baseband thread couldn't keep up with
+	const auto samples_lost = statistics.samples_missed + statistics.samples_overwritten;
+	if( samples_lost ) {
+		message += " L" + to_string_dec_uint(samples_lost);
+	}
+
 	text_stats.set(message);
 }
 
@@ -36,16 +36,14 @@ public:
 
 private:
 	Text text_stats {
-		{  0 * 8, 0, (4 * 4 + 3) * 8, 1 * 16 },
+		{  0 * 8, 0, 30 * 8, 1 * 16 },
 		"",
 	};
 
-	MessageHandlerRegistration message_handler_stats {
-		Message::ID::BasebandStatistics,
-		[this](const Message* const p) {
-			this->on_statistics_update(static_cast<const BasebandStatisticsMessage*>(p)->statistics);
-		}
-	};
+	void on_stats_message(const BasebandStatisticsMessage* const message) {
+		on_statistics_update(message->statistics);
+	}
+	MessageHandler<BasebandStatisticsMessage, BasebandStatsView, &BasebandStatsView::on_stats_message> message_handler_stats { this };
 
 	void on_statistics_update(const BasebandStatistics& statistics);
 };
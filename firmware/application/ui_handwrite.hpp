@@ -78,12 +78,10 @@ private:
 		"OK"
 	};
 	
-	MessageHandlerRegistration message_handler_sample {
-		Message::ID::DisplayFrameSync,
-		[this](const Message* const) {
-			this->sample_pen();
-		}
-	};
+	void on_sample_message(const DisplayFrameSyncMessage* const) {
+		sample_pen();
+	}
+	MessageHandler<DisplayFrameSyncMessage, HandWriteView, &HandWriteView::on_sample_message> message_handler_sample { this };
 };
 
 } /* namespace ui */
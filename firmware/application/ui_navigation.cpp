@@ -75,6 +75,7 @@
 #include "ert_app.hpp"
 #include "lge_app.hpp"
 #include "pocsag_app.hpp"
+#include "pulse_app.hpp"
 #include "replay_app.hpp"
 #include "gps_sim_app.hpp"
 #include "soundboard_app.hpp"
@@ -181,6 +182,8 @@ void SystemStatusView::refresh() {
 		image_clock_status.set_bitmap(&bitmap_icon_clk_int);
 		button_bias_tee.set_foreground(ui::Color::light_grey());
 	}
+
+	button_camera.set_foreground(portapack::screen_recorder.is_recording() ? Color::red() : Color::white());
 	
 	set_dirty();
 }
@@ -267,13 +270,20 @@ void SystemStatusView::on_bias_tee() {
 }*/
 
 void SystemStatusView::on_camera() {
+	if( portapack::screen_recorder.is_recording() ) {
+		portapack::screen_recorder.stop();
+		refresh();
+		return;
+	}
+
 	auto path = next_filename_stem_matching_pattern(u"SCR_????");
 	if( path.empty() ) {
 		return;
 	}
 
-	PNGWriter png;
-	auto create_error = png.create(path.replace_extension(u".PNG"));
+	// Encoder state is ~2KB, too much for the application thread stack.
+	std::unique_ptr<PNGWriter> png { new PNGWriter() };
+	auto create_error = png->create(path.replace_extension(u".PNG"));
 	if( create_error.is_valid() ) {
 		return;
 	}
@@ -281,10 +291,22 @@ void SystemStatusView::on_camera() {
 	for(int i = 0; i < 320; i++) {
 		std::array<ColorRGB888, 240> row;
 		portapack::display.read_pixels({ 0, i, 240, 1 }, row);
-		png.write_scanline(row);
+		png->write_scanline(row);
 	}
 }
 
+static void start_screen_recording() {
+	auto path = next_filename_stem_matching_pattern(u"SCR_????");
+	if( path.empty() ) {
+		return;
+	}
+
+	portapack::screen_recorder.start(path.replace_extension(u".PSR"));
+
+	StatusRefreshMessage message;
+	EventDispatcher::send_message(message);
+}
+
 /* Navigation ************************************************************/
 
 bool NavigationView::is_top() const {
@@ -395,6 +417,7 @@ ReceiversMenuView::ReceiversMenuView(NavigationView& nav) {
                 { "TV",                 ui::Color::white(),          &bitmap_icon_sstv,      [&nav](){ nav.push<AnalogTvView>(); } },
 		{ "ERT Meter", 	ui::Color::green(), 	&bitmap_icon_ert,		[&nav](){ nav.push<ERTAppView>(); } },
 		{ "POCSAG", 	ui::Color::green(),		&bitmap_icon_pocsag,	[&nav](){ nav.push<POCSAGAppView>(); } },
+		{ "Pulses", 	ui::Color::yellow(),	&bitmap_icon_capture,	[&nav](){ nav.push<PulseAppView>(); } },
 		{ "Radiosnde", 	ui::Color::yellow(),	&bitmap_icon_sonde,		[&nav](){ nav.push<SondeView>(); } },
 		{ "TPMS Cars", 	ui::Color::green(),		&bitmap_icon_tpms,		[&nav](){ nav.push<TPMSAppView>(); } },
 		{ "APRS", 		ui::Color::dark_grey(),	&bitmap_icon_aprs,		[&nav](){ nav.push<NotImplementedView>(); } },
@@ -446,6 +469,7 @@ UtilitiesMenuView::UtilitiesMenuView(NavigationView& nav) {
 		//{ "Tone search",	ui::Color::dark_grey(), nullptr,				[&nav](){ nav.push<ToneSearchView>(); } },
 		{ "Wave viewer",	ui::Color::blue(),		nullptr,				[&nav](){ nav.push<ViewWavView>(); } },
 		{ "Antenna length",	ui::Color::yellow(),	nullptr,				[&nav](){ nav.push<WhipCalcView>(); } },
+		{ "Screen rec",		ui::Color::red(),		&bitmap_icon_camera,	[](){ start_screen_recording(); } },
 		{ "Wipe SD card",			ui::Color::red(),		nullptr,				[&nav](){ nav.push<WipeSDView>(); } },
 	});
 	set_max_rows(2); // allow wider buttons
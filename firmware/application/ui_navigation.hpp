@@ -199,13 +199,10 @@ private:
 	void on_camera();
 	void refresh();
 	
-	MessageHandlerRegistration message_handler_refresh {
-		Message::ID::StatusRefresh,
-		[this](const Message* const p) {
-			(void)p;
-			this->refresh();
-		}
-	};
+	void on_refresh_message(const StatusRefreshMessage* const) {
+		refresh();
+	}
+	MessageHandler<StatusRefreshMessage, SystemStatusView, &SystemStatusView::on_refresh_message> message_handler_refresh { this };
 };
 
 class BMPView : public View {
@@ -26,6 +26,7 @@ using namespace portapack;
 
 #include "io_file.hpp"
 #include "io_wave.hpp"
+#include "capture_index.hpp"
 
 #include "baseband_api.hpp"
 #include "rtc_time.hpp"
@@ -44,7 +45,7 @@ void RecordView::toggle_pitch_rssi() {
 		pitch_rssi_enabled,
 		0
 	};
-	shared_memory.application_queue.push(message);
+	EventDispatcher::send_message(message);
 	
 	if( !pitch_rssi_enabled ) {
 		button_pitch_rssi.set_foreground(Color::orange());
@@ -114,6 +115,14 @@ void RecordView::set_sampling_rate(const size_t new_sampling_rate) {
 	}
 }
 
+void RecordView::set_trigger(const CaptureTrigger& new_trigger) {
+	trigger = new_trigger;
+	if( is_active() ) {
+		// Restart with the new trigger, a new file is started anyway
+		start();
+	}
+}
+
 bool RecordView::is_active() const {
 	return (bool)capture_thread;
 }
@@ -136,12 +145,73 @@ void RecordView::start() {
 		return;
 	}
 
+	if( trigger.enabled ) {
+		// Files are only created as bursts arrive, one per burst
+		button_record.set_bitmap(&bitmap_stop);
+		capture_thread = std::make_unique<CaptureThread>(
+			[this](std::unique_ptr<stream::Writer>& writer) -> Optional<File::Error> {
+				const auto base_path = next_filename_stem_matching_pattern(filename_stem_pattern);
+				if( base_path.empty() ) {
+					return { };
+				}
+				return create_writer(base_path, writer);
+			},
+			trigger,
+			write_size, buffer_count,
+			[]() {
+				CaptureThreadDoneMessage message { };
+				EventDispatcher::send_message(message);
+			},
+			[](File::Error error) {
+				CaptureThreadDoneMessage message { error.code() };
+				EventDispatcher::send_message(message);
+			}
+		);
+		update_status_display();
+		return;
+	}
+
 	auto base_path = next_filename_stem_matching_pattern(filename_stem_pattern);
 	if( base_path.empty() ) {
 		return;
 	}
 
 	std::unique_ptr<stream::Writer> writer;
+	const auto create_error = create_writer(base_path, writer);
+	if( create_error.is_valid() ) {
+		handle_error(create_error.value());
+	}
+
+	if( writer ) {
+		text_record_filename.set(base_path.replace_extension().string());
+		button_record.set_bitmap(&bitmap_stop);
+		capture_thread = std::make_unique<CaptureThread>(
+			std::move(writer),
+			write_size, buffer_count,
+			[]() {
+				CaptureThreadDoneMessage message { };
+				EventDispatcher::send_message(message);
+			},
+			[](File::Error error) {
+				CaptureThreadDoneMessage message { error.code() };
+				EventDispatcher::send_message(message);
+			}
+		);
+	}
+
+	update_status_display();
+}
+
+void RecordView::stop() {
+	if( is_active() ) {
+		capture_thread.reset();
+		button_record.set_bitmap(&bitmap_record);
+	}
+
+	update_status_display();
+}
+
+Optional<File::Error> RecordView::create_writer(std::filesystem::path base_path, std::unique_ptr<stream::Writer>& writer) {
 	switch(file_type) {
 	case FileType::WAV:
 		{
@@ -152,10 +222,9 @@ void RecordView::start() {
 				to_string_dec_uint(receiver_model.tuning_frequency()) + "Hz"
 			);
 			if( create_error.is_valid() ) {
-				handle_error(create_error.value());
-			} else {
-				writer = std::move(p);
+				return create_error;
 			}
+			writer = std::move(p);
 		}
 		break;
 
@@ -163,17 +232,21 @@ void RecordView::start() {
 		{
 			const auto metadata_file_error = write_metadata_file(base_path.replace_extension(u".TXT"));
 			if( metadata_file_error.is_valid() ) {
-				handle_error(metadata_file_error.value());
-				return;
+				return metadata_file_error;
 			}
 
-			auto p = std::make_unique<RawFileWriter>();
-			auto create_error = p->create(base_path.replace_extension(u".C16"));
+			auto p = std::make_unique<capture_index::Writer>();
+			auto create_error = p->create(base_path, {
+				static_cast<uint32_t>(sampling_rate / 8),
+				static_cast<uint64_t>(receiver_model.tuning_frequency()),
+				receiver_model.lna(),
+				receiver_model.vga(),
+				receiver_model.rf_amp()
+			});
 			if( create_error.is_valid() ) {
-				handle_error(create_error.value());
-			} else {
-				writer = std::move(p);
+				return create_error;
 			}
+			writer = std::move(p);
 		}
 		break;
 
@@ -181,33 +254,7 @@ void RecordView::start() {
 		break;
 	};
 
-	if( writer ) {
-		text_record_filename.set(base_path.replace_extension().string());
-		button_record.set_bitmap(&bitmap_stop);
-		capture_thread = std::make_unique<CaptureThread>(
-			std::move(writer),
-			write_size, buffer_count,
-			[]() {
-				CaptureThreadDoneMessage message { };
-				EventDispatcher::send_message(message);
-			},
-			[](File::Error error) {
-				CaptureThreadDoneMessage message { error.code() };
-				EventDispatcher::send_message(message);
-			}
-		);
-	}
-
-	update_status_display();
-}
-
-void RecordView::stop() {
-	if( is_active() ) {
-		capture_thread.reset();
-		button_record.set_bitmap(&bitmap_record);
-	}
-
-	update_status_display();
+	return { };
 }
 
 Optional<File::Error> RecordView::write_metadata_file(const std::filesystem::path& filename) {
@@ -237,6 +284,10 @@ void RecordView::update_status_display() {
 		const auto dropped_percent = std::min(99U, capture_thread->state().dropped_percent());
 		const auto s = to_string_dec_uint(dropped_percent, 2, ' ') + "\%";
 		text_record_dropped.set(s);
+
+		if( trigger.enabled ) {
+			text_record_filename.set("Trig " + to_string_dec_uint(capture_thread->state().segments));
+		}
 	}
 	
 	if (pitch_rssi_enabled) {
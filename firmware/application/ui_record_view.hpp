@@ -56,6 +56,7 @@ public:
 	void focus() override;
 
 	void set_sampling_rate(const size_t new_sampling_rate);
+	void set_trigger(const CaptureTrigger& new_trigger);
 
 	void start();
 	void stop();
@@ -65,6 +66,7 @@ public:
 private:
 	void toggle();
 	void toggle_pitch_rssi();
+	Optional<File::Error> create_writer(std::filesystem::path base_path, std::unique_ptr<stream::Writer>& writer);
 	Optional<File::Error> write_metadata_file(const std::filesystem::path& filename);
 
 	void on_tick_second();
@@ -79,6 +81,7 @@ private:
 	const size_t write_size;
 	const size_t buffer_count;
 	size_t sampling_rate { 0 };
+	CaptureTrigger trigger { false, 0, 0 };
 	SignalToken signal_token_tick_second { };
 
 	Rectangle rect_background {
@@ -117,13 +120,10 @@ private:
 
 	std::unique_ptr<CaptureThread> capture_thread { };
 
-	MessageHandlerRegistration message_handler_capture_thread_error {
-		Message::ID::CaptureThreadDone,
-		[this](const Message* const p) {
-			const auto message = *reinterpret_cast<const CaptureThreadDoneMessage*>(p);
-			this->handle_capture_thread_done(message.error);
-		}
-	};
+	void on_capture_thread_error_message(const CaptureThreadDoneMessage* const message) {
+		handle_capture_thread_done(message->error);
+	}
+	MessageHandler<CaptureThreadDoneMessage, RecordView, &RecordView::on_capture_thread_error_message> message_handler_capture_thread_error { this };
 };
 
 } /* namespace ui */
@@ -89,6 +89,7 @@ private:
 	Stats _stats { };
 
 	static msg_t static_fn(void* arg) {
+		chRegSetThreadName("sd_test");
 		auto obj = static_cast<SDCardTestThread*>(arg);
 		obj->_result = obj->run();
 		return 0;
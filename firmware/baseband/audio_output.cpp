@@ -31,6 +31,7 @@
 #include <cstdint>
 #include <cstddef>
 #include <array>
+#include <algorithm>
 
 void AudioOutput::configure(
 	const bool do_proc
@@ -48,65 +49,112 @@ void AudioOutput::configure(
 	squelch.set_threshold(squelch_threshold);
 }
 
-void AudioOutput::write(
-	const buffer_s16_t& audio
-) {
-	std::array<float, 32> audio_f;
-	for(size_t i=0; i<audio.count; i++) {
-		audio_f[i] = audio.p[i] * ki;
+void AudioOutput::set_processing(const bool agc_enable, const bool noise_blanker_enable) {
+	if( agc_enable && !agc_enabled ) {
+		agc.reset();
 	}
-	write(buffer_f32_t {
-		audio_f.data(),
-		audio.count,
-		audio.sampling_rate
-	});
+	if( noise_blanker_enable && !noise_blanker_enabled ) {
+		noise_blanker.reset();
+	}
+	agc_enabled = agc_enable;
+	noise_blanker_enabled = noise_blanker_enable;
 }
 
 void AudioOutput::write(
-	const buffer_f32_t& audio
+	const buffer_s16_t& audio
 ) {
 	block_buffer.feed(
 		audio,
-		[this](const buffer_f32_t& buffer) {
+		[this](const buffer_s16_t& buffer) {
 			this->on_block(buffer);
 		}
 	);
 }
 
-void AudioOutput::on_block(
+void AudioOutput::write(
 	const buffer_f32_t& audio
 ) {
-	if (do_processing) {
-		const auto audio_present_now = squelch.execute(audio);
+	/* Straight to the work format: AM magnitude and loud WFM go past full
+	 * scale, and must only saturate after the HPF and AGC. */
+	std::array<int32_t, 32> audio_q;
+	for(size_t offset=0; offset<audio.count; offset+=audio_q.size()) {
+		const size_t count = std::min(audio.count - offset, audio_q.size());
+		for(size_t i=0; i<count; i++) {
+			const float sample = std::max(std::min(audio.p[offset + i], q_float_max), -q_float_max);
+			audio_q[i] = sample * k_q;
+		}
+		block_buffer_q.feed(
+			buffer_s32_t { audio_q.data(), count, audio.sampling_rate },
+			[this](const buffer_s32_t& buffer) {
+				this->process(buffer);
+			}
+		);
+	}
+}
 
-		hpf.execute_in_place(audio);
-		deemph.execute_in_place(audio);
+void AudioOutput::on_block(
+	const buffer_s16_t& audio
+) {
+	std::array<int32_t, 32> audio_work;
+	for(size_t i=0; i<audio.count; i++) {
+		audio_work[i] = static_cast<int32_t>(audio.p[i]) << headroom_bits;
+	}
+
+	process(buffer_s32_t {
+		audio_work.data(),
+		audio.count,
+		audio.sampling_rate
+	});
+}
+
+void AudioOutput::process(
+	const buffer_s32_t& audio_q
+) {
+	if (do_processing) {
+		// The squelch measures noise in int16, clipping doesn't matter there
+		std::array<int16_t, 32> audio_int;
+		for(size_t i=0; i<audio_q.count; i++) {
+			audio_int[i] = __SSAT(audio_q.p[i] >> headroom_bits, 16);
+		}
+		const auto audio_present_now = squelch.execute(buffer_s16_t {
+			audio_int.data(),
+			audio_q.count,
+			audio_q.sampling_rate
+		});
+
+		if( noise_blanker_enabled ) {
+			noise_blanker.execute_in_place(audio_q);
+		}
+		hpf.execute_in_place(audio_q);
+		deemph.execute_in_place(audio_q);
+		if( agc_enabled ) {
+			agc.execute_in_place(audio_q);
+		}
 
 		audio_present_history = (audio_present_history << 1) | (audio_present_now ? 1 : 0);
-		audio_present = (audio_present_history != 0);
+		audio_present = (audio_present_history != 0) && tone_gate_open;
 		
 		if( !audio_present ) {
-			for(size_t i=0; i<audio.count; i++) {
-				audio.p[i] = 0;
+			for(size_t i=0; i<audio_q.count; i++) {
+				audio_q.p[i] = 0;
 			}
 		}
 	} else
 		audio_present = true;
 
-	fill_audio_buffer(audio, audio_present);
+	fill_audio_buffer(audio_q, audio_present);
 }
 
 bool AudioOutput::is_squelched() {
 	return !audio_present;
 }
 
-void AudioOutput::fill_audio_buffer(const buffer_f32_t& audio, const bool send_to_fifo) {
+void AudioOutput::fill_audio_buffer(const buffer_s32_t& audio, const bool send_to_fifo) {
 	std::array<int16_t, 32> audio_int;
 
 	auto audio_buffer = audio::dma::tx_empty_buffer();
 	for(size_t i=0; i<audio_buffer.count; i++) {
-		const int32_t sample_int = audio.p[i] * k;
-		const int32_t sample_saturated = __SSAT(sample_int, 16);
+		const int32_t sample_saturated = __SSAT(audio.p[i] >> headroom_bits, 16);
 		audio_buffer.p[i].left = audio_buffer.p[i].right = sample_saturated;
 		audio_int[i] = sample_saturated;
 	}
@@ -114,10 +162,14 @@ void AudioOutput::fill_audio_buffer(const buffer_f32_t& audio, const bool send_t
 		stream->write(audio_int.data(), audio_buffer.count * sizeof(audio_int[0]));
 	}
 
-	feed_audio_stats(audio);
+	feed_audio_stats(buffer_s16_t {
+		audio_int.data(),
+		audio_buffer.count,
+		audio.sampling_rate
+	});
 }
 
-void AudioOutput::feed_audio_stats(const buffer_f32_t& audio) {
+void AudioOutput::feed_audio_stats(const buffer_s16_t& audio) {
 	audio_stats.feed(
 		audio,
 		[](const AudioStatistics& statistics) {
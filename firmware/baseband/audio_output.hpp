@@ -31,6 +31,7 @@
 #include "stream_input.hpp"
 #include "block_decimator.hpp"
 #include "audio_stats_collector.hpp"
+#include "audio_processing.hpp"
 
 #include <cstdint>
 #include <memory>
@@ -48,21 +49,40 @@ public:
 	void write(const buffer_s16_t& audio);
 	void write(const buffer_f32_t& audio);
 
+	void set_processing(const bool agc, const bool noise_blanker);
+
 	void set_stream(std::unique_ptr<StreamInput> new_stream) {
 		stream = std::move(new_stream);
 	}
 	
 	bool is_squelched();
 
+	/* CTCSS/DCS tone squelch, gates audio on top of the noise squelch. */
+	void set_tone_gate(const bool open) {
+		tone_gate_open = open;
+	}
+
 private:
 	static constexpr float k = 32768.0f;
-	static constexpr float ki = 1.0f / k;
 
-	BlockDecimator<float, 32> block_buffer { 1 };	
+	/* Post-processing runs in fixed point on int32 samples, int16 shifted
+	 * up by headroom_bits. */
+	static constexpr size_t headroom_bits = 8;
+	/* Float input is scaled straight to the work format, clamped so that it
+	 * stays within int32. */
+	static constexpr float k_q = k * (1 << headroom_bits);
+	static constexpr float q_float_max = 255.0f;
+
+	BlockDecimator<int16_t, 32> block_buffer { 1 };	
+	BlockDecimator<int32_t, 32> block_buffer_q { 1 };
 
-	IIRBiquadFilter hpf { };
-	IIRBiquadFilter deemph { };
+	IIRBiquadFilterQ31 hpf { };
+	IIRBiquadFilterQ31 deemph { };
 	FMSquelch squelch { };
+	AudioAGC agc { };
+	NoiseBlanker noise_blanker { };
+	bool agc_enabled = false;
+	bool noise_blanker_enabled = false;
 
 	std::unique_ptr<StreamInput> stream { };
 
@@ -71,11 +91,13 @@ private:
 	uint64_t audio_present_history = 0;
 	
 	bool audio_present = false;
+	bool tone_gate_open = true;
 	bool do_processing = true;
 
-	void on_block(const buffer_f32_t& audio);
-	void fill_audio_buffer(const buffer_f32_t& audio, const bool send_to_fifo);
-	void feed_audio_stats(const buffer_f32_t& audio);
+	void on_block(const buffer_s16_t& audio);
+	void process(const buffer_s32_t& audio_q);
+	void fill_audio_buffer(const buffer_s32_t& audio, const bool send_to_fifo);
+	void feed_audio_stats(const buffer_s16_t& audio);
 };
 
 #endif/*__AUDIO_OUTPUT_H__*/
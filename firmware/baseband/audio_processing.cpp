@@ -0,0 +1,66 @@
+/*
+ * Copyright (C) 2026 agent
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "audio_processing.hpp"
+
+#include <algorithm>
+
+void AudioAGC::execute_in_place(const buffer_s32_t& buffer) {
+	int32_t peak = 0;
+	for(size_t i=0; i<buffer.count; i++) {
+		const auto v = buffer.p[i];
+		peak = std::max(peak, (v < 0) ? -v : v);
+	}
+
+	const int64_t peak_out = (static_cast<int64_t>(peak) * gain) >> 16;
+	if( peak_out > target ) {
+		gain = (static_cast<uint64_t>(target) << 16) / peak;
+	} else {
+		gain = std::min(gain + (gain >> release_shift) + 1, gain_max);
+	}
+
+	for(size_t i=0; i<buffer.count; i++) {
+		buffer.p[i] = (static_cast<int64_t>(buffer.p[i]) * gain) >> 16;
+	}
+}
+
+void NoiseBlanker::execute_in_place(const buffer_s32_t& buffer) {
+	for(size_t i=0; i<buffer.count; i++) {
+		const auto v = buffer.p[i];
+		const int32_t magnitude = (v < 0) ? -v : v;
+		const int32_t average = average_acc >> average_shift;
+
+		if( magnitude > average * threshold_factor ) {
+			hold = hold_samples;
+		}
+
+		// Keep tracking during a hold, so a genuine step in level can't
+		// blank forever.
+		average_acc += magnitude - average;
+
+		if( hold > 0 ) {
+			hold--;
+			buffer.p[i] = last_good;
+		} else {
+			last_good = v;
+		}
+	}
+}
@@ -0,0 +1,77 @@
+/*
+ * Copyright (C) 2026 agent
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __AUDIO_PROCESSING_H__
+#define __AUDIO_PROCESSING_H__
+
+#include "dsp_types.hpp"
+
+#include <cstdint>
+#include <cstddef>
+
+/* Optional fixed-point stages for AudioOutput. Samples are int32 with the
+ * int16 full scale at 1 << 23, leaving headroom for filter overshoot.
+ */
+
+/* Block-wise peak AGC: instant attack when a block would exceed the target
+ * level, slow exponential release (~6dB/s at 24kHz) up to gain_max.
+ */
+class AudioAGC {
+public:
+	void execute_in_place(const buffer_s32_t& buffer);
+
+	void reset() {
+		gain = unity;
+	}
+
+private:
+	static constexpr uint32_t unity { 1 << 16 };		// Q16
+	static constexpr uint32_t gain_max { 64 << 16 };	// +36dB
+	static constexpr int32_t target { 1 << 22 };		// -6dBFS
+	static constexpr size_t release_shift { 10 };
+
+	uint32_t gain { unity };
+};
+
+/* Impulse noise blanker: a sample well above the running mean magnitude
+ * starts a short hold, during which the last clean sample is repeated.
+ */
+class NoiseBlanker {
+public:
+	void execute_in_place(const buffer_s32_t& buffer);
+
+	void reset() {
+		average_acc = 0;
+		hold = 0;
+		last_good = 0;
+	}
+
+private:
+	static constexpr int32_t threshold_factor { 8 };	// +18dB over mean
+	static constexpr size_t hold_samples { 4 };
+	static constexpr size_t average_shift { 6 };
+
+	int32_t average_acc { 0 };
+	size_t hold { 0 };
+	int32_t last_good { 0 };
+};
+
+#endif/*__AUDIO_PROCESSING_H__*/
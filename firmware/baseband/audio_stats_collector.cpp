@@ -23,12 +23,12 @@
 
 #include "utility.hpp"
 
-void AudioStatsCollector::consume_audio_buffer(const buffer_f32_t& src) {
+void AudioStatsCollector::consume_audio_buffer(const buffer_s16_t& src) {
 	auto src_p = src.p;
 	const auto src_end = &src.p[src.count];
 	while(src_p < src_end) {
-		const auto sample = *(src_p++);
-		const auto sample_squared = sample * sample;
+		const int32_t sample = *(src_p++);
+		const uint32_t sample_squared = sample * sample;
 		squared_sum += sample_squared;
 		if( sample_squared > max_squared ) {
 			max_squared = sample_squared;
@@ -42,8 +42,10 @@ bool AudioStatsCollector::update_stats(const size_t sample_count, const size_t s
 	const size_t samples_per_update = sampling_rate * update_interval;
 
 	if( count >= samples_per_update ) {
-		statistics.rms_db = mag2_to_dbv_norm(squared_sum / count);
-		statistics.max_db = mag2_to_dbv_norm(max_squared);
+		// Q30 squares back to full scale = 1.0.
+		constexpr float k = 1.0f / (1UL << 30);
+		statistics.rms_db = mag2_to_dbv_norm(static_cast<float>(squared_sum / count) * k);
+		statistics.max_db = mag2_to_dbv_norm(max_squared * k);
 		statistics.count = count;
 
 		squared_sum = 0;
@@ -56,7 +58,7 @@ bool AudioStatsCollector::update_stats(const size_t sample_count, const size_t s
 	}
 }
 
-bool AudioStatsCollector::feed(const buffer_f32_t& src) {
+bool AudioStatsCollector::feed(const buffer_s16_t& src) {
 	consume_audio_buffer(src);
 
 	return update_stats(src.count, src.sampling_rate);
@@ -86,26 +86,33 @@ constexpr gpdma::channel::Config config(const baseband::Direction direction) {
 	};
 }
 
-constexpr size_t buffer_samples_log2n = 13;
-constexpr size_t buffer_samples = (1 << buffer_samples_log2n);
-constexpr size_t transfers_per_buffer_log2n = 2;
-constexpr size_t transfers_per_buffer = (1 << transfers_per_buffer_log2n);
-constexpr size_t transfer_samples = buffer_samples / transfers_per_buffer;
-constexpr size_t transfers_mask = transfers_per_buffer - 1;
+static std::array<gpdma::channel::LLI, transfers_max> lli_loop;
+static constexpr auto& gpdma_channel_sgpio = gpdma::channels[portapack::sgpio_gpdma_channel_number];
 
-constexpr size_t buffer_bytes = buffer_samples * sizeof(baseband::sample_t);
-constexpr size_t transfer_bytes = transfer_samples * sizeof(baseband::sample_t);
+static ThreadWait thread_wait;
 
-constexpr size_t msg_count = transfers_per_buffer - 1;
+static baseband::sample_t* buffer_base { nullptr };
+static size_t transfer_samples { 0 };
+static size_t transfer_count { 1 };
 
-static std::array<gpdma::channel::LLI, transfers_per_buffer> lli_loop;
-static constexpr auto& gpdma_channel_sgpio = gpdma::channels[portapack::sgpio_gpdma_channel_number];
+/* Transfer sequence numbers. Transfer n uses lli_loop[n % transfer_count],
+ * and its buffer is reused by transfer n + transfer_count. */
+static volatile uint32_t transfers_completed { 0 };
+static size_t transfer_active_index { 0 };
+static uint32_t transfers_handed_out { 0 };
+static bool transfer_in_process { false };
 
-static ThreadWait thread_wait;
+static Statistics transfer_statistics { };
 
 static void transfer_complete() {
-	const auto next_lli_index = gpdma_channel_sgpio.next_lli() - &lli_loop[0];
-	thread_wait.wake_from_interrupt(next_lli_index);
+	/* Count from the LLI the channel has loaded rather than per interrupt,
+	 * so that completions merged into one interrupt aren't lost. */
+	const size_t next_lli_index = gpdma_channel_sgpio.next_lli() - &lli_loop[0];
+	const size_t active_index = (next_lli_index + transfer_count - 1) % transfer_count;
+	transfers_completed += (active_index + transfer_count - transfer_active_index) % transfer_count;
+	transfer_active_index = active_index;
+
+	thread_wait.wake_from_interrupt(0);
 }
 
 static void dma_error() {
@@ -129,17 +136,29 @@ void init() {
 
 void configure(
 	baseband::sample_t* const buffer_base,
-	const baseband::Direction direction
+	const baseband::Direction direction,
+	const Ring& ring
 ) {
+	dma::buffer_base = buffer_base;
+	transfer_samples = ring.transfer_samples;
+	transfer_count = ring.transfer_count;
+
+	const size_t transfer_bytes = transfer_samples * sizeof(baseband::sample_t);
 	const auto peripheral = reinterpret_cast<uint32_t>(&LPC_SGPIO->REG_SS[0]);
 	const auto control_value = control(direction, gpdma::buffer_words(transfer_bytes, 4));
-	for(size_t i=0; i<lli_loop.size(); i++) {
+	for(size_t i=0; i<transfer_count; i++) {
 		const auto memory = reinterpret_cast<uint32_t>(&buffer_base[i * transfer_samples]);
 		lli_loop[i].srcaddr = (direction == Direction::Transmit) ? memory : peripheral;
 		lli_loop[i].destaddr = (direction == Direction::Transmit) ? peripheral : memory;
-		lli_loop[i].lli = lli_pointer(&lli_loop[(i + 1) % lli_loop.size()]);
+		lli_loop[i].lli = lli_pointer(&lli_loop[(i + 1) % transfer_count]);
 		lli_loop[i].control = control_value;
 	}
+
+	transfers_completed = 0;
+	transfer_active_index = 0;
+	transfers_handed_out = 0;
+	transfer_in_process = false;
+	transfer_statistics = { };
 }
 
 void enable(const baseband::Direction direction) {
@@ -157,17 +176,40 @@ void disable() {
 }
 
 baseband::buffer_t wait_for_buffer() {
-	const auto next_index = thread_wait.sleep();
-	
-	if( next_index >= 0 ) {
-		const size_t free_index = (next_index + transfers_per_buffer - 2) & transfers_mask;
-		const auto src = lli_loop[free_index].srcaddr;
-		const auto dst = lli_loop[free_index].destaddr;
-		const auto p = (src == reinterpret_cast<uint32_t>(&LPC_SGPIO->REG_SS[0])) ? dst : src;
-		return { reinterpret_cast<sample_t*>(p), transfer_samples };
-	} else {
+	if( transfer_in_process ) {
+		const uint32_t previous = transfers_handed_out - 1;
+		if( (transfers_completed - previous) >= transfer_count ) {
+			transfer_statistics.overwritten++;
+		}
+		transfer_in_process = false;
+	}
+
+	chSysLock();
+	const auto result = (transfers_completed != transfers_handed_out) ? 0 : thread_wait.sleep_s();
+	chSysUnlock();
+
+	if( result < 0 ) {
 		return { };
 	}
+
+	const uint32_t completed = transfers_completed;
+	if( (completed - transfers_handed_out) >= transfer_count ) {
+		// Fell a whole ring behind: catch up rather than stay on the edge
+		const uint32_t newest = completed - 1;
+		transfer_statistics.missed += newest - transfers_handed_out;
+		transfers_handed_out = newest;
+	}
+	transfer_statistics.transfers = completed;
+
+	const size_t index = transfers_handed_out % transfer_count;
+	transfers_handed_out++;
+	transfer_in_process = true;
+
+	return { &buffer_base[index * transfer_samples], transfer_samples };
+}
+
+Statistics statistics() {
+	return transfer_statistics;
 }
 
 } /* namespace dma */
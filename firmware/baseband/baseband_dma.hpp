@@ -22,6 +22,7 @@
 #ifndef __BASEBAND_DMA_H__
 #define __BASEBAND_DMA_H__
 
+#include <cstdint>
 #include <cstddef>
 #include <array>
 
@@ -31,10 +32,47 @@
 namespace baseband {
 namespace dma {
 
+constexpr size_t transfers_min = 2;
+constexpr size_t transfers_max = 16;
+/* GPDMA transfer size limit: 4095 words of two samples */
+constexpr size_t transfer_samples_max = 8190;
+
+/* Ring of transfer_count DMA transfers of transfer_samples each. Transfers
+ * are handed out in sequence, so the ring depth is how far processing can
+ * fall behind before samples are lost; the transfer size sets the
+ * per-buffer overhead and the latency. */
+struct Ring {
+	size_t transfer_samples { 2048 };
+	size_t transfer_count { 4 };
+
+	constexpr size_t samples() const {
+		return transfer_samples * transfer_count;
+	}
+
+	/* The ring the DMA can actually run: transfer_count within
+	 * [transfers_min, transfers_max], transfer_samples a whole number of
+	 * words within the transfer size limit. */
+	constexpr Ring clamped() const {
+		return {
+			(transfer_samples < 2) ? 2 : (transfer_samples > transfer_samples_max) ? transfer_samples_max : (transfer_samples & ~size_t(1)),
+			(transfer_count < transfers_min) ? transfers_min : (transfer_count > transfers_max) ? transfers_max : transfer_count
+		};
+	}
+};
+
+/* Counts since configure() */
+struct Statistics {
+	uint32_t transfers { 0 };		// Completed by the DMA
+	uint32_t missed { 0 };			// Reused by the DMA before they were handed out
+	uint32_t overwritten { 0 };		// Reused by the DMA while being processed
+};
+
 void init();
+/* ring must already be clamped(), and buffer_base hold ring.samples(). */
 void configure(
 	baseband::sample_t* const buffer_base,
-	const baseband::Direction direction
+	const baseband::Direction direction,
+	const Ring& ring
 );
 
 void enable(const baseband::Direction direction);
@@ -42,8 +80,12 @@ bool is_enabled();
 
 void disable();
 
+/* Next transfer in sequence, once the DMA has completed it. If processing
+ * has fallen a whole ring behind, skips to the newest completed transfer. */
 baseband::buffer_t wait_for_buffer();
 
+Statistics statistics();
+
 } /* namespace dma */
 } /* namespace baseband */
 
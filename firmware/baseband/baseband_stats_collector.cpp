@@ -21,6 +21,9 @@
 
 #include "baseband_stats_collector.hpp"
 
+#include "baseband_dma.hpp"
+#include "rssi_thread.hpp"
+
 #include "lpc43xx_cpp.hpp"
 
 bool BasebandStatsCollector::process(const buffer_c8_t& buffer) {
@@ -31,7 +34,7 @@ bool BasebandStatsCollector::process(const buffer_c8_t& buffer) {
 	return report_delta >= report_samples;
 }
 
-BasebandStatistics BasebandStatsCollector::capture_statistics() {
+BasebandStatistics BasebandStatsCollector::capture_statistics(const size_t transfer_samples) {
 	BasebandStatistics statistics;
 
 	const auto idle_ticks = thread_idle->total_ticks;
@@ -42,7 +45,8 @@ BasebandStatistics BasebandStatsCollector::capture_statistics() {
 	statistics.main_ticks = (main_ticks - last_main_ticks);
 	last_main_ticks = main_ticks;
 
-	const auto rssi_ticks = thread_rssi->total_ticks;
+	// Started after the baseband thread, if at all
+	const auto rssi_ticks = RSSIThread::total_ticks();
 	statistics.rssi_ticks = (rssi_ticks - last_rssi_ticks);
 	last_rssi_ticks = rssi_ticks;
 
@@ -50,6 +54,12 @@ BasebandStatistics BasebandStatsCollector::capture_statistics() {
 	statistics.baseband_ticks = (baseband_ticks - last_baseband_ticks);
 	last_baseband_ticks = baseband_ticks;
 
+	const auto dma_statistics = baseband::dma::statistics();
+	statistics.samples_missed = (dma_statistics.missed - last_transfers_missed) * transfer_samples;
+	last_transfers_missed = dma_statistics.missed;
+	statistics.samples_overwritten = (dma_statistics.overwritten - last_transfers_overwritten) * transfer_samples;
+	last_transfers_overwritten = dma_statistics.overwritten;
+
 	statistics.saturation = lpc43xx::m4::flag_saturation();
 	lpc43xx::m4::clear_flag_saturation();
 
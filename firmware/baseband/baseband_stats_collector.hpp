@@ -35,11 +35,9 @@ public:
 	BasebandStatsCollector(
 		const Thread* const thread_idle,
 		const Thread* const thread_main,
-		const Thread* const thread_rssi,
 		const Thread* const thread_baseband
 	) : thread_idle { thread_idle },
 		thread_main { thread_main },
-		thread_rssi { thread_rssi },
 		thread_baseband { thread_baseband }
 	{
 	}
@@ -47,7 +45,7 @@ public:
 	template<typename Callback>
 	void process(const buffer_c8_t& buffer, Callback callback) {
 		if( process(buffer) ) {
-			callback(capture_statistics());
+			callback(capture_statistics(buffer.count));
 		}
 	}
 
@@ -59,13 +57,14 @@ private:
 	uint32_t last_idle_ticks { 0 };
 	const Thread* const thread_main;
 	uint32_t last_main_ticks { 0 };
-	const Thread* const thread_rssi;
 	uint32_t last_rssi_ticks { 0 };
 	const Thread* const thread_baseband;
 	uint32_t last_baseband_ticks { 0 };
+	uint32_t last_transfers_missed { 0 };
+	uint32_t last_transfers_overwritten { 0 };
 
 	bool process(const buffer_c8_t& buffer);
-	BasebandStatistics capture_statistics();
+	BasebandStatistics capture_statistics(const size_t transfer_samples);
 };
 
 #endif/*__BASEBAND_STATS_COLLECTOR_H__*/
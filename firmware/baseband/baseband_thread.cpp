@@ -26,6 +26,7 @@
 #include "baseband.hpp"
 #include "baseband_sgpio.hpp"
 #include "baseband_dma.hpp"
+#include "baseband_stats_collector.hpp"
 
 #include "rssi.hpp"
 #include "i2s.hpp"
@@ -34,6 +35,7 @@ using namespace lpc43xx;
 #include "portapack_shared_memory.hpp"
 
 #include "utility.hpp"
+#include "chibios_cpp.hpp"
 
 #include <array>
 
@@ -47,9 +49,11 @@ BasebandThread::BasebandThread(
 	uint32_t sampling_rate,
 	BasebandProcessor* const baseband_processor,
 	const tprio_t priority,
-	baseband::Direction direction
+	baseband::Direction direction,
+	const baseband::dma::Ring ring
 ) : baseband_processor { baseband_processor },
 	_direction { direction },
+	ring { ring.clamped() },
 	sampling_rate { sampling_rate }
 {
 	thread = chThdCreateStatic(baseband_thread_wa, sizeof(baseband_thread_wa),
@@ -68,16 +72,31 @@ void BasebandThread::set_sampling_rate(uint32_t new_sampling_rate) {
 	sampling_rate = new_sampling_rate;
 }
 
+StackStatistics BasebandThread::stack_statistics() {
+	StackStatistics statistics;
+	if( thread ) {
+		statistics.size = sizeof(baseband_thread_wa) - sizeof(Thread);
+		statistics.unused = chibios::thread_stack_unused(thread, statistics.size);
+	}
+	return statistics;
+}
+
 void BasebandThread::run() {
 	baseband_sgpio.init();
 	baseband::dma::init();
 
-	const auto baseband_buffer = std::make_unique<std::array<baseband::sample_t, 8192>>();
+	const auto baseband_buffer = std::make_unique<baseband::sample_t[]>(ring.samples());
 	baseband::dma::configure(
-		baseband_buffer->data(),
-		direction()
+		baseband_buffer.get(),
+		direction(),
+		ring
 	);
-	//baseband::dma::allocate(4, 2048);
+
+	BasebandStatsCollector stats {
+		chSysGetIdleThread(),
+		thread_main,
+		chThdSelf()
+	};
 
 	baseband_sgpio.configure(direction());
 	baseband::dma::enable(direction());
@@ -94,6 +113,13 @@ void BasebandThread::run() {
 			if( baseband_processor ) {
 				baseband_processor->execute(buffer);
 			}
+
+			stats.process(buffer,
+				[](const BasebandStatistics& statistics) {
+					const BasebandStatisticsMessage message { statistics };
+					shared_memory.application_queue.push(message);
+				}
+			);
 		}
 	}
 
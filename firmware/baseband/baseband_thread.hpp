@@ -25,6 +25,7 @@
 #include "thread_base.hpp"
 #include "message.hpp"
 #include "baseband_processor.hpp"
+#include "baseband_dma.hpp"
 
 #include <ch.h>
 
@@ -34,7 +35,8 @@ public:
 		uint32_t sampling_rate,
 		BasebandProcessor* const baseband_processor,
 		const tprio_t priority,
-		const baseband::Direction direction = baseband::Direction::Receive
+		const baseband::Direction direction = baseband::Direction::Receive,
+		const baseband::dma::Ring ring = { }
 	);
 	~BasebandThread();
 
@@ -51,12 +53,17 @@ public:
 	
 	void set_sampling_rate(uint32_t new_sampling_rate);
 
+	static StackStatistics stack_statistics();
+
 private:
 	static Thread* thread;
 
 	BasebandProcessor* baseband_processor { nullptr };
 	baseband::Direction _direction { baseband::Direction::Receive };
+	const baseband::dma::Ring ring;
 	uint32_t sampling_rate { 0 };
+	// Processors are built by the main thread
+	const Thread* const thread_main { chThdSelf() };
 
 	void run() override;
 };
@@ -0,0 +1,133 @@
+/*
+ * Copyright (C) 2026 agent
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __BURST_TRIGGER_H__
+#define __BURST_TRIGGER_H__
+
+#include "dsp_types.hpp"
+#include "message.hpp"
+
+#include <cstdint>
+#include <cstddef>
+#include <cmath>
+#include <memory>
+#include <algorithm>
+
+#include <hal.h>
+
+/* Channel power gate for triggered captures. Opens on the first block whose
+ * mean |IQ|^2 is above the threshold, and closes once blocks have stayed 3dB
+ * below it for the hang time. While closed, the latest samples are kept in a
+ * ring so each burst can be streamed with its leading edge.
+ */
+class BurstTrigger {
+public:
+	static constexpr size_t history_samples = 2048;
+
+	void configure(const uint32_t sampling_rate, const CaptureTrigger& trigger) {
+		on_power = full_scale_power * std::pow(10.0f, trigger.threshold_db / 10.0f);
+		off_power = on_power * 0.5f;
+		hang_samples = static_cast<uint64_t>(sampling_rate) * trigger.hang_ms / 1000;
+
+		if( !history ) {
+			history = std::make_unique<complex16_t[]>(history_samples);
+		}
+		reset();
+	}
+
+	void reset() {
+		open = false;
+		hang_count = 0;
+		history_index = 0;
+		history_count = 0;
+	}
+
+	bool is_open() const {
+		return open;
+	}
+
+	void feed(const buffer_c16_t& src) {
+		const float power = block_power(src);
+
+		if( power > on_power ) {
+			open = true;
+			hang_count = 0;
+		} else if( open && (power < off_power) ) {
+			hang_count += src.count;
+			if( hang_count >= hang_samples ) {
+				open = false;
+			}
+		}
+	}
+
+	/* Keep samples seen while closed, oldest are overwritten. */
+	void keep(const buffer_c16_t& src) {
+		for(size_t i=0; i<src.count; i++) {
+			history[history_index] = src.p[i];
+			history_index = (history_index + 1) % history_samples;
+		}
+		history_count = std::min(history_count + src.count, history_samples);
+	}
+
+	/* Pass the kept samples to fn(p, count), oldest first, and empty the ring. */
+	template<typename Fn>
+	void drain(Fn fn) {
+		const size_t first = (history_index + history_samples - history_count) % history_samples;
+		const size_t first_count = std::min(history_count, history_samples - first);
+		if( first_count ) {
+			fn(&history[first], first_count);
+		}
+		if( history_count > first_count ) {
+			fn(&history[0], history_count - first_count);
+		}
+		history_count = 0;
+	}
+
+private:
+	static constexpr float full_scale_power = 32768.0f * 32768.0f;
+
+	float on_power { full_scale_power };
+	float off_power { full_scale_power };
+	uint64_t hang_samples { 0 };
+
+	bool open { false };
+	uint64_t hang_count { 0 };
+
+	std::unique_ptr<complex16_t[]> history { };
+	size_t history_index { 0 };
+	size_t history_count { 0 };
+
+	static float block_power(const buffer_c16_t& src) {
+		if( src.count == 0 ) {
+			return 0.0f;
+		}
+
+		uint64_t sum = 0;
+		auto src_p = src.p;
+		while(src_p < &src.p[src.count]) {
+			const uint32_t sample = *__SIMD32(src_p)++;
+			sum += __SMUAD(sample, sample);
+		}
+		return static_cast<float>(sum) / src.count;
+	}
+};
+
+#endif/*__BURST_TRIGGER_H__*/
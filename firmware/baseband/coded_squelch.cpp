@@ -0,0 +1,217 @@
+/*
+ * Copyright (C) 2026 agent
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "coded_squelch.hpp"
+
+#include "dcs.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+/* DCSDecoder ************************************************************/
+
+void DCSDecoder::configure(const uint32_t sampling_rate) {
+	phase_increment = ((1ULL << 32) * bit_rate_x10) / (sampling_rate * 10ULL);
+	reset();
+}
+
+void DCSDecoder::reset() {
+	phase = 0;
+	lpf = 0;
+	dc = 0;
+	last_level = false;
+	word = 0;
+	bit_count = 0;
+	candidates.fill({ 0, false, 0 });
+	result_ = { 0, false, 0 };
+}
+
+bool DCSDecoder::execute(const buffer_s16_t& src) {
+	bool report = false;
+
+	for(size_t i=0; i<src.count; i++) {
+		// One-pole low-pass (~120Hz at 12kHz) against voice and noise, slow
+		// DC tracker (Q12) against the discriminator offset caused by
+		// frequency error, then slice.
+		lpf += (src.p[i] - lpf) >> lpf_shift;
+		dc += lpf - (dc >> dc_shift);
+		const bool level = (lpf - (dc >> dc_shift)) > 0;
+
+		// Bits are sampled when the phase wraps, so pull transitions
+		// towards half a bit period.
+		if( level != last_level ) {
+			const int32_t error = static_cast<int32_t>(phase - 0x80000000U);
+			phase -= error / 8;
+			last_level = level;
+		}
+
+		const uint32_t phase_last = phase;
+		phase += phase_increment;
+		if( phase < phase_last ) {
+			on_bit(level);
+			if( ++bit_count >= (word_length * report_words) ) {
+				bit_count = 0;
+				update_result();
+				report = true;
+			}
+		}
+	}
+
+	return report;
+}
+
+void DCSDecoder::on_bit(const bool bit) {
+	// First bit received ends up in bit 0, as in dcs::dcs_word().
+	word = (word >> 1) | (bit ? (1U << (word_length - 1)) : 0);
+
+	const auto code = dcs::dcs_code(word);
+	if( code >= 0 ) {
+		add_hit(code, false);
+	}
+
+	const auto code_inverted = dcs::dcs_code(~word);
+	if( code_inverted >= 0 ) {
+		add_hit(code_inverted, true);
+	}
+}
+
+void DCSDecoder::add_hit(const uint32_t code, const bool inverted) {
+	auto weakest = &candidates[0];
+	for(auto& candidate : candidates) {
+		if( (candidate.hits > 0) && (candidate.code == code) && (candidate.inverted == inverted) ) {
+			if( candidate.hits < 255 ) {
+				candidate.hits++;
+			}
+			return;
+		}
+		if( candidate.hits < weakest->hits ) {
+			weakest = &candidate;
+		}
+	}
+
+	*weakest = { static_cast<uint16_t>(code), inverted, 1 };
+}
+
+void DCSDecoder::update_result() {
+	const auto best = std::max_element(candidates.cbegin(), candidates.cend(),
+		[](const Candidate& a, const Candidate& b) {
+			return (a.hits < b.hits) || ((a.hits == b.hits) && (a.code > b.code));
+		}
+	);
+
+	const uint32_t confidence = std::min<uint32_t>(100, best->hits * 100 / report_words);
+	result_ = { best->code, best->inverted, static_cast<uint8_t>(confidence) };
+
+	candidates.fill({ 0, false, 0 });
+}
+
+/* CodedSquelch **********************************************************/
+
+const std::array<float, CodedSquelch::ctcss_tone_count> CodedSquelch::ctcss_tones { {
+	 67.0f,  69.4f,  71.9f,  74.4f,  77.0f,  79.7f,  82.5f,  85.4f,  88.5f,  91.5f,
+	 94.8f,  97.4f, 100.0f, 103.5f, 107.2f, 110.9f, 114.8f, 118.8f, 123.0f, 127.3f,
+	131.8f, 136.5f, 141.3f, 146.2f, 151.4f, 156.7f, 159.8f, 162.2f, 165.5f, 167.9f,
+	171.3f, 173.8f, 177.3f, 179.9f, 183.5f, 186.2f, 189.9f, 192.8f, 196.6f, 199.5f,
+	203.5f, 206.5f, 210.7f, 218.1f, 225.7f, 229.1f, 233.6f, 241.8f, 250.3f, 254.1f,
+} };
+
+void CodedSquelch::configure(const uint32_t sampling_rate, const uint32_t new_tone_squelch) {
+	ctcss_bank.configure(ctcss_tones, sampling_rate, ctcss_bandwidth);
+	dcs.configure(sampling_rate);
+	dcs_valid = false;
+
+	tone_squelch = new_tone_squelch;
+	report_samples = sampling_rate * report_interval;
+	sample_count = 0;
+	gate_open_ = (tone_squelch == NBFMConfigureMessage::tone_squelch_off);
+	gate_hang = 0;
+}
+
+bool CodedSquelch::feed(const buffer_s16_t& src) {
+	ctcss_bank.execute(src);
+	if( dcs.execute(src) ) {
+		dcs_valid = true;
+	}
+
+	sample_count += src.count;
+	if( sample_count < report_samples ) {
+		return false;
+	}
+	sample_count -= report_samples;
+
+	update_message();
+	update_gate();
+	return true;
+}
+
+void CodedSquelch::update_message() {
+	size_t best = 0;
+	for(size_t i=1; i<ctcss_tone_count; i++) {
+		if( ctcss_bank.power(i) > ctcss_bank.power(best) ) {
+			best = i;
+		}
+	}
+
+	// Confidence is the share of the sub-audible band's power in the tone.
+	const auto input_power = ctcss_bank.take_input_power();
+	const auto ratio = (input_power > 0.0f) ? (ctcss_bank.power(best) / input_power) : 0.0f;
+	const uint8_t ctcss_confidence = std::min(100.0f, ratio * 100.0f);
+
+	// A DCS bit stream also puts some energy in the CTCSS bins, so a DCS
+	// match takes precedence.
+	const auto& dcs_result = dcs.result();
+	if( dcs_valid && (dcs_result.confidence >= dcs_confidence_min) ) {
+		message.type = CodedSquelchMessage::Type::DCS;
+		message.value = dcs_result.code;
+		message.confidence = dcs_result.confidence;
+		message.inverted = dcs_result.inverted;
+	} else if( ctcss_confidence >= ctcss_confidence_min ) {
+		message.type = CodedSquelchMessage::Type::CTCSS;
+		message.value = std::lround(ctcss_tones[best] * 100.0f);
+		message.confidence = ctcss_confidence;
+		message.inverted = false;
+	} else {
+		message.type = CodedSquelchMessage::Type::None;
+		message.value = 0;
+		message.confidence = ctcss_confidence;
+		message.inverted = false;
+	}
+}
+
+void CodedSquelch::update_gate() {
+	bool match = false;
+	if( tone_squelch == NBFMConfigureMessage::tone_squelch_off ) {
+		match = true;
+	} else if( tone_squelch == NBFMConfigureMessage::tone_squelch_any ) {
+		match = (message.type == CodedSquelchMessage::Type::CTCSS) || (message.type == CodedSquelchMessage::Type::DCS);
+	} else {
+		match = (message.type == CodedSquelchMessage::Type::CTCSS) && (message.value == tone_squelch);
+	}
+
+	if( match ) {
+		gate_open_ = true;
+		gate_hang = gate_hang_reports;
+	} else if( gate_hang > 0 ) {
+		gate_hang--;
+	} else {
+		gate_open_ = false;
+	}
+}
@@ -0,0 +1,140 @@
+/*
+ * Copyright (C) 2026 agent
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __CODED_SQUELCH_H__
+#define __CODED_SQUELCH_H__
+
+#include "dsp_types.hpp"
+#include "dsp_goertzel.hpp"
+#include "message.hpp"
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+
+/* DCS (CDCSS) decoder: slices the sub-audible NRZ stream at 134.4 bits/s and
+ * checks every 23-bit window against the code table in dcs.cpp, in both
+ * polarities.
+ *
+ * DCS words are cyclic, so rotations of one code can be valid words for
+ * other codes (023N also reads as 340N, 766N, 047I...), up to six per word.
+ * Matches are counted per code over a report period and the most frequent
+ * (then lowest) code wins.
+ */
+class DCSDecoder {
+public:
+	struct Result {
+		uint32_t code;
+		bool inverted;
+		uint8_t confidence;
+	};
+
+	void configure(const uint32_t sampling_rate);
+	void reset();
+
+	/* Returns true when a report period completed; see result(). */
+	bool execute(const buffer_s16_t& src);
+
+	const Result& result() const {
+		return result_;
+	}
+
+private:
+	static constexpr uint32_t bit_rate_x10 { 1344 };
+	static constexpr size_t word_length { 23 };
+	static constexpr size_t report_words { 4 };
+	static constexpr size_t lpf_shift { 4 };
+	static constexpr size_t dc_shift { 12 };
+
+	struct Candidate {
+		uint16_t code;
+		bool inverted;
+		uint8_t hits;
+	};
+
+	uint32_t phase_increment { 0 };
+	uint32_t phase { 0 };
+	int32_t lpf { 0 };
+	int32_t dc { 0 };
+	bool last_level { false };
+	uint32_t word { 0 };
+	size_t bit_count { 0 };
+
+	std::array<Candidate, 8> candidates { };
+	Result result_ { 0, false, 0 };
+
+	void on_bit(const bool bit);
+	void add_hit(const uint32_t code, const bool inverted);
+	void update_result();
+};
+
+/* Sub-audible signalling detector for NFM: a Goertzel bank over the 50
+ * standard CTCSS tones plus a DCS decoder, both fed with the ~300Hz
+ * low-passed audio at 12kHz.
+ *
+ * Reports a CodedSquelchMessage every report_interval and keeps the
+ * tone-squelch gate state: always open when tone squelch is off, otherwise
+ * open while the configured tone (or any, for tone_squelch_any) is present,
+ * with a short hang time.
+ */
+class CodedSquelch {
+public:
+	void configure(const uint32_t sampling_rate, const uint32_t tone_squelch);
+
+	template<typename Callback>
+	void feed(const buffer_s16_t& src, Callback callback) {
+		if( feed(src) ) {
+			callback(message);
+		}
+	}
+
+	bool gate_open() const {
+		return gate_open_;
+	}
+
+private:
+	static constexpr size_t ctcss_tone_count { 50 };
+	static constexpr float ctcss_bandwidth { 1.5f };
+	static constexpr float report_interval { 0.1f };
+	static constexpr uint8_t ctcss_confidence_min { 50 };
+	static constexpr uint8_t dcs_confidence_min { 75 };
+	static constexpr size_t gate_hang_reports { 3 };
+
+	static const std::array<float, ctcss_tone_count> ctcss_tones;
+
+	dsp::GoertzelBank<ctcss_tone_count> ctcss_bank { };
+	DCSDecoder dcs { };
+	bool dcs_valid { false };
+
+	uint32_t tone_squelch { NBFMConfigureMessage::tone_squelch_off };
+	size_t report_samples { 0 };
+	size_t sample_count { 0 };
+	bool gate_open_ { true };
+	size_t gate_hang { 0 };
+
+	CodedSquelchMessage message { CodedSquelchMessage::Type::None, 0 };
+
+	bool feed(const buffer_s16_t& src);
+	void update_message();
+	void update_gate();
+};
+
+#endif/*__CODED_SQUELCH_H__*/
@@ -0,0 +1,167 @@
+/*
+ * Copyright (C) 2026 agent
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "dsp_afsk.hpp"
+
+#include "crc.hpp"
+#include "complex.hpp"
+
+#include <cmath>
+#include <algorithm>
+
+namespace dsp {
+
+void AFSKCorrelator::configure(
+	const uint32_t mark_frequency,
+	const uint32_t space_frequency,
+	const uint32_t baudrate,
+	const uint32_t sampling_rate
+) {
+	length_ = std::min<size_t>(std::max<size_t>(sampling_rate / baudrate, 1), length_max);
+
+	for(size_t k=0; k<length_; k++) {
+		const float w_mark = 2.0f * pi * mark_frequency * k / sampling_rate;
+		const float w_space = 2.0f * pi * space_frequency * k / sampling_rate;
+		mark_i[k] = std::cos(w_mark);
+		mark_q[k] = std::sin(w_mark);
+		space_i[k] = std::cos(w_space);
+		space_q[k] = std::sin(w_space);
+	}
+
+	history.fill(0.0f);
+	index = 0;
+}
+
+float AFSKCorrelator::execute(const float sample) {
+	history[index] = sample;
+	history[index + length_] = sample;
+	if( ++index == length_ ) {
+		index = 0;
+	}
+
+	// Oldest to newest
+	const float* const window = &history[index];
+
+	float m_i = 0.0f, m_q = 0.0f;
+	float s_i = 0.0f, s_q = 0.0f;
+	for(size_t k=0; k<length_; k++) {
+		const float x = window[k];
+		m_i += x * mark_i[k];
+		m_q += x * mark_q[k];
+		s_i += x * space_i[k];
+		s_q += x * space_q[k];
+	}
+
+	const float mark_energy = m_i * m_i + m_q * m_q;
+	const float space_energy = s_i * s_i + s_q * s_q;
+	const float total = mark_energy + space_energy;
+
+	return (total > 0.0f) ? (mark_energy - space_energy) / total : 0.0f;
+}
+
+void AFSKSlicer::configure(
+	const float threshold,
+	const uint32_t baudrate,
+	const uint32_t sampling_rate
+) {
+	this->threshold = threshold;
+	pll_step = (static_cast<uint64_t>(baudrate) << 32) / sampling_rate;
+	pll = 0;
+	level_ = 0;
+	last_level = 0;
+	bit_history = 0;
+	locked = false;
+	nrzi_decode = { };
+	frame_ready_ = false;
+
+	packet_builder.configure(
+		{ 0b01111110, 8 },
+		{ 0b111110, 6 }
+	);
+}
+
+bool AFSKSlicer::execute(const float symbol) {
+	const uint_fast8_t sliced = (symbol > threshold) ? 1 : 0;
+
+	// Bit is sampled when the PLL rolls over, half a bit away from transitions
+	const int32_t last_pll = pll;
+	pll = static_cast<int32_t>(static_cast<uint32_t>(pll) + pll_step);
+	const bool clocked = (last_pll > 0) && (pll < 0);
+	if( clocked ) {
+		level_ = sliced;
+	}
+
+	if( sliced != last_level ) {
+		pll = locked ? (pll - pll / 4) : (pll / 2);
+		last_level = sliced;
+	}
+
+	return clocked;
+}
+
+void AFSKSlicer::deframe() {
+	const auto bit = nrzi_decode(level_);
+
+	bit_history = (bit_history << 1) | bit;
+	if( bit_history == 0b01111110 ) {
+		locked = true;
+	} else if( (bit_history & 0x7f) == 0x7f ) {
+		// Abort, or idle mark
+		locked = false;
+	}
+
+	packet_builder.execute(bit);
+}
+
+void AFSKSlicer::on_packet(const baseband::Packet& packet) {
+	// The closing flag, less its last (unstuffed) bit, is in the packet
+	constexpr size_t flag_tail = 7;
+	constexpr size_t fcs_length = 16;
+	// Destination and source addresses, control, FCS
+	constexpr size_t length_min = (7 + 7 + 1) * 8 + fcs_length + flag_tail;
+
+	const size_t length = packet.size();
+	if( (length < length_min) || ((length - flag_tail) & 7) ) {
+		return;
+	}
+
+	// Bits are in line order, LSB first: the reflected CRC takes them as-is
+	const size_t fcs_start = length - flag_tail - fcs_length;
+	CRC<16, true, true> crc { 0x1021, 0xffff, 0xffff };
+	for(size_t i=0; i<fcs_start; i++) {
+		crc.process_bit(packet[i]);
+	}
+
+	uint16_t fcs = 0;
+	for(size_t i=0; i<fcs_length; i++) {
+		fcs |= packet[fcs_start + i] << i;
+	}
+
+	if( crc.checksum() != fcs ) {
+		return;
+	}
+
+	frame_ = packet;
+	fcs_ = fcs;
+	frame_ready_ = true;
+}
+
+} /* namespace dsp */
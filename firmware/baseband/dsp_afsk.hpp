@@ -0,0 +1,159 @@
+/*
+ * Copyright (C) 2026 agent
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __DSP_AFSK_H__
+#define __DSP_AFSK_H__
+
+#include "packet_builder.hpp"
+#include "symbol_coding.hpp"
+#include "baseband_packet.hpp"
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+
+namespace dsp {
+
+/* Mark/space tone correlator.
+ *
+ * Each tone is correlated against one bit period of the input, which is a
+ * fixed complex FIR with taps e^(jwk): the magnitude doesn't depend on the
+ * phase of the received tone, so no oscillator has to be kept in step.
+ * The output is (Em - Es) / (Em + Es), in [-1, 1] whatever the audio level,
+ * positive for mark.
+ */
+class AFSKCorrelator {
+public:
+	// Ok down to 375 bauds at 24kHz
+	static constexpr size_t length_max = 64;
+
+	void configure(
+		const uint32_t mark_frequency,
+		const uint32_t space_frequency,
+		const uint32_t baudrate,
+		const uint32_t sampling_rate
+	);
+
+	float execute(const float sample);
+
+	size_t length() const {
+		return length_;
+	}
+
+private:
+	size_t length_ { 1 };
+	size_t index { 0 };
+
+	std::array<float, length_max> mark_i { }, mark_q { };
+	std::array<float, length_max> space_i { }, space_q { };
+
+	// Doubled so that the newest length_ samples are always contiguous
+	std::array<float, length_max * 2> history { };
+};
+
+/* Slices the correlator output against one threshold and recovers bits and
+ * AX.25 frames from it.
+ *
+ * A threshold of t slices at Em = Es * (1 + t) / (1 - t), which makes up for
+ * a mark/space level tilt (pre/de-emphasis mismatch, audio response of the
+ * transmitter) of that much. Running several slicers on the same correlator
+ * output lets at least one of them sit near the middle of the eye.
+ *
+ * Bit timing is a digital PLL which rolls over once per bit, sampling there,
+ * and is pulled towards zero phase on each transition; it is pulled harder
+ * while no HDLC flag has been seen, to acquire quickly on the preamble.
+ *
+ * Frames are NRZI decoded, deframed by PacketBuilder and only kept when the
+ * FCS checks.
+ */
+class AFSKSlicer {
+public:
+	AFSKSlicer() = default;
+
+	AFSKSlicer(const AFSKSlicer&) = delete;
+	AFSKSlicer(AFSKSlicer&&) = delete;
+	AFSKSlicer& operator=(const AFSKSlicer&) = delete;
+	AFSKSlicer& operator=(AFSKSlicer&&) = delete;
+
+	void configure(
+		const float threshold,
+		const uint32_t baudrate,
+		const uint32_t sampling_rate
+	);
+
+	/* Returns true when a bit was clocked, its line level is then in level() */
+	bool execute(const float symbol);
+
+	/* Passes the last clocked bit to the HDLC deframer */
+	void deframe();
+
+	uint_fast8_t level() const {
+		return level_;
+	}
+
+	/* A frame with a good FCS is held until release() */
+	bool frame_ready() const {
+		return frame_ready_;
+	}
+
+	const baseband::Packet& frame() const {
+		return frame_;
+	}
+
+	uint16_t fcs() const {
+		return fcs_;
+	}
+
+	void release() {
+		frame_ready_ = false;
+	}
+
+private:
+	float threshold { 0.0f };
+	uint32_t pll_step { 0 };
+	int32_t pll { 0 };
+	uint_fast8_t level_ { 0 };
+	uint_fast8_t last_level { 0 };
+	uint8_t bit_history { 0 };
+	bool locked { false };
+
+	symbol_coding::NRZIDecoder nrzi_decode { };
+
+	// AX.25 frames can share a flag: the end of one is the start of the next
+	PacketBuilder<BitPattern, BitPattern, BitPattern, true> packet_builder {
+		{ 0b01111110, 8 },
+		{ 0b111110, 6 },
+		{ 0b01111110, 8 },
+		[this](const baseband::Packet& packet) {
+			this->on_packet(packet);
+		}
+	};
+
+	bool frame_ready_ { false };
+	baseband::Packet frame_ { };
+	uint16_t fcs_ { 0 };
+
+	void on_packet(const baseband::Packet& packet);
+};
+
+} /* namespace dsp */
+
+#endif/*__DSP_AFSK_H__*/
@@ -24,6 +24,12 @@
 #define __DSP_GOERTZEL_H__
 
 #include "dsp_types.hpp"
+#include "complex.hpp"
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <cmath>
 
 namespace dsp {
 
@@ -38,6 +44,95 @@ private:
 	int16_t s[2] { 0 };
 };
 
+/* Bank of fixed-point "sliding" Goertzel detectors.
+ *
+ * Each tone is a leaky complex resonator, y[n] = r * e^(jw) * y[n-1] + x[n],
+ * so the output is always current (an exponentially-windowed DFT bin)
+ * without keeping a history of samples. r sets the bandwidth and settling
+ * time: tau = 1 / (pi * bandwidth).
+ *
+ * Coefficients are Q30, state is int32. The input is scaled up by
+ * 2^input_shift to keep truncation error well below small signals; the
+ * resonator gain of 1/(1-r) still fits for full-scale input as long as
+ * bandwidth >= ~1Hz at 12kHz.
+ */
+template<size_t N>
+class GoertzelBank {
+public:
+	void configure(
+		const std::array<float, N>& frequencies,
+		const uint32_t sample_rate,
+		const float bandwidth
+	) {
+		const float r = std::exp(-pi * bandwidth / sample_rate);
+		for(size_t i=0; i<N; i++) {
+			const float w = 2.0f * pi * frequencies[i] / sample_rate;
+			coef_cos[i] = std::lround(r * std::cos(w) * q30);
+			coef_sin[i] = std::lround(r * std::sin(w) * q30);
+		}
+		// Amplitude of a tone at the bin centre is 2 * (1-r) * |y|.
+		amplitude_scale = 2.0f * (1.0f - r) / (1 << input_shift);
+		reset();
+	}
+
+	void reset() {
+		state_re.fill(0);
+		state_im.fill(0);
+		input_energy = 0;
+		input_count = 0;
+	}
+
+	void execute(const buffer_s16_t& src) {
+		for(size_t i=0; i<N; i++) {
+			const int64_t c = coef_cos[i];
+			const int64_t s = coef_sin[i];
+			int32_t re = state_re[i];
+			int32_t im = state_im[i];
+			for(size_t n=0; n<src.count; n++) {
+				const int32_t x = static_cast<int32_t>(src.p[n]) << input_shift;
+				const int32_t re_next = static_cast<int32_t>((c * re - s * im) >> 30) + x;
+				im = static_cast<int32_t>((s * re + c * im) >> 30);
+				re = re_next;
+			}
+			state_re[i] = re;
+			state_im[i] = im;
+		}
+
+		for(size_t n=0; n<src.count; n++) {
+			input_energy += static_cast<int32_t>(src.p[n]) * src.p[n];
+		}
+		input_count += src.count;
+	}
+
+	/* Power of tone i, same units as the mean square of the input. */
+	float power(const size_t i) const {
+		const float re = state_re[i] * amplitude_scale;
+		const float im = state_im[i] * amplitude_scale;
+		return (re * re + im * im) * 0.5f;
+	}
+
+	/* Mean square of the input since the last call. */
+	float take_input_power() {
+		const float result = (input_count > 0) ? static_cast<float>(input_energy) / input_count : 0.0f;
+		input_energy = 0;
+		input_count = 0;
+		return result;
+	}
+
+private:
+	static constexpr float q30 = 1073741824.0f;
+	static constexpr size_t input_shift = 4;
+
+	std::array<int32_t, N> coef_cos { };
+	std::array<int32_t, N> coef_sin { };
+	std::array<int32_t, N> state_re { };
+	std::array<int32_t, N> state_im { };
+	float amplitude_scale { 0.0f };
+
+	int64_t input_energy { 0 };
+	size_t input_count { 0 };
+};
+
 } /* namespace dsp */
 
 #endif/*__DSP_GOERTZEL_H__*/
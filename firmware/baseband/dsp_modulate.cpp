@@ -0,0 +1,79 @@
+/*
+ * Copyright (C) 2026 agent
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "dsp_modulate.hpp"
+
+namespace dsp {
+namespace modulate {
+
+namespace {
+
+/* Taylor series, only used at compile time on [0, pi/2] */
+constexpr double quarter_sine(const double x) {
+	double term = x;
+	double sum = x;
+	for(int n=1; n<12; n++) {
+		term *= -x * x / ((2 * n) * (2 * n + 1));
+		sum += term;
+	}
+	return sum;
+}
+
+/* sin(2 pi k / period) */
+constexpr double sine(const size_t k, const size_t period) {
+	constexpr double pi = 3.14159265358979323846;
+	const size_t i = k % period;
+	const size_t half = i % (period / 2);
+	const size_t folded = (half < (period / 4)) ? half : ((period / 2) - half);
+	const double v = quarter_sine(2.0 * pi * folded / period);
+	return (i < (period / 2)) ? v : -v;
+}
+
+constexpr int32_t round_to_int(const double v) {
+	return static_cast<int32_t>((v < 0) ? (v - 0.5) : (v + 0.5));
+}
+
+constexpr std::array<int16_t, (1U << sine_table_i16_log2) + 1> make_sine_table() {
+	std::array<int16_t, (1U << sine_table_i16_log2) + 1> table { };
+	for(size_t k=0; k<table.size(); k++) {
+		table[k] = round_to_int(sine(k, 1U << sine_table_i16_log2) * (127.0 * 256.0));
+	}
+	return table;
+}
+
+constexpr std::array<uint16_t, 1U << phasor_table_log2> make_phasor_table() {
+	constexpr size_t period = 1U << phasor_table_log2;
+	std::array<uint16_t, period> table { };
+	for(size_t k=0; k<period; k++) {
+		const int32_t re = round_to_int(sine(k + period / 4, period) * 127.0);
+		const int32_t im = round_to_int(sine(k, period) * 127.0);
+		table[k] = (re & 0xff) | ((im & 0xff) << 8);
+	}
+	return table;
+}
+
+} /* namespace */
+
+const std::array<int16_t, (1U << sine_table_i16_log2) + 1> sine_table_i16 = make_sine_table();
+const std::array<uint16_t, 1U << phasor_table_log2> phasor_table = make_phasor_table();
+
+} /* namespace modulate */
+} /* namespace dsp */
@@ -0,0 +1,182 @@
+/*
+ * Copyright (C) 2026 agent
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __DSP_MODULATE_H__
+#define __DSP_MODULATE_H__
+
+#include "dsp_types.hpp"
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <array>
+#include <algorithm>
+
+namespace dsp {
+namespace modulate {
+
+/* One period of sin() at +/-(127 * 256), plus a guard entry for the
+ * interpolation of the last segment. */
+constexpr size_t sine_table_i16_log2 = 9;
+extern const std::array<int16_t, (1U << sine_table_i16_log2) + 1> sine_table_i16;
+
+/* One period of cos + j sin as the 16-bit images of complex8_t */
+constexpr size_t phasor_table_log2 = 10;
+extern const std::array<uint16_t, 1U << phasor_table_log2> phasor_table;
+
+/* sin(2 pi phase / 2^32) at +/-127, linearly interpolated between table
+ * entries. For modulating tones, where the sample is scaled up again by the
+ * deviation. */
+inline int32_t sine_s8(const uint32_t phase) {
+	const size_t index = phase >> (32 - sine_table_i16_log2);
+	const int32_t fraction = (phase >> (24 - sine_table_i16_log2)) & 0xff;
+	const int32_t a = sine_table_i16[index];
+	const int32_t b = sine_table_i16[index + 1];
+	return (a + (((b - a) * fraction) >> 8) + 128) >> 8;
+}
+
+/* Carrier sample for phase: one load gives both I and Q. 1024 entries put
+ * truncation spurs near -58dBc, against -44dBc for two lookups in the old
+ * 256-entry sine_table_i8; below that the int8 output dominates anyway. */
+inline uint32_t phasor(const uint32_t phase) {
+	return phasor_table[phase >> (32 - phasor_table_log2)];
+}
+
+/* Fills dst from next() (16-bit complex8_t images), two samples per 32-bit
+ * store once dst is word aligned. The stores go through memcpy, which
+ * compiles to a single STRH/STR, so they don't break strict aliasing. */
+template<typename Sample>
+void synthesize(const buffer_c8_t& dst, Sample next) {
+	auto p = dst.p;
+	size_t count = dst.count;
+
+	if( count && (reinterpret_cast<uintptr_t>(p) & 2) ) {
+		const uint16_t sample = next();
+		memcpy(static_cast<void*>(p++), &sample, sizeof(sample));
+		count--;
+	}
+
+	for(size_t n=0; n<(count >> 1); n++) {
+		const uint32_t first = next();
+		const uint32_t pair = first | (next() << 16);
+		memcpy(static_cast<void*>(p), &pair, sizeof(pair));
+		p += 2;
+	}
+
+	if( count & 1 ) {
+		const uint16_t sample = next();
+		memcpy(static_cast<void*>(p), &sample, sizeof(sample));
+	}
+}
+
+inline void silence(const buffer_c8_t& dst) {
+	std::fill(&dst.p[0], &dst.p[dst.count], complex8_t { 0, 0 });
+}
+
+/* Audio-rate phase accumulator for modulating tones (AFSK, DTMF, SSTV...) */
+class Tone {
+public:
+	/* Current sample at +/-127, then advance by step */
+	int32_t next(const uint32_t step) {
+		const auto sample = sine_s8(phase);
+		phase += step;
+		return sample;
+	}
+
+	void reset() {
+		phase = 0;
+	}
+
+	uint32_t phase { 0 };
+};
+
+class FM {
+public:
+	/* Per-sample phase step from source(), which the compiler inlines: each
+	 * processor's modulating signal gets its own specialised loop. */
+	template<typename Source>
+	void execute(const buffer_c8_t& dst, Source source) {
+		synthesize(dst, [this, &source]() {
+			phase += source();
+			return phasor(phase);
+		});
+	}
+
+	/* Constant frequency run: FSK symbols, held audio samples, CW */
+	void carrier(const buffer_c8_t& dst, const uint32_t step) {
+		synthesize(dst, [this, step]() {
+			phase += step;
+			return phasor(phase);
+		});
+	}
+
+private:
+	uint32_t phase { 0 };
+};
+
+class AM {
+public:
+	void configure(const uint32_t carrier_step) {
+		step = carrier_step;
+	}
+
+	/* Per-sample amplitude from source(), 0 to 256 */
+	template<typename Source>
+	void execute(const buffer_c8_t& dst, Source source) {
+		synthesize(dst, [this, &source]() {
+			phase += step;
+			const int32_t a = source();
+			const uint32_t iq = phasor(phase);
+			const int32_t re = (static_cast<int8_t>(iq) * a) >> 8;
+			const int32_t im = (static_cast<int8_t>(iq >> 8) * a) >> 8;
+			return static_cast<uint32_t>((re & 0xff) | ((im & 0xff) << 8));
+		});
+	}
+
+private:
+	uint32_t step { 0 };
+	uint32_t phase { 0 };
+};
+
+/* On-off keyed carrier at a fixed offset */
+class OOK {
+public:
+	void configure(const uint32_t carrier_step) {
+		step = carrier_step;
+	}
+
+	void execute(const buffer_c8_t& dst, const bool on) {
+		if( on ) {
+			nco.carrier(dst, step);
+		} else {
+			silence(dst);
+		}
+	}
+
+private:
+	FM nco { };
+	uint32_t step { 0 };
+};
+
+} /* namespace modulate */
+} /* namespace dsp */
+
+#endif/*__DSP_MODULATE_H__*/
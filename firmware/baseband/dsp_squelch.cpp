@@ -24,30 +24,31 @@
 #include <cstdint>
 #include <array>
 
-bool FMSquelch::execute(const buffer_f32_t& audio) {
-	if( threshold_squared == 0.0f ) {
+bool FMSquelch::execute(const buffer_s16_t& audio) {
+	if( threshold == 0 ) {
 		return true;
 	}
 
 	// TODO: No hard-coded array size.
-	std::array<float, N> squelch_energy_buffer;
-	const buffer_f32_t squelch_energy {
+	std::array<int16_t, N> squelch_energy_buffer;
+	const buffer_s16_t squelch_energy {
 		squelch_energy_buffer.data(),
 		squelch_energy_buffer.size()
 	};
 	non_audio_hpf.execute(audio, squelch_energy);
 
-	float non_audio_max_squared = 0;
+	int32_t non_audio_max = 0;
 	for(const auto sample : squelch_energy_buffer) {
-		const float sample_squared = sample * sample;
-		if( sample_squared > non_audio_max_squared ) {
-			non_audio_max_squared = sample_squared;
+		const int32_t sample_abs = (sample < 0) ? -sample : sample;
+		if( sample_abs > non_audio_max ) {
+			non_audio_max = sample_abs;
 		}
 	}
 
-	return (non_audio_max_squared < threshold_squared);
+	return (non_audio_max < threshold);
 }
 
 void FMSquelch::set_threshold(const float new_value) {
-	threshold_squared = new_value * new_value;
+	// Full scale is 1.0; compare magnitudes rather than squares in Q15.
+	threshold = new_value * 32768.0f;
 }
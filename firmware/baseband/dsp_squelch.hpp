@@ -31,15 +31,15 @@
 
 class FMSquelch {
 public:
-	bool execute(const buffer_f32_t& audio);
+	bool execute(const buffer_s16_t& audio);
 
 	void set_threshold(const float new_value);
 
 private:
 	static constexpr size_t N = 32;
-	float threshold_squared { 0.0f };
+	int32_t threshold { 0 };
 
-	IIRBiquadFilter non_audio_hpf { non_audio_hpf_config };
+	IIRBiquadFilterQ15 non_audio_hpf { non_audio_hpf_config };
 };
 
 #endif/*__DSP_SQUELCH_H__*/
@@ -24,6 +24,7 @@
 #include "portapack_shared_memory.hpp"
 
 #include "message_queue.hpp"
+#include "chibios_cpp.hpp"
 
 #include "ch.h"
 
@@ -101,17 +102,51 @@ void EventDispatcher::on_message(const Message* const message) {
 		on_message_shutdown(*reinterpret_cast<const ShutdownMessage*>(message));
 		break;
 
+	case Message::ID::MemoryStatistics:
+		on_message_memory_statistics(*reinterpret_cast<const MemoryStatisticsMessage*>(message));
+		acknowledge_message();
+		break;
+
 	default:
 		on_message_default(message);
-		shared_memory.baseband_message = nullptr;
+		acknowledge_message();
 		break;
 	}
 }
 
+void EventDispatcher::acknowledge_message() {
+	shared_memory.baseband_message = nullptr;
+	// Wake the M0 sender, which is blocked waiting for this acknowledgement.
+	creg::m4txevent::assert();
+}
+
 void EventDispatcher::on_message_shutdown(const ShutdownMessage&) {
 	request_stop();
 }
 
+void EventDispatcher::on_message_memory_statistics(const MemoryStatisticsMessage& message) {
+	auto& statistics = *message.statistics;
+
+	size_t heap_free = 0;
+	statistics.heap_fragments = chHeapStatus(NULL, &heap_free);
+	statistics.heap_size = chibios::heap_size();
+	statistics.heap_used = chibios::heap_used();
+	statistics.heap_high_water = chibios::heap_high_water();
+	statistics.heap_largest_free = chibios::heap_largest_free();
+
+	auto& main = statistics.stacks[MemoryStatistics::StackMain];
+	main.size = chibios::thread_stack_size(thread_event_loop);
+	main.unused = chibios::thread_stack_unused(thread_event_loop, main.size);
+
+	auto& irq = statistics.stacks[MemoryStatistics::StackIRQ];
+	irq.size = chibios::irq_stack_size();
+	irq.unused = chibios::irq_stack_unused();
+
+	statistics.stacks[MemoryStatistics::StackBaseband] = BasebandThread::stack_statistics();
+	statistics.stacks[MemoryStatistics::StackRSSI] = RSSIThread::stack_statistics();
+	statistics.valid = true;
+}
+
 void EventDispatcher::on_message_default(const Message* const message) {
 	baseband_processor->on_message(message);
 }
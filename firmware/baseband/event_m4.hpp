@@ -63,7 +63,9 @@ private:
 	void handle_baseband_queue();
 
 	void on_message(const Message* const message);
+	void acknowledge_message();
 	void on_message_shutdown(const ShutdownMessage&);
+	void on_message_memory_statistics(const MemoryStatisticsMessage& message);
 	void on_message_default(const Message* const message);
 
 	void handle_spectrum();
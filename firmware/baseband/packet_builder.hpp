@@ -44,7 +44,10 @@ struct FixedLength {
 	const size_t length;
 };
 
-template<typename PreambleMatcher, typename UnstuffMatcher, typename EndMatcher>
+/* SharedFlag: the end pattern of one packet may also be the preamble of the
+ * next, as with back-to-back HDLC frames.
+ */
+template<typename PreambleMatcher, typename UnstuffMatcher, typename EndMatcher, bool SharedFlag = false>
 class PacketBuilder {
 public:
 	using PayloadHandlerFunc = std::function<void(const baseband::Packet& packet)>;
@@ -97,6 +100,10 @@ public:
 					payload_handler(packet);
 				}
 				reset_state();
+
+				if( SharedFlag && preamble(bit_history, packet.size()) ) {
+					state = State::Payload;
+				}
 			} else {
 				if( packet_truncated() ) {
 					reset_state();
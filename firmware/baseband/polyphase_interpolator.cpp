@@ -0,0 +1,89 @@
+/*
+ * Copyright (C) 2026 agent
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "polyphase_interpolator.hpp"
+
+#include <hal.h>
+
+#include <cmath>
+#include <algorithm>
+
+namespace dsp {
+namespace interpolation {
+
+PolyphaseInterpolator::PolyphaseInterpolator() {
+	/* Cutoff at 0.45 of the input rate, Hann window over the 8 taps. Each
+	 * phase is normalised to unity DC gain so a constant input stays flat. */
+	constexpr float pi = 3.14159265358979f;
+	constexpr float cutoff = 0.9f;
+	constexpr float center = (taps / 2) - 1;
+
+	for(size_t p=0; p<phases; p++) {
+		std::array<float, taps> h;
+		float sum = 0.0f;
+		for(size_t k=0; k<taps; k++) {
+			const float x = static_cast<float>(k) - center - static_cast<float>(p) / phases;
+			const float sinc = (x == 0.0f) ? 1.0f : std::sin(pi * cutoff * x) / (pi * cutoff * x);
+			const float window = 0.5f + 0.5f * std::cos(pi * x / (taps / 2));
+			h[k] = sinc * window;
+			sum += h[k];
+		}
+		for(size_t k=0; k<taps; k++) {
+			coefficients[p][k] = std::lround(h[k] / sum * 32767.0f);
+		}
+	}
+}
+
+void PolyphaseInterpolator::configure(
+	const uint32_t input_rate,
+	const uint32_t output_rate
+) {
+	increment = (static_cast<uint64_t>(input_rate) << 16) / output_rate;
+	position = 0;
+	history.fill(0);
+}
+
+void PolyphaseInterpolator::execute(
+	const size_t input_count,
+	const buffer_s16_t& dst
+) {
+	/* history[0..taps-1] is the tail of the previous block, new samples
+	 * follow. Output n sits between history[i + 3] and history[i + 4]. */
+	for(size_t n=0; n<dst.count; n++) {
+		const size_t i = position >> 16;
+		const auto& h = coefficients[(position >> (16 - phases_log2)) & (phases - 1)];
+		const int16_t* const x = &history[i];
+
+		int32_t acc = 0;
+		for(size_t k=0; k<taps; k++) {
+			acc += h[k] * x[k];
+		}
+		dst.p[n] = __SSAT(acc >> 15, 16);
+
+		position += increment;
+	}
+
+	position -= input_count << 16;
+	std::copy(&history[input_count], &history[input_count + taps], &history[0]);
+}
+
+} /* namespace interpolation */
+} /* namespace dsp */
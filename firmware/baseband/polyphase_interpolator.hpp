@@ -0,0 +1,78 @@
+/*
+ * Copyright (C) 2026 agent
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __POLYPHASE_INTERPOLATOR_H__
+#define __POLYPHASE_INTERPOLATOR_H__
+
+#include "dsp_types.hpp"
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+
+namespace dsp {
+namespace interpolation {
+
+/* Arbitrary-ratio interpolator: an 8-tap windowed-sinc prototype split into
+ * 32 phases, the phase picked from the fractional input position. Input is
+ * pushed in blocks; samples_needed() tells how many new input samples the
+ * next execute() of a given output length will consume.
+ */
+class PolyphaseInterpolator {
+public:
+	static constexpr size_t taps = 8;
+	static constexpr size_t phases_log2 = 5;
+	static constexpr size_t phases = 1U << phases_log2;
+	static constexpr size_t input_max = 256;
+
+	PolyphaseInterpolator();
+
+	void configure(
+		const uint32_t input_rate,
+		const uint32_t output_rate
+	);
+
+	size_t samples_needed(const size_t output_count) const {
+		return (position + output_count * increment) >> 16;
+	}
+
+	/* Room for input_max new samples, to be filled before execute(). */
+	int16_t* input() {
+		return &history[taps];
+	}
+
+	void execute(
+		const size_t input_count,
+		const buffer_s16_t& dst
+	);
+
+private:
+	std::array<std::array<int16_t, taps>, phases> coefficients { };
+	std::array<int16_t, taps + input_max> history { };
+
+	uint32_t increment { 0 };	/* Input samples per output sample, 16.16 */
+	uint32_t position { 0 };
+};
+
+} /* namespace interpolation */
+} /* namespace dsp */
+
+#endif/*__POLYPHASE_INTERPOLATOR_H__*/
@@ -22,10 +22,10 @@
 
 #include "proc_afsk.hpp"
 #include "portapack_shared_memory.hpp"
-#include "sine_table_int8.hpp"
 #include "event_m4.hpp"
 
 #include <cstdint>
+#include <algorithm>
 
 void AFSKProcessor::execute(const buffer_c8_t& buffer) {
 	
@@ -33,64 +33,59 @@ void AFSKProcessor::execute(const buffer_c8_t& buffer) {
 	
 	if (!configured) return;
 	
-	for (size_t i = 0; i<buffer.count; i++) {
-
-		if (sample_count >= afsk_samples_per_bit) {
-			if (configured) {
-				cur_word = *word_ptr;
-				
-				if (!cur_word) {
-					// End of data
-					if (repeat_counter < afsk_repeat) {
-						// Repeat
-						bit_pos = 0;
-						word_ptr = (uint16_t*)shared_memory.bb_data.data;
-						cur_word = *word_ptr;
-						txprogress_message.done = false;
-						txprogress_message.progress = repeat_counter + 1;
-						shared_memory.application_queue.push(txprogress_message);
-						repeat_counter++;
-					} else {
-						// Stop
-						cur_word = 0;
-						txprogress_message.done = true;
-						shared_memory.application_queue.push(txprogress_message);
-						configured = false;
-					}
-				}
-			}
-			
-			cur_bit = (cur_word >> (symbol_count - bit_pos)) & 1;
-
-			if (bit_pos >= symbol_count) {
-				bit_pos = 0;
-				word_ptr++;
-			} else {
-				bit_pos++;
-			}
-			
-			sample_count = 0;
+	for (size_t i = 0; i < buffer.count; ) {
+		if (configured && !symbol_samples)
+			next_bit();
+		
+		const size_t run = configured ? std::min<size_t>(symbol_samples, buffer.count - i) : buffer.count - i;
+		const buffer_c8_t dst { &buffer.p[i], run };
+		
+		if (configured) {
+			const uint32_t tone_step = cur_bit ? afsk_phase_inc_mark : afsk_phase_inc_space;
+			fm.execute(dst, [this, tone_step]() {
+				return tone.next(tone_step) * fm_delta;
+			});
+			symbol_samples -= run;
 		} else {
-			sample_count++;
+			dsp::modulate::silence(dst);
 		}
-		
-		if (cur_bit)
-			tone_phase += afsk_phase_inc_mark;
-		else
-			tone_phase += afsk_phase_inc_space;
-
-		tone_sample = sine_table_i8[(tone_phase & 0xFF000000U) >> 24];
+		i += run;
+	}
+}
 
-		delta = tone_sample * fm_delta;
-		
-		phase += delta;
-		sphase = phase + (64 << 24);
+void AFSKProcessor::next_bit() {
+	cur_word = *word_ptr;
+	
+	if (!cur_word) {
+		// End of data
+		if (repeat_counter < afsk_repeat) {
+			// Repeat
+			bit_pos = 0;
+			word_ptr = (uint16_t*)shared_memory.bb_data.data;
+			cur_word = *word_ptr;
+			txprogress_message.done = false;
+			txprogress_message.progress = repeat_counter + 1;
+			shared_memory.application_queue.push(txprogress_message);
+			repeat_counter++;
+		} else {
+			// Stop
+			cur_word = 0;
+			txprogress_message.done = true;
+			shared_memory.application_queue.push(txprogress_message);
+			configured = false;
+		}
+	}
+	
+	cur_bit = (cur_word >> (symbol_count - bit_pos)) & 1;
 
-		re = (sine_table_i8[(sphase & 0xFF000000U) >> 24]);
-		im = (sine_table_i8[(phase & 0xFF000000U) >> 24]);
-			
-		buffer.p[i] = {re, im};
+	if (bit_pos >= symbol_count) {
+		bit_pos = 0;
+		word_ptr++;
+	} else {
+		bit_pos++;
 	}
+	
+	symbol_samples = afsk_samples_per_bit + 1;
 }
 
 void AFSKProcessor::on_message(const Message* const msg) {
@@ -105,7 +100,7 @@ void AFSKProcessor::on_message(const Message* const msg) {
 			fm_delta = message.fm_delta * (0xFFFFFFULL / AFSK_SAMPLERATE);
 			symbol_count = message.symbol_count - 1;
 
-			sample_count = afsk_samples_per_bit;
+			symbol_samples = 0;
 			repeat_counter = 0;
 			bit_pos = 0;
 			word_ptr = (uint16_t*)shared_memory.bb_data.data;
@@ -41,106 +41,70 @@ void AFSKRxProcessor::execute(const buffer_c8_t& buffer) {
 	
 	audio_output.write(audio);
 
-	// Audio signal processing
 	for (size_t c = 0; c < audio.count; c++) {
-
-		const int32_t sample_int = audio.p[c] * 32768.0f;
-		int32_t current_sample = __SSAT(sample_int, 16);
-		
-		current_sample /= 128;
-		
-		// Delay line put
-		delay_line[delay_line_index & 0x3F] = current_sample;
-		
-		// Delay line get, and LPF
-		sample_mixed = (delay_line[(delay_line_index - (samples_per_bit/2)) & 0x3F] * current_sample) / 4;
-		sample_filtered = prev_mixed + sample_mixed + (prev_filtered / 2);
-		
-		delay_line_index++;
-		
-		prev_filtered = sample_filtered;
-		prev_mixed = sample_mixed;
-		
-		// Slice
-		sample_bits <<= 1;
-		sample_bits |= (sample_filtered < -20) ? 1 : 0;
-		
-		// Check for "clean" transition: either 0011 or 1100
-		if ((((sample_bits >> 2) ^ sample_bits) & 3) == 3) {
-			// Adjust phase
-			if (phase < 0x8000)
-				phase += 0x800;		// Is this a proper value ?
-			else
-				phase -= 0x800;
-		}
+		const float symbol = correlator.execute(audio.p[c]);
+		sample_count++;
 		
-		phase += phase_inc;
-		
-		if (phase >= 0x10000) {
-			phase &= 0xFFFF;
-			
-			if (trigger_word) {
-				
-				// Continuous-stream value-triggered mode (AX.25) - UNTESTED
-				word_bits <<= 1;
-				word_bits |= (sample_bits & 1);
-				
-				bit_counter++;
+		if (ax25) {
+			// Multi-slicer: same symbols, different mark/space thresholds
+			for (auto& slicer : slicers) {
+				if (slicer.execute(symbol))
+					slicer.deframe();
 				
-				if (triggered) {
-					if (bit_counter == word_length) {
-						bit_counter = 0;
-						
-						data_message.is_data = true;
-						data_message.value = word_bits & word_mask;
-						shared_memory.application_queue.push(data_message);
-					}
-				} else {
-					if ((word_bits & word_mask) == trigger_value) {
-						triggered = !triggered;
-						bit_counter = 0;
-						
-						data_message.is_data = true;
-						data_message.value = trigger_value;
-						shared_memory.application_queue.push(data_message);
-					}
+				if (slicer.frame_ready()) {
+					on_frame(slicer);
+					slicer.release();
 				}
-				
-			} else {
-				
-				// RS232-like modem mode
-				if (state == WAIT_START) {
-					if (!(sample_bits & 1)) {
-						// Got start bit
-						state = RECEIVE;
-						bit_counter = 0;
-					}
-				} else if (state == WAIT_STOP) {
-					if (sample_bits & 1) {
-						// Got stop bit
-						state = WAIT_START;
-					}
-				} else {
-					word_bits <<= 1;
-					word_bits |= (sample_bits & 1);
-					
-					bit_counter++;
-				}
-				
-				if (bit_counter == word_length) {
-					bit_counter = 0;
-					state = WAIT_STOP;
-					
-					data_message.is_data = true;
-					data_message.value = word_bits;
-					shared_memory.application_queue.push(data_message);
-				}
-				
 			}
+		} else {
+			auto& slicer = slicers[slicer_count / 2];
+			if (slicer.execute(symbol))
+				on_serial_bit(slicer.level());
 		}
 	}
 }
 
+void AFSKRxProcessor::on_serial_bit(const uint_fast8_t bit) {
+	// RS232-like modem mode
+	if (state == WAIT_START) {
+		if (!bit) {
+			// Got start bit
+			state = RECEIVE;
+			bit_counter = 0;
+		}
+	} else if (state == WAIT_STOP) {
+		if (bit) {
+			// Got stop bit
+			state = WAIT_START;
+		}
+	} else {
+		word_bits <<= 1;
+		word_bits |= bit;
+		
+		bit_counter++;
+	}
+	
+	if (bit_counter == word_length) {
+		bit_counter = 0;
+		state = WAIT_STOP;
+		
+		data_message.is_data = true;
+		data_message.value = word_bits;
+		shared_memory.application_queue.push(data_message);
+	}
+}
+
+void AFSKRxProcessor::on_frame(const dsp::AFSKSlicer& slicer) {
+	if ((slicer.fcs() == last_fcs) && ((sample_count - last_frame_sample) < duplicate_window))
+		return;
+	
+	last_fcs = slicer.fcs();
+	last_frame_sample = sample_count;
+	
+	const AX25FrameMessage message { slicer.frame() };
+	shared_memory.application_queue.push(message);
+}
+
 void AFSKRxProcessor::on_message(const Message* const message) {
 	if (message->id == Message::ID::AFSKRxConfigure)
 		configure(*reinterpret_cast<const AFSKRxConfigureMessage*>(message));
@@ -165,22 +129,17 @@ void AFSKRxProcessor::configure(const AFSKRxConfigureMessage& message) {
 
 	audio_output.configure(audio_24k_hpf_300hz_config, audio_24k_deemph_300_6_config, 0);
 	
-	samples_per_bit = audio_fs / message.baudrate;
+	correlator.configure(mark_frequency, space_frequency, message.baudrate, audio_fs);
+	for (size_t i = 0; i < slicer_count; i++)
+		slicers[i].configure(slicer_thresholds[i], message.baudrate, audio_fs);
 	
-	phase_inc = (0x10000 * message.baudrate) / audio_fs;
-	phase = 0;
-	
-	trigger_word = message.trigger_word;
+	ax25 = message.ax25;
 	word_length = message.word_length;
-	trigger_value = message.trigger_value;
-	word_mask = (1 << word_length) - 1;
-	
-	// Delay line
-	delay_line_index = 0;
-	
-	triggered = false;
 	state = WAIT_START;
 	
+	duplicate_window = correlator.length() * 32;
+	last_frame_sample = sample_count - duplicate_window;
+	
 	configured = true;
 }
 
@@ -29,6 +29,7 @@
 
 #include "dsp_decimate.hpp"
 #include "dsp_demodulate.hpp"
+#include "dsp_afsk.hpp"
 
 #include "audio_output.hpp"
 
@@ -45,7 +46,13 @@ private:
 	static constexpr size_t baseband_fs = 3072000;
 	static constexpr size_t audio_fs = baseband_fs / 8 / 8 / 2;
 	
-	size_t samples_per_bit { };
+	// Bell 202
+	static constexpr uint32_t mark_frequency = 1200;
+	static constexpr uint32_t space_frequency = 2200;
+	
+	// Mark/space tilts of up to about +/-5dB, see AFSKSlicer
+	static constexpr size_t slicer_count = 5;
+	static constexpr std::array<float, slicer_count> slicer_thresholds { { -0.8f, -0.4f, 0.0f, 0.4f, 0.8f } };
 	
 	enum State {
 		WAIT_START = 0,
@@ -67,9 +74,6 @@ private:
 		audio.size()
 	};
 	
-	// Array size ok down to 375 bauds (24000 / 375)
-	std::array<int32_t, 64> delay_line { 0 };
-	
 	dsp::decimate::FIRC8xR16x24FS4Decim8 decim_0 { };
 	dsp::decimate::FIRC16xR16x32Decim8 decim_1 { };
 	dsp::decimate::FIRAndDecimateComplex channel_filter { };
@@ -77,27 +81,30 @@ private:
 	dsp::demodulate::FM demod { };
 	
 	AudioOutput audio_output { };
+	
+	dsp::AFSKCorrelator correlator { };
+	std::array<dsp::AFSKSlicer, slicer_count> slicers { };
 
 	State state { };
-	size_t delay_line_index { };
 	uint32_t bit_counter { 0 };
 	uint32_t word_bits { 0 };
-	uint32_t sample_bits { 0 };
-	uint32_t phase { }, phase_inc { };
-	int32_t sample_mixed { }, prev_mixed { }, sample_filtered { }, prev_filtered { };
 	uint32_t word_length { };
-	uint32_t word_mask { };
-	uint32_t trigger_value { };
+	
+	// Slicers which decode the same frame finish it within a few bits
+	uint32_t sample_count { 0 };
+	uint32_t duplicate_window { 0 };
+	uint32_t last_frame_sample { 0 };
+	uint16_t last_fcs { 0 };
 	
 	bool configured { false };
-	bool wait_start { };
-	bool bit_value { };
-	bool trigger_word { };
-	bool triggered { };
+	bool ax25 { false };
 	
 	void configure(const AFSKRxConfigureMessage& message);
 	
+	void on_serial_bit(const uint_fast8_t bit);
+	void on_frame(const dsp::AFSKSlicer& slicer);
+	
 	AFSKDataMessage data_message { false, 0 };
 };
 
-#endif/*__PROC_TPMS_H__*/
+#endif/*__PROC_AFSKRX_H__*/
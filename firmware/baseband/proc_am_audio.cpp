@@ -68,6 +68,10 @@ void NarrowbandAMAudio::on_message(const Message* const message) {
 	case Message::ID::CaptureConfig:
 		capture_config(*reinterpret_cast<const CaptureConfigMessage*>(message));
 		break;
+
+	case Message::ID::AudioProcessingConfig:
+		audio_processing_config(*reinterpret_cast<const AudioProcessingConfigMessage*>(message));
+		break;
 		
 	default:
 		break;
@@ -108,6 +112,10 @@ void NarrowbandAMAudio::capture_config(const CaptureConfigMessage& message) {
 	}
 }
 
+void NarrowbandAMAudio::audio_processing_config(const AudioProcessingConfigMessage& message) {
+	audio_output.set_processing(message.agc, message.noise_blanker);
+}
+
 int main() {
 	EventDispatcher event_dispatcher { std::make_unique<NarrowbandAMAudio>() };
 	event_dispatcher.run();
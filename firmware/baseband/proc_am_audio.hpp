@@ -78,6 +78,7 @@ private:
 	bool configured { false };
 	void configure(const AMConfigureMessage& message);
 	void capture_config(const CaptureConfigMessage& message);
+	void audio_processing_config(const AudioProcessingConfigMessage& message);
 
 	buffer_f32_t demodulate(const buffer_c16_t& channel);
 };
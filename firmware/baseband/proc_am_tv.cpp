@@ -24,7 +24,6 @@
 #include "proc_am_tv.hpp"
 
 #include "portapack_shared_memory.hpp"
-#include "dsp_fft.hpp"
 #include "event_m4.hpp"
 
 #include <cstdint>
@@ -33,36 +32,34 @@ void WidebandFMAudio::execute(const buffer_c8_t& buffer) {
 	if( !configured ) {
 		return;
 	}
-	
-	std::fill(spectrum.begin(), spectrum.end(), 0);
 
-	for(size_t i=0; i<spectrum.size(); i++) {
-		spectrum[i] += buffer.p[i];
-	}
-
-	const buffer_c16_t buffer_c16 {spectrum.data(),spectrum.size(),buffer.sampling_rate};
-	channel_spectrum.feed(buffer_c16);
+	line_sync.feed(buffer,
+		[this](const VideoLine& line) {
+			this->on_line(line);
+		}
+	);
+}
 
-        int8_t re, im;
-	int8_t mag;
+void WidebandFMAudio::on_line(const VideoLine& line) {
+	if( streaming ) {
+		/* A full FIFO drops the line; the previous field's row stays on screen. */
+		fifo.in(line);
+	}
 
-        for (size_t i = 0; i < 128; i++) 
-	{
-		re = buffer.p[i].real();
-		im = buffer.p[i].imag();
-		mag = __builtin_sqrtf((re * re) + (im * im)) ;
-		const unsigned int v =  re + 127.0f; //timescope
-		audio_spectrum.db[i] = std::max(0U, std::min(255U, v));
+	if( line.number == scope_line_number ) {
+		/* Time scope: one line per field is plenty */
+		for(size_t i=0; i<audio_spectrum.db.size(); i++) {
+			audio_spectrum.db[i] = line.pixels[i * line.pixels.size() / audio_spectrum.db.size()];
+		}
+		AudioSpectrumMessage message { &audio_spectrum };
+		shared_memory.application_queue.push(message);
 	}
-	AudioSpectrumMessage message { &audio_spectrum };
-	shared_memory.application_queue.push(message);
 }
 
 void WidebandFMAudio::on_message(const Message* const message) {
 	switch(message->id) {
-	case Message::ID::UpdateSpectrum:
 	case Message::ID::SpectrumStreamingConfig:
-		channel_spectrum.on_message(message);
+		set_streaming(*reinterpret_cast<const SpectrumStreamingConfigMessage*>(message));
 		break;
 
 	case Message::ID::WFMConfigure:
@@ -74,7 +71,18 @@ void WidebandFMAudio::on_message(const Message* const message) {
 	}
 }
 
-void WidebandFMAudio::configure(const WFMConfigureMessage& message) {
+void WidebandFMAudio::set_streaming(const SpectrumStreamingConfigMessage& message) {
+	if( message.mode == SpectrumStreamingConfigMessage::Mode::Running ) {
+		VideoLineConfigMessage config_message { &fifo };
+		shared_memory.application_queue.push(config_message);
+		streaming = true;
+	} else {
+		streaming = false;
+		fifo.reset_in();
+	}
+}
+
+void WidebandFMAudio::configure(const WFMConfigureMessage&) {
 	configured = true;
 }
 
@@ -29,11 +29,8 @@
 #include "rssi_thread.hpp"
 
 #include "dsp_types.hpp"
-#include "dsp_decimate.hpp"
-#include "dsp_demodulate.hpp"
-#include "block_decimator.hpp"
 
-#include "tv_collector.hpp"
+#include "video_line_sync.hpp"
 
 class WidebandFMAudio : public BasebandProcessor {
 public:
@@ -42,24 +39,26 @@ public:
 	void on_message(const Message* const message) override;
 
 private:
-	static constexpr size_t baseband_fs = 2000000;
+	/* 256 samples per 64us line */
+	static constexpr size_t baseband_fs = 4000000;
+	static constexpr uint16_t scope_line_number = 128;
 
 	BasebandThread baseband_thread { baseband_fs, this, NORMALPRIO + 20, baseband::Direction::Receive };
 	RSSIThread rssi_thread { NORMALPRIO + 10 };
 
-	std::array<complex16_t, 512> dst { };
-	const buffer_c16_t dst_buffer {
-		dst.data(),
-		dst.size()
-	};
+	VideoLineSync line_sync { baseband_fs };
+
+	VideoLine fifo_data[1 << VideoLineConfigMessage::fifo_k] { };
+	VideoLineFIFO fifo { fifo_data, VideoLineConfigMessage::fifo_k };
+	bool streaming { false };
 
 	AudioSpectrum audio_spectrum { };
-	TvCollector channel_spectrum { };
-        std::array<complex16_t, 256> spectrum { };
 
 	bool configured { false };
 	void configure(const WFMConfigureMessage& message);
 
+	void on_line(const VideoLine& line);
+	void set_streaming(const SpectrumStreamingConfigMessage& message);
 };
 
 #endif/*__PROC_AM_TV_H__*/
@@ -22,50 +22,71 @@
 
 #include "proc_audiotx.hpp"
 #include "portapack_shared_memory.hpp"
-#include "sine_table_int8.hpp"
 #include "event_m4.hpp"
 
 #include <cstdint>
+#include <algorithm>
 
 void AudioTXProcessor::execute(const buffer_c8_t& buffer){
 	
 	if (!configured) return;
 	
-	// Zero-order hold (poop)
-	for (size_t i = 0; i < buffer.count; i++) {
-		resample_acc += resample_inc;
-		if (resample_acc >= 0x10000) {
-			resample_acc -= 0x10000;
-			if (stream) {
-				stream->read(&audio_sample, 1);
-				bytes_read++;
-			}
-		}
+	for (size_t offset = 0; offset < buffer.count; ) {
+		const size_t count = std::min(buffer.count - offset, block_max * fm_hold) / fm_hold;
+		const buffer_s16_t audio_block { audio.data(), count, audio_fs };
 		
-		sample = tone_gen.process(audio_sample - 0x80);
+		const size_t needed = interpolator.samples_needed(count);
+		read_block(interpolator.input(), needed);
+		interpolator.execute(needed, audio_block);
 		
-		// FM
-		delta = sample * fm_delta;
-		
-		phase += delta;
-		sphase = phase + (64 << 24);
-		
-		re = sine_table_i8[(sphase & 0xFF000000U) >> 24];
-		im = sine_table_i8[(phase & 0xFF000000U) >> 24];
-		
-		buffer.p[i] = { (int8_t)re, (int8_t)im };
+		modulate(audio_block, &buffer.p[offset]);
+		offset += count * fm_hold;
 	}
 	
 	progress_samples += buffer.count;
 	if (progress_samples >= progress_interval_samples) {
 		progress_samples -= progress_interval_samples;
 		
-		txprogress_message.progress = bytes_read;	// Inform UI about progress
+		txprogress_message.progress = samples_read;	// Inform UI about progress
 		txprogress_message.done = false;
+		txprogress_message.underruns = underruns;
 		shared_memory.application_queue.push(txprogress_message);
 	}
 }
 
+// One StreamOutput read per block, converted to signed 16-bit
+void AudioTXProcessor::read_block(int16_t* const dst, const size_t count) {
+	size_t available = 0;
+	
+	if (stream) {
+		available = stream->read(raw.data(), count * bytes_per_sample) / bytes_per_sample;
+		if (available < count)
+			underruns++;
+	}
+	samples_read += available;
+	
+	if (bytes_per_sample == 2) {
+		const auto src = reinterpret_cast<const int16_t*>(raw.data());
+		std::copy(&src[0], &src[available], dst);
+	} else {
+		for (size_t i = 0; i < available; i++)
+			dst[i] = (raw[i] - 0x80) << 8;
+	}
+	
+	// Missing data is sent as silence
+	std::fill(&dst[available], &dst[count], 0);
+}
+
+void AudioTXProcessor::modulate(const buffer_s16_t& src, complex8_t* dst) {
+	// fm_delta is scaled for 8-bit samples: split the >> 8 to keep 32 bits
+	const int32_t fm_delta_s16 = fm_delta >> 4;
+	
+	for (size_t n = 0; n < src.count; n++) {
+		const int32_t sample = tone_gen.process_s16(src.p[n]);
+		fm.carrier({ &dst[n * fm_hold], fm_hold }, (sample >> 4) * fm_delta_s16);
+	}
+}
+
 void AudioTXProcessor::on_message(const Message* const message) {
 	switch(message->id) {
 		case Message::ID::AudioTXConfig:
@@ -74,7 +95,8 @@ void AudioTXProcessor::on_message(const Message* const message) {
 
 		case Message::ID::ReplayConfig:
 			configured = false;
-			bytes_read = 0;
+			samples_read = 0;
+			underruns = 0;
 			replay_config(*reinterpret_cast<const ReplayConfigMessage*>(message));
 			break;
 		
@@ -93,9 +115,10 @@ void AudioTXProcessor::on_message(const Message* const message) {
 
 void AudioTXProcessor::audio_config(const AudioTXConfigMessage& message) {
 	fm_delta = message.deviation_hz * (0xFFFFFFULL / baseband_fs);
-	tone_gen.configure(message.tone_key_delta, message.tone_key_mix_weight);
+	// Tone key delta is for baseband_fs, the mix runs at audio_fs
+	tone_gen.configure(message.tone_key_delta * fm_hold, message.tone_key_mix_weight);
+	bytes_per_sample = (message.bits_per_sample == 16) ? 2 : 1;
 	progress_interval_samples = message.divider;
-	resample_acc = 0;
 }
 
 void AudioTXProcessor::replay_config(const ReplayConfigMessage& message) {
@@ -111,7 +134,8 @@ void AudioTXProcessor::replay_config(const ReplayConfigMessage& message) {
 }
 
 void AudioTXProcessor::samplerate_config(const SamplerateConfigMessage& message) {
-	resample_inc = (((uint64_t)message.sample_rate) << 16) / baseband_fs;	// 16.16 fixed point message.sample_rate
+	// Sources above audio_fs would need more than one input block per output block
+	interpolator.configure(std::min<uint32_t>(message.sample_rate, audio_fs), audio_fs);
 }
 
 int main() {
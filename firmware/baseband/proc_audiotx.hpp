@@ -27,6 +27,8 @@
 #include "baseband_thread.hpp"
 #include "tone_gen.hpp"
 #include "stream_output.hpp"
+#include "polyphase_interpolator.hpp"
+#include "dsp_modulate.hpp"
 
 class AudioTXProcessor : public BasebandProcessor {
 public:
@@ -36,24 +38,34 @@ public:
 
 private:
 	static constexpr size_t baseband_fs = 1536000;
+	/* Audio is interpolated to 192kHz, each sample then holds the FM
+	 * frequency for 8 baseband samples. */
+	static constexpr size_t fm_hold = 8;
+	static constexpr size_t audio_fs = baseband_fs / fm_hold;
+	static constexpr size_t block_max = dsp::interpolation::PolyphaseInterpolator::input_max;
 	
 	BasebandThread baseband_thread { baseband_fs, this, NORMALPRIO + 20, baseband::Direction::Transmit };
 	
 	std::unique_ptr<StreamOutput> stream { };
 	
 	ToneGen tone_gen { };
+	dsp::interpolation::PolyphaseInterpolator interpolator { };
+	
+	std::array<uint8_t, block_max * 2> raw { };
+	std::array<int16_t, block_max> audio { };
 	
-	uint32_t resample_inc { }, resample_acc { };
 	uint32_t fm_delta { 0 };
-	uint32_t phase { 0 }, sphase { 0 };
-	uint8_t audio_sample { };
-	int32_t sample { 0 }, delta { };
-	int8_t re { 0 }, im { 0 };
+	dsp::modulate::FM fm { };
+	size_t bytes_per_sample { 1 };
 	
 	size_t progress_interval_samples, progress_samples = 0;
 	
 	bool configured { false };
-	uint32_t bytes_read { 0 };
+	uint32_t samples_read { 0 };
+	uint32_t underruns { 0 };
+	
+	void read_block(int16_t* const dst, const size_t count);
+	void modulate(const buffer_s16_t& src, complex8_t* dst);
 	
 	void samplerate_config(const SamplerateConfigMessage& message);
 	void audio_config(const AudioTXConfigMessage& message);
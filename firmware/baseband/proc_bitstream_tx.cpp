@@ -0,0 +1,221 @@
+/*
+ * Copyright (C) 2026 agent
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "proc_bitstream_tx.hpp"
+#include "portapack_shared_memory.hpp"
+#include "event_m4.hpp"
+
+#include <cstdint>
+#include <cmath>
+#include <algorithm>
+
+BitstreamTXProcessor::BitstreamTXProcessor() {
+	// Rising half of a raised cosine
+	for (size_t k = 0; k < ramp_table.size(); k++) {
+		const float w = pi * k / ramp_table.size();
+		ramp_table[k] = std::round(128.0f - 128.0f * std::cos(w));
+	}
+}
+
+void BitstreamTXProcessor::execute(const buffer_c8_t& buffer) {
+	
+	if (!configured) {
+		dsp::modulate::silence(buffer);
+		return;
+	}
+	
+	for (size_t i = 0; i < buffer.count; ) {
+		if (!symbol_samples && !next_symbol()) {
+			dsp::modulate::silence({ &buffer.p[i], buffer.count - i });
+			break;
+		}
+		
+		const size_t run = std::min<size_t>(ramp_samples ? ramp_samples : symbol_samples, buffer.count - i);
+		const buffer_c8_t dst { &buffer.p[i], run };
+		
+		if (ramp_samples) {
+			const int32_t from = level_from;
+			const int64_t delta = level - level_from;
+			modulate(dst, [this, from, delta]() {
+				const int32_t w = ramp_table[ramp_phase >> 16];
+				ramp_phase += ramp_step;
+				return from + static_cast<int32_t>((delta * w) >> 8);
+			});
+			ramp_samples -= run;
+		} else if ((modulation == Modulation::OOK) && !level) {
+			dsp::modulate::silence(dst);
+		} else if (modulation == Modulation::FSK) {
+			fm.carrier(dst, level);
+		} else {
+			const int32_t constant = level;
+			modulate(dst, [constant]() { return constant; });
+		}
+		
+		symbol_samples -= run;
+		i += run;
+	}
+}
+
+template<typename Level>
+void BitstreamTXProcessor::modulate(const buffer_c8_t& dst, Level level) {
+	switch (modulation) {
+		case Modulation::OOK:
+			am.execute(dst, level);
+			break;
+		
+		case Modulation::FSK:
+			fm.execute(dst, level);
+			break;
+		
+		case Modulation::AFSK:
+			fm.execute(dst, [this, &level]() {
+				return tone.next(level()) * fm_delta;
+			});
+			break;
+	}
+}
+
+// Loads the next symbol, returns false at the end of the sequence
+bool BitstreamTXProcessor::next_symbol() {
+	if (symbol_count && (symbols_sent >= symbol_count)) {
+		txprogress_message.progress = symbols_sent;
+		txprogress_message.done = true;
+		txprogress_message.underruns = underruns;
+		shared_memory.application_queue.push(txprogress_message);
+		configured = false;
+		return false;
+	}
+	
+	if ((symbol_index == symbols_available) && stream) {
+		symbols_available = stream->read(symbols.data(), symbols.size()) * 8;
+		symbol_index = 0;
+	}
+	
+	bool symbol = false;
+	
+	if (symbol_index < symbols_available) {
+		symbol = (symbols[symbol_index >> 3] << (symbol_index & 7)) & 0x80;
+		symbol_index++;
+		symbols_sent++;
+		
+		if (progress_symbols && !(symbols_sent % progress_symbols)) {
+			txprogress_message.progress = symbols_sent;
+			txprogress_message.done = false;
+			txprogress_message.underruns = underruns;
+			shared_memory.application_queue.push(txprogress_message);
+		}
+	} else {
+		// Stream ran dry: idle for one symbol, it isn't counted
+		underruns++;
+	}
+	
+	const int32_t target = levels[symbol];
+	if ((target != level) && shaping_samples) {
+		level_from = level;
+		ramp_phase = 0;
+		ramp_samples = shaping_samples;
+	}
+	level = target;
+	symbol_samples = samples_per_symbol;
+	
+	return true;
+}
+
+void BitstreamTXProcessor::on_message(const Message* const message) {
+	switch(message->id) {
+		case Message::ID::BitstreamTXConfig:
+			bitstream_config(*reinterpret_cast<const BitstreamTXConfigMessage*>(message));
+			break;
+		
+		case Message::ID::ReplayConfig:
+			configured = false;
+			replay_config(*reinterpret_cast<const ReplayConfigMessage*>(message));
+			break;
+		
+		case Message::ID::FIFOData:
+			configured = true;
+			break;
+		
+		default:
+			break;
+	}
+}
+
+void BitstreamTXProcessor::bitstream_config(const BitstreamTXConfigMessage& message) {
+	modulation = message.modulation;
+	samples_per_symbol = std::max<uint32_t>(message.samples_per_symbol, 1);
+	shaping_samples = std::min(message.shaping_samples, samples_per_symbol);
+	ramp_step = shaping_samples ? (ramp_table.size() << 16) / shaping_samples : 0;
+	symbol_count = message.symbol_count;
+	progress_symbols = message.progress_symbols;
+	
+	switch (modulation) {
+		case Modulation::OOK:
+			levels = { 0, 256 };
+			am.configure(200 << 6);		// Carrier offset of 2.28M * 200 / 2^26 ~ 6.8kHz
+			break;
+		
+		case Modulation::FSK: {
+			const int32_t shift = message.deviation_hz * (0xFFFFFFFFULL / baseband_fs);
+			levels = { -shift, shift };
+			break;
+		}
+		
+		case Modulation::AFSK:
+			levels = {
+				static_cast<int32_t>(message.space_hz * (0xFFFFFFFFULL / baseband_fs)),
+				static_cast<int32_t>(message.mark_hz * (0xFFFFFFFFULL / baseband_fs))
+			};
+			fm_delta = message.deviation_hz * (0xFFFFFFULL / baseband_fs);
+			break;
+	}
+	
+	// Start idle, the first active symbol ramps up
+	level = levels[0];
+	ramp_samples = 0;
+	symbol_samples = 0;
+	symbols_sent = 0;
+	symbols_available = 0;
+	symbol_index = 0;
+	underruns = 0;
+	tone.reset();
+	
+	txprogress_message.progress = 0;
+	txprogress_message.done = false;
+}
+
+void BitstreamTXProcessor::replay_config(const ReplayConfigMessage& message) {
+	if( message.config ) {
+		
+		stream = std::make_unique<StreamOutput>(message.config);
+		
+		// Tell application that the buffers and FIFO pointers are ready, prefill
+		shared_memory.application_queue.push(sig_message);
+	} else {
+		stream.reset();
+	}
+}
+
+int main() {
+	EventDispatcher event_dispatcher { std::make_unique<BitstreamTXProcessor>() };
+	event_dispatcher.run();
+	return 0;
+}
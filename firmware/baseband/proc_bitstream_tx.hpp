@@ -0,0 +1,98 @@
+/*
+ * Copyright (C) 2026 agent
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __PROC_BITSTREAM_TX_H__
+#define __PROC_BITSTREAM_TX_H__
+
+#include "baseband_processor.hpp"
+#include "baseband_thread.hpp"
+#include "stream_output.hpp"
+#include "dsp_modulate.hpp"
+
+#include <array>
+#include <memory>
+
+/* Sends packed symbols (MSB first) streamed from the M0. Each symbol is
+ * expanded to a run of samples, with a raised-cosine transition between
+ * levels when shaping is enabled: amplitude for OOK, frequency for FSK and
+ * tone frequency for AFSK. */
+class BitstreamTXProcessor : public BasebandProcessor {
+public:
+	BitstreamTXProcessor();
+
+	void execute(const buffer_c8_t& buffer) override;
+	
+	void on_message(const Message* const message) override;
+
+private:
+	using Modulation = BitstreamTXConfigMessage::Modulation;
+
+	static constexpr size_t baseband_fs = 2280000;
+	static constexpr size_t symbol_block_bytes = 64;
+	static constexpr size_t ramp_table_log2 = 8;
+	
+	BasebandThread baseband_thread { baseband_fs, this, NORMALPRIO + 20, baseband::Direction::Transmit };
+	
+	std::unique_ptr<StreamOutput> stream { };
+	
+	std::array<uint8_t, symbol_block_bytes> symbols { };
+	size_t symbols_available { 0 };
+	size_t symbol_index { 0 };
+	
+	// 0 to 256
+	std::array<uint16_t, 1U << ramp_table_log2> ramp_table { };
+	
+	Modulation modulation { Modulation::OOK };
+	uint32_t samples_per_symbol { 0 };
+	uint32_t shaping_samples { 0 };
+	uint32_t symbol_count { 0 };
+	uint32_t progress_symbols { 0 };
+	uint32_t fm_delta { 0 };
+	std::array<int32_t, 2> levels { };
+	
+	int32_t level { 0 };
+	int32_t level_from { 0 };
+	uint32_t ramp_phase { 0 };
+	uint32_t ramp_step { 0 };
+	uint32_t ramp_samples { 0 };
+	uint32_t symbol_samples { 0 };
+	uint32_t symbols_sent { 0 };
+	uint32_t underruns { 0 };
+	
+	dsp::modulate::AM am { };
+	dsp::modulate::FM fm { };
+	dsp::modulate::Tone tone { };
+	
+	bool configured { false };
+	
+	bool next_symbol();
+	
+	template<typename Level>
+	void modulate(const buffer_c8_t& dst, Level level);
+	
+	void bitstream_config(const BitstreamTXConfigMessage& message);
+	void replay_config(const ReplayConfigMessage& message);
+	
+	TXProgressMessage txprogress_message { };
+	RequestSignalMessage sig_message { RequestSignalMessage::Signal::FillRequest };
+};
+
+#endif/*__PROC_BITSTREAM_TX_H__*/
@@ -43,8 +43,12 @@ void CaptureProcessor::execute(const buffer_c8_t& buffer) {
 	const auto& channel = decimator_out;
 
 	if( stream ) {
-		const size_t bytes_to_write = sizeof(*decimator_out.p) * decimator_out.count;
-		const auto result = stream->write(decimator_out.p, bytes_to_write);
+		if( triggered ) {
+			stream_triggered(channel);
+		} else {
+			const size_t bytes_to_write = sizeof(*decimator_out.p) * decimator_out.count;
+			const auto result = stream->write(decimator_out.p, bytes_to_write);
+		}
 	}
 
 	feed_channel_stats(channel);
@@ -95,8 +99,33 @@ void CaptureProcessor::samplerate_config(const SamplerateConfigMessage& message)
 void CaptureProcessor::capture_config(const CaptureConfigMessage& message) {
 	if( message.config ) {
 		stream = std::make_unique<StreamInput>(message.config);
+		triggered = message.config->trigger.enabled;
+		if( triggered ) {
+			burst_trigger.configure(baseband_fs / decim_0.decimation_factor / decim_1.decimation_factor, message.config->trigger);
+		}
 	} else {
 		stream.reset();
+		triggered = false;
+	}
+}
+
+void CaptureProcessor::stream_triggered(const buffer_c16_t& channel) {
+	const auto was_open = burst_trigger.is_open();
+	burst_trigger.feed(channel);
+
+	if( burst_trigger.is_open() ) {
+		if( !was_open ) {
+			// Start the segment with what led up to the trigger
+			burst_trigger.drain([this](const complex16_t* const p, const size_t count) {
+				stream->write(p, sizeof(*p) * count);
+			});
+		}
+		stream->write(channel.p, sizeof(*channel.p) * channel.count);
+	} else {
+		if( was_open ) {
+			stream->end_segment();
+		}
+		burst_trigger.keep(channel);
 	}
 }
 
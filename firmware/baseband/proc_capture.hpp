@@ -32,6 +32,7 @@
 #include "spectrum_collector.hpp"
 
 #include "stream_input.hpp"
+#include "burst_trigger.hpp"
 
 #include <array>
 #include <memory>
@@ -64,6 +65,8 @@ private:
 	uint32_t channel_filter_stop_f = 0;
 
 	std::unique_ptr<StreamInput> stream { };
+	bool triggered { false };
+	BurstTrigger burst_trigger { };
 
 	SpectrumCollector channel_spectrum { };
 	size_t spectrum_interval_samples = 0;
@@ -71,6 +74,7 @@ private:
 
 	void samplerate_config(const SamplerateConfigMessage& message);
 	void capture_config(const CaptureConfigMessage& message);
+	void stream_triggered(const buffer_c16_t& channel);
 };
 
 #endif/*__PROC_CAPTURE_HPP__*/
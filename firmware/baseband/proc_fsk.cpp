@@ -22,59 +22,52 @@
 
 #include "proc_fsk.hpp"
 #include "portapack_shared_memory.hpp"
-#include "sine_table_int8.hpp"
 #include "event_m4.hpp"
 
 #include <cstdint>
+#include <algorithm>
 
 void FSKProcessor::execute(const buffer_c8_t& buffer) {
-	int8_t re, im;
 	
 	// This is called at 2.28M/2048 = 1113Hz
 	
-	for (size_t i = 0; i < buffer.count; i++) {
-
-		if (configured) {
-			if (sample_count >= samples_per_bit) {
-				if (bit_pos > length) {
-					// End of data
-					cur_bit = 0;
-					txprogress_message.done = true;
-					shared_memory.application_queue.push(txprogress_message);
-					configured = false;
-				} else {
-					cur_bit = (shared_memory.bb_data.data[bit_pos >> 3] << (bit_pos & 7)) & 0x80;
-					bit_pos++;
-					if (progress_count >= progress_notice) {
-						progress_count = 0;
-						txprogress_message.progress++;
-						txprogress_message.done = false;
-						shared_memory.application_queue.push(txprogress_message);
-					} else {
-						progress_count++;
-					}
-				}
-				sample_count = 0;
-			} else {
-				sample_count++;
-			}
+	for (size_t i = 0; i < buffer.count; ) {
+		if (configured && !symbol_samples)
+			next_bit();
+		
+		const size_t run = configured ? std::min<size_t>(symbol_samples, buffer.count - i) : buffer.count - i;
+		const buffer_c8_t dst { &buffer.p[i], run };
 		
-			if (cur_bit)
-				phase += shift_one;
-			else
-				phase += shift_zero;
-			
-			sphase = phase + (64 << 24);
+		if (configured) {
+			fm.carrier(dst, cur_bit ? shift_one : shift_zero);
+			symbol_samples -= run;
+		} else {
+			dsp::modulate::silence(dst);
+		}
+		i += run;
+	}
+}
 
-			re = (sine_table_i8[(sphase & 0xFF000000) >> 24]);
-			im = (sine_table_i8[(phase & 0xFF000000) >> 24]);
+void FSKProcessor::next_bit() {
+	if (bit_pos > length) {
+		// End of data
+		cur_bit = 0;
+		txprogress_message.done = true;
+		shared_memory.application_queue.push(txprogress_message);
+		configured = false;
+	} else {
+		cur_bit = (shared_memory.bb_data.data[bit_pos >> 3] << (bit_pos & 7)) & 0x80;
+		bit_pos++;
+		if (progress_count >= progress_notice) {
+			progress_count = 0;
+			txprogress_message.progress++;
+			txprogress_message.done = false;
+			shared_memory.application_queue.push(txprogress_message);
 		} else {
-			re = 0;
-			im = 0;
+			progress_count++;
 		}
-	
-		buffer.p[i] = {re, im};
 	}
+	symbol_samples = samples_per_bit + 1;
 }
 
 void FSKProcessor::on_message(const Message* const p) {
@@ -89,7 +82,7 @@ void FSKProcessor::on_message(const Message* const p) {
 		
 		progress_notice = message.progress_notice;
 		
-		sample_count = samples_per_bit;
+		symbol_samples = 0;
 		progress_count = 0;
 		bit_pos = 0;
 		cur_bit = 0;
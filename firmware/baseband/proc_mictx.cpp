@@ -22,11 +22,11 @@
 
 #include "proc_mictx.hpp"
 #include "portapack_shared_memory.hpp"
-#include "sine_table_int8.hpp"
 #include "tonesets.hpp"
 #include "event_m4.hpp"
 
 #include <cstdint>
+#include <algorithm>
 
 void MicTXProcessor::execute(const buffer_c8_t& buffer){
 
@@ -35,11 +35,11 @@ void MicTXProcessor::execute(const buffer_c8_t& buffer){
 	if (!configured) return;
 	
 	audio_input.read_audio_buffer(audio_buffer);
-
-	for (size_t i = 0; i < buffer.count; i++) {
-		
-		if (!play_beep) {
-			sample = audio_buffer.p[i >> 6] >> 8;			// 1536000 / 64 = 24000
+	
+	if (!play_beep) {
+		size_t n = 0;
+		fm.execute(buffer, [this, &n]() {
+			sample = audio_buffer.p[n++ >> 6] >> 8;			// 1536000 / 64 = 24000
 			sample *= audio_gain;
 			
 			power_acc += (sample < 0) ? -sample : sample;	// Power average for UI vu-meter
@@ -52,41 +52,39 @@ void MicTXProcessor::execute(const buffer_c8_t& buffer){
 				shared_memory.application_queue.push(level_message);
 				power_acc = 0;
 			}
-		} else {
-			if (beep_timer) {
-				beep_timer--;
+			
+			return tone_gen.process(sample) * fm_delta;
+		});
+	} else {
+		for (size_t i = 0; i < buffer.count; ) {
+			if (!beep_timer)
+				next_beep();
+			
+			const size_t run = configured ? std::min<size_t>(beep_timer, buffer.count - i) : buffer.count - i;
+			const buffer_c8_t dst { &buffer.p[i], run };
+			
+			if (configured) {
+				fm.execute(dst, [this]() {
+					return tone_gen.process(beep_gen.process(0)) * fm_delta;
+				});
+				beep_timer -= run;
 			} else {
-				beep_timer = baseband_fs * 0.05;			// 50ms
-				
-				if (beep_index == BEEP_TONES_NB) {
-					configured = false;
-					shared_memory.application_queue.push(txprogress_message);
-				} else {
-					beep_gen.configure(beep_deltas[beep_index], 1.0);
-					beep_index++;
-				}
+				dsp::modulate::silence(dst);
 			}
-			
-			sample = beep_gen.process(0);
+			i += run;
 		}
-		
-		sample = tone_gen.process(sample);
-		
-		// FM
-		if (configured) {
-			delta = sample * fm_delta;
-			
-			phase += delta;
-			sphase = phase >> 24;
+	}
+}
 
-			re = (sine_table_i8[(sphase + 64) & 255]);
-			im = (sine_table_i8[sphase]);
-		} else {
-			re = 0;
-			im = 0;
-		}
-		
-		buffer.p[i] = { re, im };
+void MicTXProcessor::next_beep() {
+	beep_timer = baseband_fs * 0.05;			// 50ms
+	
+	if (beep_index == BEEP_TONES_NB) {
+		configured = false;
+		shared_memory.application_queue.push(txprogress_message);
+	} else {
+		beep_gen.configure(beep_deltas[beep_index], 1.0);
+		beep_index++;
 	}
 }
 
@@ -27,6 +27,7 @@
 #include "baseband_thread.hpp"
 #include "audio_input.hpp"
 #include "tone_gen.hpp"
+#include "dsp_modulate.hpp"
 
 class MicTXProcessor : public BasebandProcessor {
 public:
@@ -56,11 +57,12 @@ private:
 	uint32_t power_acc_count { 0 };
 	bool play_beep { false };
 	uint32_t fm_delta { 0 };
-	uint32_t phase { 0 }, sphase { 0 };
-	int32_t sample { 0 }, delta { };
+	int32_t sample { 0 };
 	uint32_t beep_index { }, beep_timer { };
 	
-	int8_t re { 0 }, im { 0 };
+	dsp::modulate::FM fm { };
+	
+	void next_beep();
 	
 	AudioLevelReportMessage level_message { };
 	TXProgressMessage txprogress_message { };
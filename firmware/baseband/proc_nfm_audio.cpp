@@ -46,7 +46,6 @@ void NarrowbandFMAudio::execute(const buffer_c8_t& buffer) {
 	if (!pitch_rssi_enabled) {
 		// Normal mode, output demodulated audio
 		auto audio = demod.execute(channel_out, audio_buffer);
-		audio_output.write(audio);
 		
 		if (ctcss_detect_enabled) {
 			/* 24kHz int16_t[16]
@@ -54,38 +53,13 @@ void NarrowbandFMAudio::execute(const buffer_c8_t& buffer) {
 			 * -> 12kHz int16_t[8] */
 			auto audio_ctcss = ctcss_filter.execute(audio, work_audio_buffer);
 			
-			// s16 to f32 for hpf
-			std::array<float, 8> audio_f;
-			for (size_t i = 0; i < audio_ctcss.count; i++) {
-				audio_f[i] = audio_ctcss.p[i] * ki;
-			}
-			
-			hpf.execute_in_place(buffer_f32_t {
-				audio_f.data(),
-				audio_ctcss.count,
-				audio_ctcss.sampling_rate
-				});
-			
-			// Zero-crossing detection
-			for (size_t c = 0; c < audio_ctcss.count; c++) {
-				cur_sample = audio_f[c];
-				if (cur_sample * prev_sample < 0.0) {
-					z_acc += z_timer;
-					z_timer = 0;
-					z_count++;
-				} else
-					z_timer++;
-				prev_sample = cur_sample;
-			}
-			
-			if (z_count >= 30) {
-				ctcss_message.enabled = true;
-				ctcss_message.value = (100 * 12000 / 2 * z_count) / z_acc;
-				shared_memory.application_queue.push(ctcss_message);
-				z_count = 0;
-				z_acc = 0;
-			}
+			coded_squelch.feed(audio_ctcss, [](const CodedSquelchMessage& message) {
+				shared_memory.application_queue.push(message);
+			});
+			audio_output.set_tone_gate(coded_squelch.gate_open());
 		}
+
+		audio_output.write(audio);
 	} else {
 		// Direction-finding mode; output tone with pitch related to RSSI
 		for (size_t c = 0; c < 16; c++) {
@@ -95,15 +69,14 @@ void NarrowbandFMAudio::execute(const buffer_c8_t& buffer) {
 		
 		audio_output.write(tone_buffer);
 
-		if (z_count >= 30) 
+		if (rssi_report_count >= 30) 
 		{
-			ctcss_message.enabled = false;
-			ctcss_message.value =  rssi_value;
-			shared_memory.application_queue.push(ctcss_message);
-			z_count = 0;
+			rssi_message.value =  rssi_value;
+			shared_memory.application_queue.push(rssi_message);
+			rssi_report_count = 0;
 				
 		}
-		z_count++;
+		rssi_report_count++;
 
 		
 		
@@ -130,6 +103,10 @@ void NarrowbandFMAudio::on_message(const Message* const message) {
 	case Message::ID::CaptureConfig:
 		capture_config(*reinterpret_cast<const CaptureConfigMessage*>(message));
 		break;
+
+	case Message::ID::AudioProcessingConfig:
+		audio_processing_config(*reinterpret_cast<const AudioProcessingConfigMessage*>(message));
+		break;
 	
 	case Message::ID::PitchRSSIConfigure:
 		pitch_rssi_config(*reinterpret_cast<const PitchRSSIConfigureMessage*>(message));
@@ -161,8 +138,8 @@ void NarrowbandFMAudio::configure(const NBFMConfigureMessage& message) {
 	channel_spectrum.set_decimation_factor(std::floor(channel_filter_output_fs / (channel_filter_pass_f + channel_filter_stop_f)));
 	audio_output.configure(message.audio_hpf_config, message.audio_deemph_config, (float)message.squelch_level / 100.0);
 	
-	hpf.configure(audio_24k_hpf_30hz_config);
 	ctcss_filter.configure(taps_64_lp_025_025.taps);
+	coded_squelch.configure(demod_input_fs / 2, message.tone_squelch);
 
 	configured = true;
 }
@@ -181,6 +158,10 @@ void NarrowbandFMAudio::capture_config(const CaptureConfigMessage& message) {
 	}
 }
 
+void NarrowbandFMAudio::audio_processing_config(const AudioProcessingConfigMessage& message) {
+	audio_output.set_processing(message.agc, message.noise_blanker);
+}
+
 int main() {
 	EventDispatcher event_dispatcher { std::make_unique<NarrowbandFMAudio>() };
 	event_dispatcher.run();
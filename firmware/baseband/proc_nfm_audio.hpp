@@ -29,10 +29,10 @@
 
 #include "dsp_decimate.hpp"
 #include "dsp_demodulate.hpp"
-#include "dsp_iir.hpp"
 
 #include "audio_output.hpp"
 #include "spectrum_collector.hpp"
+#include "coded_squelch.hpp"
 
 #include <cstdint>
 
@@ -76,9 +76,9 @@ private:
 	uint32_t channel_filter_pass_f = 0;
 	uint32_t channel_filter_stop_f = 0;
 	
-	// For CTCSS decoding
+	// For CTCSS/DCS decoding
 	dsp::decimate::FIR64AndDecimateBy2Real ctcss_filter { };
-	IIRBiquadFilter hpf { };
+	CodedSquelch coded_squelch { };
 
 	dsp::demodulate::FM demod { };
 
@@ -90,20 +90,18 @@ private:
 	uint32_t tone_delta { 0 };
 	uint32_t rssi_value { 0 };
 	bool pitch_rssi_enabled { false };
+	uint32_t rssi_report_count { 0 };
 	
-	float cur_sample { }, prev_sample { };
-	uint32_t z_acc { 0}, z_timer { 0 }, z_count { 0 };
 	bool ctcss_detect_enabled { true };
-	static constexpr float k = 32768.0f;
-	static constexpr float ki = 1.0f / k;
 
 	bool configured { false };
 	void pitch_rssi_config(const PitchRSSIConfigureMessage& message);
 	void configure(const NBFMConfigureMessage& message);
 	void capture_config(const CaptureConfigMessage& message);
+	void audio_processing_config(const AudioProcessingConfigMessage& message);
 	
 	//RequestSignalMessage sig_message { RequestSignalMessage::Signal::Squelched };
-	CodedSquelchMessage ctcss_message {false, 0 };
+	CodedSquelchMessage rssi_message { CodedSquelchMessage::Type::RSSI, 0 };
 };
 
 #endif/*__PROC_NFM_AUDIO_H__*/
@@ -26,244 +26,249 @@
 
 #include "event_m4.hpp"
 
+#include "utility.hpp"
+
+#include <algorithm>
+
+// Enhanced ShockBurst CRCs cover the address, packet control field and payload
+static constexpr CRCTable<16> crc16_nrf { 0x1021 };
+static constexpr CRCTable<8> crc8_nrf { 0x07 };
+
 void NRFRxProcessor::execute(const buffer_c8_t& buffer) {
 	if (!configured) return;
 	
-	// FM demodulation
-
 	const auto decim_0_out = decim_0.execute(buffer, dst_buffer);
 	feed_channel_stats(decim_0_out);
-	
-	auto audio_oversampled = demod.execute(decim_0_out, work_audio_buffer);
-	// Audio signal processing
-	for (size_t c = 0; c < audio_oversampled.count; c++) {
-		int result;
-                int g_srate = 4; //4 for 250KPS
-		//int g_srate = 1; //1 for 1MPS, not working yet
-		int32_t current_sample = audio_oversampled.p[c]; //if I directly use this, some results can pass crc but not correct.
-                rb_head++;
-	        rb_head=(rb_head)%RB_SIZE;
 
-                rb_buf[rb_head] = current_sample;
-
-		skipSamples = skipSamples - 1;
-
-
-		if (skipSamples<1)
-		{
-				
-
-			int32_t threshold_tmp=0;
-			for (int c=0;c<8*g_srate;c++)
-			{
-				threshold_tmp = threshold_tmp + (int32_t)rb_buf[(rb_head+c)%RB_SIZE];
-			}
+	for(size_t n=0; n<buffer.count; n++) {
+		/* Differential detector, Im(conj(x[n-lag]) * x[n]) once the channel
+		 * is brought down from +fs/4. That adds a quarter turn per sample of
+		 * lag: three turn Im() into Re(), two into -Im(). */
+		const auto delayed = delay_line[(delay_head - lag) & (lag_max - 1)];
+		const auto sample = buffer.p[n];
+		delay_line[delay_head] = sample;
+		delay_head = (delay_head + 1) & (lag_max - 1);
+
+		const int32_t discriminator = (lag == 3)
+			? (delayed.real() * sample.real() + delayed.imag() * sample.imag())
+			: (delayed.imag() * sample.real() - delayed.real() * sample.imag());
+
+		// Integrate and dump over a symbol
+		history[history_head] = discriminator;
+		symbol_sum += discriminator - history[(history_head - integration_length) & history_mask];
+		history_head = (history_head + 1) & history_mask;
+
+		/* Peak and trough of the symbol values decay towards each other, the
+		 * slicing level between them follows the carrier offset. A mean would
+		 * be pulled off-centre by unbalanced addresses such as 0xE7E7E7. */
+		if( symbol_sum > envelope_high ) {
+			envelope_high = symbol_sum;
+		} else {
+			envelope_high -= (envelope_high - envelope_low) >> envelope_shift;
+		}
+		if( symbol_sum < envelope_low ) {
+			envelope_low = symbol_sum;
+		} else {
+			envelope_low += (envelope_high - envelope_low) >> envelope_shift;
+		}
 
-			g_threshold = (int32_t)threshold_tmp/(8*g_srate);
-	
-			int transitions=0;
-			if (rb_buf[(rb_head + 9*g_srate)%RB_SIZE] > g_threshold)
-			{
-				for (int c=0;c<8;c++)
-				{
-					if (rb_buf[(rb_head + c*g_srate)%RB_SIZE] > rb_buf[(rb_head + (c+1)*g_srate)%RB_SIZE])
-						transitions = transitions + 1;
-				}
+		if( capturing ) {
+			if( phase == capture_phase ) {
+				on_capture_bit(symbol_sum > capture_threshold);
 			}
-			else
-			{
-				for (int c=0;c<8;c++)
-				{
-					if (rb_buf[(rb_head + c*g_srate)%RB_SIZE] < rb_buf[(rb_head + (c+1)*g_srate)%RB_SIZE])
-						transitions = transitions + 1;
+		} else {
+			auto& shift = sync_shift[phase];
+			shift = (shift << 1) | (symbol_sum * 2 > envelope_high + envelope_low);
+
+			if( sync_wait ) {
+				/* The first phase to match is often at the early edge of the
+				 * eye. Once every phase has had its turn, pick the best one. */
+				if( --sync_wait == 0 ) {
+					start_capture(sync_address);
 				}
-			}
-			
-			bool packet_detected=false;
-			//if ( transitions==4 && abs(g_threshold)<15500)
-			if ( transitions==4 && abs(g_threshold)<15500)
-			{
-				int packet_length = 0;
-				uint8_t tmp_buf[10];
-				uint8_t packet_data[500];
-				uint8_t packet_packed[50];
-				uint16_t pcf;
-				uint32_t packet_crc;
-				uint32_t calced_crc;
-				uint64_t packet_addr_l;
-
-				/* extract address */
-				packet_addr_l=0;
-
-				for (int t=0;t<5;t++)
-				{
-					bool current_bit;
-					uint8_t byte=0;
-					for (int c=0;c<8;c++) 
-					{
-						if (rb_buf[(rb_head+(1*8+t*8+c)*g_srate)%RB_SIZE] > g_threshold)
-							current_bit = true;
-						else
-							current_bit = false;
-						byte |= current_bit << (7-c);
+			} else {
+				for(size_t a=0; a<address_count; a++) {
+					if( ((shift ^ sync_patterns[a]) & sync_masks[a]) == 0 ) {
+						sync_address = a;
+						sync_wait = samples_per_symbol - 1;
+						break;
 					}
-					tmp_buf[t]=byte;
 				}
+			}
+		}
 
-				for (int t=0;t<5;t++) packet_addr_l|=((uint64_t)tmp_buf[t])<<(4-t)*8;
-
-				//channel_number = 26;
-
-				
-				/* extract pcf */
-				for (int t=0;t<2;t++)
-				{
-					bool current_bit;
-					uint8_t byte=0;
-					for (int c=0;c<8;c++) 
-					{
-						if (rb_buf[(rb_head+(6*8+t*8+c)*g_srate)%RB_SIZE] > g_threshold)
-							current_bit = true;
-						else
-							current_bit = false;
-						byte |= current_bit << (7-c);
-					}
-					tmp_buf[t]=byte;
-				}
+		if( ++phase == samples_per_symbol ) {
+			phase = 0;
+		}
+	}
 
-				pcf = tmp_buf[0]<<8 | tmp_buf[1];
-				pcf >>=7;
-
-				/* extract packet length, avoid excessive length packets */
-				if(packet_length == 0)
-					packet_length=(int)pcf>>3;
-				if (packet_length>32) 
-					packet_detected = false;
-
-				/* extract data */
-				for (int t=0;t<packet_length;t++)
-				{
-					bool current_bit;
-					uint8_t byte=0;
-					for (int c=0;c<8;c++) 
-					{
-						if (rb_buf[(rb_head+(6*8+9+t*8+c)*g_srate)%RB_SIZE] > g_threshold)
-							current_bit = true;
-						else
-							current_bit = false;
-						byte |= current_bit << (7-c);
-					}
-					packet_data[t]=byte;
-				}
+	stats_samples += buffer.count;
+	if( stats_samples >= baseband_fs ) {
+		const NRFRxStatisticsMessage message { static_cast<nrf24::DataRate>(rate_index), stats };
+		shared_memory.application_queue.push(message);
+		stats = { };
+		stats_samples = 0;
+	}
 
-				/* Prepare packed bit stream for CRC calculation */
-				uint64_t packet_header=packet_addr_l;
-				packet_header<<=9;
-				packet_header|=pcf;
-				for (int c=0;c<7;c++){
-					packet_packed[c]=(packet_header>>((6-c)*8))&0xFF;
-				}
+	if( auto_rate ) {
+		dwell_samples += buffer.count;
+		if( !capturing && (dwell_samples >= dwell_limit) ) {
+			set_rate((rate_index + 1) % nrf24::data_rate_count);
+		}
+	}
+}
 
-				for (int c=0;c<packet_length;c++){
-					packet_packed[c+7]=packet_data[c];
-				}
+void NRFRxProcessor::start_capture(const size_t address_index) {
+	const auto& address = addresses[address_index];
+	const auto known_bits = sync_patterns[address_index];
+	const size_t known_count = address.width * 8 + 8;
+
+	// The sampling phase whose last symbol ended offset samples ago
+	size_t best_offset = 0;
+	auto best_eye = sync_eye(known_bits, known_count, 0);
+	for(size_t offset=1; offset<samples_per_symbol; offset++) {
+		const auto eye = sync_eye(known_bits, known_count, offset);
+		if( eye.opening > best_eye.opening ) {
+			best_offset = offset;
+			best_eye = eye;
+		}
+	}
 
-				/* calculate packet crc */
-				const uint8_t* data = packet_packed; 
-				size_t data_len =  7+packet_length;
-				bool bit;
-				uint8_t cc;
-				uint_fast16_t crc=0x3C18;
-				while (data_len--) {
-				cc = *data++;
-				for (uint8_t i = 0x80; i > 0; i >>= 1) 
-				{
-					bit = crc & 0x8000;
-					if (cc & i) 
-					{
-						bit = !bit;
-					}
-					crc <<= 1;
-					if (bit) 
-					{
-						crc ^= 0x1021;
-					}
-				}
-					crc &= 0xffff;
-				}
-				calced_crc = (uint16_t)(crc & 0xffff);
-
-				/* extract crc */
-				for (int t=0;t<2;t++)
-				{
-					bool current_bit;
-					uint8_t byte=0;
-					for (int c=0;c<8;c++) 
-					{
-						if (rb_buf[(rb_head+((6+packet_length)*8+9+t*8+c)*g_srate)%RB_SIZE] > g_threshold)
-							current_bit = true;
-						else
-							current_bit = false;
-						byte |= current_bit << (7-c);
-					}
-					tmp_buf[t]=byte;
-				}
-				packet_crc = tmp_buf[0]<<8 | tmp_buf[1];
-
-				/* NRF24L01+ packet found, dump information */
-				//if (packet_addr_l==0xE7E7E7E7)
-				if (packet_crc==calced_crc)
-				{
-					data_message.is_data = false;
-					data_message.value = 'A';
-					shared_memory.application_queue.push(data_message);
-
-					data_message.is_data = true;
-					data_message.value = packet_addr_l;
-					shared_memory.application_queue.push(data_message);
-
-					for (int c=0;c<7;c++)
-					{
-						data_message.is_data = true;
-						data_message.value = packet_addr_l >> 8;
-						shared_memory.application_queue.push(data_message);
-					}
-					/*data_message.is_data = true;
-					data_message.value = packet_addr_l;
-					shared_memory.application_queue.push(data_message);
-
-					data_message.is_data = true;
-					data_message.value = packet_addr_l >> 8;
-					shared_memory.application_queue.push(data_message);*/
-
-					data_message.is_data = false;
-					data_message.value = 'B';
-					shared_memory.application_queue.push(data_message);
-
-					for (int c=0;c<packet_length;c++)
-					{
-						data_message.is_data = true;
-						data_message.value = packet_data[c];
-						shared_memory.application_queue.push(data_message);
-					}
+	capturing = true;
+	capture_phase = (phase + samples_per_symbol - best_offset) % samples_per_symbol;
+	capture_address = address_index;
+	capture_threshold = best_eye.threshold;
+	capture_bits = 0;
+	capture_bits_needed = 0;
 
-					data_message.is_data = false;
-					data_message.value = 'C';
-					shared_memory.application_queue.push(data_message);
+	frame.fill(0);
+	for(size_t i=0; i<address.width; i++) {
+		frame[i] = address.value >> ((address.width - 1 - i) * 8);
+	}
 
+	stats[rate_index].syncs++;
+}
 
-					packet_detected = true;
-				}
-				else
-					packet_detected = false;
-			}
+void NRFRxProcessor::on_capture_bit(const bool bit) {
+	const size_t position = addresses[capture_address].width * 8 + capture_bits;
+	if( bit ) {
+		frame[position >> 3] |= 0x80 >> (position & 7);
+	}
+	capture_bits++;
+
+	if( capture_bits == pcf_bits ) {
+		const size_t length = frame_bits(position + 1 - pcf_bits, 6);
+		if( length > nrf24::payload_max ) {
+			capturing = false;
+			sync_shift.fill(0);
+			stats[rate_index].crc_errors++;
+			return;
+		}
+		capture_bits_needed = pcf_bits + length * 8 + ((crc_width == 1) ? 8 : 16);
+	} else if( capture_bits == capture_bits_needed ) {
+		finish_capture();
+	}
+}
+
+void NRFRxProcessor::finish_capture() {
+	capturing = false;
+	sync_shift.fill(0);
 
-			if (packet_detected) 
-			{
-				skipSamples=20;
+	const auto& address = addresses[capture_address];
+	const size_t pcf_start = address.width * 8;
+	const size_t length = frame_bits(pcf_start, 6);
+	const size_t message_bits = pcf_start + pcf_bits + length * 8;
+
+	uint8_t crc_bytes = 0;
+	if( (crc_width != 1) && crc_valid(crc16_nrf, 0xffff, message_bits) ) {
+		crc_bytes = 2;
+	} else if( (crc_width != 2) && crc_valid(crc8_nrf, 0xff, message_bits) ) {
+		crc_bytes = 1;
+	}
+
+	if( crc_bytes == 0 ) {
+		stats[rate_index].crc_errors++;
+		return;
+	}
+	stats[rate_index].packets++;
+
+	nrf24::Packet packet {
+		static_cast<nrf24::DataRate>(rate_index),
+		address,
+		static_cast<uint8_t>(frame_bits(pcf_start + 6, 2)),
+		frame_bits(pcf_start + 8, 1) != 0,
+		crc_bytes,
+		static_cast<uint8_t>(length),
+		{ }
+	};
+	for(size_t i=0; i<length; i++) {
+		packet.payload[i] = frame_bits(pcf_start + pcf_bits + i * 8, 8);
+	}
+
+	const NRFPacketMessage message { packet };
+	shared_memory.application_queue.push(message);
+
+	if( auto_rate ) {
+		dwell_samples = 0;
+		dwell_limit = hold_dwell_samples;
+	}
+}
+
+/* Mean one and zero symbol values over the preamble and address just
+ * matched, at one sampling phase. Halfway between them is the slicing level
+ * for the rest of the packet. */
+NRFRxProcessor::SyncEye NRFRxProcessor::sync_eye(const uint64_t known_bits, const size_t known_count, const size_t offset) const {
+	const size_t symbols = std::min((history_size - offset) / samples_per_symbol, known_count);
+
+	int32_t sum_one = 0;
+	int32_t sum_zero = 0;
+	int32_t ones = 0;
+	int32_t zeros = 0;
+
+	size_t index = (history_head - offset) & history_mask;
+	for(size_t s=0; s<symbols; s++) {
+		int32_t symbol = 0;
+		for(size_t k=0; k<samples_per_symbol; k++) {
+			index = (index - 1) & history_mask;
+			if( k < integration_length ) {
+				symbol += history[index];
 			}
 		}
+		if( (known_bits >> s) & 1 ) {
+			sum_one += symbol;
+			ones++;
+		} else {
+			sum_zero += symbol;
+			zeros++;
+		}
+	}
+
+	if( ones && zeros ) {
+		const int32_t mean_one = sum_one / ones;
+		const int32_t mean_zero = sum_zero / zeros;
+		return { mean_one - mean_zero, (mean_one + mean_zero) / 2 };
+	} else {
+		return { 0, (envelope_high + envelope_low) / 2 };
+	}
+}
+
+uint32_t NRFRxProcessor::frame_bits(const size_t start_bit, const size_t length) const {
+	uint32_t value = 0;
+	for(size_t i=start_bit; i<(start_bit + length); i++) {
+		value = (value << 1) | ((frame[i >> 3] >> (~i & 7)) & 1);
+	}
+	return value;
+}
+
+/* The packet control field is 9 bits, so the CRC'd message ends one bit past
+ * a byte boundary: whole bytes go through the table, the rest bit by bit. */
+template<size_t Width>
+bool NRFRxProcessor::crc_valid(const CRCTable<Width>& table, const uint32_t initial_remainder, const size_t message_bits) const {
+	auto remainder = table.checksum(frame.data(), message_bits / 8, initial_remainder);
+	for(size_t i=(message_bits & ~7U); i<message_bits; i++) {
+		remainder = table.process_bit(remainder, frame_bits(i, 1));
 	}
+	return remainder == frame_bits(message_bits, Width);
 }
 
 void NRFRxProcessor::on_message(const Message* const message) {
@@ -271,14 +276,58 @@ void NRFRxProcessor::on_message(const Message* const message) {
 		configure(*reinterpret_cast<const NRFRxConfigureMessage*>(message));
 }
 
-void NRFRxProcessor::configure(const NRFRxConfigureMessage& message) {	
+void NRFRxProcessor::configure(const NRFRxConfigureMessage& message) {
 	decim_0.configure(taps_200k_wfm_decim_0.taps, 33554432);
-	decim_1.configure(taps_200k_wfm_decim_1.taps, 131072);
-	demod.configure(audio_fs, 5000);
+
+	auto_rate = (message.data_rate == nrf24::DataRate::Auto);
+	crc_width = message.crc_width;
+
+	/* Correlate on preamble and address together. The preamble alternates,
+	 * starting with the inverse of the first address bit. */
+	address_count = std::min(message.address_count, nrf24::addresses_max);
+	for(size_t a=0; a<address_count; a++) {
+		auto address = message.addresses[a];
+		address.width = std::max<uint32_t>(3, std::min<uint32_t>(5, address.width));
+
+		const size_t bits = address.width * 8;
+		address.value &= (1ULL << bits) - 1;
+		const uint64_t preamble = ((address.value >> (bits - 1)) & 1) ? 0xAA : 0x55;
+
+		addresses[a] = address;
+		sync_patterns[a] = (preamble << bits) | address.value;
+		sync_masks[a] = (1ULL << (bits + 8)) - 1;
+	}
+
+	set_rate(auto_rate ? 0 : toUType(message.data_rate));
+	stats = { };
+	stats_samples = 0;
 
 	configured = true;
 }
 
+void NRFRxProcessor::set_rate(const size_t new_rate_index) {
+	rate_index = new_rate_index;
+	samples_per_symbol = samples_per_symbol_by_rate[rate_index];
+	lag = lag_by_rate[rate_index];
+	// Products wholly inside the symbol
+	integration_length = samples_per_symbol - lag + 1;
+	envelope_shift = envelope_shift_by_rate[rate_index];
+
+	delay_line.fill({ });
+
+	history.fill(0);
+	symbol_sum = 0;
+	envelope_high = 0;
+	envelope_low = 0;
+	sync_shift.fill(0);
+	sync_wait = 0;
+	phase = 0;
+	capturing = false;
+
+	dwell_samples = 0;
+	dwell_limit = scan_dwell_samples;
+}
+
 int main() {
 	EventDispatcher event_dispatcher { std::make_unique<NRFRxProcessor>() };
 	event_dispatcher.run();
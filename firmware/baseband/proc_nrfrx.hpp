@@ -29,13 +29,14 @@
 #include "rssi_thread.hpp"
 
 #include "dsp_decimate.hpp"
-#include "dsp_demodulate.hpp"
 
-#include "audio_output.hpp"
-
-#include "fifo.hpp"
+#include "crc.hpp"
 #include "message.hpp"
 
+#include <cstdint>
+#include <cstddef>
+#include <array>
+
 class NRFRxProcessor : public BasebandProcessor {
 public:
 	void execute(const buffer_c8_t& buffer) override;
@@ -43,54 +44,107 @@ public:
 	void on_message(const Message* const message) override;
 	
 private:
+	/* The receiver is tuned fs/4 below the channel, so 2Mbps GFSK fits
+	 * without decimation and gets 2 samples per symbol. */
 	static constexpr size_t baseband_fs = 4000000;
-	static constexpr size_t audio_fs = baseband_fs / 8 / 8 / 2;
-	
+
+	static constexpr std::array<size_t, nrf24::data_rate_count> samples_per_symbol_by_rate { { 16, 4, 2 } };
+	static constexpr size_t samples_per_symbol_max = 16;
+
+	/* Differential detection lag, about a radian of phase change at the
+	 * nominal deviation (160kHz at 250k and 1Mbps, 320kHz at 2Mbps) without
+	 * wrapping on a carrier offset. Longer lags average less noise. Only 2
+	 * and 3 are handled by the detector. */
+	static constexpr std::array<size_t, nrf24::data_rate_count> lag_by_rate { { 3, 3, 2 } };
+	static constexpr size_t lag_max = 4;
+
+	// Slicing envelope decays with a time constant of about 16 symbols
+	static constexpr std::array<size_t, nrf24::data_rate_count> envelope_shift_by_rate { { 8, 6, 5 } };
+
+	// Discriminator history, a power of two holding 16 symbols at 250kbps
+	static constexpr size_t history_size = 256;
+	static constexpr size_t history_mask = history_size - 1;
+
+	// Auto rate: time spent on a rate without packets, and kept after one
+	static constexpr size_t scan_dwell_samples = baseband_fs / 20;
+	static constexpr size_t hold_dwell_samples = baseband_fs;
+
+	static constexpr size_t pcf_bits = 9;
+	static constexpr size_t frame_bytes_max = 5 + (pcf_bits + nrf24::payload_max * 8 + 16 + 7) / 8;
+
 	BasebandThread baseband_thread { baseband_fs, this, NORMALPRIO + 20, baseband::Direction::Receive };
 	RSSIThread rssi_thread { NORMALPRIO + 10 };
 	
+	// Only feeds the channel statistics, the decoder works on the raw samples
 	std::array<complex16_t, 512> dst { };
 	const buffer_c16_t dst_buffer {
 		dst.data(),
 		dst.size()
 	};
 
-        std::array<complex16_t, 512> spectrum { };
-	const buffer_c16_t spectrum_buffer {
-		spectrum.data(),
-		spectrum.size()
-	};
+	dsp::decimate::FIRC8xR16x24FS4Decim4 decim_0 { };
 
-	const buffer_s16_t work_audio_buffer {
-		(int16_t*)dst.data(),
-		sizeof(dst) / sizeof(int16_t)
-	};
+	bool configured { false };
+	bool auto_rate { false };
+	size_t rate_index { 0 };
+	size_t samples_per_symbol { samples_per_symbol_by_rate[0] };
+	size_t lag { lag_by_rate[0] };
+	size_t integration_length { 1 };
+	size_t envelope_shift { envelope_shift_by_rate[0] };
+	uint32_t crc_width { 0 };
 
+	size_t address_count { 0 };
+	std::array<nrf24::Address, nrf24::addresses_max> addresses { };
+	std::array<uint64_t, nrf24::addresses_max> sync_patterns { };
+	std::array<uint64_t, nrf24::addresses_max> sync_masks { };
 
-	// Array size ok down to 375 bauds (24000 / 375)
-	std::array<int32_t, 64> delay_line { 0 };
-	std::array<int16_t, 1000> rb_buf { 0 };
+	std::array<complex8_t, lag_max> delay_line { };
+	size_t delay_head { 0 };
 
-	/*dsp::decimate::FIRC8xR16x24FS4Decim8 decim_0 { };
-	dsp::decimate::FIRC16xR16x32Decim8 decim_1 { };
-	dsp::decimate::FIRAndDecimateComplex channel_filter { };*/
-	dsp::decimate::FIRC8xR16x24FS4Decim4 decim_0 { };
-	dsp::decimate::FIRC16xR16x16Decim2 decim_1 { };
-	
-	dsp::demodulate::FM demod { };
-	int rb_head {-1};
-	int32_t g_threshold {0};  
-	//uint8_t g_srate {8}; 
-	uint8_t channel_number {38};
-	int skipSamples {1000};
-	int RB_SIZE {1000};
+	std::array<int32_t, history_size> history { };
+	size_t history_head { 0 };
+	int32_t symbol_sum { 0 };
+	int32_t envelope_high { 0 };
+	int32_t envelope_low { 0 };
 
-	bool configured { false };
+	// One shift-register correlator per sampling phase within a symbol
+	std::array<uint64_t, samples_per_symbol_max> sync_shift { };
+	size_t phase { 0 };
+	size_t sync_address { 0 };
+	size_t sync_wait { 0 };		// Samples until every phase has seen sync_address
+
+	bool capturing { false };
+	size_t capture_phase { 0 };
+	size_t capture_address { 0 };
+	int32_t capture_threshold { 0 };
+	size_t capture_bits { 0 };
+	size_t capture_bits_needed { 0 };
+	std::array<uint8_t, frame_bytes_max> frame { };
+
+	size_t dwell_samples { 0 };
+	size_t dwell_limit { scan_dwell_samples };
+
+	size_t stats_samples { 0 };
+	std::array<nrf24::RateStats, nrf24::data_rate_count> stats { };
 
-	
 	void configure(const NRFRxConfigureMessage& message);
-	
-	AFSKDataMessage data_message { false, 0 };
+	void set_rate(const size_t new_rate_index);
+
+	void start_capture(const size_t address_index);
+	void on_capture_bit(const bool bit);
+	void finish_capture();
+
+	struct SyncEye {
+		int32_t opening;
+		int32_t threshold;
+	};
+
+	SyncEye sync_eye(const uint64_t known_bits, const size_t known_count, const size_t offset) const;
+
+	uint32_t frame_bits(const size_t start_bit, const size_t length) const;
+
+	template<size_t Width>
+	bool crc_valid(const CRCTable<Width>& table, const uint32_t initial_remainder, const size_t message_bits) const;
 };
 
 #endif/*__PROC_NRFRX_H__*/
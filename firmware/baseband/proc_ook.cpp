@@ -22,77 +22,64 @@
 
 #include "proc_ook.hpp"
 #include "portapack_shared_memory.hpp"
-#include "sine_table_int8.hpp"
 #include "event_m4.hpp"
 
 #include <cstdint>
+#include <algorithm>
 
 void OOKProcessor::execute(const buffer_c8_t& buffer) {
-	int8_t re, im;
 	
 	// This is called at 2.28M/2048 = 1113Hz
 	
 	if (!configured) return;
 	
-	for (size_t i = 0; i < buffer.count; i++) {
+	for (size_t i = 0; i < buffer.count; ) {
+		if (configured && !symbol_samples)
+			next_symbol();
 		
-		// Synthesis at 2.28M/10 = 228kHz
-		if (!s) {
-			s = 10 - 1;
-			if (sample_count >= samples_per_bit) {
-				if (configured) {
-					if (bit_pos >= length) {
-						// End of data
-						if (pause_counter == 0) {
-							pause_counter = pause;
-							cur_bit = 0;
-						} else if (pause_counter == 1) {
-							if (repeat_counter < repeat) {
-								// Repeat
-								bit_pos = 0;
-								cur_bit = shared_memory.bb_data.data[0] & 0x80;
-								txprogress_message.progress = repeat_counter + 1;
-								txprogress_message.done = false;
-								shared_memory.application_queue.push(txprogress_message);
-								repeat_counter++;
-							} else {
-								// Stop
-								cur_bit = 0;
-								txprogress_message.done = true;
-								shared_memory.application_queue.push(txprogress_message);
-								configured = false;
-							}
-							pause_counter = 0;
-						} else {
-							pause_counter--;
-						}
-					} else {
-						cur_bit = (shared_memory.bb_data.data[bit_pos >> 3] << (bit_pos & 7)) & 0x80;
-						bit_pos++;
-					}
-				}
-				
-				sample_count = 0;
-			} else {
-				sample_count++;
-			}
-		} else {
-			s--;
-		}
+		const size_t run = configured ? std::min<size_t>(symbol_samples, buffer.count - i) : buffer.count - i;
+		const buffer_c8_t dst { &buffer.p[i], run };
 		
-		if (cur_bit) {
-			phase = (phase + 200);			// What ?
-			sphase = phase + (64 << 18);
+		ook.execute(dst, configured && cur_bit);
+		if (configured)
+			symbol_samples -= run;
+		i += run;
+	}
+}
 
-			re = (sine_table_i8[(sphase & 0x03FC0000) >> 18]);
-			im = (sine_table_i8[(phase & 0x03FC0000) >> 18]);
+void OOKProcessor::next_symbol() {
+	if (bit_pos >= length) {
+		// End of data
+		if (pause_counter == 0) {
+			pause_counter = pause;
+			cur_bit = 0;
+		} else if (pause_counter == 1) {
+			if (repeat_counter < repeat) {
+				// Repeat
+				bit_pos = 0;
+				cur_bit = shared_memory.bb_data.data[0] & 0x80;
+				txprogress_message.progress = repeat_counter + 1;
+				txprogress_message.done = false;
+				shared_memory.application_queue.push(txprogress_message);
+				repeat_counter++;
+			} else {
+				// Stop
+				cur_bit = 0;
+				txprogress_message.done = true;
+				shared_memory.application_queue.push(txprogress_message);
+				configured = false;
+			}
+			pause_counter = 0;
 		} else {
-			re = 0;
-			im = 0;
+			pause_counter--;
 		}
-	
-		buffer.p[i] = {re, im};
+	} else {
+		cur_bit = (shared_memory.bb_data.data[bit_pos >> 3] << (bit_pos & 7)) & 0x80;
+		bit_pos++;
 	}
+	
+	// Symbols are timed in steps of 10 samples (228kHz)
+	symbol_samples = (samples_per_bit + 1) * 10;
 }
 
 void OOKProcessor::on_message(const Message* const p) {
@@ -105,13 +92,13 @@ void OOKProcessor::on_message(const Message* const p) {
 		pause = message.pause_symbols + 1;
 	
 		pause_counter = 0;
-		s = 0;
-		sample_count = samples_per_bit;
+		symbol_samples = 0;
 		repeat_counter = 0;
 		bit_pos = 0;
 		cur_bit = 0;
 		txprogress_message.progress = 0;
 		txprogress_message.done = false;
+		ook.configure(200 << 6);		// Carrier offset of 2.28M * 200 / 2^26 ~ 6.8kHz
 		configured = true;
 	}
 }
@@ -25,6 +25,7 @@
 
 #include "baseband_processor.hpp"
 #include "baseband_thread.hpp"
+#include "dsp_modulate.hpp"
 
 class OOKProcessor : public BasebandProcessor {
 public:
@@ -44,12 +45,13 @@ private:
 	
 	uint32_t pause_counter { 0 };
 	uint8_t repeat_counter { 0 };
-	uint8_t s { 0 };
     uint16_t bit_pos { 0 };
     uint8_t cur_bit { 0 };
-    uint32_t sample_count { 0 };
-	uint32_t tone_phase { 0 }, phase { 0 }, sphase { 0 };
-	int32_t tone_sample { 0 }, sig { 0 }, frq { 0 };
+    uint32_t symbol_samples { 0 };
+	
+	dsp::modulate::OOK ook { };
+	
+	void next_symbol();
 	
 	TXProgressMessage txprogress_message { };
 };
@@ -0,0 +1,110 @@
+/*
+ * Copyright (C) 2026 agent
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "proc_pulse.hpp"
+#include "portapack_shared_memory.hpp"
+
+#include "dsp_fir_taps.hpp"
+
+#include "event_m4.hpp"
+
+PulseProcessor::PulseProcessor() {
+	decim_0.configure(taps_200k_decim_0.taps, 33554432);
+	decim_1.configure(taps_200k_decim_1.taps, 131072);
+
+	detector.configure(channel_fs, 4, 10, 1, 65535);
+}
+
+void PulseProcessor::execute(const buffer_c8_t& buffer) {
+	/* 2.4576MHz, 2048 samples */
+	const auto decim_0_out = decim_0.execute(buffer, dst_buffer);
+	const auto decim_1_out = decim_1.execute(decim_0_out, dst_buffer);
+	const auto& channel = decim_1_out;
+
+	feed_channel_stats(channel);
+
+	detector.feed(channel, [this](const PulseDescriptor& pulse) {
+		this->on_pulse(pulse);
+	});
+
+	statistics_samples += channel.count;
+	if( statistics_samples >= statistics_interval_samples ) {
+		statistics_samples -= statistics_interval_samples;
+
+		const PulseStatisticsMessage message {
+			detector.rate(),
+			pulse_count,
+			static_cast<int32_t>(detector.noise_floor_db()),
+			last_pulse
+		};
+		shared_memory.application_queue.push(message);
+	}
+}
+
+void PulseProcessor::on_pulse(const PulseDescriptor& pulse) {
+	pulse_count++;
+	last_pulse = pulse;
+
+	if( stream ) {
+		stream->write(&pulse, sizeof(pulse));
+	}
+}
+
+void PulseProcessor::on_message(const Message* const message) {
+	switch(message->id) {
+	case Message::ID::PulseConfigure:
+		configure(*reinterpret_cast<const PulseConfigureMessage*>(message));
+		break;
+
+	case Message::ID::CaptureConfig:
+		capture_config(*reinterpret_cast<const CaptureConfigMessage*>(message));
+		break;
+
+	default:
+		break;
+	}
+}
+
+void PulseProcessor::configure(const PulseConfigureMessage& message) {
+	detector.configure(
+		channel_fs,
+		message.decimation,
+		message.threshold_db,
+		message.min_width,
+		message.max_width
+	);
+	pulse_count = 0;
+	last_pulse = { };
+}
+
+void PulseProcessor::capture_config(const CaptureConfigMessage& message) {
+	if( message.config ) {
+		stream = std::make_unique<StreamInput>(message.config);
+	} else {
+		stream.reset();
+	}
+}
+
+int main() {
+	EventDispatcher event_dispatcher { std::make_unique<PulseProcessor>() };
+	event_dispatcher.run();
+	return 0;
+}
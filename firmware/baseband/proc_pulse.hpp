@@ -0,0 +1,78 @@
+/*
+ * Copyright (C) 2026 agent
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __PROC_PULSE_H__
+#define __PROC_PULSE_H__
+
+#include "baseband_processor.hpp"
+#include "baseband_thread.hpp"
+#include "rssi_thread.hpp"
+
+#include "dsp_decimate.hpp"
+#include "pulse_detector.hpp"
+
+#include "stream_input.hpp"
+
+#include "message.hpp"
+
+#include <array>
+#include <memory>
+
+class PulseProcessor : public BasebandProcessor {
+public:
+	PulseProcessor();
+
+	void execute(const buffer_c8_t& buffer) override;
+
+	void on_message(const Message* const message) override;
+
+private:
+	static constexpr size_t baseband_fs = 2457600;
+	static constexpr size_t channel_fs = baseband_fs / 8;
+	static constexpr size_t statistics_interval_samples = channel_fs / 10;
+
+	BasebandThread baseband_thread { baseband_fs, this, NORMALPRIO + 20, baseband::Direction::Receive };
+	RSSIThread rssi_thread { NORMALPRIO + 10 };
+
+	std::array<complex16_t, 512> dst { };
+	const buffer_c16_t dst_buffer {
+		dst.data(),
+		dst.size()
+	};
+
+	dsp::decimate::FIRC8xR16x24FS4Decim4 decim_0 { };
+	dsp::decimate::FIRC16xR16x16Decim2 decim_1 { };
+
+	PulseDetector detector { };
+
+	std::unique_ptr<StreamInput> stream { };
+
+	uint32_t pulse_count { 0 };
+	PulseDescriptor last_pulse { };
+	size_t statistics_samples { 0 };
+
+	void on_pulse(const PulseDescriptor& pulse);
+
+	void configure(const PulseConfigureMessage& message);
+	void capture_config(const CaptureConfigMessage& message);
+};
+
+#endif/*__PROC_PULSE_H__*/
@@ -22,65 +22,89 @@
 
 #include "proc_siggen.hpp"
 #include "portapack_shared_memory.hpp"
-#include "sine_table_int8.hpp"
 #include "event_m4.hpp"
 
 #include <cstdint>
 
+// One FM loop per waveform, shape() giving the int8 sample for tone_phase
+template<typename Shape>
+void SigGenProcessor::modulate(const buffer_c8_t& buffer, Shape shape) {
+	fm.execute(buffer, [this, &shape]() {
+		const int32_t sample = shape();
+		tone_phase += tone_delta;
+		return sample * fm_delta;
+	});
+}
+
 void SigGenProcessor::execute(const buffer_c8_t& buffer) {
 	if (!configured) return;
 	
-	for (size_t i = 0; i < buffer.count; i++) {
-		
-		if (!sample_count && auto_off) {
+	if (auto_off) {
+		if (sample_count > buffer.count) {
+			sample_count -= buffer.count;
+		} else {
+			sample_count = 0;
 			txprogress_message.done = true;
 			shared_memory.application_queue.push(txprogress_message);
-		} else
-			sample_count--;
-		
-		if (tone_shape == 0) {
+		}
+	}
+	
+	switch (tone_shape) {
+		case 0:
 			// CW
-			re = 0;
-			im = 0;
-		} else {
-			
-			if (tone_shape == 1) {
-				// Sine
-				sample = (sine_table_i8[(tone_phase & 0xFF000000) >> 24]);
-			} else if (tone_shape == 2) {
-				// Tri
-				int8_t a = (tone_phase & 0xFF000000) >> 24;
-				sample = (a & 0x80) ? ((a << 1) ^ 0xFF) - 0x80 : (a << 1) + 0x80;
-			} else if (tone_shape == 3) {
-				// Saw up
-				sample = ((tone_phase & 0xFF000000) >> 24);
-			} else if (tone_shape == 4) {
-				// Saw down
-				sample = ((tone_phase & 0xFF000000) >> 24) ^ 0xFF;
-			} else if (tone_shape == 5) {
-				// Square
-				sample = (((tone_phase & 0xFF000000) >> 24) & 0x80) ? 127 : -128;
-			} else if (tone_shape == 6) {
-				// Noise
-				sample = (lfsr & 0xFF000000) >> 24;
+			fm.carrier(buffer, 0);
+			break;
+		
+		case 1:
+			// Sine
+			modulate(buffer, [this]() {
+				return dsp::modulate::sine_s8(tone_phase);
+			});
+			break;
+		
+		case 2:
+			// Tri
+			modulate(buffer, [this]() {
+				const int8_t a = tone_phase >> 24;
+				return static_cast<int8_t>((a & 0x80) ? ((a << 1) ^ 0xFF) - 0x80 : (a << 1) + 0x80);
+			});
+			break;
+		
+		case 3:
+			// Saw up
+			modulate(buffer, [this]() {
+				return static_cast<int8_t>(tone_phase >> 24);
+			});
+			break;
+		
+		case 4:
+			// Saw down
+			modulate(buffer, [this]() {
+				return static_cast<int8_t>((tone_phase >> 24) ^ 0xFF);
+			});
+			break;
+		
+		case 5:
+			// Square
+			modulate(buffer, [this]() {
+				return (tone_phase & 0x80000000) ? 127 : -128;
+			});
+			break;
+		
+		case 6:
+			// Noise
+			modulate(buffer, [this]() {
+				const int8_t sample = lfsr >> 24;
 				feedback = ((lfsr >> 31) ^ (lfsr >> 29) ^ (lfsr >> 15) ^ (lfsr >> 11)) & 1;
 				lfsr = (lfsr << 1) | feedback;
 				if (!lfsr) lfsr = 0x1337;				// Shouldn't do this :(
-			}
-			
-			tone_phase += tone_delta;
-			
-			// Do FM
-			delta = sample * fm_delta;
-			
-			phase += delta;
-			sphase = phase + (64 << 24);
-
-			re = (sine_table_i8[(sphase & 0xFF000000) >> 24]);
-			im = (sine_table_i8[(phase & 0xFF000000) >> 24]);
-		}
-
-		buffer.p[i] = {re, im};
+				return sample;
+			});
+			break;
+		
+		default:
+			dsp::modulate::silence(buffer);
+			break;
 	}
 };
 
@@ -26,6 +26,7 @@
 #include "baseband_processor.hpp"
 #include "baseband_thread.hpp"
 #include "portapack_shared_memory.hpp"
+#include "dsp_modulate.hpp"
 
 class SigGenProcessor : public BasebandProcessor {
 public:
@@ -42,9 +43,12 @@ private:
 	uint32_t lfsr { }, feedback { }, tone_shape { };
     uint32_t sample_count { 0 };
     bool auto_off { };
-	uint32_t tone_phase { 0 }, phase { 0 }, delta { 0 }, sphase { 0 };
-	int8_t sample { 0 };
-	int8_t re { 0 }, im { 0 };
+	uint32_t tone_phase { 0 };
+	
+	dsp::modulate::FM fm { };
+	
+	template<typename Shape>
+	void modulate(const buffer_c8_t& buffer, Shape shape);
 	
 	TXProgressMessage txprogress_message { };
 };
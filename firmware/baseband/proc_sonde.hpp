@@ -125,7 +125,7 @@ private:
 	PacketBuilder<BitPattern, NeverMatch, FixedLength> packet_builder_fsk_9600_Meteomodem {
 		{ 0b00110011001100110101100110110011, 32, 1 },
 		{ },
-		{ 88 * 2 * 8 },
+		{ 101 * 2 * 8 },		// Whole M10 frame, up to the checksum
 		[this](const baseband::Packet& packet) {
 			const SondePacketMessage message { sonde::Packet::Type::Meteomodem_unknown, packet };
 			shared_memory.application_queue.push(message);
@@ -21,91 +21,86 @@
  */
 
 #include "proc_sstvtx.hpp"
-#include "sine_table_int8.hpp"
 #include "event_m4.hpp"
 
 #include <cstdint>
+#include <algorithm>
 
 // This is called at 3072000/2048 = 1500Hz
 void SSTVTXProcessor::execute(const buffer_c8_t& buffer) {
 	
 	if (!configured) return;
 	
-	for (size_t i = 0; i < buffer.count; i++) {
+	for (size_t i = 0; i < buffer.count; ) {
+		if (!step_samples) {
+			next_step();
+			step_samples = sample_count + 1;
+		}
 		
-		if (!sample_count) {
-			
-			// This FSM is a mess. It seems to do a lot where it shouldn't (I/Q loop),
-			// but it actually doesn't do much. Used for sequencing the different parts
-			// of the scanline. Todo: simplify !
-			
-			if (state == STATE_CALIBRATION) {
-				// Once per picture
-				tone_delta = calibration_sequence[substep].first;
-				sample_count = calibration_sequence[substep].second;
-				if (substep == 2) {
-					substep = 0;
-					state = STATE_VIS;
-				} else
-					substep++;
-			} else if (state == STATE_VIS) {
-				// Once per picture
-				if (substep == 10) {
-					current_scanline = &scanline_buffer[buffer_flip];
-					buffer_flip ^= 1;
-					// Ask application for a new scanline
-					shared_memory.application_queue.push(sig_message);
-					// Do we have to transmit a start tone ?
-					if (current_scanline->start_tone.duration) {
-						state = STATE_SYNC;
-						tone_delta = current_scanline->start_tone.frequency;
-						sample_count = current_scanline->start_tone.duration;
-					} else {
-						state = STATE_PIXELS;
-						tone_delta = current_scanline->gap_tone.frequency;
-						sample_count = current_scanline->gap_tone.duration;
-					}
-				} else {
-					tone_delta = vis_code_sequence[substep];
-					sample_count = SSTV_MS2S(30);	// A VIS code bit is 30ms
-					substep++;
-				}
-			} else if (state == STATE_SYNC) {
-				// Once per scanline, optional
+		const size_t run = std::min<size_t>(step_samples, buffer.count - i);
+		const buffer_c8_t dst { &buffer.p[i], run };
+		
+		fm.execute(dst, [this]() {
+			return tone.next(tone_delta) * fm_delta;
+		});
+		
+		step_samples -= run;
+		i += run;
+	}
+}
+
+void SSTVTXProcessor::next_step() {
+	// Sequences the different parts of the picture and scanlines, one tone
+	// per step. Todo: simplify !
+	
+	if (state == STATE_CALIBRATION) {
+		// Once per picture
+		tone_delta = calibration_sequence[substep].first;
+		sample_count = calibration_sequence[substep].second;
+		if (substep == 2) {
+			substep = 0;
+			state = STATE_VIS;
+		} else
+			substep++;
+	} else if (state == STATE_VIS) {
+		// Once per picture
+		if (substep == 10) {
+			current_scanline = &scanline_buffer[buffer_flip];
+			buffer_flip ^= 1;
+			// Ask application for a new scanline
+			shared_memory.application_queue.push(sig_message);
+			// Do we have to transmit a start tone ?
+			if (current_scanline->start_tone.duration) {
+				state = STATE_SYNC;
+				tone_delta = current_scanline->start_tone.frequency;
+				sample_count = current_scanline->start_tone.duration;
+			} else {
 				state = STATE_PIXELS;
 				tone_delta = current_scanline->gap_tone.frequency;
 				sample_count = current_scanline->gap_tone.duration;
-			} else if (state == STATE_PIXELS) {
-				// Many times per scanline
-				tone_delta = SSTV_F2D(1500 + ((current_scanline->luma[pixel_index] * 800) / 256));
-				sample_count = pixel_duration;
-				pixel_index++;
-				
-				if (pixel_index >= 320) {
-					// Scanline done, (dirty) state jump
-					pixel_index = 0;
-					state = STATE_VIS;
-					substep = 10;
-				}
 			}
 		} else {
-			sample_count--;
+			tone_delta = vis_code_sequence[substep];
+			sample_count = SSTV_MS2S(30);	// A VIS code bit is 30ms
+			substep++;
 		}
-
-		// Tone synth
-		tone_sample = (sine_table_i8[(tone_phase & 0xFF000000U) >> 24]);
-		tone_phase += tone_delta;
-		
-		// FM
-		delta = tone_sample * fm_delta;
+	} else if (state == STATE_SYNC) {
+		// Once per scanline, optional
+		state = STATE_PIXELS;
+		tone_delta = current_scanline->gap_tone.frequency;
+		sample_count = current_scanline->gap_tone.duration;
+	} else if (state == STATE_PIXELS) {
+		// Many times per scanline
+		tone_delta = SSTV_F2D(1500 + ((current_scanline->luma[pixel_index] * 800) / 256));
+		sample_count = pixel_duration;
+		pixel_index++;
 		
-		phase += delta;
-		sphase = phase + (64 << 24);
-
-		re = (sine_table_i8[(sphase & 0xFF000000U) >> 24]);
-		im = (sine_table_i8[(phase & 0xFF000000U) >> 24]);
-		
-		buffer.p[i] = {re, im};
+		if (pixel_index >= 320) {
+			// Scanline done, (dirty) state jump
+			pixel_index = 0;
+			state = STATE_VIS;
+			substep = 10;
+		}
 	}
 }
 
@@ -134,8 +129,8 @@ void SSTVTXProcessor::on_message(const Message* const msg) {
 			fm_delta = 9000 * (0xFFFFFFULL / 3072000);	// Fixed bw for now
 			
 			pixel_index = 0;
-			sample_count = 0;
-			tone_phase = 0;
+			step_samples = 0;
+			tone.reset();
 			state = STATE_CALIBRATION;
 			substep = 0;
 			
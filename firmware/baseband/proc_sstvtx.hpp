@@ -26,6 +26,7 @@
 #include "portapack_shared_memory.hpp"
 #include "baseband_processor.hpp"
 #include "baseband_thread.hpp"
+#include "dsp_modulate.hpp"
 #include "sstv.hpp"
 
 using namespace sstv;
@@ -69,13 +70,15 @@ private:
 	
 	uint8_t pixel_luma { };
 	uint32_t fm_delta { 0 };
-	uint32_t tone_phase { 0 };
 	uint32_t tone_delta { 0 };
     uint32_t pixel_index { 0 };
-    uint32_t sample_count { 0 };
-	uint32_t phase { 0 }, sphase { 0 };
-	int32_t tone_sample { 0 }, delta { 0 };
-	int8_t re { }, im { };
+    uint32_t sample_count { 0 };		// Duration of the current step, minus one
+    uint32_t step_samples { 0 };
+	
+	dsp::modulate::Tone tone { };
+	dsp::modulate::FM fm { };
+	
+	void next_step();
 	
 	RequestSignalMessage sig_message { RequestSignalMessage::Signal::FillRequest };
 };
@@ -21,105 +21,110 @@
  */
 
 #include "proc_tones.hpp"
-#include "sine_table_int8.hpp"
 #include "event_m4.hpp"
 
 #include <cstdint>
+#include <algorithm>
+
+// FM of source() over dst, offset being dst's position in the baseband
+// buffer. Headphone output gets every 64th sample: 1536000/64 = 24000
+template<typename Source>
+void TonesProcessor::modulate(const buffer_c8_t& dst, const size_t offset, Source source) {
+	size_t n = offset;
+	
+	fm.execute(dst, [this, &n, &source]() {
+		const int32_t tone_sample = source();
+		if (audio_out && !(n & 63))
+			audio[n >> 6] = tone_sample * 128;
+		n++;
+		return tone_sample * fm_delta;
+	});
+}
 
 // This is called at 1536000/2048 = 750Hz
 void TonesProcessor::execute(const buffer_c8_t& buffer) {
 	
 	if (!configured) return;
 	
-	ai = 0;
+	audio.fill(0);
 	
-	for (size_t i = 0; i < buffer.count; i++) {
+	for (size_t i = 0; i < buffer.count; ) {
+		const size_t remaining = buffer.count - i;
 		
-		// Tone generation at full samplerate
 		if (silence_count) {
 			// Just occupy channel with carrier
-			silence_count--;
+			const size_t run = std::min<size_t>(silence_count, remaining);
+			dsp::modulate::silence({ &buffer.p[i], run });
+			silence_count -= run;
 			if (!silence_count) {
 				sample_count = 0;
-				tone_a_phase = 0;
-				tone_b_phase = 0;
-			}
-			tone_sample = 0;
-			re = 0;
-			im = 0;
-		} else {
-			if (!sample_count) {
-				digit = shared_memory.bb_data.tones_data.message[digit_pos];
-				if (digit_pos >= message_length) {
-					configured = false;
-					txprogress_message.done = true;
-					shared_memory.application_queue.push(txprogress_message);
-					return;
-				} else {
-					txprogress_message.progress = digit_pos;	// Inform UI about progress
-					txprogress_message.done = false;
-					shared_memory.application_queue.push(txprogress_message);
-				}
-				
-				digit_pos++;
-				
-				if (digit >= 32) {	//  || (tone_deltas[digit] == 0)
-					sample_count = shared_memory.bb_data.tones_data.silence;
-				} else {
-					if (!dual_tone) {
-						tone_a_delta = tone_deltas[digit];
-					} else {
-						tone_a_delta = tone_deltas[digit << 1];
-						tone_b_delta = tone_deltas[(digit << 1) + 1];
-					}
-					sample_count = tone_durations[digit];
-				}
-			} else {
-				sample_count--;
-			}
-			
-			// Ugly
-			if ((digit >= 32) || (tone_deltas[digit] == 0)) {
-				tone_sample = 0;
-			} else {
-				if (!dual_tone) {
-					tone_sample = (sine_table_i8[(tone_a_phase & 0xFF000000U) >> 24]);
-					tone_a_phase += tone_a_delta;
-				} else {
-					tone_sample = sine_table_i8[(tone_a_phase & 0xFF000000U) >> 24] >> 1;
-					tone_sample += sine_table_i8[(tone_b_phase & 0xFF000000U) >> 24] >> 1;
-					
-					tone_a_phase += tone_a_delta;
-					tone_b_phase += tone_b_delta;
-				}
+				tone_a.reset();
+				tone_b.reset();
 			}
+			i += run;
+			continue;
+		}
 		
-			// FM
-			delta = tone_sample * fm_delta;
-			
-			phase += delta;
-			sphase = phase + (64 << 24);
-
-			re = (sine_table_i8[(sphase & 0xFF000000U) >> 24]);
-			im = (sine_table_i8[(phase & 0xFF000000U) >> 24]);
+		if (!sample_count && !next_digit()) {
+			dsp::modulate::silence({ &buffer.p[i], remaining });
+			break;
 		}
 		
-		// Headphone output sample generation: 1536000/24000 = 64
-		if (audio_out) {
-			if (!as) {
-				as = 64;
-				audio_buffer.p[ai++] = tone_sample * 128;
-			} else {
-				as--;
-			}
+		const size_t run = std::min<size_t>(sample_count, remaining);
+		const buffer_c8_t dst { &buffer.p[i], run };
+		
+		if ((digit >= 32) || (tone_deltas[digit] == 0)) {
+			modulate(dst, i, []() { return 0; });
+		} else if (!dual_tone) {
+			modulate(dst, i, [this]() {
+				return tone_a.next(tone_a_delta);
+			});
+		} else {
+			modulate(dst, i, [this]() {
+				return (tone_a.next(tone_a_delta) >> 1) + (tone_b.next(tone_b_delta) >> 1);
+			});
 		}
 		
-		buffer.p[i] = {re, im};
+		sample_count -= run;
+		i += run;
 	}
 	
 	if (audio_out) audio_output.write(audio_buffer);
 }
 
+// Sets up the next digit and its duration in sample_count, false at the end
+bool TonesProcessor::next_digit() {
+	digit = shared_memory.bb_data.tones_data.message[digit_pos];
+	if (digit_pos >= message_length) {
+		configured = false;
+		txprogress_message.done = true;
+		shared_memory.application_queue.push(txprogress_message);
+		return false;
+	} else {
+		txprogress_message.progress = digit_pos;	// Inform UI about progress
+		txprogress_message.done = false;
+		shared_memory.application_queue.push(txprogress_message);
+	}
+	
+	digit_pos++;
+	
+	if (digit >= 32) {	//  || (tone_deltas[digit] == 0)
+		sample_count = shared_memory.bb_data.tones_data.silence;
+	} else {
+		if (!dual_tone) {
+			tone_a_delta = tone_deltas[digit];
+		} else {
+			tone_a_delta = tone_deltas[digit << 1];
+			tone_b_delta = tone_deltas[(digit << 1) + 1];
+		}
+		sample_count = tone_durations[digit];
+	}
+	
+	// A digit lasts one sample more than its duration
+	sample_count++;
+	return true;
+}
+
 void TonesProcessor::on_message(const Message* const p) {
 	const auto message = *reinterpret_cast<const TonesConfigureMessage*>(p);
 	if (message.id == Message::ID::TonesConfigure) {
@@ -142,9 +147,8 @@ void TonesProcessor::on_message(const Message* const p) {
 			
 			digit_pos = 0;
 			sample_count = 0;
-			tone_a_phase = 0;
-			tone_b_phase = 0;
-			as = 0;
+			tone_a.reset();
+			tone_b.reset();
 			
 			configured = true;
 		} else {
@@ -27,6 +27,7 @@
 #include "baseband_processor.hpp"
 #include "baseband_thread.hpp"
 #include "audio_output.hpp"
+#include "dsp_modulate.hpp"
 
 class TonesProcessor : public BasebandProcessor {
 public:
@@ -51,16 +52,18 @@ private:
 	bool audio_out { false };
 	bool dual_tone { false };
 	uint32_t fm_delta { 0 };
-	uint32_t tone_a_phase { 0 }, tone_b_phase { 0 };
 	uint32_t tone_a_delta { 0 }, tone_b_delta { 0 };
     uint8_t digit_pos { 0 };
     uint8_t digit { 0 };
     uint32_t silence_count { 0 }, sample_count { 0 };
     uint32_t message_length { 0 };
-	uint32_t phase { 0 }, sphase { 0 };
-	int32_t tone_sample { 0 }, delta { 0 };
-	int8_t re { 0 }, im { 0 };
-	uint8_t as { 0 }, ai { 0 };
+	
+	dsp::modulate::Tone tone_a { }, tone_b { };
+	dsp::modulate::FM fm { };
+	
+	bool next_digit();
+	template<typename Source>
+	void modulate(const buffer_c8_t& dst, const size_t offset, Source source);
 	
 	TXProgressMessage txprogress_message { };
 	AudioOutput audio_output { };
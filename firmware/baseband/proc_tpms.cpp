@@ -58,6 +58,18 @@ void TPMSProcessor::execute(const buffer_c8_t& buffer) {
 	}
 }
 
+void TPMSProcessor::on_packet(const tpms::SignalType signal_type, const baseband::Packet& packet) {
+	/* Every preamble match on a busy road builds a candidate, most of them
+	 * noise or other OOK/FSK traffic. Only pass on those that check out. */
+	candidates++;
+
+	const auto coding = tpms::validate(packet, signal_type);
+	if( coding.is_valid() ) {
+		const TPMSPacketMessage message { signal_type, coding.value(), candidates, packet };
+		shared_memory.application_queue.push(message);
+	}
+}
+
 int main() {
 	EventDispatcher event_dispatcher { std::make_unique<TPMSProcessor>() };
 	event_dispatcher.run();
@@ -92,8 +92,7 @@ private:
 		{ },
 		{ 160 },
 		[this](const baseband::Packet& packet) {
-			const TPMSPacketMessage message { tpms::SignalType::FSK_19k2_Schrader, packet };
-			shared_memory.application_queue.push(message);
+			this->on_packet(tpms::SignalType::FSK_19k2_Schrader, packet);
 		}
 	};
 
@@ -115,9 +114,8 @@ private:
 		{ 0b010101010101010101011110, 24, 0 },
 		{ },
 		{ 37 * 2 },
-		[](const baseband::Packet& packet) {
-			const TPMSPacketMessage message { tpms::SignalType::OOK_8k192_Schrader, packet };
-			shared_memory.application_queue.push(message);
+		[this](const baseband::Packet& packet) {
+			this->on_packet(tpms::SignalType::OOK_8k192_Schrader, packet);
 		}
 	};
 
@@ -133,11 +131,14 @@ private:
 		{ 0b01010101010101010101010101100101, 32, 0 },
 		{ },
 		{ 76 * 2 },
-		[](const baseband::Packet& packet) {
-			const TPMSPacketMessage message { tpms::SignalType::OOK_8k4_Schrader, packet };
-			shared_memory.application_queue.push(message);
+		[this](const baseband::Packet& packet) {
+			this->on_packet(tpms::SignalType::OOK_8k4_Schrader, packet);
 		}
 	};
+
+	uint32_t candidates { 0 };
+
+	void on_packet(const tpms::SignalType signal_type, const baseband::Packet& packet);
 };
 
 #endif/*__PROC_TPMS_H__*/
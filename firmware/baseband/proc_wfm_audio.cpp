@@ -149,6 +149,10 @@ void WidebandFMAudio::on_message(const Message* const message) {
 	case Message::ID::CaptureConfig:
 		capture_config(*reinterpret_cast<const CaptureConfigMessage*>(message));
 		break;
+
+	case Message::ID::AudioProcessingConfig:
+		audio_processing_config(*reinterpret_cast<const AudioProcessingConfigMessage*>(message));
+		break;
 		
 	default:
 		break;
@@ -188,6 +192,10 @@ void WidebandFMAudio::capture_config(const CaptureConfigMessage& message) {
 	}
 }
 
+void WidebandFMAudio::audio_processing_config(const AudioProcessingConfigMessage& message) {
+	audio_output.set_processing(message.agc, message.noise_blanker);
+}
+
 int main() {
 	EventDispatcher event_dispatcher { std::make_unique<WidebandFMAudio>() };
 	event_dispatcher.run();
@@ -97,6 +97,7 @@ private:
 	bool configured { false };
 	void configure(const WFMConfigureMessage& message);
 	void capture_config(const CaptureConfigMessage& message);
+	void audio_processing_config(const AudioProcessingConfigMessage& message);
 	void post_message(const buffer_c16_t& data);
 };
 
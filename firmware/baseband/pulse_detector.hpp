@@ -0,0 +1,199 @@
+/*
+ * Copyright (C) 2026 agent
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __PULSE_DETECTOR_H__
+#define __PULSE_DETECTOR_H__
+
+#include "dsp_types.hpp"
+#include "message.hpp"
+#include "utility.hpp"
+
+#include <cstdint>
+#include <cstddef>
+#include <cmath>
+#include <algorithm>
+
+#include <hal.h>
+
+/* Power envelope pulse detector. Averages |IQ|^2 over `decimation` channel
+ * samples, tracks the noise floor while no pulse is present, and reports a
+ * PulseDescriptor for every excursion above floor + threshold. The frequency
+ * offset comes from the mean phase step across the pulse.
+ */
+class PulseDetector {
+public:
+	void configure(
+		const uint32_t sampling_rate,
+		const uint32_t new_decimation,
+		const int32_t threshold_db,
+		const uint32_t new_min_width,
+		const uint32_t new_max_width
+	) {
+		decimation = std::max<uint32_t>(new_decimation, 1);
+		min_width = std::max<uint32_t>(new_min_width, 1);
+		max_width = std::max(new_max_width, min_width);
+		envelope_rate = sampling_rate / decimation;
+		radians_to_hz = sampling_rate / (2.0f * pi);
+
+		on_ratio = std::pow(10.0f, threshold_db / 10.0f);
+		/* 3dB of hysteresis, but never end a pulse above the floor itself. */
+		off_ratio = std::max(on_ratio * 0.5f, 1.0f);
+
+		/* Floor follows the envelope with a fixed time constant, whatever the
+		 * envelope rate. */
+		floor_alpha = std::min(1.0f, 1.0f / (envelope_rate * floor_time_constant));
+
+		reset();
+	}
+
+	void reset() {
+		block_power = 0;
+		block_corr_re = 0;
+		block_corr_im = 0;
+		block_count = 0;
+		envelope_index = 0;
+		noise_floor = 0.0f;
+		in_pulse = false;
+	}
+
+	template<typename Callback>
+	void feed(const buffer_c16_t& src, Callback callback) {
+		auto src_p = src.p;
+		while(src_p < &src.p[src.count]) {
+			const uint32_t sample = *__SIMD32(src_p)++;
+			block_power += __SMUAD(sample, sample);
+			/* conj(previous) * sample */
+			block_corr_re += static_cast<int32_t>(__SMUAD(previous, sample));
+			block_corr_im += static_cast<int32_t>(__SMUSDX(previous, sample));
+			previous = sample;
+
+			if( ++block_count >= decimation ) {
+				on_envelope(callback);
+			}
+		}
+	}
+
+	uint32_t rate() const {
+		return envelope_rate;
+	}
+
+	float noise_floor_db() const {
+		return to_dbfs(noise_floor);
+	}
+
+private:
+	static constexpr float pi = 3.14159265358979323846f;
+	static constexpr float floor_time_constant = 0.05f;
+	/* Keeps an all-zero floor from turning every sample into a pulse. */
+	static constexpr float floor_min = 1.0f;
+
+	uint32_t decimation { 1 };
+	uint32_t min_width { 1 };
+	uint32_t max_width { 65535 };
+	uint32_t envelope_rate { 0 };
+	float radians_to_hz { 0.0f };
+	float on_ratio { 10.0f };
+	float off_ratio { 5.0f };
+	float floor_alpha { 1.0f };
+
+	uint64_t block_power { 0 };
+	int64_t block_corr_re { 0 };
+	int64_t block_corr_im { 0 };
+	uint32_t block_count { 0 };
+	uint32_t previous { 0 };
+
+	uint32_t envelope_index { 0 };
+	float noise_floor { 0.0f };
+
+	bool in_pulse { false };
+	uint32_t pulse_start { 0 };
+	uint32_t pulse_width { 0 };
+	float pulse_peak { 0.0f };
+	float pulse_floor { 0.0f };
+	int64_t pulse_corr_re { 0 };
+	int64_t pulse_corr_im { 0 };
+
+	static float to_dbfs(const float power) {
+		return mag2_to_dbv_norm(power * (1.0f / (32768.0f * 32768.0f)));
+	}
+
+	template<typename Callback>
+	void on_envelope(Callback callback) {
+		const float envelope = static_cast<float>(block_power) / block_count;
+		const auto floor = std::max(noise_floor, floor_min);
+
+		if( in_pulse ) {
+			if( envelope < floor * off_ratio ) {
+				end_pulse(callback, 0);
+			} else {
+				pulse_peak = std::max(pulse_peak, envelope);
+				pulse_corr_re += block_corr_re;
+				pulse_corr_im += block_corr_im;
+				if( ++pulse_width >= max_width ) {
+					end_pulse(callback, PulseDescriptor::flag_truncated);
+				}
+			}
+		} else if( (envelope_index > 0) && (envelope > floor * on_ratio) ) {
+			in_pulse = true;
+			pulse_start = envelope_index;
+			pulse_width = 1;
+			pulse_peak = envelope;
+			pulse_floor = floor;
+			pulse_corr_re = block_corr_re;
+			pulse_corr_im = block_corr_im;
+		} else {
+			noise_floor = (envelope_index > 0)
+				? noise_floor + (envelope - noise_floor) * floor_alpha
+				: envelope;
+		}
+
+		envelope_index++;
+		block_power = 0;
+		block_corr_re = 0;
+		block_corr_im = 0;
+		block_count = 0;
+	}
+
+	template<typename Callback>
+	void end_pulse(Callback callback, const uint16_t flags) {
+		in_pulse = false;
+		if( pulse_width < min_width ) {
+			return;
+		}
+
+		const float phase_step = std::atan2(
+			static_cast<float>(pulse_corr_im),
+			static_cast<float>(pulse_corr_re)
+		);
+
+		const PulseDescriptor pulse {
+			pulse_start,
+			pulse_width,
+			static_cast<int32_t>(phase_step * radians_to_hz),
+			static_cast<int8_t>(std::max(to_dbfs(pulse_peak), -128.0f)),
+			static_cast<int8_t>(std::max(to_dbfs(pulse_floor), -128.0f)),
+			flags
+		};
+		callback(pulse);
+	}
+};
+
+#endif/*__PULSE_DETECTOR_H__*/
@@ -27,6 +27,7 @@
 
 #include "message.hpp"
 #include "portapack_shared_memory.hpp"
+#include "chibios_cpp.hpp"
 
 WORKING_AREA(rssi_thread_wa, 128);
 
@@ -45,6 +46,19 @@ RSSIThread::~RSSIThread() {
 	thread = nullptr;
 }
 
+StackStatistics RSSIThread::stack_statistics() {
+	StackStatistics statistics;
+	if( thread ) {
+		statistics.size = sizeof(rssi_thread_wa) - sizeof(Thread);
+		statistics.unused = chibios::thread_stack_unused(thread, statistics.size);
+	}
+	return statistics;
+}
+
+uint32_t RSSIThread::total_ticks() {
+	return thread ? thread->total_ticks : 0;
+}
+
 void RSSIThread::run() {
 	rf::rssi::init();
 	rf::rssi::dma::allocate(4, 400);
@@ -23,6 +23,7 @@
 #define __RSSI_THREAD_H__
 
 #include "thread_base.hpp"
+#include "message.hpp"
 
 #include <ch.h>
 
@@ -33,6 +34,11 @@ public:
 	RSSIThread(const tprio_t priority);
 	~RSSIThread();
 
+	static StackStatistics stack_statistics();
+
+	/* Thread profiling ticks, 0 while no RSSI thread is running */
+	static uint32_t total_ticks();
+
 private:
 	void run() override;
 
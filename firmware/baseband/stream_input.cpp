@@ -74,3 +74,21 @@ size_t StreamInput::write(const void* const data, const size_t length) {
 
 	return written;
 }
+
+void StreamInput::end_segment() {
+	config->segments++;
+
+	if( !active_buffer ) {
+		if( !fifo_buffers_empty.out(active_buffer) ) {
+			// No buffer to carry the marker, the application is behind and
+			// the next segment will be appended to this one.
+			return;
+		}
+	}
+
+	active_buffer->set_segment_end(true);
+	if( fifo_buffers_full.in(active_buffer) ) {
+		active_buffer = nullptr;
+		creg::m4txevent::assert();
+	}
+}
@@ -41,6 +41,10 @@ public:
 
 	size_t write(const void* const data, const size_t length);
 
+	/* Hands the partly filled buffer to the application, marked as the end
+	 * of a triggered capture segment. */
+	void end_segment();
+
 private:
 	static constexpr size_t buffer_count_max_log2 = 3;
 	static constexpr size_t buffer_count_max = 1U << buffer_count_max_log2;
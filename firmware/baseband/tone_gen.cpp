@@ -38,3 +38,14 @@ int32_t ToneGen::process(const int32_t sample_in) {
 	
 	return (sample_in * input_mix_weight_) + (tone_sample * tone_mix_weight_);
 }
+
+/* Same mix for 16-bit input, tone scaled to match */
+int32_t ToneGen::process_s16(const int32_t sample_in) {
+	if (!delta_)
+		return sample_in;
+	
+	int32_t tone_sample = sine_table_i8[(tone_phase_ & 0xFF000000U) >> 24] * 256;
+	tone_phase_ += delta_;
+	
+	return (sample_in * input_mix_weight_) + (tone_sample * tone_mix_weight_);
+}
@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2026 agent
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "video_line_sync.hpp"
+
+#include <algorithm>
+
+bool VideoLineSync::build_line(const size_t cut, const bool locked) {
+	if( cut == 0 ) {
+		return false;
+	}
+
+	/* Levels: sync tip is the line maximum, black the back porch (6us to
+	 * 9us after the sync leading edge). */
+	const uint32_t p = period();
+	const size_t porch_start = std::min<size_t>(p * 6 / 64, cut);
+	const size_t porch_end = std::min<size_t>(p * 9 / 64, cut);
+
+	uint32_t line_max = 0;
+	for(size_t n=0; n<cut; n++) {
+		line_max = std::max<uint32_t>(line_max, line[n]);
+	}
+	if( porch_end > porch_start ) {
+		uint32_t porch_sum = 0;
+		for(size_t n=porch_start; n<porch_end; n++) {
+			porch_sum += line[n];
+		}
+		const int32_t porch = porch_sum / (porch_end - porch_start);
+		black += (porch - static_cast<int32_t>(black)) / 8;
+	}
+	sync_tip += (static_cast<int32_t>(line_max) - static_cast<int32_t>(sync_tip)) / 8;
+	sync_threshold = (sync_tip + black) / 2;
+
+	if( field_odd || (field_line < first_active_line) ) {
+		return false;
+	}
+	const uint32_t number = field_line - first_active_line;
+	if( number >= field_lines_out ) {
+		return false;
+	}
+
+	/* Peak white is ~12.5% carrier for negative modulation. */
+	const int32_t white = sync_tip / 8;
+	const int32_t span = static_cast<int32_t>(black) - white;
+	if( span <= 0 ) {
+		return false;
+	}
+
+	/* Active video: 10.5us after the sync edge, 52us long. Positions in Q8. */
+	const uint32_t start_q8 = period_q8 * 21 / 128;
+	const uint32_t step_q8 = period_q8 * 52 / (64 * VideoLine::pixel_count);
+	const int32_t scale = (255 << 16) / span;
+
+	uint32_t pos_q8 = start_q8;
+	for(size_t x=0; x<VideoLine::pixel_count; x++, pos_q8 += step_q8) {
+		const size_t index = pos_q8 >> 8;
+		int32_t v;
+		if( index + 1 < cut ) {
+			const int32_t frac = pos_q8 & 0xff;
+			v = (line[index] * (256 - frac) + line[index + 1] * frac) >> 8;
+		} else {
+			v = line[cut - 1];
+		}
+		const int32_t pixel = ((static_cast<int32_t>(black) - v) * scale) >> 16;
+		line_out.pixels[x] = std::max(0L, std::min(255L, static_cast<long>(pixel)));
+	}
+
+	line_out.number = number;
+	line_out.flags = 0;
+	if( number == 0 ) {
+		line_out.flags |= VideoLine::flag_field_start;
+	}
+	if( !locked ) {
+		line_out.flags |= VideoLine::flag_unlocked;
+	}
+	return true;
+}
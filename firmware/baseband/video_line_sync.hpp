@@ -0,0 +1,190 @@
+/*
+ * Copyright (C) 2026 agent
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __VIDEO_LINE_SYNC_H__
+#define __VIDEO_LINE_SYNC_H__
+
+#include "dsp_types.hpp"
+#include "message.hpp"
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <cstdlib>
+
+/* Negative-modulation AM video (PAL/NTSC broadcast) line synchroniser.
+ * Envelope-detects the whole baseband buffer with an integer magnitude,
+ * cuts lines at horizontal sync leading edges (with a flywheel when sync is
+ * missing), numbers them from the vertical sync broad pulses, and resamples
+ * the active part of each line to VideoLine::pixel_count pixels.
+ */
+class VideoLineSync {
+public:
+	constexpr VideoLineSync(
+		const uint32_t sampling_rate
+	) : period_nominal { sampling_rate / 15625 },	/* 64us, refined from measured syncs */
+		hsync_min { sampling_rate / 400000 },		/* 2.5us, rejects equalising pulses */
+		hsync_max { sampling_rate / 140000 },		/* ~7us */
+		broad_min { sampling_rate / 62500 },		/* 16us, vertical sync broad pulse */
+		period_q8 { period_nominal << 8 }
+	{
+	}
+
+	template<typename Callback>
+	void feed(const buffer_c8_t& src, Callback callback) {
+		int32_t sum_i = 0;
+		int32_t sum_q = 0;
+
+		for(size_t n=0; n<src.count; n++) {
+			const int32_t i = src.p[n].real();
+			const int32_t q = src.p[n].imag();
+			sum_i += i;
+			sum_q += q;
+
+			const auto mag = magnitude(i - dc_i, q - dc_q);
+			line[length++] = mag;
+
+			if( mag >= sync_threshold ) {
+				sync_run++;
+			} else if( sync_run ) {
+				on_sync_end(callback);
+				sync_run = 0;
+			}
+
+			if( length >= flywheel_length() ) {
+				/* No usable sync where one was due: keep line timing. */
+				misses++;
+				end_line(period(), false, callback);
+			}
+		}
+
+		/* Track the RF front end's DC offset one buffer behind; it would
+		 * otherwise beat against the carrier (tuned to fs/4) in the envelope. */
+		dc_i += (static_cast<int32_t>(sum_i / static_cast<int32_t>(src.count)) - dc_i) / 4;
+		dc_q += (static_cast<int32_t>(sum_q / static_cast<int32_t>(src.count)) - dc_q) / 4;
+	}
+
+private:
+	static constexpr size_t line_length_max = 384;
+	static constexpr uint32_t first_active_line = 20;	/* After the first broad pulse */
+	static constexpr uint32_t field_lines_min = 200;
+	static constexpr uint32_t field_lines_out = 256;
+	static constexpr size_t misses_to_unlock = 4;
+
+	const uint32_t period_nominal;
+	const uint32_t hsync_min;
+	const uint32_t hsync_max;
+	const uint32_t broad_min;
+
+	uint32_t period_q8;
+	std::array<uint16_t, line_length_max> line { };
+	size_t length { 0 };
+	uint32_t sync_run { 0 };
+	size_t misses { misses_to_unlock };
+
+	int32_t dc_i { 0 };
+	int32_t dc_q { 0 };
+
+	/* Envelope levels, IIR-averaged over lines. Negative modulation: sync
+	 * tip is the strongest carrier, white the weakest. */
+	uint32_t sync_tip { 128 };
+	uint32_t black { 96 };
+	uint32_t sync_threshold { 112 };
+
+	uint32_t field_line { 0 };
+	bool field_odd { false };
+
+	VideoLine line_out { };
+
+	/* Alpha-max-plus-beta-min, |z| ~= 15/16 max + 15/32 min (6% worst case). */
+	static uint16_t magnitude(const int32_t i, const int32_t q) {
+		const uint32_t a = std::abs(i);
+		const uint32_t b = std::abs(q);
+		const uint32_t max = (a > b) ? a : b;
+		const uint32_t min = (a > b) ? b : a;
+		return (max * 30 + min * 15) >> 5;
+	}
+
+	uint32_t period() const {
+		return period_q8 >> 8;
+	}
+
+	size_t flywheel_length() const {
+		return period() + (period() >> 3);
+	}
+
+	template<typename Callback>
+	void on_sync_end(Callback callback) {
+		const int32_t leading_edge = static_cast<int32_t>(length) - static_cast<int32_t>(sync_run);
+
+		if( sync_run >= broad_min ) {
+			on_broad_pulse();
+			return;
+		}
+
+		if( (sync_run < hsync_min) || (sync_run > hsync_max) || (leading_edge <= 0) ) {
+			return;
+		}
+
+		/* Gate out half-line equalising pulses, unless lock has been lost. */
+		const auto edge = static_cast<uint32_t>(leading_edge);
+		const bool in_gate = (edge >= period() - (period() >> 3));
+		if( !in_gate && (misses < misses_to_unlock) ) {
+			return;
+		}
+
+		if( in_gate && (misses == 0) ) {
+			/* Refine the line period from consecutive locked syncs. */
+			period_q8 += static_cast<int32_t>((edge << 8) - period_q8) / 16;
+			const uint32_t limit_q8 = period_nominal << 4;	/* +/-1/16 of nominal */
+			if( period_q8 > (period_nominal << 8) + limit_q8 ) period_q8 = (period_nominal << 8) + limit_q8;
+			if( period_q8 < (period_nominal << 8) - limit_q8 ) period_q8 = (period_nominal << 8) - limit_q8;
+		}
+		misses = 0;
+		end_line(edge, true, callback);
+	}
+
+	void on_broad_pulse() {
+		if( field_line >= field_lines_min ) {
+			field_line = 0;
+			field_odd = !field_odd;
+		}
+	}
+
+	template<typename Callback>
+	void end_line(const size_t cut, const bool locked, Callback callback) {
+		if( build_line(cut, locked) ) {
+			callback(line_out);
+		}
+
+		/* Keep the samples after the cut (the new line's sync) */
+		const size_t remainder = length - cut;
+		for(size_t n=0; n<remainder; n++) {
+			line[n] = line[cut + n];
+		}
+		length = remainder;
+		field_line++;
+	}
+
+	bool build_line(const size_t cut, const bool locked);
+};
+
+#endif/*__VIDEO_LINE_SYNC_H__*/
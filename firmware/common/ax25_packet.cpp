@@ -0,0 +1,136 @@
+/*
+ * Copyright (C) 2026 agent
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "ax25_packet.hpp"
+
+namespace ax25 {
+
+size_t Packet::length() const {
+	const size_t bits = packet_.size();
+	if( bits < (flag_tail_length + fcs_length) ) {
+		return 0;
+	}
+	return (bits - flag_tail_length - fcs_length) / 8;
+}
+
+Timestamp Packet::received_at() const {
+	return packet_.timestamp();
+}
+
+uint8_t Packet::byte(const size_t index) const {
+	return field_.read(index * 8, 8);
+}
+
+size_t Packet::address_count() const {
+	size_t count = 0;
+	while( ((count + 1) * address_length <= length()) && (count < address_count_max) ) {
+		// The last address has the extension bit set in its SSID byte
+		const auto ssid_byte = byte(count * address_length + address_length - 1);
+		count++;
+		if( ssid_byte & 1 ) {
+			break;
+		}
+	}
+	return count;
+}
+
+std::string Packet::address(const size_t index) const {
+	std::string result;
+	result.reserve(9);
+
+	const size_t start = index * address_length;
+	for(size_t i=0; i<6; i++) {
+		const char c = byte(start + i) >> 1;
+		if( c != ' ' ) {
+			result += c;
+		}
+	}
+
+	const auto ssid_byte = byte(start + 6);
+	const uint8_t ssid = (ssid_byte >> 1) & 0x0f;
+	if( ssid ) {
+		result += '-';
+		if( ssid >= 10 ) {
+			result += '1';
+		}
+		result += '0' + (ssid % 10);
+	}
+
+	// Digipeater has repeated the frame
+	if( (index >= 2) && (ssid_byte & 0x80) ) {
+		result += '*';
+	}
+
+	return result;
+}
+
+uint8_t Packet::control() const {
+	return byte(address_count() * address_length);
+}
+
+bool Packet::has_info() const {
+	// I frames, and UI frames (poll/final bit ignored)
+	const auto c = control();
+	return ((c & 0x01) == 0) || ((c & 0xef) == 0x03);
+}
+
+size_t Packet::info_start() const {
+	// Control and PID
+	return address_count() * address_length + 2;
+}
+
+std::string Packet::info() const {
+	std::string result;
+	if( !has_info() ) {
+		return result;
+	}
+
+	const size_t end = length();
+	const size_t start = info_start();
+	if( start >= end ) {
+		return result;
+	}
+
+	result.reserve(end - start);
+	for(size_t i=start; i<end; i++) {
+		const uint8_t c = byte(i);
+		result += ((c >= 32) && (c < 127)) ? (char)c : '.';
+	}
+
+	return result;
+}
+
+std::string Packet::to_string() const {
+	const size_t count = address_count();
+	if( count < 2 ) {
+		return { };
+	}
+
+	std::string result = address(1) + ">" + address(0);
+	for(size_t i=2; i<count; i++) {
+		result += "," + address(i);
+	}
+	result += ":" + info();
+
+	return result;
+}
+
+} /* namespace ax25 */
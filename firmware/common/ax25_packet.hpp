@@ -0,0 +1,78 @@
+/*
+ * Copyright (C) 2026 agent
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __AX25_PACKET_H__
+#define __AX25_PACKET_H__
+
+#include "baseband_packet.hpp"
+#include "field_reader.hpp"
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+
+namespace ax25 {
+
+/* AX.25 frame as deframed by the AFSK RX baseband, FCS already checked. */
+class Packet {
+public:
+	constexpr Packet(
+		const baseband::Packet& packet
+	) : packet_ { packet },
+		field_ { packet_ }
+	{
+	}
+
+	/* Bytes from the destination address to the end of info, less the FCS */
+	size_t length() const;
+
+	Timestamp received_at() const;
+
+	uint8_t byte(const size_t index) const;
+
+	/* Destination, source, then up to 8 digipeaters */
+	size_t address_count() const;
+	std::string address(const size_t index) const;
+
+	uint8_t control() const;
+	bool has_info() const;
+	std::string info() const;
+
+	/* TNC2 monitor format, "SRC>DST,DIGI*:info" */
+	std::string to_string() const;
+
+private:
+	using Reader = FieldReader<baseband::Packet, BitRemapByteReverse>;
+
+	const baseband::Packet packet_;
+	const Reader field_;
+
+	static constexpr size_t flag_tail_length = 7;
+	static constexpr size_t fcs_length = 16;
+	static constexpr size_t address_length = 7;
+	static constexpr size_t address_count_max = 10;
+
+	size_t info_start() const;
+};
+
+} /* namespace ax25 */
+
+#endif/*__AX25_PACKET_H__*/
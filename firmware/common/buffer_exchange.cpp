@@ -58,11 +58,18 @@ StreamBuffer* BufferExchange::get(FIFO<StreamBuffer*>* fifo) {
 			return p;
 		}
 
-		// Put thread to sleep, woken up by M4 IRQ
+		// Put thread to sleep, woken up by M4 IRQ. The timeout lets the
+		// owner see chThdTerminate() once the baseband stops exchanging
+		// buffers (end of a bitstream, idle triggered capture...).
 		chSysLock();
 		thread = chThdSelf();
-		chSchGoSleepS(THD_STATE_SUSPENDED);
+		chSchGoSleepTimeoutS(THD_STATE_SUSPENDED, terminate_poll_ticks);
+		thread = nullptr;
 		chSysUnlock();
+
+		if( chThdShouldTerminate() ) {
+			return nullptr;
+		}
 	}
 }
 
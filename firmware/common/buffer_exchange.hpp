@@ -43,6 +43,8 @@ public:
 		return fifo_buffers_for_application->is_empty();
 	}
 
+	/* Waits for a buffer, nullptr once the calling thread is asked to
+	 * terminate. */
 	StreamBuffer* get() {
 		return get(fifo_buffers_for_application);
 	}
@@ -85,6 +87,8 @@ private:
 	//ReplayConfig* const config_replay;
 	FIFO<StreamBuffer*>* fifo_buffers_for_baseband { nullptr };
 	FIFO<StreamBuffer*>* fifo_buffers_for_application { nullptr };
+	static constexpr systime_t terminate_poll_ticks = 100;
+
 	Thread* thread { nullptr };
 	static BufferExchange* obj;
 	
@@ -22,14 +22,22 @@
 #include "chibios_cpp.hpp"
 
 #include <cstdint>
+#include <algorithm>
 
 #include <ch.h>
 
+/* Not locked: a preempted increment may lose a count, which is fine for the
+ * trend it's meant to show.
+ */
+static uint32_t allocation_count = 0;
+
 void* operator new(size_t size) {
+	allocation_count++;
 	return chHeapAlloc(0x0, size);
 }
 
 void* operator new[](size_t size) {
+	allocation_count++;
 	return chHeapAlloc(0x0, size);
 }
 
@@ -51,6 +59,10 @@ void operator delete[](void* ptr, std::size_t) noexcept {
 
 extern uint8_t __heap_base__[];
 extern uint8_t __heap_end__[];
+extern uint8_t __main_stack_base__[];
+extern uint8_t __main_stack_end__[];
+extern uint8_t __main_thread_stack_base__[];
+extern uint8_t __main_thread_stack_end__[];
 
 namespace chibios {
 
@@ -65,4 +77,76 @@ size_t heap_used() {
 	return heap_size() - (core_free + heap_free);
 }
 
+uint32_t heap_allocations() {
+	return allocation_count;
+}
+
+size_t heap_high_water() {
+	return heap_size() - chCoreStatus();
+}
+
+static MemoryHeap* default_heap() {
+	/* ChibiOS doesn't export the default heap, but every block header points
+	 * back at its owner. */
+	static MemoryHeap* heap = nullptr;
+	if( !heap ) {
+		void* const p = chHeapAlloc(NULL, sizeof(stkalign_t));
+		if( p ) {
+			heap = (reinterpret_cast<union heap_header*>(p) - 1)->h.u.heap;
+			chHeapFree(p);
+		}
+	}
+	return heap;
+}
+
+size_t heap_largest_free() {
+	size_t largest = chCoreStatus();
+
+	const auto heap = default_heap();
+	if( heap ) {
+		chMtxLock(&heap->h_mtx);
+		for(auto qp = heap->h_free.h.u.next; qp; qp = qp->h.u.next) {
+			largest = std::max(largest, qp->h.size);
+		}
+		chMtxUnlock();
+	}
+
+	return largest;
+}
+
+size_t stack_unused(const void* const base, const size_t size) {
+	const auto p = reinterpret_cast<const uint8_t*>(base);
+	size_t n = 0;
+	while( (n < size) && (p[n] == CH_STACK_FILL_VALUE) ) {
+		n++;
+	}
+	return n;
+}
+
+size_t thread_stack_size(const Thread* const tp) {
+	if( reinterpret_cast<const uint8_t*>(tp->p_stklimit) == __main_thread_stack_base__ ) {
+		return __main_thread_stack_end__ - __main_thread_stack_base__;
+	}
+	if( reinterpret_cast<const void*>(tp) == _idle_thread_wa ) {
+		return sizeof(_idle_thread_wa) - sizeof(Thread);
+	}
+	if( (tp->p_flags & THD_MEM_MODE_MASK) == THD_MEM_MODE_HEAP ) {
+		const auto hp = reinterpret_cast<const union heap_header*>(tp) - 1;
+		return hp->h.size - sizeof(Thread);
+	}
+	return 0;
+}
+
+size_t thread_stack_unused(const Thread* const tp, const size_t size) {
+	return stack_unused(tp->p_stklimit, size);
+}
+
+size_t irq_stack_size() {
+	return __main_stack_end__ - __main_stack_base__;
+}
+
+size_t irq_stack_unused() {
+	return stack_unused(__main_stack_base__, irq_stack_size());
+}
+
 } /* namespace chibios */
@@ -23,6 +23,9 @@
 #define __CHIBIOS_CPP_H__
 
 #include <cstddef>
+#include <cstdint>
+
+#include <ch.h>
 
 /* Override new/delete to use Chibi/OS heap functions */
 /* NOTE: Do not inline these, it doesn't work. ;-) */
@@ -38,6 +41,32 @@ namespace chibios {
 size_t heap_size();
 size_t heap_used();
 
+/* Number of operator new calls since boot. */
+uint32_t heap_allocations();
+
+/* Memory ever claimed from the core allocator by the heap. The core allocator
+ * never takes memory back, so this is the heap's high-water mark. */
+size_t heap_high_water();
+
+/* Largest single block an allocation could get right now, either from the
+ * heap free list or from the core allocator. */
+size_t heap_largest_free();
+
+/* Bytes at the bottom of a stack that still hold the fill pattern written at
+ * thread creation (CH_DBG_FILL_THREADS) or by crt0 for the main and
+ * exception stacks, i.e. stack that has never been used. */
+size_t stack_unused(const void* const base, const size_t size);
+
+/* Stack size of a thread, excluding its Thread structure. Only known for
+ * heap-allocated threads, the main thread and the idle thread; returns 0
+ * for other static threads, whose owners know their working area size. */
+size_t thread_stack_size(const Thread* const tp);
+size_t thread_stack_unused(const Thread* const tp, const size_t size);
+
+/* Exception/interrupt (MSP) stack. */
+size_t irq_stack_size();
+size_t irq_stack_unused();
+
 } /* namespace chibios */
 
 #endif/*__CHIBIOS_CPP_H__*/
@@ -26,6 +26,7 @@
 #include <cstdint>
 #include <limits>
 #include <array>
+#include <type_traits>
 
 /* Inspired by
  * http://www.barrgroup.com/Embedded-Systems/How-To/CRC-Calculation-C-Code
@@ -153,6 +154,61 @@ private:
 	}
 };
 
+/* Byte-at-a-time CRC, MSB first without reflection or final XOR, from a
+ * table generated at compile time. Gives the same result as CRC<Width> with
+ * the same polynomial, for checking many candidate packets on the M4.
+ * process_bit() finishes messages that don't end on a byte boundary. */
+template<size_t Width>
+class CRCTable {
+public:
+	static_assert((Width >= 8) && (Width <= 16), "CRCTable supports 8 to 16 bit CRCs");
+
+	using value_type = uint32_t;
+
+	constexpr CRCTable(
+		const value_type truncated_polynomial
+	) : truncated_polynomial { truncated_polynomial },
+		table { }
+	{
+		for(size_t i=0; i<table.size(); i++) {
+			value_type remainder = i << (Width - 8);
+			for(size_t bit=0; bit<8; bit++) {
+				remainder = (remainder & top_bit) ? ((remainder << 1) ^ truncated_polynomial) : (remainder << 1);
+			}
+			table[i] = remainder & mask;
+		}
+	}
+
+	value_type checksum(
+		const uint8_t* const data,
+		const size_t length,
+		const value_type initial_remainder = 0
+	) const {
+		value_type remainder = initial_remainder;
+		for(size_t i=0; i<length; i++) {
+			remainder = ((remainder << 8) ^ table[((remainder >> (Width - 8)) ^ data[i]) & 0xff]) & mask;
+		}
+		return remainder;
+	}
+
+	value_type process_bit(
+		const value_type remainder,
+		const bool bit
+	) const {
+		const auto feedback = remainder ^ (bit ? top_bit : 0U);
+		return ((feedback << 1) ^ ((feedback & top_bit) ? truncated_polynomial : 0U)) & mask;
+	}
+
+private:
+	using entry_type = typename std::conditional<(Width <= 8), uint8_t, uint16_t>::type;
+
+	static constexpr value_type top_bit = 1U << (Width - 1);
+	static constexpr value_type mask = (1U << Width) - 1;
+
+	const value_type truncated_polynomial;
+	std::array<entry_type, 256> table;
+};
+
 class Adler32 {
 public:
 	void feed(const uint8_t v) {
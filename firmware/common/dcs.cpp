@@ -544,4 +544,9 @@ uint32_t dcs_word(uint32_t code) {
 	return (dcs_parity[code] << 12) | (0b100 << 9) | code;
 }
 
+int32_t dcs_code(const uint32_t word) {
+	const uint32_t code = word & 511;
+	return (dcs_word(code) == (word & 0x7fffff)) ? code : -1;
+}
+
 }
@@ -23,6 +23,7 @@
 #ifndef __DCS_H_
 #define __DCS_H_
 
+#include <cstdint>
 #include <memory>
 
 #define DCS_CODES_NB 512
@@ -31,6 +32,10 @@ namespace dcs {
 
 uint32_t dcs_word(uint32_t code);
 
+// 9-bit code carried by a received 23-bit word (first bit in bit 0), or -1
+// if the word is not a valid DCS word.
+int32_t dcs_code(const uint32_t word);
+
 }
 
 #endif/*__DCS_H_*/
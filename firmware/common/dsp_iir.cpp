@@ -55,3 +55,84 @@ void IIRBiquadFilter::execute(const buffer_f32_t& buffer_in, const buffer_f32_t&
 void IIRBiquadFilter::execute_in_place(const buffer_f32_t& buffer) {
 	execute(buffer, buffer);
 }
+
+template<int Q>
+static int32_t to_fixed(const float v) {
+	return static_cast<int32_t>(v * (1UL << Q) + ((v >= 0.0f) ? 0.5f : -0.5f));
+}
+
+void IIRBiquadFilterQ31::configure(const iir_biquad_config_t& new_config) {
+	for(size_t i=0; i<3; i++) {
+		b[i] = to_fixed<30>(new_config.b[i]);
+		a[i] = to_fixed<30>(new_config.a[i]);
+	}
+	x1 = x2 = y1 = y2 = 0;
+	e1 = e2 = 0;
+}
+
+void IIRBiquadFilterQ31::execute_in_place(const buffer_s32_t& buffer) {
+	auto x1_ = x1, x2_ = x2;
+	auto y1_ = y1, y2_ = y2;
+	auto e1_ = e1, e2_ = e2;
+
+	for(size_t i=0; i<buffer.count; i++) {
+		const int32_t x0 = buffer.p[i];
+
+		// Second-order error feedback: the rounding error is shaped by
+		// (1 - z^-1)^2, cancelling the poles' huge gain near DC.
+		int64_t acc = 2 * static_cast<int64_t>(e1_) - e2_;
+		acc += static_cast<int64_t>(b[0]) * x0;
+		acc += static_cast<int64_t>(b[1]) * x1_;
+		acc += static_cast<int64_t>(b[2]) * x2_;
+		acc -= static_cast<int64_t>(a[1]) * y1_;
+		acc -= static_cast<int64_t>(a[2]) * y2_;
+		const int32_t y0 = (acc + (1LL << 29)) >> 30;
+
+		e2_ = e1_;
+		e1_ = acc - (static_cast<int64_t>(y0) << 30);
+		x2_ = x1_;
+		x1_ = x0;
+		y2_ = y1_;
+		y1_ = y0;
+		buffer.p[i] = y0;
+	}
+
+	x1 = x1_; x2 = x2_;
+	y1 = y1_; y2 = y2_;
+	e1 = e1_; e2 = e2_;
+}
+
+static uint32_t pack_q14(const float lo, const float hi) {
+	return __PKHBT(to_fixed<14>(lo), to_fixed<14>(hi), 16);
+}
+
+void IIRBiquadFilterQ15::configure(const iir_biquad_config_t& new_config) {
+	b0_b1 = pack_q14(new_config.b[0], new_config.b[1]);
+	b2_na1 = pack_q14(new_config.b[2], -new_config.a[1]);
+	na2 = to_fixed<14>(-new_config.a[2]);
+	x1 = x2 = y1 = y2 = 0;
+}
+
+void IIRBiquadFilterQ15::execute(const buffer_s16_t& buffer_in, const buffer_s16_t& buffer_out) {
+	auto x1_ = x1, x2_ = x2;
+	auto y1_ = y1, y2_ = y2;
+
+	for(size_t i=0; i<buffer_out.count; i++) {
+		const int16_t x0 = buffer_in.p[i];
+
+		// b0*x0 + b1*x1 + b2*x2 - a1*y1 - a2*y2
+		int32_t acc = __SMUAD(b0_b1, __PKHBT(x0, x1_, 16));
+		acc = __SMLAD(b2_na1, __PKHBT(x2_, y1_, 16), acc);
+		acc += na2 * y2_;
+		const int16_t y0 = __SSAT(acc >> 14, 16);
+
+		x2_ = x1_;
+		x1_ = x0;
+		y2_ = y1_;
+		y1_ = y0;
+		buffer_out.p[i] = y0;
+	}
+
+	x1 = x1_; x2 = x2_;
+	y1 = y1_; y2 = y2_;
+}
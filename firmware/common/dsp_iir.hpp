@@ -67,4 +67,64 @@ private:
 	std::array<float, 3> y { { 0.0f, 0.0f, 0.0f } };
 };
 
+/* Fixed-point biquad, direct form I, for int32 samples in any Q format with
+ * headroom for the filter's gain. Coefficients are Q30 (|c| < 2), products
+ * accumulate in 64 bits (SMLAL), so even the 30Hz high-pass poles at 48kHz
+ * are represented exactly enough.
+ */
+class IIRBiquadFilterQ31 {
+public:
+	IIRBiquadFilterQ31(
+	) : IIRBiquadFilterQ31(iir_config_no_pass)
+	{
+	}
+
+	IIRBiquadFilterQ31(
+		const iir_biquad_config_t& config
+	) {
+		configure(config);
+	}
+
+	void configure(const iir_biquad_config_t& new_config);
+
+	void execute_in_place(const buffer_s32_t& buffer);
+
+private:
+	std::array<int32_t, 3> b { };
+	std::array<int32_t, 3> a { };
+	int32_t x1 { 0 }, x2 { 0 };
+	int32_t y1 { 0 }, y2 { 0 };
+	int32_t e1 { 0 }, e2 { 0 };
+};
+
+/* Q15 biquad, direct form I, coefficients Q14 (|c| < 2). Two dual 16-bit
+ * MACs (SMLAD) and one MLA per sample, 32-bit accumulator: the sum of
+ * absolute coefficients must stay below 4 to rule out overflow. Good enough
+ * for detectors, not for audio.
+ */
+class IIRBiquadFilterQ15 {
+public:
+	IIRBiquadFilterQ15(
+	) : IIRBiquadFilterQ15(iir_config_no_pass)
+	{
+	}
+
+	IIRBiquadFilterQ15(
+		const iir_biquad_config_t& config
+	) {
+		configure(config);
+	}
+
+	void configure(const iir_biquad_config_t& new_config);
+
+	void execute(const buffer_s16_t& buffer_in, const buffer_s16_t& buffer_out);
+
+private:
+	uint32_t b0_b1 { 0 };
+	uint32_t b2_na1 { 0 };
+	int32_t na2 { 0 };
+	int16_t x1 { 0 }, x2 { 0 };
+	int16_t y1 { 0 }, y2 { 0 };
+};
+
 #endif/*__DSP_IIR_H__*/
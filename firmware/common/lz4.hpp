@@ -0,0 +1,43 @@
+/*
+ * Copyright (C) 2026 agent
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __LZ4_H__
+#define __LZ4_H__
+
+#include <cstdint>
+#include <cstddef>
+
+namespace lz4 {
+
+/* Decodes one LZ4 block (no frame header) from src into dst.
+ * Returns the number of bytes written, or 0 if the block is malformed or
+ * would overrun dst.
+ */
+size_t decompress_block(
+	const uint8_t* const src,
+	const size_t src_length,
+	uint8_t* const dst,
+	const size_t dst_capacity
+);
+
+} /* namespace lz4 */
+
+#endif/*__LZ4_H__*/
@@ -38,6 +38,7 @@
 #include "pocsag_packet.hpp"
 #include "sonde_packet.hpp"
 #include "tpms_packet.hpp"
+#include "nrf24_packet.hpp"
 #include "jammer.hpp"
 #include "dsp_fir_taps.hpp"
 #include "dsp_iir.hpp"
@@ -97,8 +98,6 @@ public:
 		WidebandSpectrumConfig = 42,
 		FSKConfigure = 43,
 		SSTVConfigure = 44,
-		SigGenConfig = 43,
-		SigGenTone = 44,
 		
 		POCSAGPacket = 45,
 		ADSBFrame = 46,
@@ -111,6 +110,18 @@ public:
 		AudioLevelReport = 51,
 		CodedSquelch = 52,
 		AudioSpectrum = 53,
+		SigGenConfig = 54,
+		SigGenTone = 55,
+		AudioProcessingConfig = 56,
+		PeakIndexDone = 57,
+		MemoryStatistics = 58,
+		PulseConfigure = 59,
+		PulseStatistics = 60,
+		VideoLineConfig = 61,
+		AX25Frame = 62,
+		BitstreamTXConfig = 63,
+		NRFPacket = 64,
+		NRFRxStatistics = 65,
 		MAX
 	};
 
@@ -132,9 +143,11 @@ struct RSSIStatistics {
 
 class RSSIStatisticsMessage : public Message {
 public:
+	static constexpr ID message_id = ID::RSSIStatistics;
+
 	constexpr RSSIStatisticsMessage(
 		const RSSIStatistics& statistics
-	) : Message { ID::RSSIStatistics },
+	) : Message { message_id },
 		statistics { statistics }
 	{
 	}
@@ -147,14 +160,18 @@ struct BasebandStatistics {
 	uint32_t main_ticks { 0 };
 	uint32_t rssi_ticks { 0 };
 	uint32_t baseband_ticks { 0 };
+	uint32_t samples_missed { 0 };		// Reused by the DMA before the baseband thread got to them
+	uint32_t samples_overwritten { 0 };	// Reused by the DMA while being processed
 	bool saturation { false };
 };
 
 class BasebandStatisticsMessage : public Message {
 public:
+	static constexpr ID message_id = ID::BasebandStatistics;
+
 	constexpr BasebandStatisticsMessage(
 		const BasebandStatistics& statistics
-	) : Message { ID::BasebandStatistics },
+	) : Message { message_id },
 		statistics { statistics }
 	{
 	}
@@ -177,9 +194,11 @@ struct ChannelStatistics {
 
 class ChannelStatisticsMessage : public Message {
 public:
+	static constexpr ID message_id = ID::ChannelStatistics;
+
 	constexpr ChannelStatisticsMessage(
 		const ChannelStatistics& statistics
-	) : Message { ID::ChannelStatistics },
+	) : Message { message_id },
 		statistics { statistics }
 	{
 	}
@@ -189,8 +208,10 @@ public:
 
 class DisplayFrameSyncMessage : public Message {
 public:
+	static constexpr ID message_id = ID::DisplayFrameSync;
+
 	constexpr DisplayFrameSyncMessage(
-	) : Message { ID::DisplayFrameSync }
+	) : Message { message_id }
 	{
 	}
 };
@@ -220,25 +241,31 @@ struct AudioStatistics {
 
 class DisplaySleepMessage : public Message {
 public:
+	static constexpr ID message_id = ID::DisplaySleep;
+
 	constexpr DisplaySleepMessage(
-	) : Message { ID::DisplaySleep }
+	) : Message { message_id }
 	{
 	}
 };
 
 class StatusRefreshMessage : public Message {
 public:
+	static constexpr ID message_id = ID::StatusRefresh;
+
 	constexpr StatusRefreshMessage(
-	) : Message { ID::StatusRefresh }
+	) : Message { message_id }
 	{
 	}
 };
 
 class AudioStatisticsMessage : public Message {
 public:
+	static constexpr ID message_id = ID::AudioStatistics;
+
 	constexpr AudioStatisticsMessage(
 		const AudioStatistics& statistics
-	) : Message { ID::AudioStatistics },
+	) : Message { message_id },
 		statistics { statistics }
 	{
 	}
@@ -248,6 +275,8 @@ public:
 
 class SpectrumStreamingConfigMessage : public Message {
 public:
+	static constexpr ID message_id = ID::SpectrumStreamingConfig;
+
 	enum class Mode : uint32_t {
 		Stopped = 0,
 		Running = 1,
@@ -255,7 +284,7 @@ public:
 
 	constexpr SpectrumStreamingConfigMessage(
 		Mode mode
-	) : Message { ID::SpectrumStreamingConfig },
+	) : Message { message_id },
 		mode { mode }
 	{
 	}
@@ -265,10 +294,12 @@ public:
 
 class WidebandSpectrumConfigMessage : public Message {
 public:
+	static constexpr ID message_id = ID::WidebandSpectrumConfig;
+
 	constexpr WidebandSpectrumConfigMessage (
 		size_t sampling_rate,
 		size_t trigger
-	) : Message { ID::WidebandSpectrumConfig },
+	) : Message { message_id },
 		sampling_rate { sampling_rate },
 		trigger { trigger }
 	{
@@ -285,9 +316,11 @@ struct AudioSpectrum {
 
 class AudioSpectrumMessage : public Message {
 public:
+	static constexpr ID message_id = ID::AudioSpectrum;
+
 	constexpr AudioSpectrumMessage(
 		AudioSpectrum* data
-	) : Message { ID::AudioSpectrum },
+	) : Message { message_id },
 		data { data }
 	{
 	}
@@ -306,11 +339,13 @@ using ChannelSpectrumFIFO = FIFO<ChannelSpectrum>;
 
 class ChannelSpectrumConfigMessage : public Message {
 public:
+	static constexpr ID message_id = ID::ChannelSpectrumConfig;
+
 	static constexpr size_t fifo_k = 2;
 	
 	constexpr ChannelSpectrumConfigMessage(
 		ChannelSpectrumFIFO* fifo
-	) : Message { ID::ChannelSpectrumConfig },
+	) : Message { message_id },
 		fifo { fifo }
 	{
 	}
@@ -318,11 +353,62 @@ public:
 	ChannelSpectrumFIFO* fifo { nullptr };
 };
 
+/* One synchronised, resampled line of AM TV video. Pixels are luminance,
+ * 0 = black. Lines are numbered from the first active line of the field.
+ */
+struct VideoLine {
+	static constexpr size_t pixel_count = 240;
+	static constexpr uint8_t flag_field_start = 1 << 0;
+	static constexpr uint8_t flag_unlocked = 1 << 1;	/* No horizontal sync, line is flywheel-timed */
+
+	uint16_t number { 0 };
+	uint8_t flags { 0 };
+	std::array<uint8_t, pixel_count> pixels { { 0 } };
+};
+
+using VideoLineFIFO = FIFO<VideoLine>;
+
+class VideoLineConfigMessage : public Message {
+public:
+	static constexpr ID message_id = ID::VideoLineConfig;
+
+	/* Drained once per display frame: holds a little over 1/60s of lines
+	 * at one 256-line field per 1/25s. */
+	static constexpr size_t fifo_k = 7;
+
+	constexpr VideoLineConfigMessage(
+		VideoLineFIFO* fifo
+	) : Message { message_id },
+		fifo { fifo }
+	{
+	}
+
+	VideoLineFIFO* fifo { nullptr };
+};
+
 class AISPacketMessage : public Message {
 public:
+	static constexpr ID message_id = ID::AISPacket;
+
 	constexpr AISPacketMessage(
 		const baseband::Packet& packet
-	) : Message { ID::AISPacket },
+	) : Message { message_id },
+		packet { packet }
+	{
+	}
+
+	baseband::Packet packet;
+};
+
+/* AX.25 frame with a good FCS: HDLC bits as received (unstuffed, LSB
+ * first), including the FCS and the first 7 bits of the closing flag */
+class AX25FrameMessage : public Message {
+public:
+	static constexpr ID message_id = ID::AX25Frame;
+
+	constexpr AX25FrameMessage(
+		const baseband::Packet& packet
+	) : Message { message_id },
 		packet { packet }
 	{
 	}
@@ -332,24 +418,34 @@ public:
 
 class TPMSPacketMessage : public Message {
 public:
+	static constexpr ID message_id = ID::TPMSPacket;
+
 	constexpr TPMSPacketMessage(
 		const tpms::SignalType signal_type,
+		const tpms::Coding coding,
+		const uint32_t candidates,
 		const baseband::Packet& packet
-	) : Message { ID::TPMSPacket },
+	) : Message { message_id },
 		signal_type { signal_type },
+		coding { coding },
+		candidates { candidates },
 		packet { packet }
 	{
 	}
 
 	tpms::SignalType signal_type;
+	tpms::Coding coding;
+	uint32_t candidates;		// Packets built by the M4 so far, valid or not
 	baseband::Packet packet;
 };
 
 class POCSAGPacketMessage : public Message {
 public:
+	static constexpr ID message_id = ID::POCSAGPacket;
+
 	constexpr POCSAGPacketMessage(
 		const pocsag::POCSAGPacket& packet
-	) : Message { ID::POCSAGPacket },
+	) : Message { message_id },
 		packet { packet }
 	{
 	}
@@ -359,9 +455,11 @@ public:
 
 class ACARSPacketMessage : public Message {
 public:
+	static constexpr ID message_id = ID::ACARSPacket;
+
 	constexpr ACARSPacketMessage(
 		const baseband::Packet& packet
-	) : Message { ID::ACARSPacket },
+	) : Message { message_id },
 		packet { packet }
 	{
 	}
@@ -371,9 +469,11 @@ public:
 
 class ADSBFrameMessage : public Message {
 public:
+	static constexpr ID message_id = ID::ADSBFrame;
+
 	constexpr ADSBFrameMessage(
 		const adsb::ADSBFrame& frame
-	) : Message { ID::ADSBFrame },
+	) : Message { message_id },
 		frame { frame }
 	{
 	}
@@ -383,10 +483,12 @@ public:
 
 class AFSKDataMessage : public Message {
 public:
+	static constexpr ID message_id = ID::AFSKData;
+
 	constexpr AFSKDataMessage(
 		const bool is_data,
 		const uint32_t value
-	) : Message { ID::AFSKData },
+	) : Message { message_id },
 		is_data { is_data },
 		value { value }
 	{
@@ -398,32 +500,52 @@ public:
 
 class CodedSquelchMessage : public Message {
 public:
+	static constexpr ID message_id = ID::CodedSquelch;
+
+	enum class Type : uint8_t {
+		None = 0,
+		CTCSS = 1,		// value = tone frequency * 100
+		DCS = 2,		// value = 9-bit code
+		RSSI = 3,		// value = RSSI, direction-finding mode
+	};
+
 	constexpr CodedSquelchMessage(
-		const bool enabled,
-		const uint32_t value
-	) : Message { ID::CodedSquelch },
-		enabled { enabled },
-		value { value }
+		const Type type,
+		const uint32_t value,
+		const uint8_t confidence = 0,
+		const bool inverted = false
+	) : Message { message_id },
+		type { type },
+		value { value },
+		confidence { confidence },
+		inverted { inverted }
 	{
 	}
-	bool enabled;
+
+	Type type;
 	uint32_t value;
+	uint8_t confidence;		// 0-100
+	bool inverted;			// DCS only
 };
 
 class ShutdownMessage : public Message {
 public:
+	static constexpr ID message_id = ID::Shutdown;
+
 	constexpr ShutdownMessage(
-	) : Message { ID::Shutdown }
+	) : Message { message_id }
 	{
 	}
 };
 
 class ERTPacketMessage : public Message {
 public:
+	static constexpr ID message_id = ID::ERTPacket;
+
 	constexpr ERTPacketMessage(
 		const ert::Packet::Type type,
 		const baseband::Packet& packet
-	) : Message { ID::ERTPacket },
+	) : Message { message_id },
 		type { type },
 		packet { packet }
 	{
@@ -436,10 +558,12 @@ public:
 
 class SondePacketMessage : public Message {
 public:
+	static constexpr ID message_id = ID::SondePacket;
+
 	constexpr SondePacketMessage(
 		const sonde::Packet::Type type,
 		const baseband::Packet& packet
-	) : Message { ID::SondePacket },
+	) : Message { message_id },
 		type { type },
 		packet { packet }
 	{
@@ -452,9 +576,11 @@ public:
 
 class TestAppPacketMessage : public Message {
 public:
+	static constexpr ID message_id = ID::TestAppPacket;
+
 	constexpr TestAppPacketMessage(
 		const baseband::Packet& packet
-	) : Message { ID::TestAppPacket },
+	) : Message { message_id },
 		packet { packet }
 	{
 	}
@@ -464,14 +590,18 @@ public:
 
 class UpdateSpectrumMessage : public Message {
 public:
+	static constexpr ID message_id = ID::UpdateSpectrum;
+
 	constexpr UpdateSpectrumMessage(
-	) : Message { ID::UpdateSpectrum }
+	) : Message { message_id }
 	{
 	}
 };
 
 class NBFMConfigureMessage : public Message {
 public:
+	static constexpr ID message_id = ID::NBFMConfigure;
+
 	constexpr NBFMConfigureMessage(
 		const fir_taps_real<24> decim_0_filter,
 		const fir_taps_real<32> decim_1_filter,
@@ -480,8 +610,9 @@ public:
 		const size_t deviation,
 		const iir_biquad_config_t audio_hpf_config,
 		const iir_biquad_config_t audio_deemph_config,
-		const uint8_t squelch_level
-	) : Message { ID::NBFMConfigure },
+		const uint8_t squelch_level,
+		const uint32_t tone_squelch = tone_squelch_off
+	) : Message { message_id },
 		decim_0_filter(decim_0_filter),
 		decim_1_filter(decim_1_filter),
 		channel_filter(channel_filter),
@@ -489,10 +620,15 @@ public:
 		deviation { deviation },
 		audio_hpf_config(audio_hpf_config),
 		audio_deemph_config(audio_deemph_config),
-		squelch_level(squelch_level)
+		squelch_level(squelch_level),
+		tone_squelch(tone_squelch)
 	{
 	}
 
+	// Tone squelch: off, open on any CTCSS/DCS, or a CTCSS frequency * 100.
+	static constexpr uint32_t tone_squelch_off = 0;
+	static constexpr uint32_t tone_squelch_any = 1;
+
 	const fir_taps_real<24> decim_0_filter;
 	const fir_taps_real<32> decim_1_filter;
 	const fir_taps_real<32> channel_filter;
@@ -501,10 +637,13 @@ public:
 	const iir_biquad_config_t audio_hpf_config;
 	const iir_biquad_config_t audio_deemph_config;
 	const uint8_t squelch_level;
+	const uint32_t tone_squelch;
 };
 
 class WFMConfigureMessage : public Message {
 public:
+	static constexpr ID message_id = ID::WFMConfigure;
+
 	constexpr WFMConfigureMessage(
 		const fir_taps_real<24> decim_0_filter,
 		const fir_taps_real<16> decim_1_filter,
@@ -512,7 +651,7 @@ public:
 		const size_t deviation,
 		const iir_biquad_config_t audio_hpf_config,
 		const iir_biquad_config_t audio_deemph_config
-	) : Message { ID::WFMConfigure },
+	) : Message { message_id },
 		decim_0_filter(decim_0_filter),
 		decim_1_filter(decim_1_filter),
 		audio_filter(audio_filter),
@@ -532,6 +671,8 @@ public:
 
 class AMConfigureMessage : public Message {
 public:
+	static constexpr ID message_id = ID::AMConfigure;
+
 	enum class Modulation : int32_t {
 		DSB = 0,
 		SSB = 1,
@@ -544,7 +685,7 @@ public:
 		const fir_taps_complex<64> channel_filter,
 		const Modulation modulation,
 		const iir_biquad_config_t audio_hpf_config
-	) : Message { ID::AMConfigure },
+	) : Message { message_id },
 		decim_0_filter(decim_0_filter),
 		decim_1_filter(decim_1_filter),
 		decim_2_filter(decim_2_filter),
@@ -567,6 +708,7 @@ class StreamBuffer {
 	uint8_t* data_;
 	size_t used_;
 	size_t capacity_;
+	bool segment_end_;
 
 public:
 	constexpr StreamBuffer(
@@ -574,7 +716,8 @@ public:
 		const size_t capacity = 0
 	) : data_ { static_cast<uint8_t*>(data) },
 		used_ { 0 },
-		capacity_ { capacity }
+		capacity_ { capacity },
+		segment_end_ { false }
 	{
 	}
 
@@ -616,26 +759,52 @@ public:
 		used_ = value;
 	}
 
+	/* Last buffer of a triggered capture burst, may be partly filled. */
+	bool is_segment_end() const {
+		return segment_end_;
+	}
+
+	void set_segment_end(const bool value) {
+		segment_end_ = value;
+	}
+
 	void empty() {
 		used_ = 0;
+		segment_end_ = false;
 	}
 };
 
+/* Squelch-style trigger for captures. When enabled, the baseband keeps a
+ * short pre-trigger history and only streams bursts: from channel power
+ * rising above threshold_db (dBFS) until it has stayed 3dB below it for
+ * hang_ms. Each burst ends with a StreamBuffer marked as segment end.
+ */
+struct CaptureTrigger {
+	bool enabled;
+	int32_t threshold_db;
+	uint32_t hang_ms;
+};
+
 struct CaptureConfig {
 	const size_t write_size;
 	const size_t buffer_count;
+	const CaptureTrigger trigger;
 	uint64_t baseband_bytes_received;
 	uint64_t baseband_bytes_dropped;
+	uint32_t segments;
 	FIFO<StreamBuffer*>* fifo_buffers_empty;
 	FIFO<StreamBuffer*>* fifo_buffers_full;
 
 	constexpr CaptureConfig(
 		const size_t write_size,
-		const size_t buffer_count
+		const size_t buffer_count,
+		const CaptureTrigger trigger = { false, 0, 0 }
 	) : write_size { write_size },
 		buffer_count { buffer_count },
+		trigger { trigger },
 		baseband_bytes_received { 0 },
 		baseband_bytes_dropped { 0 },
+		segments { 0 },
 		fifo_buffers_empty { nullptr },
 		fifo_buffers_full { nullptr }
 	{
@@ -653,9 +822,11 @@ struct CaptureConfig {
 
 class CaptureConfigMessage : public Message {
 public:
+	static constexpr ID message_id = ID::CaptureConfig;
+
 	constexpr CaptureConfigMessage(
 		CaptureConfig* const config
-	) : Message { ID::CaptureConfig },
+	) : Message { message_id },
 		config { config }
 	{
 	}
@@ -663,6 +834,23 @@ public:
 	CaptureConfig* const config;
 };
 
+/* Fixed-size record streamed to the application (and SD) by the pulse
+ * analysis mode, one per detected pulse. Times are in envelope samples, see
+ * PulseConfigureMessage::decimation.
+ */
+struct PulseDescriptor {
+	static constexpr uint16_t flag_truncated = 1 << 0;	/* Hit max_width, pulse continues */
+
+	uint32_t start;				/* Envelope samples since the mode was configured */
+	uint32_t width;				/* Envelope samples */
+	int32_t frequency_offset;	/* Hz, relative to the tuned frequency */
+	int8_t peak_db;				/* Envelope peak, dB full scale */
+	int8_t noise_floor_db;		/* Adaptive noise floor at pulse start, dB full scale */
+	uint16_t flags;
+};
+
+static_assert(sizeof(PulseDescriptor) == 16, "PulseDescriptor is a file format, keep it 16 bytes");
+
 struct ReplayConfig {
 	const size_t read_size;
 	const size_t buffer_count;
@@ -684,9 +872,11 @@ struct ReplayConfig {
 
 class ReplayConfigMessage : public Message {
 public:
+	static constexpr ID message_id = ID::ReplayConfig;
+
 	constexpr ReplayConfigMessage(
 		ReplayConfig* const config
-	) : Message { ID::ReplayConfig },
+	) : Message { message_id },
 		config { config }
 	{
 	}
@@ -696,44 +886,48 @@ public:
 
 class TXProgressMessage : public Message {
 public:
+	static constexpr ID message_id = ID::TXProgress;
+
 	constexpr TXProgressMessage(
-	) : Message { ID::TXProgress }
+	) : Message { message_id }
 	{
 	}
 	
 	uint32_t progress = 0;
 	bool done = false;
+	uint32_t underruns = 0;		// Blocks short of source data since start
 };
 
 class AFSKRxConfigureMessage : public Message {
 public:
+	static constexpr ID message_id = ID::AFSKRxConfigure;
+
 	constexpr AFSKRxConfigureMessage(
 		const uint32_t baudrate,
 		const uint32_t word_length,
-		const uint32_t trigger_value,
-		const bool trigger_word
-	) : Message { ID::AFSKRxConfigure },
+		const bool ax25
+	) : Message { message_id },
 		baudrate(baudrate),
 		word_length(word_length),
-		trigger_value(trigger_value),
-		trigger_word(trigger_word)
+		ax25(ax25)
 	{
 	}
 	
 	const uint32_t baudrate;
-	const uint32_t word_length;
-	const uint32_t trigger_value;
-	const bool trigger_word;
+	const uint32_t word_length;	// Serial mode only
+	const bool ax25;			// HDLC deframing instead of serial words
 };
 
 class BTLERxConfigureMessage : public Message {
 public:
+	static constexpr ID message_id = ID::BTLERxConfigure;
+
 	constexpr BTLERxConfigureMessage(
 		const uint32_t baudrate,
 		const uint32_t word_length,
 		const uint32_t trigger_value,
 		const bool trigger_word
-	) : Message { ID::BTLERxConfigure },
+	) : Message { message_id },
 		baudrate(baudrate),
 		word_length(word_length),
 		trigger_value(trigger_value),
@@ -749,31 +943,66 @@ public:
 
 class NRFRxConfigureMessage : public Message {
 public:
+	static constexpr ID message_id = ID::NRFRxConfigure;
+
 	constexpr NRFRxConfigureMessage(
-		const uint32_t baudrate,
-		const uint32_t word_length,
-		const uint32_t trigger_value,
-		const bool trigger_word
-	) : Message { ID::NRFRxConfigure },
-		baudrate(baudrate),
-		word_length(word_length),
-		trigger_value(trigger_value),
-		trigger_word(trigger_word)
+		const nrf24::DataRate data_rate,
+		const size_t address_count,
+		const std::array<nrf24::Address, nrf24::addresses_max>& addresses,
+		const uint32_t crc_width
+	) : Message { message_id },
+		data_rate(data_rate),
+		address_count(address_count),
+		addresses(addresses),
+		crc_width(crc_width)
 	{
 	}
 	
-	const uint32_t baudrate;
-	const uint32_t word_length;
-	const uint32_t trigger_value;
-	const bool trigger_word;
+	const nrf24::DataRate data_rate;
+	const size_t address_count;
+	const std::array<nrf24::Address, nrf24::addresses_max> addresses;
+	const uint32_t crc_width;		// Bytes, 0 tries 2 then 1
+};
+
+class NRFPacketMessage : public Message {
+public:
+	static constexpr ID message_id = ID::NRFPacket;
+
+	constexpr NRFPacketMessage(
+		const nrf24::Packet& packet
+	) : Message { message_id },
+		packet { packet }
+	{
+	}
+
+	nrf24::Packet packet;
+};
+
+class NRFRxStatisticsMessage : public Message {
+public:
+	static constexpr ID message_id = ID::NRFRxStatistics;
+
+	constexpr NRFRxStatisticsMessage(
+		const nrf24::DataRate data_rate,
+		const std::array<nrf24::RateStats, nrf24::data_rate_count>& rates
+	) : Message { message_id },
+		data_rate { data_rate },
+		rates { rates }
+	{
+	}
+
+	nrf24::DataRate data_rate;		// Rate listened to at the end of the second
+	std::array<nrf24::RateStats, nrf24::data_rate_count> rates;
 };
 
 class PitchRSSIConfigureMessage : public Message {
 public:
+	static constexpr ID message_id = ID::PitchRSSIConfigure;
+
 	constexpr PitchRSSIConfigureMessage(
 		const bool enabled,
 		const int32_t rssi
-	) : Message { ID::PitchRSSIConfigure },
+	) : Message { message_id },
 		enabled(enabled),
 		rssi(rssi)
 	{
@@ -783,15 +1012,34 @@ public:
 	const int32_t rssi;
 };
 
+class AudioProcessingConfigMessage : public Message {
+public:
+	static constexpr ID message_id = ID::AudioProcessingConfig;
+
+	constexpr AudioProcessingConfigMessage(
+		const bool agc,
+		const bool noise_blanker
+	) : Message { message_id },
+		agc(agc),
+		noise_blanker(noise_blanker)
+	{
+	}
+
+	const bool agc;
+	const bool noise_blanker;
+};
+
 class TonesConfigureMessage : public Message {
 public:
+	static constexpr ID message_id = ID::TonesConfigure;
+
 	constexpr TonesConfigureMessage(
 		const uint32_t fm_delta,
 		const uint32_t pre_silence,
 		const uint16_t tone_count,
 		const bool dual_tone,
 		const bool audio_out
-	) : Message { ID::TonesConfigure },
+	) : Message { message_id },
 		fm_delta(fm_delta),
 		pre_silence(pre_silence),
 		tone_count(tone_count),
@@ -809,9 +1057,11 @@ public:
 
 class RDSConfigureMessage : public Message {
 public:
+	static constexpr ID message_id = ID::RDSConfigure;
+
 	constexpr RDSConfigureMessage(
 		const uint16_t length
-	) : Message { ID::RDSConfigure },
+	) : Message { message_id },
 		length(length)
 	{
 	}
@@ -821,8 +1071,10 @@ public:
 
 class RetuneMessage : public Message {
 public:
+	static constexpr ID message_id = ID::Retune;
+
 	constexpr RetuneMessage(
-	) : Message { ID::Retune }
+	) : Message { message_id }
 	{
 	}
 	
@@ -832,9 +1084,11 @@ public:
 
 class SamplerateConfigMessage : public Message {
 public:
+	static constexpr ID message_id = ID::SamplerateConfig;
+
 	constexpr SamplerateConfigMessage(
 		const uint32_t sample_rate
-	) : Message { ID::SamplerateConfig },
+	) : Message { message_id },
 		sample_rate(sample_rate)
 	{
 	}
@@ -842,10 +1096,58 @@ public:
 	const uint32_t sample_rate = 0;
 };
 
+class PulseConfigureMessage : public Message {
+public:
+	static constexpr ID message_id = ID::PulseConfigure;
+
+	constexpr PulseConfigureMessage(
+		const uint32_t decimation,
+		const int32_t threshold_db,
+		const uint32_t min_width,
+		const uint32_t max_width
+	) : Message { message_id },
+		decimation(decimation),
+		threshold_db(threshold_db),
+		min_width(min_width),
+		max_width(max_width)
+	{
+	}
+
+	const uint32_t decimation;		/* Channel samples per envelope sample */
+	const int32_t threshold_db;		/* Pulse start, dB above the noise floor */
+	const uint32_t min_width;		/* Envelope samples, shorter pulses are dropped */
+	const uint32_t max_width;		/* Envelope samples, longer pulses are split */
+};
+
+class PulseStatisticsMessage : public Message {
+public:
+	static constexpr ID message_id = ID::PulseStatistics;
+
+	constexpr PulseStatisticsMessage(
+		const uint32_t envelope_rate,
+		const uint32_t pulse_count,
+		const int32_t noise_floor_db,
+		const PulseDescriptor last_pulse
+	) : Message { message_id },
+		envelope_rate(envelope_rate),
+		pulse_count(pulse_count),
+		noise_floor_db(noise_floor_db),
+		last_pulse(last_pulse)
+	{
+	}
+
+	const uint32_t envelope_rate;
+	const uint32_t pulse_count;
+	const int32_t noise_floor_db;
+	const PulseDescriptor last_pulse;
+};
+
 class AudioLevelReportMessage : public Message {
 public:
+	static constexpr ID message_id = ID::AudioLevelReport;
+
 	constexpr AudioLevelReportMessage(
-	) : Message { ID::AudioLevelReport }
+	) : Message { message_id }
 	{
 	}
 	
@@ -854,18 +1156,22 @@ public:
 
 class AudioTXConfigMessage : public Message {
 public:
+	static constexpr ID message_id = ID::AudioTXConfig;
+
 	constexpr AudioTXConfigMessage(
 		const uint32_t divider,
 		const float deviation_hz,
 		const float audio_gain,
 		const uint32_t tone_key_delta,
-		const float tone_key_mix_weight
-	) : Message { ID::AudioTXConfig },
+		const float tone_key_mix_weight,
+		const uint8_t bits_per_sample = 8
+	) : Message { message_id },
 		divider(divider),
 		deviation_hz(deviation_hz),
 		audio_gain(audio_gain),
 		tone_key_delta(tone_key_delta),
-		tone_key_mix_weight(tone_key_mix_weight)
+		tone_key_mix_weight(tone_key_mix_weight),
+		bits_per_sample(bits_per_sample)
 	{
 	}
 
@@ -874,15 +1180,18 @@ public:
 	const float audio_gain;
 	const uint32_t tone_key_delta;
 	const float tone_key_mix_weight;
+	const uint8_t bits_per_sample;		// 8 (unsigned) or 16 (signed) mono
 };
 
 class SigGenConfigMessage : public Message {
 public:
+	static constexpr ID message_id = ID::SigGenConfig;
+
 	constexpr SigGenConfigMessage(
 		const uint32_t bw,
 		const uint32_t shape,
 		const uint32_t duration
-	) : Message { ID::SigGenConfig },
+	) : Message { message_id },
 		bw(bw),
 		shape(shape),
 		duration(duration)
@@ -896,9 +1205,11 @@ public:
 
 class SigGenToneMessage : public Message {
 public:
+	static constexpr ID message_id = ID::SigGenTone;
+
 	constexpr SigGenToneMessage(
 		const uint32_t tone_delta
-	) : Message { ID::SigGenTone },
+	) : Message { message_id },
 		tone_delta(tone_delta)
 	{
 	}
@@ -908,6 +1219,8 @@ public:
 
 class AFSKTxConfigureMessage : public Message {
 public:
+	static constexpr ID message_id = ID::AFSKTxConfigure;
+
 	constexpr AFSKTxConfigureMessage(
 		const uint32_t samples_per_bit,
 		const uint32_t phase_inc_mark,
@@ -915,7 +1228,7 @@ public:
 		const uint8_t repeat,
 		const uint32_t fm_delta,
 		const uint8_t symbol_count
-	) : Message { ID::AFSKTxConfigure },
+	) : Message { message_id },
 		samples_per_bit(samples_per_bit),
 		phase_inc_mark(phase_inc_mark),
 		phase_inc_space(phase_inc_space),
@@ -935,12 +1248,14 @@ public:
 
 class OOKConfigureMessage : public Message {
 public:
+	static constexpr ID message_id = ID::OOKConfigure;
+
 	constexpr OOKConfigureMessage(
 		const uint32_t stream_length,
 		const uint32_t samples_per_bit,
 		const uint8_t repeat,
 		const uint32_t pause_symbols
-	) : Message { ID::OOKConfigure },
+	) : Message { message_id },
 		stream_length(stream_length),
 		samples_per_bit(samples_per_bit),
 		repeat(repeat),
@@ -954,12 +1269,55 @@ public:
 	const uint32_t pause_symbols;
 };
 
+class BitstreamTXConfigMessage : public Message {
+public:
+	static constexpr ID message_id = ID::BitstreamTXConfig;
+
+	enum class Modulation : uint8_t {
+		OOK = 0,
+		FSK,		// +/- deviation_hz around the carrier
+		AFSK		// space_hz/mark_hz tones FM modulated with deviation_hz
+	};
+
+	constexpr BitstreamTXConfigMessage(
+		const Modulation modulation,
+		const uint32_t samples_per_symbol,
+		const uint32_t shaping_samples,
+		const uint32_t symbol_count,
+		const uint32_t progress_symbols,
+		const uint32_t deviation_hz = 0,
+		const uint32_t mark_hz = 0,
+		const uint32_t space_hz = 0
+	) : Message { message_id },
+		modulation(modulation),
+		samples_per_symbol(samples_per_symbol),
+		shaping_samples(shaping_samples),
+		symbol_count(symbol_count),
+		progress_symbols(progress_symbols),
+		deviation_hz(deviation_hz),
+		mark_hz(mark_hz),
+		space_hz(space_hz)
+	{
+	}
+
+	const Modulation modulation;
+	const uint32_t samples_per_symbol;
+	const uint32_t shaping_samples;		// Raised-cosine transition, 0 for hard keying
+	const uint32_t symbol_count;		// 0: send until the stream is stopped
+	const uint32_t progress_symbols;	// TXProgress interval, 0 for none
+	const uint32_t deviation_hz;
+	const uint32_t mark_hz;
+	const uint32_t space_hz;
+};
+
 class SSTVConfigureMessage : public Message {
 public:
+	static constexpr ID message_id = ID::SSTVConfigure;
+
 	constexpr SSTVConfigureMessage(
 		const uint8_t vis_code,
 		const uint32_t pixel_duration
-	) : Message { ID::SSTVConfigure },
+	) : Message { message_id },
 		vis_code(vis_code),
 		pixel_duration(pixel_duration)
 	{
@@ -971,12 +1329,14 @@ public:
 
 class FSKConfigureMessage : public Message {
 public:
+	static constexpr ID message_id = ID::FSKConfigure;
+
 	constexpr FSKConfigureMessage(
 		const uint32_t stream_length,
 		const uint32_t samples_per_bit,
 		const uint32_t shift,
 		const uint32_t progress_notice
-	) : Message { ID::FSKConfigure },
+	) : Message { message_id },
 		stream_length(stream_length),
 		samples_per_bit(samples_per_bit),
 		shift(shift),
@@ -992,10 +1352,12 @@ public:
 
 class POCSAGConfigureMessage : public Message {
 public:
+	static constexpr ID message_id = ID::POCSAGConfigure;
+
 	constexpr POCSAGConfigureMessage(
 		const pocsag::BitRate bitrate,
 		const bool phase
-	) : Message { ID::POCSAGConfigure },
+	) : Message { message_id },
 		bitrate(bitrate),
 		phase(phase)
 	{
@@ -1007,9 +1369,11 @@ public:
 
 class ADSBConfigureMessage : public Message {
 public:
+	static constexpr ID message_id = ID::ADSBConfigure;
+
 	constexpr ADSBConfigureMessage(
 		const uint32_t test
-	) : Message { ID::ADSBConfigure },
+	) : Message { message_id },
 		test(test)
 	{
 	}
@@ -1019,11 +1383,13 @@ public:
 
 class JammerConfigureMessage : public Message {
 public:
+	static constexpr ID message_id = ID::JammerConfigure;
+
 	constexpr JammerConfigureMessage(
 		const bool run,
 		const jammer::JammerType type,
 		const uint32_t speed
-	) : Message { ID::JammerConfigure },
+	) : Message { message_id },
 		run(run),
 		type(type),
 		speed(speed)
@@ -1037,11 +1403,13 @@ public:
 
 class DTMFTXConfigMessage : public Message {
 public:
+	static constexpr ID message_id = ID::DTMFTXConfig;
+
 	constexpr DTMFTXConfigMessage(
 		const uint32_t bw,
 		const uint32_t tone_length,
 		const uint32_t pause_length
-	) : Message { ID::DTMFTXConfig },
+	) : Message { message_id },
 		bw(bw),
 		tone_length(tone_length),
 		pause_length(pause_length)
@@ -1057,6 +1425,8 @@ public:
 // TODO: rename (not only used for requests)
 class RequestSignalMessage : public Message {
 public:
+	static constexpr ID message_id = ID::RequestSignal;
+
 	enum class Signal : char {
 		FillRequest = 1,
 		BeepRequest = 2,
@@ -1065,7 +1435,7 @@ public:
 
 	constexpr RequestSignalMessage(
 		Signal signal
-	) : Message { ID::RequestSignal },
+	) : Message { message_id },
 		signal ( signal )
 	{
 	}
@@ -1075,9 +1445,11 @@ public:
 
 class FIFODataMessage : public Message {
 public:
+	static constexpr ID message_id = ID::FIFOData;
+
 	constexpr FIFODataMessage(
 		const int8_t * data
-	) : Message { ID::FIFOData },
+	) : Message { message_id },
 		data ( data )
 	{
 	}
@@ -1087,9 +1459,11 @@ public:
 
 class CaptureThreadDoneMessage : public Message {
 public:
+	static constexpr ID message_id = ID::CaptureThreadDone;
+
 	constexpr CaptureThreadDoneMessage(
 		uint32_t error = 0
-	) : Message { ID::CaptureThreadDone },
+	) : Message { message_id },
 		error { error }
 	{
 	}
@@ -1099,9 +1473,11 @@ public:
 
 class ReplayThreadDoneMessage : public Message {
 public:
+	static constexpr ID message_id = ID::ReplayThreadDone;
+
 	constexpr ReplayThreadDoneMessage(
 		uint32_t return_code = 0
-	) : Message { ID::ReplayThreadDone },
+	) : Message { message_id },
 		return_code { return_code }
 	{
 	}
@@ -1109,4 +1485,144 @@ public:
 	uint32_t return_code;
 };
 
+class PeakIndexDoneMessage : public Message {
+public:
+	static constexpr ID message_id = ID::PeakIndexDone;
+
+	constexpr PeakIndexDoneMessage(
+		bool success = false
+	) : Message { message_id },
+		success { success }
+	{
+	}
+
+	bool success;
+};
+
+struct StackStatistics {
+	uint32_t size { 0 };
+	uint32_t unused { 0 };
+};
+
+struct MemoryStatistics {
+	enum Stack {
+		StackMain = 0,
+		StackIRQ = 1,
+		StackBaseband = 2,
+		StackRSSI = 3,
+		StackCount
+	};
+
+	bool valid { false };
+	uint32_t heap_size { 0 };
+	uint32_t heap_used { 0 };
+	uint32_t heap_high_water { 0 };
+	uint32_t heap_largest_free { 0 };
+	uint32_t heap_fragments { 0 };
+	std::array<StackStatistics, StackCount> stacks { };
+};
+
+/* Sent to the M4, which fills in *statistics before acknowledging. */
+class MemoryStatisticsMessage : public Message {
+public:
+	static constexpr ID message_id = ID::MemoryStatistics;
+
+	constexpr MemoryStatisticsMessage(
+		MemoryStatistics* const statistics
+	) : Message { message_id },
+		statistics { statistics }
+	{
+	}
+
+	MemoryStatistics* const statistics;
+};
+
+/* Every message type must be listed here, so that two types sharing a
+ * Message::ID (and so the same handler slot) fails to compile. */
+template<typename... Ts>
+struct MessageTypeList {
+	static constexpr bool ids_unique() {
+		const Message::ID ids[] { Ts::message_id... };
+		for(size_t i=0; i<sizeof...(Ts); i++) {
+			if( ids[i] >= Message::ID::MAX ) {
+				return false;
+			}
+			for(size_t j=i+1; j<sizeof...(Ts); j++) {
+				if( ids[i] == ids[j] ) {
+					return false;
+				}
+			}
+		}
+		return true;
+	}
+};
+
+using MessageTypes = MessageTypeList<
+	RSSIStatisticsMessage,
+	BasebandStatisticsMessage,
+	ChannelStatisticsMessage,
+	DisplayFrameSyncMessage,
+	DisplaySleepMessage,
+	StatusRefreshMessage,
+	AudioStatisticsMessage,
+	SpectrumStreamingConfigMessage,
+	WidebandSpectrumConfigMessage,
+	AudioSpectrumMessage,
+	ChannelSpectrumConfigMessage,
+	AISPacketMessage,
+	TPMSPacketMessage,
+	POCSAGPacketMessage,
+	ACARSPacketMessage,
+	ADSBFrameMessage,
+	AFSKDataMessage,
+	CodedSquelchMessage,
+	ShutdownMessage,
+	ERTPacketMessage,
+	SondePacketMessage,
+	TestAppPacketMessage,
+	UpdateSpectrumMessage,
+	NBFMConfigureMessage,
+	WFMConfigureMessage,
+	AMConfigureMessage,
+	CaptureConfigMessage,
+	ReplayConfigMessage,
+	TXProgressMessage,
+	AFSKRxConfigureMessage,
+	BTLERxConfigureMessage,
+	NRFRxConfigureMessage,
+	PitchRSSIConfigureMessage,
+	TonesConfigureMessage,
+	RDSConfigureMessage,
+	RetuneMessage,
+	SamplerateConfigMessage,
+	AudioLevelReportMessage,
+	AudioTXConfigMessage,
+	SigGenConfigMessage,
+	SigGenToneMessage,
+	AFSKTxConfigureMessage,
+	OOKConfigureMessage,
+	SSTVConfigureMessage,
+	FSKConfigureMessage,
+	POCSAGConfigureMessage,
+	ADSBConfigureMessage,
+	JammerConfigureMessage,
+	DTMFTXConfigMessage,
+	RequestSignalMessage,
+	FIFODataMessage,
+	CaptureThreadDoneMessage,
+	ReplayThreadDoneMessage,
+	AudioProcessingConfigMessage,
+	PeakIndexDoneMessage,
+	MemoryStatisticsMessage,
+	PulseConfigureMessage,
+	PulseStatisticsMessage,
+	VideoLineConfigMessage,
+	AX25FrameMessage,
+	BitstreamTXConfigMessage,
+	NRFPacketMessage,
+	NRFRxStatisticsMessage
+>;
+
+static_assert(MessageTypes::ids_unique(), "Message::ID used by more than one message type");
+
 #endif/*__MESSAGE_H__*/
@@ -28,10 +28,18 @@ using namespace lpc43xx;
 void MessageQueue::signal() {
 	creg::m0apptxevent::assert();
 }
+
+void SPSCMessageQueue::signal() {
+	creg::m0apptxevent::assert();
+}
 #endif
 
 #if defined(LPC43XX_M4)
 void MessageQueue::signal() {
 	creg::m4txevent::assert();
 }
+
+void SPSCMessageQueue::signal() {
+	creg::m4txevent::assert();
+}
 #endif
@@ -23,6 +23,7 @@
 #define __MESSAGE_QUEUE_H__
 
 #include <cstdint>
+#include <algorithm>
 
 #include "message.hpp"
 #include "fifo.hpp"
@@ -51,16 +52,6 @@ public:
 		return push(&message, sizeof(message));
 	}
 
-	template<typename T>
-	bool push_and_wait(const T& message) {
-		const bool result = push(message);
-		if( result ) {
-			// TODO: More graceful method of waiting for empty? Maybe sleep for a bit?
-			while( !is_empty() );
-		}
-		return result;
-	}
-
 	template<typename HandlerFn>
 	void handle(HandlerFn handler) {
 		std::array<uint8_t, Message::MAX_SIZE> message_buffer;
@@ -115,4 +106,96 @@ private:
 	void signal();
 };
 
+struct MessageQueueStatistics {
+	uint32_t pushed { 0 };
+	uint32_t dropped { 0 };
+	uint32_t depth_max { 0 };
+};
+
+/* Single-producer/single-consumer message queue for crossing between cores.
+ * The consumer never locks: a record becomes visible in one store to the FIFO
+ * input index, after the payload has been written out. The producer side is a
+ * single core; threads on that core are serialized by a short kernel critical
+ * section instead of a mutex.
+ */
+class SPSCMessageQueue {
+public:
+	SPSCMessageQueue() = delete;
+	SPSCMessageQueue(const SPSCMessageQueue&) = delete;
+	SPSCMessageQueue(SPSCMessageQueue&&) = delete;
+
+	SPSCMessageQueue(
+		uint8_t* const data,
+		size_t k
+	) : fifo { data, k }
+	{
+	}
+
+	template<typename T>
+	bool push(const T& message) {
+		static_assert(sizeof(T) <= Message::MAX_SIZE, "Message::MAX_SIZE too small for message type");
+		static_assert(std::is_base_of<Message, T>::value, "type is not based on Message");
+
+		return push(&message, sizeof(message));
+	}
+
+	template<typename HandlerFn>
+	void handle(HandlerFn handler) {
+		std::array<uint8_t, Message::MAX_SIZE> message_buffer;
+		while(Message* const message = peek(message_buffer)) {
+			handler(message);
+			skip();
+		}
+	}
+
+	bool is_empty() const {
+		return fifo.is_empty();
+	}
+
+	size_t depth() const {
+		return fifo.len();
+	}
+
+	MessageQueueStatistics statistics() const {
+		return stats;
+	}
+
+	void reset() {
+		fifo.reset();
+		stats = { };
+	}
+
+private:
+	FIFO<uint8_t> fifo;
+	MessageQueueStatistics stats { };
+
+	Message* peek(std::array<uint8_t, Message::MAX_SIZE>& buf) {
+		Message* const p = reinterpret_cast<Message*>(buf.data());
+		return fifo.peek_r(buf.data(), buf.size()) ? p : nullptr;
+	}
+
+	bool skip() {
+		return fifo.skip();
+	}
+
+	bool push(const void* const buf, const size_t len) {
+		chSysLock();
+		const bool success = (fifo.in_r(buf, len) == len);
+		if( success ) {
+			stats.pushed++;
+			stats.depth_max = std::max<uint32_t>(stats.depth_max, fifo.len());
+		} else {
+			stats.dropped++;
+		}
+		chSysUnlock();
+
+		if( success ) {
+			signal();
+		}
+		return success;
+	}
+
+	void signal();
+};
+
 #endif/*__MESSAGE_QUEUE_H__*/
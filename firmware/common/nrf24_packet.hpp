@@ -0,0 +1,73 @@
+/*
+ * Copyright (C) 2026 agent
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __NRF24_PACKET_H__
+#define __NRF24_PACKET_H__
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+
+namespace nrf24 {
+
+enum class DataRate : uint32_t {
+	Rate250k = 0,
+	Rate1M = 1,
+	Rate2M = 2,
+	Auto = 3,		// Configuration only: cycle through the rates until packets show up
+};
+
+constexpr size_t data_rate_count = 3;
+
+/* Addresses are 3 to 5 bytes, held in on-air order: the MSB of the lowest
+ * width * 8 bits of value is the first bit after the preamble. */
+struct Address {
+	uint64_t value;
+	uint32_t width;
+};
+
+constexpr size_t addresses_max = 4;
+constexpr size_t payload_max = 32;
+
+/* Enhanced ShockBurst packet, after address match and CRC check:
+ * preamble, address, 9-bit packet control field, payload, CRC. The packet
+ * control field is 6 bits of payload length, 2 of PID and a no-ACK flag. */
+struct Packet {
+	DataRate data_rate;
+	Address address;
+	uint8_t pid;
+	bool no_ack;
+	uint8_t crc_width;		// Bytes
+	uint8_t length;
+	std::array<uint8_t, payload_max> payload;
+};
+
+/* Counts for one second of reception at one data rate. Syncs are preamble
+ * and address matches. Those that fail the length or CRC check are errors. */
+struct RateStats {
+	uint32_t syncs;
+	uint32_t packets;
+	uint32_t crc_errors;
+};
+
+} /* namespace nrf24 */
+
+#endif/*__NRF24_PACKET_H__*/
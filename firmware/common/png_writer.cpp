@@ -21,6 +21,9 @@
 
 #include "png_writer.hpp"
 
+#include <algorithm>
+#include <cstdlib>
+
 static constexpr std::array<uint8_t, 8> png_file_header { {
 	0x89, 0x50, 0x4e, 0x47,
 	0x0d, 0x0a, 0x1a, 0x0a,
@@ -49,6 +52,20 @@ static constexpr std::array<uint8_t, 12> png_iend { {
 	0xae, 0x42, 0x60, 0x82,		// CRC
 } };
 
+/* Deflate length codes 257..285: base lengths and extra bit counts. */
+static constexpr std::array<uint16_t, 29> deflate_length_base { {
+	3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+	35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258,
+} };
+
+static constexpr std::array<uint8_t, 29> deflate_length_extra { {
+	0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+	3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0,
+} };
+
+static constexpr size_t deflate_match_min { 3 };
+static constexpr size_t deflate_match_max { 258 };
+
 Optional<File::Error> PNGWriter::create(
 	const std::filesystem::path& filename
 ) {
@@ -59,51 +76,186 @@ Optional<File::Error> PNGWriter::create(
 
 	file.write(png_file_header);
 	file.write(png_ihdr_screen_capture);
-	
-	write_chunk_header(
-		2 + height * (5 + 1 + width * 3) + 4,
-		png_idat_chunk_type
-	);
 
-	constexpr std::array<uint8_t, 2> zlib_header { 0x78, 0x01 };	// Zlib CM, CINFO, FLG.
-	write_chunk_content(zlib_header);
+	// Zlib CM, CINFO, FLG.
+	put_byte(0x78);
+	put_byte(0x01);
+
+	// The whole image is a single fixed-Huffman DEFLATE block: bfinal=1, btype=01.
+	put_bits(0b011, 3);
 
 	return { };
 }
 
 PNGWriter::~PNGWriter() {
-	write_chunk_content(adler_32.bytes());
-	write_chunk_crc();
+	put_symbol(256);	// End of block
+	flush_bits();
+
+	for(const auto b : adler_32.bytes()) {
+		put_byte(b);
+	}
+	flush_idat();
 
 	file.write(png_iend);
 }
 
 void PNGWriter::write_scanline(const std::array<ui::ColorRGB888, 240>& scanline) {
-	constexpr uint8_t scanline_filter_type = 0;
-	constexpr uint32_t deflate_block_length = 1 + sizeof(scanline);
-
-	const std::array<uint8_t, 6> deflate_and_scanline_header {
-		static_cast<uint8_t>((scanline_count == (height - 1)) ? 0x01 : 0x00),	// DEFLATE header bits, bfinal=0, btype=00
-		static_cast<uint8_t>((deflate_block_length >> 0) & 0xff),			// Length LSB
-		static_cast<uint8_t>((deflate_block_length >> 8) & 0xff),			// Length MSB
-		static_cast<uint8_t>((deflate_block_length >> 0) & 0xff) ^ 0xff,	// ~Length LSB
-		static_cast<uint8_t>((deflate_block_length >> 8) & 0xff) ^ 0xff,	// ~Length MSB
-		scanline_filter_type,
-	};
-	write_chunk_content(deflate_and_scanline_header);
-
-	adler_32.feed(scanline_filter_type);
-	adler_32.feed(scanline);
-
-	// Small writes to avoid some sort of large-transfer plus block
-	// boundary FatFs or SDC driver bug?
-	write_chunk_content(&scanline[  0], 80 * sizeof(ui::ColorRGB888));
-	write_chunk_content(&scanline[ 80], 80 * sizeof(ui::ColorRGB888));
-	write_chunk_content(&scanline[160], 80 * sizeof(ui::ColorRGB888));
+	const auto row = reinterpret_cast<const uint8_t*>(scanline.data());
+
+	filter_scanline(row, choose_filter(row));
+	adler_32.feed(filtered);
+	deflate(filtered.data(), filtered.size());
 
+	std::copy(row, row + scanline_bytes, previous_scanline.begin());
 	scanline_count++;
 }
 
+/* Usual PNG encoder heuristic: pick the filter with the smallest sum of
+ * absolute (signed) residuals.
+ */
+PNGWriter::Filter PNGWriter::choose_filter(const uint8_t* const row) const {
+	uint32_t sum_none = 0;
+	uint32_t sum_sub = 0;
+	uint32_t sum_up = 0;
+
+	for(size_t i=0; i<scanline_bytes; i++) {
+		const uint8_t left = (i >= bytes_per_pixel) ? row[i - bytes_per_pixel] : 0;
+		sum_none += std::abs(static_cast<int8_t>(row[i]));
+		sum_sub += std::abs(static_cast<int8_t>(row[i] - left));
+		sum_up += std::abs(static_cast<int8_t>(row[i] - previous_scanline[i]));
+	}
+
+	if( (sum_sub <= sum_up) && (sum_sub <= sum_none) ) {
+		return Filter::Sub;
+	}
+	return (sum_up <= sum_none) ? Filter::Up : Filter::None;
+}
+
+void PNGWriter::filter_scanline(const uint8_t* const row, const Filter filter) {
+	filtered[0] = static_cast<uint8_t>(filter);
+
+	for(size_t i=0; i<scanline_bytes; i++) {
+		uint8_t predictor = 0;
+		if( filter == Filter::Sub ) {
+			predictor = (i >= bytes_per_pixel) ? row[i - bytes_per_pixel] : 0;
+		} else if( filter == Filter::Up ) {
+			predictor = previous_scanline[i];
+		}
+		filtered[1 + i] = row[i] - predictor;
+	}
+}
+
+/* Run-length flavoured LZ77: only looks back one byte (runs of the same
+ * byte) or one pixel (runs of the same colour), which is where nearly all the
+ * redundancy in a filtered UI screenshot is. Matches stay within the row.
+ */
+void PNGWriter::deflate(const uint8_t* const data, const size_t length) {
+	size_t i = 0;
+	while( i < length ) {
+		size_t best_length = 0;
+		size_t best_distance = 0;
+
+		for(const size_t distance : { size_t(1), bytes_per_pixel }) {
+			if( i < distance ) {
+				continue;
+			}
+			const size_t limit = std::min(length - i, deflate_match_max);
+			size_t n = 0;
+			while( (n < limit) && (data[i + n] == data[i + n - distance]) ) {
+				n++;
+			}
+			if( n > best_length ) {
+				best_length = n;
+				best_distance = distance;
+			}
+		}
+
+		if( best_length >= deflate_match_min ) {
+			put_match(best_length, best_distance);
+			i += best_length;
+		} else {
+			put_literal(data[i]);
+			i++;
+		}
+	}
+}
+
+void PNGWriter::put_literal(const uint8_t value) {
+	put_symbol(value);
+}
+
+void PNGWriter::put_match(const size_t length, const size_t distance) {
+	size_t code = deflate_length_base.size() - 1;
+	while( deflate_length_base[code] > length ) {
+		code--;
+	}
+	put_symbol(257 + code);
+	put_bits(length - deflate_length_base[code], deflate_length_extra[code]);
+
+	// Fixed 5-bit distance codes 0..3 are distances 1..4, no extra bits.
+	put_huffman(distance - 1, 5);
+}
+
+/* Fixed Huffman literal/length code (RFC 1951, 3.2.6). */
+void PNGWriter::put_symbol(const uint32_t symbol) {
+	if( symbol < 144 ) {
+		put_huffman(0x30 + symbol, 8);
+	} else if( symbol < 256 ) {
+		put_huffman(0x190 + (symbol - 144), 9);
+	} else if( symbol < 280 ) {
+		put_huffman(symbol - 256, 7);
+	} else {
+		put_huffman(0xc0 + (symbol - 280), 8);
+	}
+}
+
+/* Huffman codes are packed starting from their most significant bit. */
+void PNGWriter::put_huffman(const uint32_t code, const size_t length) {
+	uint32_t reversed = 0;
+	for(size_t i=0; i<length; i++) {
+		reversed = (reversed << 1) | ((code >> i) & 1);
+	}
+	put_bits(reversed, length);
+}
+
+void PNGWriter::put_bits(const uint32_t bits, const size_t length) {
+	bit_buffer |= bits << bit_count;
+	bit_count += length;
+	while( bit_count >= 8 ) {
+		put_byte(bit_buffer & 0xff);
+		bit_buffer >>= 8;
+		bit_count -= 8;
+	}
+}
+
+void PNGWriter::flush_bits() {
+	if( bit_count > 0 ) {
+		put_byte(bit_buffer & 0xff);
+	}
+	bit_buffer = 0;
+	bit_count = 0;
+}
+
+void PNGWriter::put_byte(const uint8_t value) {
+	idat_buffer[idat_length++] = value;
+	if( idat_length == idat_buffer.size() ) {
+		flush_idat();
+	}
+}
+
+/* The zlib stream may be split across any number of IDAT chunks, which
+ * avoids needing the compressed length up front. */
+void PNGWriter::flush_idat() {
+	if( idat_length == 0 ) {
+		return;
+	}
+
+	write_chunk_header(idat_length, png_idat_chunk_type);
+	write_chunk_content(idat_buffer.data(), idat_length);
+	write_chunk_crc();
+	idat_length = 0;
+}
+
 void PNGWriter::write_chunk_header(
 	const size_t length,
 	const std::array<uint8_t, 4>& type
@@ -44,11 +44,41 @@ private:
 	static constexpr int width { 240 };
 	static constexpr int height { 320 };
 
+	static constexpr size_t scanline_bytes { width * 3 };
+	static constexpr size_t bytes_per_pixel { 3 };
+
+	enum class Filter : uint8_t {
+		None = 0,
+		Sub = 1,
+		Up = 2,
+	};
+
 	File file { };
 	int scanline_count { 0 };
 	CRC<32, true, true> crc { 0x04c11db7, 0xffffffff, 0xffffffff };
 	Adler32 adler_32 { };
 
+	std::array<uint8_t, scanline_bytes> previous_scanline { };
+	std::array<uint8_t, 1 + scanline_bytes> filtered { };
+
+	std::array<uint8_t, 512> idat_buffer { };
+	size_t idat_length { 0 };
+	uint32_t bit_buffer { 0 };
+	size_t bit_count { 0 };
+
+	Filter choose_filter(const uint8_t* const row) const;
+	void filter_scanline(const uint8_t* const row, const Filter filter);
+
+	void deflate(const uint8_t* const data, const size_t length);
+	void put_literal(const uint8_t value);
+	void put_match(const size_t length, const size_t distance);
+	void put_symbol(const uint32_t symbol);
+	void put_huffman(const uint32_t code, const size_t length);
+	void put_bits(const uint32_t bits, const size_t length);
+	void put_byte(const uint8_t value);
+	void flush_bits();
+	void flush_idat();
+
 	void write_chunk_header(const size_t length, const std::array<uint8_t, 4>& type);
 	void write_chunk_content(const void* const p, const size_t count);
 
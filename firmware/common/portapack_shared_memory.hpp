@@ -54,7 +54,7 @@ struct SharedMemory {
 	uint8_t application_queue_data[1 << application_queue_k] { 0 };
 	uint8_t app_local_queue_data[1 << app_local_queue_k] { 0 };
 	const Message* volatile baseband_message { nullptr };
-	MessageQueue application_queue { application_queue_data, application_queue_k };
+	SPSCMessageQueue application_queue { application_queue_data, application_queue_k };
 	MessageQueue app_local_queue { app_local_queue_data, app_local_queue_k };
 
 	char m4_panic_msg[32] { 0 };
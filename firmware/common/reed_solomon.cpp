@@ -0,0 +1,153 @@
+/*
+ * Copyright (C) 2026 agent
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "reed_solomon.hpp"
+
+#include <algorithm>
+
+namespace reed_solomon {
+
+constexpr GF256 gf256 { 0x11d };
+
+int Decoder::decode(uint8_t* const codeword, const size_t length) const {
+	const auto& gf = gf256;
+	const size_t nroots = std::min(parity_count, parity_max);
+
+	// Syndromes S_j = c(alpha^(first_root + j)), Horner from the highest power
+	std::array<uint8_t, parity_max> syndromes { };
+	uint8_t any_error = 0;
+	for(size_t j=0; j<nroots; j++) {
+		const size_t root_log = (first_root + j) % 255;
+		uint8_t s = 0;
+		for(size_t i=length; i>0; i--) {
+			s = (s ? gf.exp[gf.log[s] + root_log] : 0) ^ codeword[i - 1];
+		}
+		syndromes[j] = s;
+		any_error |= s;
+	}
+
+	if( !any_error ) {
+		return 0;
+	}
+
+	// Berlekamp-Massey: error locator lambda(x) of degree errors
+	std::array<uint8_t, parity_max + 1> lambda { 1 };
+	std::array<uint8_t, parity_max + 1> previous { 1 };
+	size_t errors = 0;
+	size_t shift = 1;
+	uint8_t previous_delta = 1;
+
+	for(size_t r=0; r<nroots; r++) {
+		uint8_t delta = syndromes[r];
+		for(size_t i=1; i<=errors; i++) {
+			delta ^= gf.mul(lambda[i], syndromes[r - i]);
+		}
+
+		if( !delta ) {
+			shift++;
+			continue;
+		}
+
+		const auto lambda_before = lambda;
+		const uint8_t scale = gf.div(delta, previous_delta);
+		for(size_t i=0; (i + shift)<=nroots; i++) {
+			lambda[i + shift] ^= gf.mul(scale, previous[i]);
+		}
+
+		if( 2 * errors <= r ) {
+			errors = r + 1 - errors;
+			previous = lambda_before;
+			previous_delta = delta;
+			shift = 1;
+		} else {
+			shift++;
+		}
+	}
+
+	if( 2 * errors > nroots ) {
+		return -1;
+	}
+
+	// Chien search: lambda(alpha^-p) = 0 for an error at p. Roots in the
+	// shortened part (implicit zeros) are as bad as too few roots.
+	std::array<uint8_t, parity_max / 2> positions { };
+	size_t found = 0;
+	for(size_t p=0; (p<length) && (found<errors); p++) {
+		const size_t x_inv_log = (255 - p) % 255;
+		uint8_t sum = lambda[0];
+		for(size_t k=1; k<=errors; k++) {
+			if( lambda[k] ) {
+				sum ^= gf.exp[gf.log[lambda[k]] + (x_inv_log * k) % 255];
+			}
+		}
+		if( !sum ) {
+			positions[found++] = p;
+		}
+	}
+
+	if( found != errors ) {
+		return -1;
+	}
+
+	// Forney: e = X^(1 - first_root) omega(X^-1) / lambda'(X^-1),
+	// with omega(x) = S(x) lambda(x) mod x^nroots
+	std::array<uint8_t, parity_max> omega { };
+	for(size_t i=0; i<nroots; i++) {
+		for(size_t k=0; (k<=errors) && (k<=i); k++) {
+			omega[i] ^= gf.mul(lambda[k], syndromes[i - k]);
+		}
+	}
+
+	std::array<uint8_t, parity_max / 2> values { };
+	const size_t x_power = (256 - (first_root % 255)) % 255;
+	for(size_t e=0; e<found; e++) {
+		const size_t p = positions[e];
+		const size_t x_inv_log = (255 - p) % 255;
+
+		uint8_t numerator = 0;
+		for(size_t i=0; i<nroots; i++) {
+			if( omega[i] ) {
+				numerator ^= gf.exp[gf.log[omega[i]] + (x_inv_log * i) % 255];
+			}
+		}
+
+		uint8_t denominator = 0;
+		for(size_t k=1; k<=errors; k+=2) {
+			if( lambda[k] ) {
+				denominator ^= gf.exp[gf.log[lambda[k]] + (x_inv_log * (k - 1)) % 255];
+			}
+		}
+
+		if( !denominator ) {
+			return -1;
+		}
+
+		values[e] = gf.mul(gf.div(numerator, denominator), gf.exp[(p * x_power) % 255]);
+	}
+
+	for(size_t e=0; e<found; e++) {
+		codeword[positions[e]] ^= values[e];
+	}
+
+	return found;
+}
+
+} /* namespace reed_solomon */
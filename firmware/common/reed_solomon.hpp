@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2026 agent
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __REED_SOLOMON_H__
+#define __REED_SOLOMON_H__
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+
+namespace reed_solomon {
+
+/* GF(2^8) arithmetic from log/antilog tables, generated at compile time for
+ * the field polynomial x^8+x^4+x^3+x^2+1 (0x11D) with alpha = 2. exp is
+ * doubled so a sum of two logs indexes it without a modulo. */
+struct GF256 {
+	std::array<uint8_t, 512> exp;
+	std::array<uint8_t, 256> log;
+
+	constexpr GF256(
+		const uint32_t polynomial
+	) : exp { },
+		log { }
+	{
+		uint32_t x = 1;
+		for(size_t i=0; i<255; i++) {
+			exp[i] = x;
+			exp[i + 255] = x;
+			log[x] = i;
+			x <<= 1;
+			if( x & 0x100 ) {
+				x ^= polynomial;
+			}
+		}
+		exp[510] = exp[0];
+		exp[511] = exp[1];
+	}
+
+	constexpr uint8_t mul(const uint8_t a, const uint8_t b) const {
+		return (a && b) ? exp[log[a] + log[b]] : 0;
+	}
+
+	// b must not be zero
+	constexpr uint8_t div(const uint8_t a, const uint8_t b) const {
+		return a ? exp[log[a] + 255 - log[b]] : 0;
+	}
+};
+
+extern const GF256 gf256;
+
+/* RS(255, 255 - parity_count) over gf256, with generator roots alpha^first_root
+ * onwards. Codewords are held lowest power first: codeword[i] is the
+ * coefficient of x^i, so systematic codes have the parity in the first
+ * parity_count entries. Shortened codes pass their length, the symbols above
+ * it being implicitly zero. */
+class Decoder {
+public:
+	static constexpr size_t n = 255;
+	static constexpr size_t parity_max = 32;
+
+	constexpr Decoder(
+		const size_t parity_count,
+		const size_t first_root = 0
+	) : parity_count { parity_count },
+		first_root { first_root }
+	{
+	}
+
+	/* Corrects codeword in place. Returns the number of symbols corrected,
+	 * or -1 (codeword untouched) if there are more errors than the code can
+	 * locate. */
+	int decode(uint8_t* const codeword, const size_t length = n) const;
+
+private:
+	const size_t parity_count;
+	const size_t first_root;
+};
+
+} /* namespace reed_solomon */
+
+#endif/*__REED_SOLOMON_H__*/
@@ -22,6 +22,11 @@
 
 #include "sonde_packet.hpp"
 #include "string_format.hpp"
+#include "reed_solomon.hpp"
+#include "crc.hpp"
+
+#include <cmath>
+#include <algorithm>
 
 namespace sonde {
 
@@ -42,6 +47,74 @@ Packet::Packet(
 		else if (id_byte == 0x648F)
 			type_ = Type::Meteomodem_M2K2;
 	}
+	
+	if ((type_ == Type::Meteomodem_M10) || (type_ == Type::Meteomodem_M2K2))
+		decode_M10();
+	else if (type_ == Type::Vaisala_RS41_SG)
+		decode_RS41();
+}
+
+void Packet::decode_M10() {
+	for (size_t i = 0; i < m10_length; i++)
+		frame_[i] = reader_bi_m.read(i * 8, 8);
+	
+	if (type_ == Type::Meteomodem_M10) {
+		corrected_ = repair_M10();
+		crc_ok_ = (corrected_ >= 0);
+		gps_valid_ = crc_ok_;
+	} else {
+		// No known checksum for the M2K2: its position is shown unchecked
+		gps_valid_ = true;
+	}
+	
+	altitude_ = (reader_frame_.read(22 * 8, 32) / 1000) - 48;
+	latitude_ = static_cast<int32_t>(reader_frame_.read(14 * 8, 32)) / ((1ULL << 32) / 360.0);
+	longitude_ = static_cast<int32_t>(reader_frame_.read(18 * 8, 32)) / ((1ULL << 32) / 360.0);
+}
+
+void Packet::decode_RS41() {
+	// The packet starts after the sync, which is the first half of the header
+	std::copy(std::begin(rs41_header), std::end(rs41_header), frame_.begin());
+	
+	for (size_t i = rs41_sync_length; i < frame_max; i++) {
+		const size_t bit = (i - rs41_sync_length) * 8;
+		uint8_t byte = 0;
+		for (size_t b = 0; b < 8; b++)
+			byte |= packet_[bit + b] << b;		// LSB first
+		frame_[i] = byte ^ vaisala_mask[i & 63];
+	}
+	
+	corrected_ = repair_RS41();
+	
+	// The blocks are also CRC protected, which covers extended frames the
+	// packet is too short to hold the RS codewords of
+	crc_ok_ = block_ok_RS41(rs41_block_status, 0x79);
+	
+	gps_valid_ = block_ok_RS41(rs41_block_gps_position, 0x7B);
+	if (gps_valid_) {
+		// ECEF in cm to WGS84, Bowring's method
+		const double x = static_cast<int32_t>(read_le_RS41(rs41_block_gps_position + 2, 4)) / 100.0;
+		const double y = static_cast<int32_t>(read_le_RS41(rs41_block_gps_position + 6, 4)) / 100.0;
+		const double z = static_cast<int32_t>(read_le_RS41(rs41_block_gps_position + 10, 4)) / 100.0;
+		
+		constexpr double a = 6378137.0;
+		constexpr double b = 6356752.31424518;
+		constexpr double e2 = (a * a - b * b) / (a * a);
+		constexpr double ep2 = (a * a - b * b) / (b * b);
+		constexpr double degrees = 180.0 / 3.14159265358979323846;
+		
+		const double p = std::sqrt(x * x + y * y);
+		const double theta = std::atan2(z * a, p * b);
+		const double st = std::sin(theta);
+		const double ct = std::cos(theta);
+		const double lat = std::atan2(z + ep2 * b * st * st * st, p - e2 * a * ct * ct * ct);
+		const double sl = std::sin(lat);
+		const double n = a / std::sqrt(1.0 - e2 * sl * sl);
+		
+		altitude_ = p / std::cos(lat) - n;
+		latitude_ = lat * degrees;
+		longitude_ = std::atan2(y, x) * degrees;
+	}
 }
 
 size_t Packet::length() const {
@@ -60,44 +133,29 @@ Packet::Type Packet::type() const {
 	return type_;
 }
 
-/*uint8_t Packet::vaisala_descramble(const uint32_t pos) {
-	return reader_raw.read(pos * 8, 8) ^ vaisala_mask[pos & 63];
-};*/
+bool Packet::GPS_valid() const {
+	return gps_valid_;
+}
 
 uint32_t Packet::GPS_altitude() const {
-	if ((type_ == Type::Meteomodem_M10) || (type_ == Type::Meteomodem_M2K2))
-		return (reader_bi_m.read(22 * 8, 32) / 1000) - 48;
-	else if (type_ == Type::Vaisala_RS41_SG) {
-		/*uint32_t altitude_ecef = 0;
-		for (uint32_t i = 0; i < 4; i++)
-			altitude_ecef = (altitude_ecef << 8) + vaisala_descramble(0x11C + i);*/
-		// TODO: and a bunch of maths (see ecef2elli() from RS1729)
-		return 0;
-	} else
-		return 0;	// Unknown
+	return gps_valid_ ? altitude_ : 0;
 }
 
 float Packet::GPS_latitude() const {
-	if ((type_ == Type::Meteomodem_M10) || (type_ == Type::Meteomodem_M2K2))
-		return reader_bi_m.read(14 * 8, 32) / ((1ULL << 32) / 360.0);
-	//else if (type_ == Type::Vaisala_RS41_SG)
-	//	return vaisala_descramble();
-	else
-		return 0;	// Unknown
+	return gps_valid_ ? latitude_ : 0;
 }
 
 float Packet::GPS_longitude() const {
-	if ((type_ == Type::Meteomodem_M10) || (type_ == Type::Meteomodem_M2K2))
-		return reader_bi_m.read(18 * 8, 32) / ((1ULL << 32) / 360.0);
-	else
-		return 0;	// Unknown
+	return gps_valid_ ? longitude_ : 0;
 }
 
 uint32_t Packet::battery_voltage() const {
 	if (type_ == Type::Meteomodem_M10)
-		return (reader_bi_m.read(69 * 8, 8) + (reader_bi_m.read(70 * 8, 8) << 8)) * 1000 / 150;
+		return (reader_frame_.read(69 * 8, 8) + (reader_frame_.read(70 * 8, 8) << 8)) * 1000 / 150;
 	else if (type_ == Type::Meteomodem_M2K2)
-		return reader_bi_m.read(69 * 8, 8) * 66;	// Actually 65.8
+		return reader_frame_.read(69 * 8, 8) * 66;	// Actually 65.8
+	else if (type_ == Type::Vaisala_RS41_SG)
+		return frame_[0x45] * 100;
 	else
 		return 0;	// Unknown
 }
@@ -121,33 +179,64 @@ std::string Packet::serial_number() const {
 		//                                                  44444444 33333333
 		//                                                  DDDEEEEE EEEEEEEE
 		
-		return to_string_hex(reader_bi_m.read(93 * 8 + 16, 4), 1) +
-			to_string_dec_uint(reader_bi_m.read(93 * 8 + 20, 4), 2, '0') + " " +
-			to_string_hex(reader_bi_m.read(93 * 8 + 4, 4), 1) + " " +
-			to_string_dec_uint(reader_bi_m.read(93 * 8 + 24, 3), 1) +
-			to_string_dec_uint(reader_bi_m.read(93 * 8 + 27, 13), 4, '0');
+		return to_string_hex(reader_frame_.read(93 * 8 + 16, 4), 1) +
+			to_string_dec_uint(reader_frame_.read(93 * 8 + 20, 4), 2, '0') + " " +
+			to_string_hex(reader_frame_.read(93 * 8 + 4, 4), 1) + " " +
+			to_string_dec_uint(reader_frame_.read(93 * 8 + 24, 3), 1) +
+			to_string_dec_uint(reader_frame_.read(93 * 8 + 27, 13), 4, '0');
+	
+	} else if (type() == Type::Vaisala_RS41_SG) {
+		std::string serial;
+		for (size_t i = 0; i < 8; i++) {
+			const char c = frame_[rs41_block_status + 4 + i];
+			serial += ((c >= '0') && (c <= 'Z')) ? c : '?';
+		}
+		return serial;
 	
 	} else
 		return "?";
 }
 
+uint64_t Packet::serial_key() const {
+	// RS41 serials are 8 ASCII characters, M10 ones 5 bytes: the keys can't collide
+	uint64_t key = 0;
+	
+	// Unchecked and with no serial decoded, M2K2 frames all share one key
+	if (type() == Type::Meteomodem_M2K2)
+		return m2k2_key;
+	
+	if (!crc_ok())
+		return 0;
+	
+	if (type() == Type::Meteomodem_M10) {
+		for (size_t i = 93; i < 98; i++)
+			key = (key << 8) | frame_[i];
+	} else if (type() == Type::Vaisala_RS41_SG) {
+		for (size_t i = 0; i < 8; i++)
+			key = (key << 8) | frame_[rs41_block_status + 4 + i];
+	}
+	
+	return key;
+}
+
 FormattedSymbols Packet::symbols_formatted() const {
 	return format_symbols(decoder_);
 }
 
 bool Packet::crc_ok() const {
-	switch(type()) {
-	case Type::Meteomodem_M10:	return crc_ok_M10();
-	default:					return false;
-	}
+	return crc_ok_;
+}
+
+int Packet::corrected() const {
+	return corrected_;
 }
 
-bool Packet::crc_ok_M10() const {
-    uint16_t cs { 0 };
-	uint32_t c0, c1, t, t6, t7, s,b ;
-    
-	for (size_t i = 0; i < packet_.size(); i++) {
-		b = packet_[i];
+static uint16_t checksum_M10(const uint8_t* const data, const size_t length) {
+	uint16_t cs { 0 };
+	uint32_t c0, c1, t, t6, t7, s, b;
+	
+	for (size_t i = 0; i < length; i++) {
+		b = data[i];
 		c1 = cs & 0xFF;
 
 		// B
@@ -165,10 +254,101 @@ bool Packet::crc_ok_M10() const {
 
 		c0 = b ^ t ^ s;
 
-		cs = ((c1<<8) | c0) & 0xFFFF;
-    }
+		cs = ((c1 << 8) | c0) & 0xFFFF;
+	}
+	
+	return cs;
+}
+
+/* The M10 checksum is linear over GF(2) and starts from 0, so a flipped bit
+ * changes it by the checksum of that bit alone: a single bit error can be
+ * found by matching the syndrome. */
+int Packet::repair_M10() {
+	const uint16_t received = (frame_[m10_check] << 8) | frame_[m10_check + 1];
+	const uint16_t syndrome = checksum_M10(frame_.data(), m10_check) ^ received;
+	
+	if (!syndrome)
+		return 0;
+	
+	// Error in the checksum itself
+	if (!(syndrome & (syndrome - 1))) {
+		if (syndrome >> 8)
+			frame_[m10_check] ^= syndrome >> 8;
+		else
+			frame_[m10_check + 1] ^= syndrome;
+		return 1;
+	}
+	
+	std::array<uint8_t, m10_check> error { };
+	for (size_t i = 0; i < m10_check; i++) {
+		for (size_t bit = 0; bit < 8; bit++) {
+			error[i] = 1 << bit;
+			if (checksum_M10(&error[i], m10_check - i) == syndrome) {
+				frame_[i] ^= error[i];
+				return 1;
+			}
+		}
+		error[i] = 0;
+	}
+	
+	return -1;
+}
+
+/* Two interleaved RS(255, 231) codewords: even and odd message bytes from
+ * 0x38, each with 24 parity bytes from 0x08. The standard frame is the
+ * shortened code, the rest of the codeword being implicit zeros. */
+int Packet::repair_RS41() {
+	constexpr size_t parity = 24;
+	constexpr size_t message = (frame_max - rs41_message) / 2;
+	constexpr reed_solomon::Decoder rs { parity, 0 };
+	
+	std::array<uint8_t, reed_solomon::Decoder::n> codeword;
+	int corrected = 0;
+	
+	for (size_t k = 0; k < 2; k++) {
+		for (size_t i = 0; i < parity; i++)
+			codeword[i] = frame_[rs41_parity + k * parity + i];
+		for (size_t i = 0; i < message; i++)
+			codeword[parity + i] = frame_[rs41_message + 2 * i + k];
+		
+		const auto errors = rs.decode(codeword.data(), parity + message);
+		if (errors < 0) {
+			corrected = -1;
+			continue;
+		}
+		
+		for (size_t i = 0; i < parity; i++)
+			frame_[rs41_parity + k * parity + i] = codeword[i];
+		for (size_t i = 0; i < message; i++)
+			frame_[rs41_message + 2 * i + k] = codeword[parity + i];
+		
+		if (corrected >= 0)
+			corrected += errors;
+	}
+	
+	return corrected;
+}
+
+// Block: ID, length, data, then CRC-16/CCITT-FALSE of the data (LE)
+bool Packet::block_ok_RS41(const size_t position, const uint8_t id) const {
+	if (frame_[position] != id)
+		return false;
+	
+	const size_t length = frame_[position + 1];
+	if ((position + 2 + length + 2) > frame_max)
+		return false;
+	
+	CRC<16> crc { 0x1021, 0xffff };
+	crc.process_bytes(&frame_[position + 2], length);
+	
+	return crc.checksum() == read_le_RS41(position + 2 + length, 2);
+}
 
-	return ((cs & 0xFFFF) == ((packet_[0x63] << 8) | (packet_[0x63 + 1])));
+uint32_t Packet::read_le_RS41(const size_t position, const size_t bytes) const {
+	uint32_t value = 0;
+	for (size_t i = bytes; i > 0; i--)
+		value = (value << 8) | frame_[position + i - 1];
+	return value;
 }
 
 } /* namespace sonde */
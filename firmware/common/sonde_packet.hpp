@@ -25,6 +25,8 @@
 
 #include <cstdint>
 #include <cstddef>
+#include <array>
+#include <string>
 
 #include "field_reader.hpp"
 #include "baseband_packet.hpp"
@@ -54,8 +56,12 @@ public:
 	std::string type_string() const;
 	
 	std::string serial_number() const;
+	/* Serial number as a track key, 0 when the frame can't be trusted. The
+	 * M2K2 has no checksum to trust it by, and gets one key for all. */
+	uint64_t serial_key() const;
 	uint32_t battery_voltage() const;
 	
+	bool GPS_valid() const;
 	uint32_t GPS_altitude() const;
 	float GPS_latitude() const;
 	float GPS_longitude() const;
@@ -63,8 +69,37 @@ public:
 	FormattedSymbols symbols_formatted() const;
 
 	bool crc_ok() const;
+	
+	/* Symbols repaired before the checks: RS41 bytes fixed by the
+	 * Reed-Solomon code, or the M10 bit put back by its checksum. -1 when
+	 * the errors are beyond repair. */
+	int corrected() const;
 
 private:
+	/* Bits of a byte array, MSB first, for FieldReader */
+	struct FrameBits {
+		const uint8_t* const data;
+
+		uint_fast8_t operator[](const size_t index) const {
+			return (data[index >> 3] >> (~index & 7)) & 1;
+		}
+	};
+
+	// RS41 standard frame, header included. M10 frames are shorter.
+	static constexpr size_t frame_max = 320;
+	static constexpr size_t m10_length = 101;
+	static constexpr size_t m10_check = 0x63;
+	static constexpr uint64_t m2k2_key = 1ULL << 40;	// Above any 5-byte M10 serial
+	
+	// RS41 frame layout
+	static constexpr size_t rs41_sync_length = 4;		// Eaten by the packet builder
+	static constexpr size_t rs41_parity = 0x08;
+	static constexpr size_t rs41_message = 0x38;
+	static constexpr size_t rs41_block_status = 0x39;
+	static constexpr size_t rs41_block_gps_position = 0x112;
+	
+	static constexpr uint8_t rs41_header[rs41_sync_length] = { 0x86, 0x35, 0xF4, 0x40 };
+	
 	static constexpr uint8_t vaisala_mask[64] = { 
 		0x96, 0x83, 0x3E, 0x51, 0xB1, 0x49, 0x08, 0x98, 
 		0x32, 0x05, 0x59, 0x0E, 0xF9, 0x44, 0xC6, 0x26,
@@ -82,8 +117,25 @@ private:
 	const BiphaseMDecoder decoder_;
 	const FieldReader<BiphaseMDecoder, BitRemapNone> reader_bi_m;
 	Type type_;
+	
+	std::array<uint8_t, frame_max> frame_ { };
+	const FrameBits frame_bits_ { frame_.data() };
+	const FieldReader<FrameBits, BitRemapNone> reader_frame_ { frame_bits_ };
+	
+	bool crc_ok_ { false };
+	int corrected_ { 0 };
+	bool gps_valid_ { false };
+	int32_t altitude_ { 0 };
+	float latitude_ { 0 };
+	float longitude_ { 0 };
 
-	bool crc_ok_M10() const;
+	void decode_M10();
+	void decode_RS41();
+	
+	int repair_M10();
+	int repair_RS41();
+	bool block_ok_RS41(const size_t position, const uint8_t id) const;
+	uint32_t read_le_RS41(const size_t position, const size_t bytes) const;
 };
 
 } /* namespace sonde */
@@ -77,6 +77,7 @@ constexpr image_tag_t image_tag_capture				{ 'P', 'C', 'A', 'P' };
 constexpr image_tag_t image_tag_ert					{ 'P', 'E', 'R', 'T' };
 constexpr image_tag_t image_tag_nfm_audio			{ 'P', 'N', 'F', 'M' };
 constexpr image_tag_t image_tag_pocsag				{ 'P', 'P', 'O', 'C' };
+constexpr image_tag_t image_tag_pulse				{ 'P', 'P', 'L', 'S' };
 constexpr image_tag_t image_tag_sonde				{ 'P', 'S', 'O', 'N' };
 constexpr image_tag_t image_tag_tpms				{ 'P', 'T', 'P', 'M' };
 constexpr image_tag_t image_tag_wfm_audio			{ 'P', 'W', 'F', 'M' };
@@ -86,6 +87,7 @@ constexpr image_tag_t image_tag_test				{ 'P', 'T', 'S', 'T' };
 constexpr image_tag_t image_tag_adsb_tx				{ 'P', 'A', 'D', 'T' };
 constexpr image_tag_t image_tag_afsk				{ 'P', 'A', 'F', 'T' };
 constexpr image_tag_t image_tag_audio_tx			{ 'P', 'A', 'T', 'X' };
+constexpr image_tag_t image_tag_bitstream_tx		{ 'P', 'B', 'T', 'X' };
 constexpr image_tag_t image_tag_fsktx				{ 'P', 'F', 'S', 'K' };
 constexpr image_tag_t image_tag_jammer				{ 'P', 'J', 'A', 'M' };
 constexpr image_tag_t image_tag_mic_tx				{ 'P', 'M', 'T', 'X' };
@@ -101,13 +103,45 @@ constexpr image_tag_t image_tag_noop				{ 'P', 'N', 'O', 'P' };
 
 constexpr image_tag_t image_tag_hackrf				{ 'H', 'R', 'F', '1' };
 
-struct chunk_t {
+/* Baseband images are stored behind a directory written by make_spi_image.py.
+ * Each image is LZ4 block-compressed, or stored as-is when compression
+ * doesn't help (compressed_length == length). Offsets are relative to the
+ * start of the directory.
+ */
+constexpr uint32_t image_directory_magic = 0x4d495050;	// "PPIM"
+
+struct image_directory_entry_t {
 	const image_tag_t tag;
+	const uint32_t offset;
+	const uint32_t compressed_length;
 	const uint32_t length;
-	const uint8_t data[];
+	const uint32_t crc32;
+
+	bool is_compressed() const {
+		return compressed_length != length;
+	}
+};
+
+struct image_directory_t {
+	const uint32_t magic;
+	const uint32_t count;
+	const image_directory_entry_t entries[];
+
+	bool is_valid() const {
+		return magic == image_directory_magic;
+	}
+
+	const image_directory_entry_t* find(const image_tag_t& tag) const {
+		for(size_t i=0; i<count; i++) {
+			if( entries[i].tag == tag ) {
+				return &entries[i];
+			}
+		}
+		return nullptr;
+	}
 
-	const chunk_t* next() const {
-		return reinterpret_cast<const chunk_t*>(&data[length]);
+	const uint8_t* data(const image_directory_entry_t& entry) const {
+		return reinterpret_cast<const uint8_t*>(this) + entry.offset;
 	}
 };
 
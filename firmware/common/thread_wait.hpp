@@ -27,6 +27,10 @@
 class ThreadWait {
 public:
 	int sleep();
+
+	/* As sleep(), for a caller which has locked the system to check its
+	 * wake condition first, so that a wake in between can't be missed. */
+	int sleep_s();
 	bool wake_from_interrupt(const int value);
 
 private:
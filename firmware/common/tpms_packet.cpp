@@ -23,14 +23,30 @@
 
 #include "crc.hpp"
 
+#include <algorithm>
+
 namespace tpms {
 
-Timestamp Packet::received_at() const {
-	return packet_.timestamp();
+/* x^8 + 1, used by the 72 and 80 bit FLM formats */
+static constexpr CRCTable<8> crc8_flm { 0x01 };
+
+Packet::Packet(
+	const baseband::Packet& packet,
+	const SignalType signal_type,
+	const Coding coding
+) : packet_ { packet },
+	signal_type_ { signal_type },
+	coding_ { coding }
+{
+	// Same symbol values as ManchesterDecoder, without the per-symbol virtual call.
+	const size_t symbols_count = std::min(packet_.size() / 2, payload_.size() * 8);
+	for(size_t i=0; i<symbols_count; i++) {
+		payload_[i >> 3] |= packet_[i * 2 + coding_] << (~i & 7);
+	}
 }
 
-FormattedSymbols Packet::symbols_formatted() const {
-	return format_symbols(decoder_);
+Timestamp Packet::received_at() const {
+	return packet_.timestamp();
 }
 
 Optional<Reading> Packet::reading_fsk_19k2_schrader() const {
@@ -141,43 +157,37 @@ Optional<Reading> Packet::reading() const {
 }
 
 size_t Packet::crc_valid_length() const {
-	constexpr uint32_t checksum_bytes = 0b1111111;
-	constexpr uint32_t crc_72_bytes = 0b111111111;
-	constexpr uint32_t crc_80_bytes = 0b1111111110;
-
-	std::array<uint8_t, 10> bytes;
-	for(size_t i=0; i<bytes.size(); i++) {
-		bytes[i] = reader_.read(i * 8, 8);
+	uint8_t checksum = 0;
+	for(size_t i=0; i<7; i++) {
+		checksum += payload_[i];
 	}
 
-	uint32_t checksum = 0;
-	CRC<8> crc_72 { 0x01, 0x00 };
-	CRC<8> crc_80 { 0x01, 0x00 };
-
-	for(size_t i=0; i<bytes.size(); i++) {
-		const uint32_t byte_mask = 1 << i;
-		const auto byte = bytes[i];
-
-		if( checksum_bytes & byte_mask ) {
-			checksum += byte;
-		}
-		if( crc_72_bytes & byte_mask ) {
-			crc_72.process_byte(byte);
-		}
-		if( crc_80_bytes & byte_mask ) {
-			crc_80.process_byte(byte);
-		}
-	}
-
-	if( crc_80.checksum() == 0 ) {
+	if( crc8_flm.checksum(&payload_[1], 9) == 0 ) {
 		return 80;
-	} else if( crc_72.checksum() == 0 ) {
+	} else if( crc8_flm.checksum(&payload_[0], 9) == 0 ) {
 		return 72;
-	} else if( (checksum & 0xff) == bytes[7] ) {
+	} else if( checksum == payload_[7] ) {
 		return 64;
 	} else {
 		return 0;
 	}
 }
 
+Optional<Coding> validate(
+	const baseband::Packet& packet,
+	const SignalType signal_type
+) {
+	const size_t coding_count = (signal_type == SignalType::FSK_19k2_Schrader) ? 2 : 1;
+
+	for(size_t i=0; i<coding_count; i++) {
+		const auto coding = static_cast<Coding>(i);
+		const Packet candidate { packet, signal_type, coding };
+		if( candidate.reading().is_valid() ) {
+			return coding;
+		}
+	}
+
+	return { };
+}
+
 } /* namespace tpms */
@@ -24,6 +24,7 @@
 
 #include <cstdint>
 #include <cstddef>
+#include <array>
 
 #include "optional.hpp"
 
@@ -45,6 +46,13 @@ enum SignalType : uint32_t {
 	OOK_8k4_Schrader = 3,
 };
 
+/* Manchester sense the payload was decoded with. FSK polarity depends on
+ * which tone a sensor sends for a mark, so both are tried for FSK. */
+enum Coding : uint32_t {
+	Manchester = 0,
+	ManchesterInverted = 1,
+};
+
 class TransponderID {
 public:
 	constexpr TransponderID(
@@ -134,31 +142,44 @@ private:
 
 class Packet {
 public:
-	constexpr Packet(
+	Packet(
 		const baseband::Packet& packet,
-		const SignalType signal_type
-	) : packet_ { packet },
-		signal_type_ { signal_type },
-		decoder_ { packet_, 0 },
-		reader_ { decoder_ }
-	{
-	}
+		const SignalType signal_type,
+		const Coding coding = Coding::Manchester
+	);
 
 	SignalType signal_type() const { return signal_type_; }
+	Coding coding() const { return coding_; }
 	Timestamp received_at() const;
 
-	FormattedSymbols symbols_formatted() const;
+	FormattedSymbols symbols_formatted() const {
+		return format_symbols(ManchesterDecoder { packet_, coding_ });
+	}
 
 	Optional<Reading> reading() const;
 
 private:
-	using Reader = FieldReader<ManchesterDecoder, BitRemapNone>;
+	struct PayloadBits {
+		const uint8_t* const data;
+
+		uint_fast8_t operator[](const size_t index) const {
+			return (data[index >> 3] >> (~index & 7)) & 1;
+		}
+	};
+
+	using Reader = FieldReader<PayloadBits, BitRemapNone>;
+
+	static constexpr size_t payload_bytes_max = 12;
 
 	const baseband::Packet packet_;
 	const SignalType signal_type_;
-	const ManchesterDecoder decoder_;
+	const Coding coding_;
 
-	const Reader reader_;
+	/* Payload Manchester-decoded once, MSB first, so the CRCs and checksums
+	 * work on whole bytes instead of walking the symbols bit by bit. */
+	std::array<uint8_t, payload_bytes_max> payload_ { };
+	const PayloadBits payload_bits_ { payload_.data() };
+	const Reader reader_ { payload_bits_ };
 
 	Optional<Reading> reading_fsk_19k2_schrader() const;
 	Optional<Reading> reading_ook_8k192_schrader() const;
@@ -167,6 +188,14 @@ private:
 	size_t crc_valid_length() const;
 };
 
+/* Tries each Manchester sense the signal type's formats may use and returns
+ * the first that yields a reading passing its CRC or checksum. Runs on the
+ * M4 so only validated packets are passed on to the application. */
+Optional<Coding> validate(
+	const baseband::Packet& packet,
+	const SignalType signal_type
+);
+
 } /* namespace tpms */
 
 #endif/*__TPMS_PACKET_H__*/
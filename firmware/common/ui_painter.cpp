@@ -43,13 +43,13 @@ int Painter::draw_char(const Point p, const Style& style, const char c) {
 }
 
 int Painter::draw_string(Point p, const Font& font, const Color foreground,
-	const Color background, const std::string text) {
+	const Color background, const char* text) {
 	
 	bool escape = false;
 	size_t width = 0;
 	Color pen = foreground;
 	
-	for(const auto c : text) {
+	while( const char c = *(text++) ) {
 		if (escape) {
 			if (c <= 15)
 				pen = term_colors[c & 15];
@@ -71,10 +71,19 @@ int Painter::draw_string(Point p, const Font& font, const Color foreground,
 	return width;
 }
 
-int Painter::draw_string(Point p, const Style& style, const std::string text) {
+int Painter::draw_string(Point p, const Style& style, const char* const text) {
 	return draw_string(p, style.font, style.foreground, style.background, text);
 }
 
+int Painter::draw_string(Point p, const Font& font, const Color foreground,
+	const Color background, const std::string& text) {
+	return draw_string(p, font, foreground, background, text.c_str());
+}
+
+int Painter::draw_string(Point p, const Style& style, const std::string& text) {
+	return draw_string(p, style.font, style.foreground, style.background, text.c_str());
+}
+
 void Painter::draw_bitmap(const Point p, const Bitmap& bitmap, const Color foreground, const Color background) {
 	display.draw_bitmap(p, bitmap.size, bitmap.data, foreground, background);
 }
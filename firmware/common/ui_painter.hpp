@@ -48,9 +48,14 @@ public:
 
 	int draw_char(const Point p, const Style& style, const char c);
 
+	/* The const char* overloads take a NUL terminated string and never
+	 * allocate; pair them with FixedString in paint() hot paths. */
 	int draw_string(Point p, const Font& font, const Color foreground,
-		const Color background, const std::string text);
-	int draw_string(Point p, const Style& style, const std::string text);
+		const Color background, const char* text);
+	int draw_string(Point p, const Style& style, const char* const text);
+	int draw_string(Point p, const Font& font, const Color foreground,
+		const Color background, const std::string& text);
+	int draw_string(Point p, const Style& style, const std::string& text);
 
 	void draw_bitmap(const Point p, const Bitmap& bitmap, const Color background, const Color foreground);
 
@@ -1698,7 +1698,7 @@ void Waveform::paint(Painter& painter) {
 	if (show_cursors) {
 		for (n = 0; n < 2; n++) {
 			painter.draw_vline(
-				Point(std::min(screen_rect().size().width(), (int)cursors[n]), y_offset),
+				Point(screen_rect().location().x() + std::min(screen_rect().size().width() - 1, (int)cursors[n]), y_offset),
 				screen_rect().size().height(),
 				cursor_colors[n]
 				);
@@ -0,0 +1,135 @@
+/*
+ * Copyright (C) 2026 agent
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __FILE_H__
+#define __FILE_H__
+
+/* Host stand-in for application/file.hpp: files live in memory, keyed by
+ * path, so tests can inspect what the firmware code wrote.
+ */
+
+#include "optional.hpp"
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <array>
+#include <map>
+#include <algorithm>
+
+namespace std {
+namespace filesystem {
+
+struct filesystem_error {
+	uint32_t err { 0 };
+
+	uint32_t code() const {
+		return err;
+	}
+};
+
+using path = std::string;
+
+} /* namespace filesystem */
+} /* namespace std */
+
+inline std::map<std::string, std::vector<uint8_t>>& host_files() {
+	static std::map<std::string, std::vector<uint8_t>> files;
+	return files;
+}
+
+class File {
+public:
+	using Size = uint64_t;
+	using Offset = uint64_t;
+	using Error = std::filesystem::filesystem_error;
+
+	template<typename T>
+	struct Result {
+		bool ok;
+		T value_;
+		Error error_;
+
+		Result(T value) : ok { true }, value_ { value }, error_ { } { }
+		Result(Error error) : ok { false }, value_ { }, error_ { error } { }
+
+		bool is_ok() const { return ok; }
+		bool is_error() const { return !ok; }
+		const T& value() const { return value_; }
+		Error error() const { return error_; }
+	};
+
+	Optional<Error> open(const std::filesystem::path& filename) {
+		if( !host_files().count(filename) ) {
+			return Error { 4 };
+		}
+		name = filename;
+		position = 0;
+		return { };
+	}
+
+	Optional<Error> create(const std::filesystem::path& filename) {
+		host_files()[filename].clear();
+		name = filename;
+		position = 0;
+		return { };
+	}
+
+	Result<Size> read(void* const data, const Size bytes_to_read) {
+		const auto& contents = host_files()[name];
+		const Size n = std::min<Size>(bytes_to_read, (contents.size() > position) ? contents.size() - position : 0);
+		memcpy(data, contents.data() + position, n);
+		position += n;
+		return n;
+	}
+
+	Result<Size> write(const void* const data, const Size bytes_to_write) {
+		auto& contents = host_files()[name];
+		if( contents.size() < position + bytes_to_write ) {
+			contents.resize(position + bytes_to_write);
+		}
+		memcpy(contents.data() + position, data, bytes_to_write);
+		position += bytes_to_write;
+		return bytes_to_write;
+	}
+
+	template<size_t N>
+	Result<Size> write(const std::array<uint8_t, N>& data) {
+		return write(data.data(), N);
+	}
+
+	Result<Offset> seek(const Offset new_position) {
+		position = new_position;
+		return new_position;
+	}
+
+	Size size() const {
+		return host_files()[name].size();
+	}
+
+private:
+	std::string name { };
+	Offset position { 0 };
+};
+
+#endif/*__FILE_H__*/
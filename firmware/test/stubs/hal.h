@@ -0,0 +1,47 @@
+/*
+ * Copyright (C) 2026 agent
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __HAL_H__
+#define __HAL_H__
+
+/* Host versions of the CMSIS SIMD intrinsics used by common DSP code. */
+
+#include <cstdint>
+
+static inline uint32_t __PKHBT(const uint32_t a, const uint32_t b, const uint32_t shift) {
+	return (a & 0xffff) | ((b << shift) & 0xffff0000);
+}
+
+static inline int32_t __SMUAD(const uint32_t a, const uint32_t b) {
+	return int16_t(a) * int16_t(b) + int16_t(a >> 16) * int16_t(b >> 16);
+}
+
+static inline int32_t __SMLAD(const uint32_t a, const uint32_t b, const int32_t acc) {
+	return acc + __SMUAD(a, b);
+}
+
+static inline int32_t __SSAT(const int32_t v, const uint32_t bits) {
+	const int32_t max = (1 << (bits - 1)) - 1;
+	const int32_t min = -(1 << (bits - 1));
+	return (v > max) ? max : ((v < min) ? min : v);
+}
+
+#endif/*__HAL_H__*/
@@ -0,0 +1,275 @@
+/*
+ * Copyright (C) 2026 agent
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/* Decode count for the Bell 202 correlator and AX.25 deframer: synthetic
+ * APRS frames, NRZI and bit stuffed, AFSK modulated at 24kHz with baud rate
+ * error, pre-emphasis tilt and white noise, fed through the correlator and
+ * the five slicers with the same duplicate suppression as AFSKRxProcessor.
+ * A run of frames sharing their flags checks the shared flag re-match.
+ */
+
+#include "dsp_afsk.hpp"
+#include "ax25_packet.hpp"
+#include "crc.hpp"
+#include "test_check.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <cmath>
+#include <array>
+#include <vector>
+#include <string>
+#include <random>
+
+Timestamp Timestamp::now() {
+	return { };
+}
+
+static constexpr uint32_t sampling_rate = 24000;
+static constexpr size_t frame_count = 50;
+
+static constexpr std::array<float, 5> slicer_thresholds { { -0.8f, -0.4f, 0.0f, 0.4f, 0.8f } };
+
+struct Recording {
+	std::vector<float> audio;
+	std::vector<std::string> expected;
+};
+
+static std::vector<uint8_t> make_frame(const std::string& info, const size_t n) {
+	std::vector<uint8_t> frame;
+	const auto address = [&frame](const char* const call, const uint8_t ssid, const bool last) {
+		for(size_t i=0; i<6; i++) {
+			frame.push_back(((i < strlen(call)) ? call[i] : ' ') << 1);
+		}
+		frame.push_back(0x60 | (ssid << 1) | (last ? 1 : 0));
+	};
+	address("APRS", 0, false);
+	address("N0CALL", n % 16, false);
+	address("WIDE1", 1, false);
+	address("WIDE2", 1, true);
+	frame.push_back(0x03);
+	frame.push_back(0xf0);
+	frame.insert(frame.end(), info.begin(), info.end());
+
+	CRC<16, true, true> crc { 0x1021, 0xffff, 0xffff };
+	crc.process_bytes(frame.data(), frame.size());
+	const auto fcs = crc.checksum();
+	frame.push_back(fcs & 0xff);
+	frame.push_back(fcs >> 8);
+	return frame;
+}
+
+static void add_flags(std::vector<uint8_t>& bits, const size_t count) {
+	for(size_t n=0; n<count; n++) {
+		for(size_t i=0; i<8; i++) {
+			bits.push_back((0x7e >> i) & 1);
+		}
+	}
+}
+
+/* LSB first, a zero stuffed after five ones. */
+static void add_frame(std::vector<uint8_t>& bits, const std::vector<uint8_t>& frame) {
+	size_t ones = 0;
+	for(const auto byte : frame) {
+		for(size_t i=0; i<8; i++) {
+			const uint8_t bit = (byte >> i) & 1;
+			bits.push_back(bit);
+			ones = bit ? (ones + 1) : 0;
+			if( ones == 5 ) {
+				bits.push_back(0);
+				ones = 0;
+			}
+		}
+	}
+}
+
+/* NRZI (a zero toggles the tone), phase continuous, mark at full amplitude
+ * and space tilted by tilt_db.
+ */
+static void modulate(std::vector<float>& audio, const std::vector<uint8_t>& bits, const float baud, const float tilt_db) {
+	const float samples_per_bit = float(sampling_rate) / baud;
+	const float space_gain = std::pow(10.0f, tilt_db / 20.0f);
+	static float phase = 0;
+	static bool mark = true;
+
+	double end = audio.size();
+	for(const auto bit : bits) {
+		if( !bit ) {
+			mark = !mark;
+		}
+		end += samples_per_bit;
+		while( audio.size() < end ) {
+			phase += 2 * M_PI * (mark ? 1200 : 2200) / sampling_rate;
+			audio.push_back(std::sin(phase) * (mark ? 1.0f : space_gain));
+		}
+	}
+}
+
+static std::string expected_string(const std::string& info, const size_t n) {
+	const auto ssid = n % 16;
+	return std::string("N0CALL") + (ssid ? "-" + std::to_string(ssid) : "") + ">APRS,WIDE1-1,WIDE2-1:" + info;
+}
+
+static std::string info_field(const size_t n) {
+	return "!4903.50N/07201.75W-Test " + std::to_string(n) + " 0123456789 ~~~ {}|";
+}
+
+/* Frames separated by silence, each with its own preamble. */
+static Recording make_recording(const float snr_db, const float tilt_db) {
+	Recording recording;
+	for(size_t n=0; n<frame_count; n++) {
+		const auto info = info_field(n);
+		std::vector<uint8_t> bits;
+		add_flags(bits, 25);
+		add_frame(bits, make_frame(info, n));
+		add_flags(bits, 3);
+
+		// Baud rate off by up to 0.8%
+		const float baud = 1200.0f * (1.0f + 0.004f * ((int(n) % 5) - 2));
+		modulate(recording.audio, bits, baud, tilt_db);
+		recording.audio.insert(recording.audio.end(), 2000, 0.0f);
+		recording.expected.push_back(expected_string(info, n));
+	}
+
+	// Noise relative to the mark tone's power
+	std::mt19937 rng { 1 };
+	std::normal_distribution<float> gauss;
+	const float sigma = std::sqrt(0.5f / std::pow(10.0f, snr_db / 10.0f));
+	for(auto& sample : recording.audio) {
+		sample += sigma * gauss(rng);
+	}
+	return recording;
+}
+
+/* Back to back: a single flag ends one frame and starts the next. */
+static Recording make_burst() {
+	Recording recording;
+	std::vector<uint8_t> bits;
+	add_flags(bits, 25);
+	for(size_t n=0; n<8; n++) {
+		const auto info = info_field(n);
+		add_frame(bits, make_frame(info, n));
+		add_flags(bits, 1);
+		recording.expected.push_back(expected_string(info, n));
+	}
+	add_flags(bits, 2);
+	modulate(recording.audio, bits, 1200.0f, 0.0f);
+	recording.audio.insert(recording.audio.end(), 2000, 0.0f);
+	return recording;
+}
+
+struct DecodeCount {
+	size_t good;
+	size_t extra;
+};
+
+static DecodeCount decode(const Recording& recording, const size_t slicer_count) {
+	dsp::AFSKCorrelator correlator;
+	correlator.configure(1200, 2200, 1200, sampling_rate);
+
+	std::array<dsp::AFSKSlicer, slicer_thresholds.size()> slicers;
+	const size_t first = (slicers.size() - slicer_count) / 2;
+	for(size_t i=0; i<slicers.size(); i++) {
+		slicers[i].configure(slicer_thresholds[i], 1200, sampling_rate);
+	}
+
+	const uint32_t duplicate_window = correlator.length() * 32;
+	uint32_t sample_count = 0;
+	uint32_t last_frame_sample = -duplicate_window;
+	uint16_t last_fcs = 0;
+
+	DecodeCount count { 0, 0 };
+	size_t next = 0;
+	for(const auto sample : recording.audio) {
+		const auto symbol = correlator.execute(sample);
+		sample_count++;
+
+		for(size_t i=first; i<first+slicer_count; i++) {
+			auto& slicer = slicers[i];
+			if( slicer.execute(symbol) ) {
+				slicer.deframe();
+			}
+			if( !slicer.frame_ready() ) {
+				continue;
+			}
+
+			if( (slicer.fcs() != last_fcs) || ((sample_count - last_frame_sample) >= duplicate_window) ) {
+				last_fcs = slicer.fcs();
+				last_frame_sample = sample_count;
+
+				const auto decoded = ax25::Packet { slicer.frame() }.to_string();
+				bool found = false;
+				for(size_t k=next; k<recording.expected.size(); k++) {
+					if( recording.expected[k] == decoded ) {
+						found = true;
+						next = k + 1;
+						break;
+					}
+				}
+				if( found ) {
+					count.good++;
+				} else {
+					count.extra++;
+				}
+			}
+			slicer.release();
+		}
+	}
+	return count;
+}
+
+int main() {
+	struct Case {
+		float snr_db;
+		float tilt_db;
+		size_t good_min;	// With five slicers
+	};
+	const Case cases[] {
+		{ 20, 0, frame_count },
+		{ 20, 6, frame_count },
+		{ 20, -6, frame_count },
+		{ 10, 0, frame_count },
+		{ 10, 9, frame_count },
+		{ 6, 0, frame_count * 7 / 10 },
+		{ 6, 6, frame_count * 7 / 10 },
+		{ 4, 0, frame_count / 10 },
+	};
+
+	for(const auto& c : cases) {
+		const auto recording = make_recording(c.snr_db, c.tilt_db);
+		const auto one = decode(recording, 1);
+		const auto five = decode(recording, 5);
+		std::printf("SNR %4.1fdB, tilt %+3.0fdB: %2zu/%zu decoded with 1 slicer, %2zu with 5, %zu extra\n",
+			c.snr_db, c.tilt_db, one.good, frame_count, five.good, five.extra);
+		CHECK(five.good >= c.good_min);
+		CHECK(five.good >= one.good);
+		CHECK(five.extra == 0);
+	}
+
+	const auto burst = make_burst();
+	const auto burst_count = decode(burst, 5);
+	std::printf("Shared flags: %zu/%zu decoded\n", burst_count.good, burst.expected.size());
+	CHECK(burst_count.good == burst.expected.size());
+	CHECK(burst_count.extra == 0);
+
+	return test_failures();
+}
@@ -0,0 +1,186 @@
+/*
+ * Copyright (C) 2026 agent
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/* Runs the AudioOutput filter chain (high-pass, then de-emphasis) in Q31 on
+ * Q23 samples, as the M4 does, and in float, as it used to. Both are checked
+ * against the same biquads in double: the Q31 chain must be within 1 LSB and
+ * no worse than float. The squelch's Q15 high-pass is checked against float.
+ * Errors are in int16 output LSBs.
+ */
+
+#include "dsp_iir.hpp"
+#include "dsp_iir_config.hpp"
+#include "test_check.hpp"
+
+#include <hal.h>
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+#include <algorithm>
+
+static constexpr size_t length = 48000;
+static constexpr size_t headroom_bits = 8;
+
+struct Chain {
+	const char* const name;
+	const uint32_t sampling_rate;
+	const iir_biquad_config_t& hpf;
+	const iir_biquad_config_t& deemph;
+};
+
+static std::vector<float> test_signal(const uint32_t sampling_rate, const float amplitude) {
+	std::vector<float> signal(length);
+	uint32_t lfsr = 1;
+	for(size_t i=0; i<length; i++) {
+		const float t = float(i) / sampling_rate;
+		lfsr = lfsr * 1664525 + 1013904223;
+		const float noise = (int32_t(lfsr) / 2147483648.0f) * 0.05f;
+		signal[i] = amplitude * (
+			0.4f * std::sin(2 * M_PI * 1000 * t) +
+			0.2f * std::sin(2 * M_PI * 3100 * t) +
+			0.2f * std::sin(2 * M_PI * 12 * t) +
+			0.1f + noise
+		);
+	}
+	return signal;
+}
+
+/* Direct form I in double, the reference for both. */
+class BiquadDouble {
+public:
+	BiquadDouble(const iir_biquad_config_t& config) {
+		std::copy(config.b.begin(), config.b.end(), b);
+		std::copy(config.a.begin(), config.a.end(), a);
+	}
+
+	double execute(const double x0) {
+		const double y0 = b[0] * x0 + b[1] * x1 + b[2] * x2 - a[1] * y1 - a[2] * y2;
+		x2 = x1;
+		x1 = x0;
+		y2 = y1;
+		y1 = y0;
+		return y0;
+	}
+
+private:
+	double b[3];
+	double a[3];
+	double x1 { 0 }, x2 { 0 };
+	double y1 { 0 }, y2 { 0 };
+};
+
+static int16_t to_int16(const float v) {
+	return __SSAT(static_cast<int32_t>(std::lround(v * 32768.0f)), 16);
+}
+
+struct ChainError {
+	double float_max;
+	double q31_max;
+};
+
+static ChainError chain_error(const Chain& chain, const float amplitude) {
+	auto signal_f = test_signal(chain.sampling_rate, amplitude);
+	std::vector<int32_t> signal_q(length);
+	std::vector<double> signal_d(length);
+	for(size_t i=0; i<length; i++) {
+		signal_q[i] = static_cast<int32_t>(signal_f[i] * (32768.0f * (1 << headroom_bits)));
+		signal_d[i] = signal_f[i];
+	}
+
+	IIRBiquadFilter hpf_f { chain.hpf };
+	IIRBiquadFilter deemph_f { chain.deemph };
+	IIRBiquadFilterQ31 hpf_q { chain.hpf };
+	IIRBiquadFilterQ31 deemph_q { chain.deemph };
+	BiquadDouble hpf_d { chain.hpf };
+	BiquadDouble deemph_d { chain.deemph };
+
+	// Blocks of 32, as AudioOutput processes them.
+	for(size_t offset=0; offset<length; offset+=32) {
+		const buffer_f32_t block_f { &signal_f[offset], 32, chain.sampling_rate };
+		hpf_f.execute_in_place(block_f);
+		deemph_f.execute_in_place(block_f);
+
+		const buffer_s32_t block_q { &signal_q[offset], 32, chain.sampling_rate };
+		hpf_q.execute_in_place(block_q);
+		deemph_q.execute_in_place(block_q);
+	}
+
+	ChainError error { 0, 0 };
+	for(size_t i=0; i<length; i++) {
+		const double exact = deemph_d.execute(hpf_d.execute(signal_d[i])) * 32768.0;
+		error.float_max = std::max(error.float_max, std::abs(signal_f[i] * 32768.0 - exact));
+		error.q31_max = std::max(error.q31_max, std::abs(signal_q[i] / double(1 << headroom_bits) - exact));
+	}
+	return error;
+}
+
+static int32_t squelch_hpf_error() {
+	auto reference = test_signal(48000, 0.5f);
+	std::vector<int16_t> input(length);
+	std::vector<int16_t> output(length);
+	for(size_t i=0; i<length; i++) {
+		input[i] = to_int16(reference[i]);
+		reference[i] = input[i] / 32768.0f;
+	}
+
+	IIRBiquadFilter hpf_f { non_audio_hpf_config };
+	IIRBiquadFilterQ15 hpf_q { non_audio_hpf_config };
+	for(size_t offset=0; offset<length; offset+=32) {
+		hpf_f.execute_in_place(buffer_f32_t { &reference[offset], 32, 48000 });
+		hpf_q.execute(
+			buffer_s16_t { &input[offset], 32, 48000 },
+			buffer_s16_t { &output[offset], 32, 48000 }
+		);
+	}
+
+	int32_t error_max = 0;
+	for(size_t i=0; i<length; i++) {
+		error_max = std::max(error_max, std::abs(output[i] - to_int16(reference[i])));
+	}
+	return error_max;
+}
+
+int main() {
+	const Chain chains[] {
+		{ "WFM 48k", 48000, audio_48k_hpf_30hz_config, audio_48k_deemph_2122_6_config },
+		{ "NFM 24k", 24000, audio_24k_hpf_300hz_config, audio_24k_deemph_300_6_config },
+		{ "NFM 12k", 12000, audio_12k_hpf_300hz_config, audio_12k_deemph_300_6_config },
+		{ "AM 12k", 12000, audio_12k_hpf_300hz_config, iir_config_passthrough },
+	};
+
+	for(const auto& chain : chains) {
+		for(const float amplitude : { 0.01f, 0.5f, 1.0f }) {
+			const auto error = chain_error(chain, amplitude);
+			std::printf("%s, amplitude %.2f: max error float %.3f, Q31 %.3f LSB\n",
+				chain.name, amplitude, error.float_max, error.q31_max);
+			CHECK(error.q31_max <= 1.0);
+			CHECK(error.q31_max <= std::max(error.float_max, 0.01));
+		}
+	}
+
+	// A detector, not audio: a few LSB are fine against a threshold.
+	const auto squelch_error = squelch_hpf_error();
+	std::printf("Squelch high-pass: Q15 max error %d LSB\n", squelch_error);
+	CHECK(squelch_error <= 16);
+
+	return test_failures();
+}
@@ -0,0 +1,205 @@
+/*
+ * Copyright (C) 2026 agent
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/* Message dispatch on the M0: the std::function table event_m0 used to
+ * have, against the flat handler/context table behind MessageHandler and the
+ * same table reached through MessageHandlerRegistration's thunk. The tables
+ * are copies of the event_m0 ones, which can't be built without the UI and
+ * ChibiOS. All three must deliver every message once to the right view; the
+ * ns/dispatch and table sizes are only printed.
+ */
+
+#include "test_check.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <array>
+#include <functional>
+#include <chrono>
+#include <algorithm>
+
+struct Message {
+	size_t id;
+	uint32_t value;
+};
+
+static constexpr size_t message_id_max = 64;
+static constexpr size_t views_count = 8;
+
+struct View {
+	uint32_t sum { 0 };
+	uint32_t count { 0 };
+
+	void on_message(const Message* const message) {
+		sum += message->value;
+		count++;
+	}
+};
+
+/* The std::function table MessageHandlerMap used before. */
+class FunctionMap {
+public:
+	using Handler = std::function<void(Message* const p)>;
+
+	void register_handler(const size_t id, Handler&& handler) {
+		map_[id] = std::move(handler);
+	}
+
+	__attribute__((noinline)) void send(Message* const message) {
+		if( message->id < message_id_max ) {
+			auto& fn = map_[message->id];
+			if( fn ) {
+				fn(message);
+			}
+		}
+	}
+
+	static constexpr size_t table_size() {
+		return sizeof(std::array<Handler, message_id_max>);
+	}
+
+private:
+	std::array<Handler, message_id_max> map_ { };
+};
+
+/* MessageHandlerMap as it is now. */
+class FlatMap {
+public:
+	using Handler = void (*)(void* const context, Message* const p);
+
+	void register_handler(const size_t id, const Handler handler, void* const context) {
+		map_[id] = { handler, context };
+	}
+
+	__attribute__((noinline)) void send(Message* const message) {
+		if( message->id < message_id_max ) {
+			const auto& entry = map_[message->id];
+			if( entry.handler ) {
+				entry.handler(entry.context, message);
+			}
+		}
+	}
+
+	static constexpr size_t table_size() {
+		return sizeof(std::array<Entry, message_id_max>);
+	}
+
+private:
+	struct Entry {
+		Handler handler;
+		void* context;
+	};
+
+	std::array<Entry, message_id_max> map_ { };
+};
+
+/* MessageHandler's dispatch. */
+template<typename Owner, void (Owner::*Fn)(const Message* const)>
+static void typed_dispatch(void* const context, Message* const p) {
+	(static_cast<Owner*>(context)->*Fn)(p);
+}
+
+/* MessageHandlerRegistration's dispatch. */
+struct Registration {
+	std::function<void(Message* const p)> callback;
+
+	static void dispatch(void* const context, Message* const p) {
+		static_cast<Registration*>(context)->callback(p);
+	}
+};
+
+static constexpr size_t runs = 5;
+static constexpr size_t dispatches = 20000000;
+
+template<typename Send>
+static double best_ns_per_dispatch(Send&& send, std::array<Message, views_count>& messages) {
+	double best = 1e9;
+	for(size_t r=0; r<runs; r++) {
+		const auto t0 = std::chrono::steady_clock::now();
+		for(size_t i=0; i<dispatches; i++) {
+			send(&messages[i % views_count]);
+		}
+		const auto t1 = std::chrono::steady_clock::now();
+		best = std::min(best, std::chrono::duration<double, std::nano>(t1 - t0).count() / dispatches);
+	}
+	return best;
+}
+
+static void check_views(const std::array<View, views_count>& views, const std::array<Message, views_count>& messages) {
+	for(size_t i=0; i<views_count; i++) {
+		const uint32_t expected_count = runs * dispatches / views_count;
+		CHECK(views[i].count == expected_count);
+		CHECK(views[i].sum == uint32_t(expected_count * messages[i].value));
+	}
+}
+
+int main() {
+	std::array<Message, views_count> messages;
+	for(size_t i=0; i<views_count; i++) {
+		messages[i] = { i * 7, uint32_t(i + 1) };
+	}
+	/* An unregistered ID and one out of range must be ignored. */
+	Message unhandled { 1, 100 };
+	Message out_of_range { message_id_max, 100 };
+
+	std::array<View, views_count> function_views;
+	FunctionMap function_map;
+	for(size_t i=0; i<views_count; i++) {
+		View* const view = &function_views[i];
+		function_map.register_handler(messages[i].id, [view](Message* const p) { view->on_message(p); });
+	}
+
+	std::array<View, views_count> typed_views;
+	FlatMap typed_map;
+	for(size_t i=0; i<views_count; i++) {
+		typed_map.register_handler(messages[i].id, &typed_dispatch<View, &View::on_message>, &typed_views[i]);
+	}
+
+	std::array<View, views_count> thunk_views;
+	std::array<Registration, views_count> registrations;
+	FlatMap thunk_map;
+	for(size_t i=0; i<views_count; i++) {
+		View* const view = &thunk_views[i];
+		registrations[i].callback = [view](Message* const p) { view->on_message(p); };
+		thunk_map.register_handler(messages[i].id, &Registration::dispatch, &registrations[i]);
+	}
+
+	const auto function_ns = best_ns_per_dispatch([&function_map](Message* const m) { function_map.send(m); }, messages);
+	const auto typed_ns = best_ns_per_dispatch([&typed_map](Message* const m) { typed_map.send(m); }, messages);
+	const auto thunk_ns = best_ns_per_dispatch([&thunk_map](Message* const m) { thunk_map.send(m); }, messages);
+
+	function_map.send(&unhandled);
+	function_map.send(&out_of_range);
+	typed_map.send(&unhandled);
+	typed_map.send(&out_of_range);
+	thunk_map.send(&unhandled);
+	thunk_map.send(&out_of_range);
+
+	check_views(function_views, messages);
+	check_views(typed_views, messages);
+	check_views(thunk_views, messages);
+
+	std::printf("std::function table : %5.2f ns/dispatch, table %zu B\n", function_ns, FunctionMap::table_size());
+	std::printf("typed flat table    : %5.2f ns/dispatch, table %zu B\n", typed_ns, FlatMap::table_size());
+	std::printf("flat + lambda thunk : %5.2f ns/dispatch\n", thunk_ns);
+
+	return test_failures();
+}
@@ -0,0 +1,216 @@
+/*
+ * Copyright (C) 2026 agent
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/* dsp::modulate against the per-processor code it replaced (a phase
+ * accumulator and two sine_table_i8 lookups per sample): spur-free dynamic
+ * range of the carrier from an FFT, tone accuracy, AM scaling, buffer edges,
+ * and time per 2048-sample transmit buffer on the host. The timings are
+ * printed, not checked, as they depend on the machine.
+ */
+
+#include "dsp_modulate.hpp"
+#include "sine_table_int8.hpp"
+#include "test_check.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <cmath>
+#include <complex>
+#include <vector>
+#include <chrono>
+#include <algorithm>
+
+static constexpr size_t buffer_samples = 2048;
+static constexpr size_t fft_length = 65536;
+
+/* The removed per-processor carrier loop. */
+static void old_carrier(const buffer_c8_t& dst, uint32_t& phase, const uint32_t step) {
+	for(size_t i=0; i<dst.count; i++) {
+		phase += step;
+		const uint32_t sphase = phase + (64 << 24);
+		dst.p[i] = { sine_table_i8[(sphase & 0xff000000) >> 24], sine_table_i8[(phase & 0xff000000) >> 24] };
+	}
+}
+
+static void fft(std::vector<std::complex<double>>& a) {
+	const size_t n = a.size();
+	for(size_t i=1, j=0; i<n; i++) {
+		size_t bit = n >> 1;
+		for(; j & bit; bit >>= 1) {
+			j ^= bit;
+		}
+		j ^= bit;
+		if( i < j ) {
+			std::swap(a[i], a[j]);
+		}
+	}
+	for(size_t length=2; length<=n; length<<=1) {
+		const std::complex<double> w_length = std::polar(1.0, -2 * M_PI / length);
+		for(size_t i=0; i<n; i+=length) {
+			std::complex<double> w { 1.0 };
+			for(size_t j=0; j<length/2; j++) {
+				const auto u = a[i + j];
+				const auto v = a[i + j + length / 2] * w;
+				a[i + j] = u + v;
+				a[i + j + length / 2] = u - v;
+				w *= w_length;
+			}
+		}
+	}
+}
+
+/* Carrier power over the strongest other bin, Blackman window, ignoring
+ * the window's main lobe.
+ */
+static double sfdr_db(const std::vector<complex8_t>& samples) {
+	const size_t n = samples.size();
+	std::vector<std::complex<double>> spectrum(n);
+	for(size_t i=0; i<n; i++) {
+		const double w = 0.42 - 0.5 * std::cos(2 * M_PI * i / n) + 0.08 * std::cos(4 * M_PI * i / n);
+		spectrum[i] = std::complex<double>(samples[i].real(), samples[i].imag()) * w;
+	}
+	fft(spectrum);
+
+	size_t peak = 0;
+	for(size_t i=0; i<n; i++) {
+		if( std::norm(spectrum[i]) > std::norm(spectrum[peak]) ) {
+			peak = i;
+		}
+	}
+
+	double spur = 0;
+	for(size_t i=0; i<n; i++) {
+		const size_t d = (i > peak) ? (i - peak) : (peak - i);
+		if( std::min(d, n - d) > 8 ) {
+			spur = std::max(spur, std::norm(spectrum[i]));
+		}
+	}
+	return 10 * std::log10(std::norm(spectrum[peak]) / spur);
+}
+
+static void check_spurs() {
+	// A few carrier offsets as fractions of the sampling rate, not bin-centred
+	for(const double offset : { 0.0123, 0.1, 0.2371, -0.3141 }) {
+		const uint32_t step = static_cast<uint32_t>(static_cast<int64_t>(offset * 4294967296.0));
+
+		std::vector<complex8_t> new_samples(fft_length);
+		dsp::modulate::FM fm;
+		fm.carrier({ new_samples.data(), fft_length, 0 }, step);
+
+		std::vector<complex8_t> old_samples(fft_length);
+		uint32_t phase = 0;
+		old_carrier({ old_samples.data(), fft_length, 0 }, phase, step);
+
+		const auto sfdr_new = sfdr_db(new_samples);
+		const auto sfdr_old = sfdr_db(old_samples);
+		std::printf("Carrier at %+.4f fs: SFDR %.1f dBc, was %.1f dBc\n", offset, sfdr_new, sfdr_old);
+		// Periodic offsets like fs/10 are limited by int8 rounding, not the table
+		CHECK(sfdr_new >= 50.0);
+		CHECK(sfdr_new >= sfdr_old + 8.0);
+	}
+}
+
+static void check_tone() {
+	int32_t error_max = 0;
+	for(uint64_t phase=0; phase<(1ULL << 32); phase+=0x10001) {
+		const auto exact = std::lround(127.0 * std::sin(2 * M_PI * phase / 4294967296.0));
+		error_max = std::max<int32_t>(error_max, std::abs(dsp::modulate::sine_s8(phase) - exact));
+	}
+	std::printf("Tone: max error %d LSB\n", error_max);
+	CHECK(error_max <= 1);
+}
+
+static void check_am() {
+	std::array<complex8_t, 64> samples;
+	dsp::modulate::AM am;
+	am.configure(0x10000000);
+	for(const int32_t amplitude : { 0, 64, 128, 256 }) {
+		am.execute({ samples.data(), samples.size(), 0 }, [amplitude]() { return amplitude; });
+		int32_t peak = 0;
+		for(const auto& s : samples) {
+			peak = std::max({ peak, std::abs(int32_t(s.real())), std::abs(int32_t(s.imag())) });
+		}
+		CHECK(std::abs(peak - ((127 * amplitude) >> 8)) <= 1);
+	}
+}
+
+/* Odd start and length: every sample written, nothing past the end. */
+static void check_edges() {
+	dsp::modulate::FM reference;
+	std::array<complex8_t, 16> expected;
+	reference.carrier({ expected.data(), expected.size(), 0 }, 0x12345678);
+
+	for(size_t offset=0; offset<2; offset++) {
+		for(size_t count=0; count<=13; count++) {
+			alignas(4) std::array<complex8_t, 20> samples;
+			samples.fill({ 0x55, 0x55 });
+			dsp::modulate::FM fm;
+			fm.carrier({ &samples[offset], count, 0 }, 0x12345678);
+			for(size_t i=0; i<samples.size(); i++) {
+				const bool written = (i >= offset) && (i < offset + count);
+				const complex8_t want = written ? expected[i - offset] : complex8_t { 0x55, 0x55 };
+				CHECK(samples[i] == want);
+			}
+		}
+	}
+}
+
+static void report_timing() {
+	static constexpr size_t buffers = 20000;
+	std::vector<complex8_t> samples(buffer_samples);
+	const buffer_c8_t buffer { samples.data(), buffer_samples, 0 };
+
+	dsp::modulate::FM fm;
+	const auto t0 = std::chrono::steady_clock::now();
+	for(size_t n=0; n<buffers; n++) {
+		fm.carrier(buffer, 0x0a3d70a3 + n);
+	}
+	const auto t1 = std::chrono::steady_clock::now();
+
+	uint32_t phase = 0;
+	for(size_t n=0; n<buffers; n++) {
+		old_carrier(buffer, phase, 0x0a3d70a3 + n);
+	}
+	const auto t2 = std::chrono::steady_clock::now();
+
+	// Tone source through the FM modulator, as AFSK and SSTV use it
+	dsp::modulate::Tone tone;
+	for(size_t n=0; n<buffers; n++) {
+		fm.execute(buffer, [&tone]() { return tone.next(0x01000000) * 0x10000; });
+	}
+	const auto t3 = std::chrono::steady_clock::now();
+
+	const auto per_buffer = [](const std::chrono::steady_clock::duration d) {
+		return std::chrono::duration<double, std::micro>(d).count() / buffers;
+	};
+	std::printf("Host time per %zu-sample buffer: carrier %.2f us, old carrier %.2f us, FM tone %.2f us\n",
+		buffer_samples, per_buffer(t1 - t0), per_buffer(t2 - t1), per_buffer(t3 - t2));
+}
+
+int main() {
+	check_spurs();
+	check_tone();
+	check_am();
+	check_edges();
+	report_timing();
+
+	return test_failures();
+}
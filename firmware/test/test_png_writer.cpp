@@ -0,0 +1,160 @@
+/*
+ * Copyright (C) 2026 agent
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/* Writes screenshots with PNGWriter and decodes them with zlib: every chunk
+ * CRC must match, the IDAT stream must inflate, and the unfiltered rows must
+ * be the pixels that went in.
+ */
+
+#include "png_writer.hpp"
+#include "test_check.hpp"
+
+#include <zlib.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+#include <array>
+
+static constexpr size_t width = 240;
+static constexpr size_t height = 320;
+static constexpr size_t row_bytes = width * 3;
+
+using Image = std::vector<std::array<ui::ColorRGB888, width>>;
+
+static uint32_t be32(const uint8_t* const p) {
+	return (uint32_t(p[0]) << 24) | (uint32_t(p[1]) << 16) | (uint32_t(p[2]) << 8) | p[3];
+}
+
+/* Menus and status bar: flat blocks of a few colours. */
+static Image ui_image() {
+	Image image(height);
+	for(size_t y=0; y<height; y++) {
+		for(size_t x=0; x<width; x++) {
+			const uint8_t v = ((x / 20 + y / 16) % 3) ? 30 : 200;
+			image[y][x] = { v, uint8_t(v / 2), uint8_t((y < 16) ? 255 : 0) };
+		}
+	}
+	return image;
+}
+
+/* Waterfall-like: smooth horizontal and vertical gradients. */
+static Image gradient_image() {
+	Image image(height);
+	for(size_t y=0; y<height; y++) {
+		for(size_t x=0; x<width; x++) {
+			image[y][x] = { uint8_t(x), uint8_t(y), uint8_t(x + y) };
+		}
+	}
+	return image;
+}
+
+/* Worst case for the encoder, nothing to match. */
+static Image noise_image() {
+	Image image(height);
+	srand(1);
+	for(auto& row : image) {
+		for(auto& pixel : row) {
+			pixel = { uint8_t(rand()), uint8_t(rand()), uint8_t(rand()) };
+		}
+	}
+	return image;
+}
+
+static size_t check_round_trip(const Image& image) {
+	{
+		PNGWriter png;
+		CHECK(!png.create("TEST.PNG").is_valid());
+		for(const auto& row : image) {
+			png.write_scanline(row);
+		}
+	}
+
+	const auto& file = host_files()["TEST.PNG"];
+	static constexpr uint8_t signature[8] { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n' };
+	CHECK(file.size() > 8);
+	CHECK(std::equal(signature, signature + 8, file.begin()));
+
+	std::vector<uint8_t> idat;
+	bool ihdr_seen = false;
+	bool iend_seen = false;
+	size_t offset = 8;
+	while( offset + 12 <= file.size() ) {
+		const auto length = be32(&file[offset]);
+		const auto type = &file[offset + 4];
+		const auto data = &file[offset + 8];
+		CHECK(offset + 12 + length <= file.size());
+		CHECK(crc32(crc32(0, nullptr, 0), type, length + 4) == be32(data + length));
+
+		const std::string name(type, type + 4);
+		if( name == "IHDR" ) {
+			CHECK(be32(data) == width);
+			CHECK(be32(data + 4) == height);
+			ihdr_seen = true;
+		} else if( name == "IDAT" ) {
+			idat.insert(idat.end(), data, data + length);
+		} else if( name == "IEND" ) {
+			iend_seen = true;
+		}
+		offset += 12 + length;
+	}
+	CHECK(ihdr_seen);
+	CHECK(iend_seen);
+	CHECK(offset == file.size());
+
+	// uncompress() checks the Adler-32 as well.
+	std::vector<uint8_t> raw(height * (1 + row_bytes));
+	uLongf raw_length = raw.size();
+	CHECK(uncompress(raw.data(), &raw_length, idat.data(), idat.size()) == Z_OK);
+	CHECK(raw_length == raw.size());
+
+	std::array<uint8_t, row_bytes> previous { };
+	std::array<uint8_t, row_bytes> current { };
+	for(size_t y=0; y<height; y++) {
+		const auto line = &raw[y * (1 + row_bytes)];
+		const auto filter = line[0];
+		CHECK(filter <= 2);
+		for(size_t i=0; i<row_bytes; i++) {
+			const uint8_t left = (i >= 3) ? current[i - 3] : 0;
+			const uint8_t up = previous[i];
+			const uint8_t predictor = (filter == 1) ? left : ((filter == 2) ? up : 0);
+			current[i] = line[1 + i] + predictor;
+		}
+		CHECK(!memcmp(current.data(), image[y].data(), row_bytes));
+		previous = current;
+	}
+
+	return file.size();
+}
+
+int main() {
+	const auto ui_size = check_round_trip(ui_image());
+	const auto gradient_size = check_round_trip(gradient_image());
+	const auto noise_size = check_round_trip(noise_image());
+
+	std::printf("PNG bytes: ui %zu, gradient %zu, noise %zu (raw %zu)\n",
+		ui_size, gradient_size, noise_size, height * (1 + row_bytes));
+
+	// Flat UI screens are what the DEFLATE encoder is for.
+	CHECK(ui_size < 16384);
+
+	return test_failures();
+}
@@ -0,0 +1,175 @@
+/*
+ * Copyright (C) 2026 agent
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/* RecentEntries against the std::list it replaced: the same sequence of
+ * packets must give the same entries in the same order, forwards and
+ * backwards, with the same lookups, for key populations below, at and far
+ * above the capacity. Then both are timed on 2M packets from 32 up to 16k
+ * distinct keys.
+ */
+
+#include "recent_entries_container.hpp"
+#include "test_check.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <list>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <algorithm>
+
+static constexpr size_t capacity = 64;
+
+/* Shaped like the decoder apps' entries: a key, counters and some text. */
+struct Entry {
+	using Key = uint32_t;
+
+	Key key_;
+	uint32_t received_count { 0 };
+	std::string last_text { "B5 1D 2C" };
+
+	Entry(const Key key) : key_ { key } { }
+
+	Key key() const {
+		return key_;
+	}
+};
+
+/* The std::list code that RecentEntries replaced. */
+namespace list_model {
+
+using Entries = std::list<Entry>;
+
+static Entries::iterator find(Entries& entries, const Entry::Key key) {
+	return std::find_if(entries.begin(), entries.end(), [key](const Entry& e) { return e.key() == key; });
+}
+
+static void truncate_entries(Entries& entries, const size_t entries_max = capacity) {
+	while( entries.size() > entries_max ) {
+		entries.pop_back();
+	}
+}
+
+static Entry& on_packet(Entries& entries, const Entry::Key key) {
+	auto matching_recent = find(entries, key);
+	if( matching_recent != entries.end() ) {
+		entries.push_front(*matching_recent);
+		entries.erase(matching_recent);
+	} else {
+		entries.emplace_front(key);
+		truncate_entries(entries);
+	}
+	return entries.front();
+}
+
+} /* namespace list_model */
+
+static bool same_entries(const list_model::Entries& expected, const RecentEntries<Entry, capacity>& entries) {
+	if( expected.size() != entries.size() ) {
+		return false;
+	}
+
+	auto it = entries.begin();
+	for(const auto& e : expected) {
+		if( (e.key() != it->key()) || (e.received_count != it->received_count) ) {
+			return false;
+		}
+		++it;
+	}
+	if( it != entries.end() ) {
+		return false;
+	}
+
+	auto reverse = entries.end();
+	for(auto e=expected.rbegin(); e!=expected.rend(); ++e) {
+		--reverse;
+		if( e->key() != reverse->key() ) {
+			return false;
+		}
+	}
+	return true;
+}
+
+static void check_against_list(std::mt19937& rng) {
+	for(const uint32_t keys : { 10, 64, 65, 200, 5000 }) {
+		list_model::Entries expected;
+		RecentEntries<Entry, capacity> entries;
+
+		for(size_t i=0; i<100000; i++) {
+			const Entry::Key key = rng() % keys;
+			list_model::on_packet(expected, key).received_count++;
+			on_packet(entries, key).received_count++;
+
+			if( (i % 997) == 0 ) {
+				CHECK(same_entries(expected, entries));
+				for(size_t q=0; q<20; q++) {
+					const Entry::Key probe = rng() % keys;
+					const bool in_list = list_model::find(expected, probe) != expected.end();
+					const bool in_entries = find(entries, probe) != entries.end();
+					CHECK(in_list == in_entries);
+				}
+			}
+		}
+
+		list_model::truncate_entries(expected, 10);
+		truncate_entries(entries, 10);
+		CHECK(same_entries(expected, entries));
+	}
+}
+
+static void benchmark(std::mt19937& rng) {
+	for(const uint32_t keys : { 32, 64, 1000, 4000, 16000 }) {
+		std::vector<Entry::Key> packets(2000000);
+		for(auto& key : packets) {
+			key = (rng() % keys) * 2654435761U;
+		}
+
+		list_model::Entries list_entries;
+		RecentEntries<Entry, capacity> entries;
+		uint64_t sink = 0;
+
+		const auto t0 = std::chrono::steady_clock::now();
+		for(const auto key : packets) {
+			sink += list_model::on_packet(list_entries, key).received_count++;
+		}
+		const auto t1 = std::chrono::steady_clock::now();
+		for(const auto key : packets) {
+			sink += on_packet(entries, key).received_count++;
+		}
+		const auto t2 = std::chrono::steady_clock::now();
+
+		const auto ns_per_packet = [&packets](const std::chrono::steady_clock::duration d) {
+			return std::chrono::duration<double, std::nano>(d).count() / packets.size();
+		};
+		std::printf("%5u keys: std::list %6.1f ns/packet, RecentEntries %5.1f ns/packet (%u)\n",
+			keys, ns_per_packet(t1 - t0), ns_per_packet(t2 - t1), unsigned(sink & 1));
+	}
+}
+
+int main() {
+	std::mt19937 rng { 1 };
+	check_against_list(rng);
+	benchmark(rng);
+
+	return test_failures();
+}
@@ -0,0 +1,151 @@
+/*
+ * Copyright (C) 2026 agent
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/* RS(255, 231) as the RS41 radiosonde uses it, full length and shortened:
+ * codewords from an independent encoder, with up to 12 symbol errors
+ * corrected exactly, and more than that either refused with the codeword
+ * untouched or (rarely) miscorrected into another codeword.
+ */
+
+#include "reed_solomon.hpp"
+#include "test_check.hpp"
+
+#include <cstdint>
+#include <cstdlib>
+#include <array>
+#include <vector>
+#include <algorithm>
+
+using reed_solomon::gf256;
+
+static constexpr size_t parity = 24;
+static constexpr size_t t = parity / 2;
+// RS41 frames: 24 parity and 132 message bytes per codeword
+static constexpr size_t rs41_length = parity + 132;
+
+using Codeword = std::array<uint8_t, reed_solomon::Decoder::n>;
+
+/* Systematic encoder, lowest power first: parity in codeword[0..parity),
+ * message above. Divides by the generator prod(x - alpha^(first_root + j)).
+ */
+static void encode(Codeword& codeword, const size_t first_root) {
+	std::array<uint8_t, parity + 1> generator { };
+	generator[0] = 1;
+	for(size_t j=0; j<parity; j++) {
+		const uint8_t root = gf256.exp[(first_root + j) % 255];
+		for(size_t i=parity; i>0; i--) {
+			generator[i] = generator[i - 1] ^ gf256.mul(generator[i], root);
+		}
+		generator[0] = gf256.mul(generator[0], root);
+	}
+
+	std::array<uint8_t, parity> remainder { };
+	for(size_t i=codeword.size(); i-- > parity; ) {
+		const uint8_t feedback = codeword[i] ^ remainder[parity - 1];
+		for(size_t k=parity-1; k>0; k--) {
+			remainder[k] = remainder[k - 1] ^ gf256.mul(feedback, generator[k]);
+		}
+		remainder[0] = gf256.mul(feedback, generator[0]);
+	}
+	std::copy(remainder.begin(), remainder.end(), codeword.begin());
+}
+
+static Codeword random_codeword(const size_t length, const size_t first_root) {
+	Codeword codeword { };
+	for(size_t i=parity; i<length; i++) {
+		codeword[i] = rand();
+	}
+	encode(codeword, first_root);
+	return codeword;
+}
+
+/* Flips error_count distinct symbols below length to other values. */
+static void add_errors(Codeword& codeword, const size_t length, const size_t error_count) {
+	std::vector<size_t> positions(length);
+	for(size_t i=0; i<length; i++) {
+		positions[i] = i;
+	}
+	for(size_t i=0; i<error_count; i++) {
+		std::swap(positions[i], positions[i + rand() % (length - i)]);
+		codeword[positions[i]] ^= 1 + rand() % 255;
+	}
+}
+
+static bool is_codeword(const Codeword& codeword, const size_t first_root) {
+	auto check = codeword;
+	encode(check, first_root);
+	return check == codeword;
+}
+
+int main() {
+	srand(1);
+
+	size_t miscorrected = 0;
+	size_t refused = 0;
+
+	for(const size_t first_root : { 0, 1 }) {
+		const reed_solomon::Decoder rs { parity, first_root };
+
+		for(const size_t length : { rs41_length, reed_solomon::Decoder::n }) {
+			for(size_t error_count=0; error_count<=t; error_count++) {
+				for(size_t trial=0; trial<200; trial++) {
+					const auto sent = random_codeword(length, first_root);
+					auto received = sent;
+					add_errors(received, length, error_count);
+					CHECK(rs.decode(received.data(), length) == static_cast<int>(error_count));
+					CHECK(received == sent);
+				}
+			}
+
+			// The ends of the codeword, where an off-by-one would show
+			for(const size_t start : { size_t(0), length - t }) {
+				const auto sent = random_codeword(length, first_root);
+				auto received = sent;
+				for(size_t i=start; i<start+t; i++) {
+					received[i] ^= 0xff;
+				}
+				CHECK(rs.decode(received.data(), length) == static_cast<int>(t));
+				CHECK(received == sent);
+			}
+
+			for(size_t error_count=t+1; error_count<=2*t; error_count++) {
+				for(size_t trial=0; trial<200; trial++) {
+					auto received = random_codeword(length, first_root);
+					add_errors(received, length, error_count);
+					const auto before = received;
+					if( rs.decode(received.data(), length) < 0 ) {
+						CHECK(received == before);
+						refused++;
+					} else {
+						// Beyond the code's reach: at least it's a codeword now
+						CHECK(is_codeword(received, first_root));
+						miscorrected++;
+					}
+				}
+			}
+		}
+	}
+
+	std::printf("Beyond %zu errors: %zu refused, %zu miscorrected\n", t, refused, miscorrected);
+	CHECK(miscorrected * 1000 < refused);
+
+	return test_failures();
+}
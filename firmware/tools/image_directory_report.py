@@ -0,0 +1,101 @@
+#!/usr/bin/env python
+
+
+#
+# Copyright (C) 2026 agent
+#
+# This file is part of PortaPack.
+#
+# This program is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 2, or (at your option)
+# any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program; see the file COPYING.  If not, write to
+# the Free Software Foundation, Inc., 51 Franklin Street,
+# Boston, MA 02110-1301, USA.
+
+import sys
+import struct
+import zlib
+
+import lz4_block
+
+usage_message = """
+PortaPack baseband image directory report
+
+Usage: <command> <spi_image_path> [<spifi MB/s> [<LZ4 decode MB/s>]]
+       Lists each baseband image in the SPI flash image with its compression
+       ratio and an estimate of the M4 load time, compressed vs. plain copy.
+"""
+
+# Must match image_directory_t in common/spi_image.hpp
+image_directory_magic = b'PPIM'
+image_directory_header_format = '<4sI'
+image_directory_entry_format = '<4sIIII'
+
+# Rough M0 throughput figures: SPIFI quad reads through the cache, and the
+# byte-wise LZ4 decoder's output rate. Override on the command line once
+# measured on hardware.
+spifi_mbytes_per_second = 20.0
+lz4_mbytes_per_second = 25.0
+
+def read_image(path):
+	f = open(path, 'rb')
+	data = f.read()
+	f.close()
+	return data
+
+def find_directory(data):
+	offset = data.find(image_directory_magic)
+	while offset >= 0:
+		_, count = struct.unpack_from(image_directory_header_format, data, offset)
+		if 0 < count < 256:
+			return offset, count
+		offset = data.find(image_directory_magic, offset + 1)
+	raise RuntimeError('image directory not found')
+
+if len(sys.argv) not in (2, 3, 4):
+	print(usage_message)
+	sys.exit(-1)
+
+if len(sys.argv) >= 3:
+	spifi_mbytes_per_second = float(sys.argv[2])
+if len(sys.argv) >= 4:
+	lz4_mbytes_per_second = float(sys.argv[3])
+
+data = read_image(sys.argv[1])
+base, count = find_directory(data)
+header_size = struct.calcsize(image_directory_header_format)
+entry_size = struct.calcsize(image_directory_entry_format)
+
+def load_ms(compressed_length, length, compressed):
+	read_ms = compressed_length / (spifi_mbytes_per_second * 1000.0)
+	decode_ms = (length / (lz4_mbytes_per_second * 1000.0)) if compressed else 0.0
+	return read_ms + decode_ms
+
+print('%-4s %8s %8s %6s %8s %8s %s' % ('tag', 'length', 'stored', 'ratio', 'copy ms', 'load ms', 'crc'))
+
+total_length = 0
+total_stored = 0
+for i in range(count):
+	tag, offset, compressed_length, length, crc32 = struct.unpack_from(image_directory_entry_format, data, base + header_size + i * entry_size)
+	stored = data[base + offset:base + offset + compressed_length]
+	compressed = compressed_length != length
+	image = lz4_block.decompress(stored, length) if compressed else stored
+	crc_ok = (zlib.crc32(image) & 0xffffffff) == crc32
+	print('%-4s %8d %8d %5.1f%% %8.2f %8.2f %s' % (
+		tag.decode('ascii'), length, compressed_length, 100.0 * compressed_length / max(length, 1),
+		load_ms(length, length, False), load_ms(compressed_length, length, compressed),
+		'ok' if crc_ok else 'BAD'
+	))
+	total_length += length
+	total_stored += compressed_length
+
+print('%d images, %d bytes stored for %d bytes of code (%.1f%%)' % (count, total_stored, total_length, 100.0 * total_stored / max(total_length, 1)))
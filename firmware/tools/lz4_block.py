@@ -0,0 +1,130 @@
+#!/usr/bin/env python
+
+
+#
+# Copyright (C) 2026 agent
+#
+# This file is part of PortaPack.
+#
+# This program is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 2, or (at your option)
+# any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program; see the file COPYING.  If not, write to
+# the Free Software Foundation, Inc., 51 Franklin Street,
+# Boston, MA 02110-1301, USA.
+
+# LZ4 block format (no frame header) compressor and decompressor, used to
+# pack baseband images into the SPI flash image. Greedy matching over short
+# hash chains: not the best ratio, but deterministic and dependency-free.
+
+import struct
+
+min_match = 4
+max_offset = 65535
+# LZ4 block rules: the last match must start at least 12 bytes before the
+# end of the block, and the last 5 bytes are always literals.
+match_start_margin = 12
+last_literals = 5
+
+def _write_length(out, n):
+	while n >= 255:
+		out.append(255)
+		n -= 255
+	out.append(n)
+
+def _emit(out, literals, offset=None, match_length=None):
+	literal_length = len(literals)
+	token = min(literal_length, 15) << 4
+	if match_length is not None:
+		token |= min(match_length - min_match, 15)
+	out.append(token)
+	if literal_length >= 15:
+		_write_length(out, literal_length - 15)
+	out += literals
+	if match_length is not None:
+		out += struct.pack('<H', offset)
+		if (match_length - min_match) >= 15:
+			_write_length(out, match_length - min_match - 15)
+
+def _match_length(data, a, b, limit):
+	length = 0
+	while (length < limit) and (data[a + length] == data[b + length]):
+		length += 1
+	return length
+
+def compress(data, chain_depth=32):
+	data = bytes(data)
+	n = len(data)
+	out = bytearray()
+	chains = {}
+	anchor = 0
+	i = 0
+	while i < (n - match_start_margin):
+		key = data[i:i + min_match]
+		chain = chains.setdefault(key, [])
+		best_length = 0
+		best_offset = 0
+		match_length_max = n - last_literals - i
+		for candidate in reversed(chain[-chain_depth:]):
+			if (i - candidate) > max_offset:
+				break
+			length = _match_length(data, candidate, i, match_length_max)
+			if length > best_length:
+				best_length = length
+				best_offset = i - candidate
+		chain.append(i)
+		if best_length >= min_match:
+			_emit(out, data[anchor:i], best_offset, best_length)
+			for j in range(i + 1, min(i + best_length, n - match_start_margin)):
+				chains.setdefault(data[j:j + min_match], []).append(j)
+			i += best_length
+			anchor = i
+		else:
+			i += 1
+	_emit(out, data[anchor:])
+	return out
+
+def decompress(data, length):
+	data = bytearray(data)
+	out = bytearray()
+	i = 0
+	while i < len(data):
+		token = data[i]
+		i += 1
+		literal_length = token >> 4
+		if literal_length == 15:
+			while True:
+				b = data[i]
+				i += 1
+				literal_length += b
+				if b != 255:
+					break
+		out += data[i:i + literal_length]
+		i += literal_length
+		if i >= len(data):
+			break
+		offset = data[i] | (data[i + 1] << 8)
+		i += 2
+		match_length = token & 15
+		if match_length == 15:
+			while True:
+				b = data[i]
+				i += 1
+				match_length += b
+				if b != 255:
+					break
+		match_length += min_match
+		start = len(out) - offset
+		for j in range(match_length):
+			out.append(out[start + j])
+	if len(out) != length:
+		raise RuntimeError('decompressed length %d does not match expected %d' % (len(out), length))
+	return out
@@ -22,6 +22,10 @@
 #
 
 import sys
+import struct
+import zlib
+
+import lz4_block
 
 usage_message = """
 PortaPack SPI flash image generator
@@ -45,8 +49,46 @@ if len(sys.argv) != 4:
 	print(usage_message)
 	sys.exit(-1)
 
+# Must match image_directory_t in common/spi_image.hpp
+image_directory_magic = b'PPIM'
+image_directory_header_format = '<4sI'
+image_directory_entry_format = '<4sIIII'
+
+def read_chunks(data):
+	# Baseband images arrive as a list of <tag><length><data> chunks (see
+	# make_image_chunk.py), ended by a chunk with an all-zero tag.
+	chunks = []
+	offset = 0
+	while True:
+		tag, length = struct.unpack_from('<4sI', data, offset)
+		offset += 8
+		if tag == b'\0\0\0\0':
+			break
+		chunks.append((tag, bytes(data[offset:offset + length])))
+		offset += length
+	return chunks
+
+def make_image_directory(chunks):
+	header_size = struct.calcsize(image_directory_header_format)
+	entry_size = struct.calcsize(image_directory_entry_format)
+	offset = header_size + entry_size * len(chunks)
+
+	directory = bytearray(struct.pack(image_directory_header_format, image_directory_magic, len(chunks)))
+	payload = bytearray()
+	for tag, data in chunks:
+		compressed = lz4_block.compress(data)
+		if len(compressed) >= len(data):
+			compressed = data
+		crc32 = zlib.crc32(data) & 0xffffffff
+		directory += struct.pack(image_directory_entry_format, tag, offset, len(compressed), len(data), crc32)
+		pad_size = (-len(compressed)) & 3
+		payload += compressed + (bytearray((0,)) * pad_size)
+		offset += len(compressed) + pad_size
+
+	return directory + payload
+
 application_image = read_image(sys.argv[1])
-baseband_image = read_image(sys.argv[2])
+baseband_image = make_image_directory(read_chunks(read_image(sys.argv[2])))
 output_path = sys.argv[3]
 
 spi_size = 1048576
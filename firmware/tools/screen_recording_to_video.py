@@ -0,0 +1,112 @@
+#!/usr/bin/env python
+
+#
+# Copyright (C) 2026 agent
+#
+# This file is part of PortaPack.
+#
+# This program is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 2, or (at your option)
+# any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program; see the file COPYING.  If not, write to
+# the Free Software Foundation, Inc., 51 Franklin Street,
+# Boston, MA 02110-1301, USA.
+
+import sys
+import os
+import struct
+
+usage_message = """
+PortaPack screen recording converter
+
+Usage: <command> <recording.PSR> <output_directory>
+       Writes one PPM image per recorded frame. Frames are repeated so the
+       sequence plays back in real time at the recording's frame interval,
+       e.g.:
+           ffmpeg -framerate 10 -i <output_directory>/%05d.ppm out.mp4
+"""
+
+# Must match the format described in application/screen_recorder.hpp
+file_header_format = '<4sHHHHHH'
+frame_header_format = '<I'
+frame_end = 0xffff
+format_rgb565 = 1
+
+def read_image(path):
+	f = open(path, 'rb')
+	data = f.read()
+	f.close()
+	return data
+
+def rgb565_to_rgb888(v):
+	r = (v >> 11) & 0x1f
+	g = (v >> 5) & 0x3f
+	b = v & 0x1f
+	return bytearray(((r << 3) | (r >> 2), (g << 2) | (g >> 4), (b << 3) | (b >> 2)))
+
+def read_frames(data):
+	magic, version, width, height, pixel_format, interval_ms, _ = struct.unpack_from(file_header_format, data, 0)
+	if magic != b'PPSR' or version != 2 or pixel_format != format_rgb565:
+		raise RuntimeError('not a PortaPack screen recording')
+
+	rows = [bytearray(width * 3) for _ in range(height)]
+	offset = struct.calcsize(file_header_format)
+	while offset + struct.calcsize(frame_header_format) <= len(data):
+		time_ms, = struct.unpack_from(frame_header_format, data, offset)
+		offset += struct.calcsize(frame_header_format)
+		try:
+			while True:
+				y, = struct.unpack_from('<H', data, offset)
+				offset += 2
+				if y == frame_end:
+					break
+				row = bytearray()
+				while len(row) < width * 3:
+					count, value = struct.unpack_from('<BH', data, offset)
+					offset += 3
+					row += rgb565_to_rgb888(value) * count
+				rows[y] = row
+		except struct.error:
+			# Recording was cut off mid-frame (power loss, card pulled).
+			break
+		yield time_ms, width, height, interval_ms, b''.join(bytes(r) for r in rows)
+
+def write_ppm(path, width, height, pixels):
+	f = open(path, 'wb')
+	f.write(('P6\n%d %d\n255\n' % (width, height)).encode('ascii'))
+	f.write(pixels)
+	f.close()
+
+if len(sys.argv) != 3:
+	print(usage_message)
+	sys.exit(-1)
+
+data = read_image(sys.argv[1])
+output_path = sys.argv[2]
+if not os.path.isdir(output_path):
+	os.makedirs(output_path)
+
+output_count = 0
+previous = None
+for time_ms, width, height, interval_ms, pixels in read_frames(data):
+	# Unchanged frames are not recorded; fill the gap with the last image.
+	if previous is not None:
+		repeat = max(1, int(round(float(time_ms - previous[0]) / interval_ms)))
+		for _ in range(repeat):
+			write_ppm(os.path.join(output_path, '%05d.ppm' % output_count), width, height, previous[1])
+			output_count += 1
+	previous = (time_ms, pixels)
+
+if previous is not None:
+	write_ppm(os.path.join(output_path, '%05d.ppm' % output_count), width, height, previous[1])
+	output_count += 1
+
+print('%d frames written' % output_count)